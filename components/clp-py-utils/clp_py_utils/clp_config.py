@@ -504,6 +504,7 @@ class Reducer(BaseModel):
     base_port: Port = DEFAULT_PORT
     logging_level: LoggingLevel = "INFO"
     upsert_interval: PositiveInt = 100  # milliseconds
+    num_threads: PositiveInt = 1
 
     def transform_for_container(self):
         self.host = REDUCER_COMPONENT_NAME
@@ -33,6 +33,7 @@ def _create_archives_table(db_cursor, archives_table_name: str) -> None:
             `creator_id` VARCHAR(64) NOT NULL,
             `creation_ix` INT NOT NULL,
             KEY `archives_creation_order` (`creator_id`,`creation_ix`) USING BTREE,
+            KEY `archives_time_window` (`end_timestamp`,`begin_timestamp`) USING BTREE,
             UNIQUE KEY `archive_id` (`id`) USING BTREE,
             PRIMARY KEY (`pagination_id`)
         )
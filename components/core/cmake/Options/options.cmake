@@ -361,6 +361,7 @@ endfunction()
 
 function(set_clp_s_reducer_dependencies_dependencies)
     set_clp_need_flags(
+        CLP_NEED_ABSL
         CLP_NEED_NLOHMANN_JSON
     )
 endfunction()
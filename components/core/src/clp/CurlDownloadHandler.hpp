@@ -59,6 +59,11 @@ public:
      * `connection_timeout`. Doc: https://curl.se/libcurl/c/CURLOPT_TIMEOUT.html
      * @param http_header_kv_pairs Key-value pairs representing HTTP headers to pass to the server
      * in the download request. Doc: https://curl.se/libcurl/c/CURLOPT_HTTPHEADER.html
+     * @param end_offset Index of the byte at which to stop the download (exclusive), or
+     * `std::nullopt` to download until the end of the data. Must be greater than `offset`.
+     * @param share_handle A libcurl share handle whose caches (e.g., of connections) the download
+     * should use, or `nullptr` if the download shouldn't share any data with other downloads.
+     * Doc: https://curl.se/libcurl/c/CURLOPT_SHARE.html
      * @throw CurlOperationFailed if an error occurs.
      */
     explicit CurlDownloadHandler(
@@ -72,7 +77,9 @@ public:
             std::chrono::seconds connection_timeout = cDefaultConnectionTimeout,
             std::chrono::seconds overall_timeout = cDefaultOverallTimeout,
             std::optional<std::unordered_map<std::string, std::string>> const& http_header_kv_pairs
-            = std::nullopt
+            = std::nullopt,
+            std::optional<size_t> end_offset = std::nullopt,
+            CURLSH* share_handle = nullptr
     );
 
     // Disable copy/move constructors/assignment operators
@@ -91,6 +98,16 @@ public:
      */
     [[nodiscard]] auto perform() -> CURLcode { return m_easy_handle.perform(); }
 
+    /**
+     * @return The HTTP response code of the last transfer, or 0 if no response was received.
+     * @throw CurlOperationFailed if an error occurs.
+     */
+    [[nodiscard]] auto get_response_code() const -> long {
+        long response_code{0};
+        m_easy_handle.get_info(CURLINFO_RESPONSE_CODE, response_code);
+        return response_code;
+    }
+
 private:
     /**
      * Locates the certificate authority (CA) bundle file available on the current host.
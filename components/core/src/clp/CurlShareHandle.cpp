@@ -0,0 +1,78 @@
+#include "CurlShareHandle.hpp"
+
+#include <curl/curl.h>
+
+#include "CurlOperationFailed.hpp"
+#include "ErrorCode.hpp"
+
+namespace clp {
+namespace {
+/**
+ * libcurl callback that locks shared data.
+ * NOTE: This function must have C linkage to be a libcurl callback.
+ * @param handle Unused
+ * @param data
+ * @param access Unused
+ * @param share_handle_ptr A pointer to the `CurlShareHandle`.
+ */
+extern "C" auto curl_share_handle_lock_callback(
+        [[maybe_unused]] CURL* handle,
+        curl_lock_data data,
+        [[maybe_unused]] curl_lock_access access,
+        void* share_handle_ptr
+) -> void {
+    static_cast<CurlShareHandle*>(share_handle_ptr)->lock(data);
+}
+
+/**
+ * libcurl callback that unlocks shared data.
+ * NOTE: This function must have C linkage to be a libcurl callback.
+ * @param handle Unused
+ * @param data
+ * @param share_handle_ptr A pointer to the `CurlShareHandle`.
+ */
+extern "C" auto curl_share_handle_unlock_callback(
+        [[maybe_unused]] CURL* handle,
+        curl_lock_data data,
+        void* share_handle_ptr
+) -> void {
+    static_cast<CurlShareHandle*>(share_handle_ptr)->unlock(data);
+}
+}  // namespace
+
+CurlShareHandle::CurlShareHandle() : m_handle{curl_share_init()} {
+    if (nullptr == m_handle) {
+        throw CurlOperationFailed(
+                ErrorCode_Failure,
+                __FILE__,
+                __LINE__,
+                CURLE_FAILED_INIT,
+                "`curl_share_init` failed."
+        );
+    }
+    try {
+        set_option(CURLSHOPT_LOCKFUNC, curl_share_handle_lock_callback);
+        set_option(CURLSHOPT_UNLOCKFUNC, curl_share_handle_unlock_callback);
+        set_option(CURLSHOPT_USERDATA, static_cast<void*>(this));
+        set_option(CURLSHOPT_SHARE, CURL_LOCK_DATA_CONNECT);
+        set_option(CURLSHOPT_SHARE, CURL_LOCK_DATA_DNS);
+        set_option(CURLSHOPT_SHARE, CURL_LOCK_DATA_SSL_SESSION);
+    } catch (...) {
+        curl_share_cleanup(m_handle);
+        throw;
+    }
+}
+
+template <typename ValueType>
+auto CurlShareHandle::set_option(CURLSHoption option, ValueType value) -> void {
+    if (auto const err{curl_share_setopt(m_handle, option, value)}; CURLSHE_OK != err) {
+        throw CurlOperationFailed(
+                ErrorCode_Failure,
+                __FILE__,
+                __LINE__,
+                CURLE_FAILED_INIT,
+                "`curl_share_setopt` failed."
+        );
+    }
+}
+}  // namespace clp
@@ -0,0 +1,69 @@
+#ifndef CLP_CURLSHAREHANDLE_HPP
+#define CLP_CURLSHAREHANDLE_HPP
+
+#include <array>
+#include <mutex>
+
+#include <curl/curl.h>
+
+namespace clp {
+/**
+ * A C++ wrapper for libcurl's share handle, which lets multiple easy handles share data. This
+ * handle shares the connection cache, DNS cache, and TLS session cache, so that requests to the
+ * same host reuse connections instead of each opening (and negotiating TLS for) a new one. The
+ * shared data is protected by locks, so the easy handles using it may run on different threads.
+ *
+ * NOTE: The handle must outlive every easy handle that uses it.
+ */
+class CurlShareHandle {
+public:
+    // Constructors
+    /**
+     * @throw CurlOperationFailed if an error occurs.
+     */
+    CurlShareHandle();
+
+    // Disable copy/move constructors/assignment operators
+    CurlShareHandle(CurlShareHandle const&) = delete;
+    CurlShareHandle(CurlShareHandle&&) = delete;
+    auto operator=(CurlShareHandle const&) -> CurlShareHandle& = delete;
+    auto operator=(CurlShareHandle&&) -> CurlShareHandle& = delete;
+
+    // Destructor
+    ~CurlShareHandle() { curl_share_cleanup(m_handle); }
+
+    // Methods
+    /**
+     * @return The underlying share handle, to set as an easy handle's `CURLOPT_SHARE` option.
+     */
+    [[nodiscard]] auto get() const -> CURLSH* { return m_handle; }
+
+    /**
+     * Locks the given shared data. Called by libcurl.
+     * @param data
+     */
+    auto lock(curl_lock_data data) -> void { m_mutexes.at(data).lock(); }
+
+    /**
+     * Unlocks the given shared data. Called by libcurl.
+     * @param data
+     */
+    auto unlock(curl_lock_data data) -> void { m_mutexes.at(data).unlock(); }
+
+private:
+    /**
+     * Sets the given CURL option for this handle.
+     * @tparam ValueType
+     * @param option
+     * @param value
+     * @throw CurlOperationFailed if an error occurs.
+     */
+    template <typename ValueType>
+    auto set_option(CURLSHoption option, ValueType value) -> void;
+
+    CURLSH* m_handle{nullptr};
+    std::array<std::mutex, CURL_LOCK_DATA_LAST> m_mutexes;
+};
+}  // namespace clp
+
+#endif  // CLP_CURLSHAREHANDLE_HPP
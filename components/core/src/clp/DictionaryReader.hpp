@@ -2,6 +2,7 @@
 #define CLP_DICTIONARYREADER_HPP
 
 #include <iterator>
+#include <optional>
 #include <string>
 #include <string_view>
 #include <utility>
@@ -12,6 +13,7 @@
 
 #include "dictionary_utils.hpp"
 #include "DictionaryEntry.hpp"
+#include "DictionarySubstringIndex.hpp"
 #include "FileReader.hpp"
 #include "streaming_compression/passthrough/Decompressor.hpp"
 #include "streaming_compression/zstd/Decompressor.hpp"
@@ -65,6 +67,16 @@ public:
      */
     void read_new_entries();
 
+    /**
+     * Reads the dictionary's substring index from disk. Entries added after the index was built are
+     * still searched without the index.
+     * NOTE: This must be called after the entries covered by the index have been read.
+     * @param substring_index_path
+     */
+    void read_substring_index(std::string const& substring_index_path);
+
+    bool has_substring_index() const { return m_substring_index.has_value(); }
+
     /**
      * Gets the dictionary's entries
      * @return All dictionary entries
@@ -126,6 +138,7 @@ protected:
 #endif
     size_t m_num_segments_read_from_index;
     std::vector<EntryType> m_entries;
+    std::optional<DictionarySubstringIndex> m_substring_index;
 };
 
 template <typename DictionaryIdType, typename EntryType>
@@ -170,6 +183,7 @@ void DictionaryReader<DictionaryIdType, EntryType>::close() {
 
     m_num_segments_read_from_index = 0;
     m_entries.clear();
+    m_substring_index.reset();
 
     m_is_open = false;
 }
@@ -216,6 +230,24 @@ void DictionaryReader<DictionaryIdType, EntryType>::read_new_entries() {
     }
 }
 
+template <typename DictionaryIdType, typename EntryType>
+void DictionaryReader<DictionaryIdType, EntryType>::read_substring_index(
+        std::string const& substring_index_path
+) {
+    if (false == m_is_open) {
+        throw OperationFailed(ErrorCode_NotInit, __FILENAME__, __LINE__);
+    }
+
+    std::vector<std::string_view> values;
+    values.reserve(m_entries.size());
+    for (auto const& entry : m_entries) {
+        values.emplace_back(entry.get_value());
+    }
+    m_substring_index.emplace(
+            DictionarySubstringIndex::read_from_file(substring_index_path, values)
+    );
+}
+
 template <typename DictionaryIdType, typename EntryType>
 EntryType const&
 DictionaryReader<DictionaryIdType, EntryType>::get_entry(DictionaryIdType id) const {
@@ -277,7 +309,7 @@ void DictionaryReader<DictionaryIdType, EntryType>::get_entries_matching_wildcar
         bool ignore_case,
         std::unordered_set<EntryType const*>& entries
 ) const {
-    for (auto const& entry : m_entries) {
+    auto const add_entry_if_matching = [&](EntryType const& entry) {
         if (string_utils::wildcard_match_unsafe(
                     entry.get_value(),
                     wildcard_string,
@@ -286,6 +318,26 @@ void DictionaryReader<DictionaryIdType, EntryType>::get_entries_matching_wildcar
         {
             entries.insert(&entry);
         }
+    };
+
+    if (m_substring_index.has_value()) {
+        auto const optional_candidate_ids{
+                m_substring_index->get_ids_of_candidate_entries(wildcard_string)
+        };
+        if (optional_candidate_ids.has_value()) {
+            for (auto const id : optional_candidate_ids.value()) {
+                add_entry_if_matching(m_entries[id]);
+            }
+            // Entries added after the index was built aren't covered by it
+            for (auto i = m_substring_index->get_num_indexed_entries(); i < m_entries.size(); ++i) {
+                add_entry_if_matching(m_entries[i]);
+            }
+            return;
+        }
+    }
+
+    for (auto const& entry : m_entries) {
+        add_entry_if_matching(entry);
     }
 }
 
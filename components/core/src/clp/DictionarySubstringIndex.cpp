@@ -0,0 +1,259 @@
+#include "DictionarySubstringIndex.hpp"
+
+#include <algorithm>
+#include <cstddef>
+#include <cstdint>
+#include <iterator>
+#include <limits>
+#include <optional>
+#include <string>
+#include <string_view>
+#include <utility>
+#include <vector>
+
+#include <string_utils/constants.hpp>
+#include <string_utils/string_utils.hpp>
+
+#include "ErrorCode.hpp"
+#include "FileReader.hpp"
+#include "FileWriter.hpp"
+
+namespace clp {
+namespace {
+// Separator appended after each value so that a search can't match across two values
+constexpr char cValueSeparator{'\0'};
+constexpr size_t cNumByteValues{256};
+}  // namespace
+
+DictionarySubstringIndex::DictionarySubstringIndex(std::vector<std::string_view> const& values) {
+    build_text(values, values.size());
+    build_suffix_array();
+}
+
+auto DictionarySubstringIndex::read_from_file(
+        std::string const& path,
+        std::vector<std::string_view> const& values
+) -> DictionarySubstringIndex {
+    FileReader file_reader{path};
+    uint64_t num_indexed_entries{0};
+    file_reader.read_numeric_value(num_indexed_entries, false);
+    uint64_t text_length{0};
+    file_reader.read_numeric_value(text_length, false);
+    if (num_indexed_entries > values.size()) {
+        throw OperationFailed(ErrorCode_Corrupt, __FILENAME__, __LINE__);
+    }
+
+    DictionarySubstringIndex index;
+    index.build_text(values, num_indexed_entries);
+    if (index.m_text.size() != text_length) {
+        throw OperationFailed(ErrorCode_Corrupt, __FILENAME__, __LINE__);
+    }
+
+    index.m_suffix_array.resize(text_length);
+    if (0 == text_length) {
+        return index;
+    }
+    file_reader.read_exact_length(
+            reinterpret_cast<char*>(index.m_suffix_array.data()),
+            text_length * sizeof(uint32_t),
+            false
+    );
+    if (std::ranges::any_of(index.m_suffix_array, [&](uint32_t pos) { return pos >= text_length; }
+        ))
+    {
+        throw OperationFailed(ErrorCode_Corrupt, __FILENAME__, __LINE__);
+    }
+
+    return index;
+}
+
+auto DictionarySubstringIndex::write_to_file(std::string const& path) const -> size_t {
+    FileWriter file_writer;
+    file_writer.open(path, FileWriter::OpenMode::CREATE_FOR_WRITING);
+    file_writer.write_numeric_value<uint64_t>(m_entry_begin_offsets.size());
+    file_writer.write_numeric_value<uint64_t>(m_text.size());
+    if (false == m_suffix_array.empty()) {
+        file_writer.write(
+                reinterpret_cast<char const*>(m_suffix_array.data()),
+                m_suffix_array.size() * sizeof(uint32_t)
+        );
+    }
+    auto const index_size{file_writer.get_pos()};
+    file_writer.close();
+    return index_size;
+}
+
+auto DictionarySubstringIndex::get_ids_of_candidate_entries(std::string_view wildcard_string
+) const -> std::optional<std::vector<size_t>> {
+    auto const literal{get_longest_literal(wildcard_string)};
+    if (literal.empty()) {
+        return std::nullopt;
+    }
+
+    // Find the range of suffixes that begin with the literal
+    std::string_view const text{m_text};
+    auto const compare_suffix_prefix = [&](uint32_t pos) -> int {
+        return text.compare(pos, literal.length(), literal);
+    };
+    auto const range_begin{std::partition_point(
+            m_suffix_array.cbegin(),
+            m_suffix_array.cend(),
+            [&](uint32_t pos) { return compare_suffix_prefix(pos) < 0; }
+    )};
+    auto const range_end{std::partition_point(
+            range_begin,
+            m_suffix_array.cend(),
+            [&](uint32_t pos) { return 0 == compare_suffix_prefix(pos); }
+    )};
+
+    // Map each suffix to the entry containing it
+    std::vector<size_t> ids;
+    ids.reserve(std::distance(range_begin, range_end));
+    for (auto it{range_begin}; range_end != it; ++it) {
+        auto const next_entry_begin_it{std::upper_bound(
+                m_entry_begin_offsets.cbegin(),
+                m_entry_begin_offsets.cend(),
+                *it
+        )};
+        ids.push_back(std::distance(m_entry_begin_offsets.cbegin(), next_entry_begin_it) - 1);
+    }
+    std::ranges::sort(ids);
+    auto const duplicate_ids{std::ranges::unique(ids)};
+    ids.erase(duplicate_ids.begin(), duplicate_ids.end());
+    return ids;
+}
+
+auto DictionarySubstringIndex::build_text(
+        std::vector<std::string_view> const& values,
+        size_t num_values
+) -> void {
+    size_t text_length{0};
+    for (size_t i = 0; i < num_values; ++i) {
+        text_length += values[i].length() + 1;
+    }
+    if (text_length > std::numeric_limits<uint32_t>::max()) {
+        throw OperationFailed(ErrorCode_OutOfBounds, __FILENAME__, __LINE__);
+    }
+
+    m_text.clear();
+    m_text.reserve(text_length);
+    m_entry_begin_offsets.clear();
+    m_entry_begin_offsets.reserve(num_values);
+    for (size_t i = 0; i < num_values; ++i) {
+        m_entry_begin_offsets.push_back(static_cast<uint32_t>(m_text.length()));
+        m_text.append(values[i]);
+        m_text.push_back(cValueSeparator);
+    }
+    string_utils::to_lower(m_text);
+}
+
+auto DictionarySubstringIndex::build_suffix_array() -> void {
+    auto const text_length{m_text.length()};
+    m_suffix_array.resize(text_length);
+    if (0 == text_length) {
+        return;
+    }
+
+    auto const get_char = [&](size_t pos) -> uint8_t { return static_cast<uint8_t>(m_text[pos]); };
+
+    // Counting sort the suffixes by their first character
+    std::vector<uint32_t> counts(std::max(text_length, cNumByteValues), 0);
+    for (size_t i = 0; i < text_length; ++i) {
+        ++counts[get_char(i)];
+    }
+    for (size_t c = 1; c < cNumByteValues; ++c) {
+        counts[c] += counts[c - 1];
+    }
+    for (size_t i = text_length; i-- > 0;) {
+        m_suffix_array[--counts[get_char(i)]] = static_cast<uint32_t>(i);
+    }
+
+    std::vector<uint32_t> ranks(text_length);
+    ranks[m_suffix_array[0]] = 0;
+    for (size_t i = 1; i < text_length; ++i) {
+        auto const prev{m_suffix_array[i - 1]};
+        auto const curr{m_suffix_array[i]};
+        ranks[curr] = ranks[prev] + (get_char(prev) == get_char(curr) ? 0 : 1);
+    }
+
+    // Each iteration sorts the suffixes by their first `2 * prefix_length` characters, given that
+    // they're already ranked by their first `prefix_length` characters. This terminates once every
+    // suffix has a distinct rank.
+    std::vector<uint32_t> suffixes_by_second_half(text_length);
+    std::vector<uint32_t> new_ranks(text_length);
+    for (size_t prefix_length = 1; ranks[m_suffix_array[text_length - 1]] + 1 < text_length;
+         prefix_length *= 2)
+    {
+        // Order the suffixes by the rank of their second half. Suffixes without a second half come
+        // first.
+        size_t num_ordered{0};
+        for (auto i = text_length - std::min(prefix_length, text_length); i < text_length; ++i) {
+            suffixes_by_second_half[num_ordered++] = static_cast<uint32_t>(i);
+        }
+        for (auto const pos : m_suffix_array) {
+            if (pos >= prefix_length) {
+                suffixes_by_second_half[num_ordered++] = static_cast<uint32_t>(pos - prefix_length);
+            }
+        }
+
+        // Stably counting sort them by the rank of their first half
+        size_t const num_ranks{ranks[m_suffix_array[text_length - 1]] + 1UL};
+        std::fill_n(counts.begin(), num_ranks, 0);
+        for (auto const rank : ranks) {
+            ++counts[rank];
+        }
+        for (size_t rank = 1; rank < num_ranks; ++rank) {
+            counts[rank] += counts[rank - 1];
+        }
+        for (size_t i = text_length; i-- > 0;) {
+            auto const pos{suffixes_by_second_half[i]};
+            m_suffix_array[--counts[ranks[pos]]] = pos;
+        }
+
+        // Rerank the suffixes by their first `2 * prefix_length` characters
+        auto const get_second_half_rank = [&](uint32_t pos) -> uint64_t {
+            return pos + prefix_length < text_length ? ranks[pos + prefix_length] + 1ULL : 0;
+        };
+        new_ranks[m_suffix_array[0]] = 0;
+        for (size_t i = 1; i < text_length; ++i) {
+            auto const prev{m_suffix_array[i - 1]};
+            auto const curr{m_suffix_array[i]};
+            bool const is_same_rank{
+                    ranks[prev] == ranks[curr]
+                    && get_second_half_rank(prev) == get_second_half_rank(curr)
+            };
+            new_ranks[curr] = new_ranks[prev] + (is_same_rank ? 0 : 1);
+        }
+        ranks.swap(new_ranks);
+    }
+}
+
+auto DictionarySubstringIndex::get_longest_literal(std::string_view wildcard_string)
+        -> std::string {
+    std::string longest_literal;
+    std::string literal;
+    for (size_t i = 0; i < wildcard_string.length(); ++i) {
+        auto c{wildcard_string[i]};
+        if (string_utils::cZeroOrMoreCharsWildcard == c || string_utils::cSingleCharWildcard == c) {
+            if (literal.length() > longest_literal.length()) {
+                std::swap(literal, longest_literal);
+            }
+            literal.clear();
+            continue;
+        }
+        if (string_utils::cWildcardEscapeChar == c) {
+            ++i;
+            if (wildcard_string.length() == i) {
+                break;
+            }
+            c = wildcard_string[i];
+        }
+        literal.push_back(c);
+    }
+    if (literal.length() > longest_literal.length()) {
+        std::swap(literal, longest_literal);
+    }
+    string_utils::to_lower(longest_literal);
+    return longest_literal;
+}
+}  // namespace clp
@@ -0,0 +1,122 @@
+#ifndef CLP_DICTIONARYSUBSTRINGINDEX_HPP
+#define CLP_DICTIONARYSUBSTRINGINDEX_HPP
+
+#include <cstddef>
+#include <cstdint>
+#include <optional>
+#include <string>
+#include <string_view>
+#include <vector>
+
+#include "ErrorCode.hpp"
+#include "TraceableException.hpp"
+
+namespace clp {
+/**
+ * Index for finding the entries of a dictionary that contain a given substring without scanning
+ * every entry.
+ *
+ * The index is a suffix array over the lowercased values of the dictionary's entries, concatenated
+ * in ID order with a separator after each value. Since the values are lowercased, the same index
+ * serves both case-sensitive and case-insensitive searches. The index only narrows down the
+ * candidate entries for a query; callers must still match each candidate against the query.
+ *
+ * Only the suffix array is persisted. The concatenated values are rebuilt from the dictionary's
+ * entries when the index is read, so the index must be read after the entries it covers.
+ */
+class DictionarySubstringIndex {
+public:
+    // Types
+    class OperationFailed : public TraceableException {
+    public:
+        // Constructors
+        OperationFailed(ErrorCode error_code, char const* const filename, int line_number)
+                : TraceableException(error_code, filename, line_number) {}
+
+        // Methods
+        [[nodiscard]] auto what() const noexcept -> char const* override {
+            return "DictionarySubstringIndex operation failed";
+        }
+    };
+
+    // Constructors
+    /**
+     * Builds an index over the given values
+     * @param values The values of the dictionary's entries, in ID order
+     * @throw OperationFailed if the values are too large to index
+     */
+    explicit DictionarySubstringIndex(std::vector<std::string_view> const& values);
+
+    // Methods
+    /**
+     * Reads an index from disk
+     * @param path
+     * @param values The values of the dictionary's entries, in ID order. This may include entries
+     * that were added after the index was written.
+     * @return The index
+     * @throw OperationFailed if the index doesn't match the given values
+     * @throw FileReader::OperationFailed if reading the file fails
+     */
+    [[nodiscard]] static auto
+    read_from_file(std::string const& path, std::vector<std::string_view> const& values)
+            -> DictionarySubstringIndex;
+
+    /**
+     * Writes the index to disk
+     * @param path
+     * @return The size of the written index, in bytes
+     * @throw FileWriter::OperationFailed if writing the file fails
+     */
+    auto write_to_file(std::string const& path) const -> size_t;
+
+    /**
+     * @return The number of entries covered by the index. Entries with larger IDs must be searched
+     * without the index.
+     */
+    [[nodiscard]] auto get_num_indexed_entries() const -> size_t {
+        return m_entry_begin_offsets.size();
+    }
+
+    /**
+     * Gets the IDs of the indexed entries that may match the given wildcard string
+     * @param wildcard_string
+     * @return The IDs of the candidate entries in ascending order, or std::nullopt if the wildcard
+     * string contains no literal text to search for (i.e., every entry is a candidate).
+     */
+    [[nodiscard]] auto get_ids_of_candidate_entries(std::string_view wildcard_string) const
+            -> std::optional<std::vector<size_t>>;
+
+private:
+    // Constructors
+    DictionarySubstringIndex() = default;
+
+    // Methods
+    /**
+     * Concatenates and lowercases the first `num_values` values into `m_text`, recording where each
+     * value begins.
+     * @param values
+     * @param num_values
+     * @throw OperationFailed if the concatenated values are too large to index
+     */
+    auto build_text(std::vector<std::string_view> const& values, size_t num_values) -> void;
+
+    /**
+     * Builds the suffix array of `m_text` by prefix doubling, using radix sorting at each step.
+     */
+    auto build_suffix_array() -> void;
+
+    /**
+     * @param wildcard_string
+     * @return The longest run of (unescaped) literal characters in the given wildcard string,
+     * lowercased.
+     */
+    [[nodiscard]] static auto get_longest_literal(std::string_view wildcard_string) -> std::string;
+
+    // Variables
+    std::string m_text;
+    std::vector<uint32_t> m_entry_begin_offsets;
+    std::vector<uint32_t> m_suffix_array;
+};
+}  // namespace clp
+
+#endif  // CLP_DICTIONARYSUBSTRINGINDEX_HPP
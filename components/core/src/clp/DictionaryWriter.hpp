@@ -2,11 +2,14 @@
 #define CLP_DICTIONARYWRITER_HPP
 
 #include <string>
+#include <string_view>
+#include <vector>
 
 #include <absl/container/flat_hash_map.h>
 
 #include "ArrayBackedPosIntSet.hpp"
 #include "Defs.h"
+#include "DictionarySubstringIndex.hpp"
 #include "FileWriter.hpp"
 #include "spdlog_with_specializations.hpp"
 #include "streaming_compression/passthrough/Compressor.hpp"
@@ -71,6 +74,13 @@ public:
      */
     void index_segment(segment_id_t segment_id, ArrayBackedPosIntSet<DictionaryIdType> const& ids);
 
+    /**
+     * Builds a substring index over the dictionary's entries and writes it to disk
+     * @param substring_index_path
+     * @return The size of the index on disk, in bytes
+     */
+    size_t write_substring_index(std::string const& substring_index_path) const;
+
     /**
      * Gets the size of the dictionary when it is stored on disk
      * @return Size in bytes
@@ -204,6 +214,22 @@ void DictionaryWriter<DictionaryIdType, EntryType>::index_segment(
     m_segment_index_file_writer.write_numeric_value<uint64_t>(m_num_segments_in_index);
     m_segment_index_file_writer.seek_from_begin(segment_index_file_writer_pos);
 }
+
+template <typename DictionaryIdType, typename EntryType>
+size_t DictionaryWriter<DictionaryIdType, EntryType>::write_substring_index(
+        std::string const& substring_index_path
+) const {
+    if (false == m_is_open) {
+        throw OperationFailed(ErrorCode_NotInit, __FILENAME__, __LINE__);
+    }
+
+    std::vector<std::string_view> values(m_value_to_id.size());
+    for (auto const& [value, id] : m_value_to_id) {
+        values[id] = value;
+    }
+    DictionarySubstringIndex const substring_index{values};
+    return substring_index.write_to_file(substring_index_path);
+}
 }  // namespace clp
 
 #endif  // CLP_DICTIONARYWRITER_HPP
@@ -83,6 +83,47 @@ void create_tables(
     create_archives_index.step();
     statement_buffer.clear();
 
+    // NOTE: SQLite's R*Tree module stores coordinates as 32-bit floats (rounded outwards), so the
+    // index only narrows down the candidate archives; queries must still compare the exact
+    // timestamps in the archives table.
+    fmt::format_to(
+            statement_buffer_ix,
+            "CREATE VIRTUAL TABLE IF NOT EXISTS {} USING rtree({}, {}, {}, +{})",
+            streaming_archive::cMetadataDB::ArchivesTimeIndexTableName,
+            streaming_archive::cMetadataDB::ArchiveTimeIndex::Id,
+            streaming_archive::cMetadataDB::ArchiveTimeIndex::BeginTimestamp,
+            streaming_archive::cMetadataDB::ArchiveTimeIndex::EndTimestamp,
+            streaming_archive::cMetadataDB::ArchiveTimeIndex::ArchiveId
+    );
+    SPDLOG_DEBUG("{:.{}}", statement_buffer.data(), statement_buffer.size());
+    auto create_archives_time_index
+            = db.prepare_statement(statement_buffer.data(), statement_buffer.size());
+    create_archives_time_index.step();
+    statement_buffer.clear();
+
+    // Index any archives added before the index existed
+    fmt::format_to(
+            statement_buffer_ix,
+            "INSERT INTO {} ({}, {}, {}) SELECT {}, {}, {} FROM {} WHERE {} <= {} AND NOT EXISTS "
+            "(SELECT 1 FROM {})",
+            streaming_archive::cMetadataDB::ArchivesTimeIndexTableName,
+            streaming_archive::cMetadataDB::ArchiveTimeIndex::BeginTimestamp,
+            streaming_archive::cMetadataDB::ArchiveTimeIndex::EndTimestamp,
+            streaming_archive::cMetadataDB::ArchiveTimeIndex::ArchiveId,
+            streaming_archive::cMetadataDB::Archive::BeginTimestamp,
+            streaming_archive::cMetadataDB::Archive::EndTimestamp,
+            streaming_archive::cMetadataDB::Archive::Id,
+            streaming_archive::cMetadataDB::ArchivesTableName,
+            streaming_archive::cMetadataDB::Archive::BeginTimestamp,
+            streaming_archive::cMetadataDB::Archive::EndTimestamp,
+            streaming_archive::cMetadataDB::ArchivesTimeIndexTableName
+    );
+    SPDLOG_DEBUG("{:.{}}", statement_buffer.data(), statement_buffer.size());
+    auto populate_archives_time_index
+            = db.prepare_statement(statement_buffer.data(), statement_buffer.size());
+    populate_archives_time_index.step();
+    statement_buffer.clear();
+
     fmt::format_to(
             statement_buffer_ix,
             "CREATE TABLE IF NOT EXISTS {} ({}) WITHOUT ROWID",
@@ -136,13 +177,29 @@ SQLitePreparedStatement get_archives_for_time_window_select_statement(
         epochtime_t begin_ts,
         epochtime_t end_ts
 ) {
+    // Find candidate archives using the time index, then filter them using their exact timestamps
     auto statement_string = fmt::format(
-            "SELECT {} FROM {} WHERE {} <= ? AND {} >= ? ORDER BY {} ASC, {} ASC",
+            "SELECT {}.{} FROM {} JOIN {} ON {}.{} = {}.{} WHERE {}.{} <= ?1 AND {}.{} >= ?2 AND "
+            "{}.{} <= ?1 AND {}.{} >= ?2 ORDER BY {}.{} ASC, {}.{} ASC",
+            streaming_archive::cMetadataDB::ArchivesTableName,
+            streaming_archive::cMetadataDB::Archive::Id,
+            streaming_archive::cMetadataDB::ArchivesTimeIndexTableName,
+            streaming_archive::cMetadataDB::ArchivesTableName,
+            streaming_archive::cMetadataDB::ArchivesTableName,
             streaming_archive::cMetadataDB::Archive::Id,
+            streaming_archive::cMetadataDB::ArchivesTimeIndexTableName,
+            streaming_archive::cMetadataDB::ArchiveTimeIndex::ArchiveId,
+            streaming_archive::cMetadataDB::ArchivesTimeIndexTableName,
+            streaming_archive::cMetadataDB::ArchiveTimeIndex::BeginTimestamp,
+            streaming_archive::cMetadataDB::ArchivesTimeIndexTableName,
+            streaming_archive::cMetadataDB::ArchiveTimeIndex::EndTimestamp,
+            streaming_archive::cMetadataDB::ArchivesTableName,
+            streaming_archive::cMetadataDB::Archive::BeginTimestamp,
+            streaming_archive::cMetadataDB::ArchivesTableName,
+            streaming_archive::cMetadataDB::Archive::EndTimestamp,
             streaming_archive::cMetadataDB::ArchivesTableName,
-            streaming_archive::cMetadataDB::File::BeginTimestamp,
-            streaming_archive::cMetadataDB::File::EndTimestamp,
             streaming_archive::cMetadataDB::Archive::CreatorId,
+            streaming_archive::cMetadataDB::ArchivesTableName,
             streaming_archive::cMetadataDB::Archive::CreationIx
     );
     SPDLOG_DEBUG("{}", statement_string);
@@ -212,6 +269,83 @@ get_file_split_statement(SQLiteDB& db, string const& orig_file_id, size_t messag
 
     return statement;
 }
+
+/**
+ * A transaction that's rolled back unless it's committed before going out of scope. When it goes
+ * out of scope, the transaction's statements and the statements executed within it are reset so
+ * that they can be reused, even if one of them failed.
+ */
+class ScopedTransaction {
+public:
+    // Constructors
+    /**
+     * Begins the transaction
+     * @param begin_statement
+     * @param commit_statement
+     * @param rollback_statement
+     * @param statements The statements executed within the transaction
+     * @throw SQLitePreparedStatement::OperationFailed if the transaction couldn't be begun
+     */
+    ScopedTransaction(
+            SQLitePreparedStatement& begin_statement,
+            SQLitePreparedStatement& commit_statement,
+            SQLitePreparedStatement& rollback_statement,
+            vector<SQLitePreparedStatement*> statements
+    )
+            : m_begin_statement(begin_statement),
+              m_commit_statement(commit_statement),
+              m_rollback_statement(rollback_statement),
+              m_statements(std::move(statements)) {
+        try {
+            m_begin_statement.step();
+        } catch (SQLitePreparedStatement::OperationFailed const&) {
+            m_begin_statement.reset();
+            throw;
+        }
+    }
+
+    // Delete copy & move constructors and assignment operators
+    ScopedTransaction(ScopedTransaction const&) = delete;
+    ScopedTransaction(ScopedTransaction&&) = delete;
+    ScopedTransaction& operator=(ScopedTransaction const&) = delete;
+    ScopedTransaction& operator=(ScopedTransaction&&) = delete;
+
+    // Destructor
+    ~ScopedTransaction() {
+        for (auto* statement : m_statements) {
+            statement->reset();
+        }
+        if (false == m_committed) {
+            try {
+                m_rollback_statement.step();
+            } catch (SQLitePreparedStatement::OperationFailed const& e) {
+                SPDLOG_ERROR("Failed to roll back transaction - {}", e.what());
+            }
+            m_rollback_statement.reset();
+        }
+        m_begin_statement.reset();
+        m_commit_statement.reset();
+    }
+
+    // Methods
+    /**
+     * Commits the transaction
+     * @throw SQLitePreparedStatement::OperationFailed if the transaction couldn't be committed, in
+     * which case it's rolled back when going out of scope
+     */
+    void commit() {
+        m_commit_statement.step();
+        m_committed = true;
+    }
+
+private:
+    // Variables
+    SQLitePreparedStatement& m_begin_statement;
+    SQLitePreparedStatement& m_commit_statement;
+    SQLitePreparedStatement& m_rollback_statement;
+    vector<SQLitePreparedStatement*> m_statements;
+    bool m_committed{false};
+};
 }  // namespace
 
 GlobalSQLiteMetadataDB::ArchiveIterator::ArchiveIterator(SQLiteDB& db)
@@ -408,6 +542,51 @@ void GlobalSQLiteMetadataDB::open() {
     );
     statement_buffer.clear();
 
+    fmt::format_to(
+            statement_buffer_ix,
+            "INSERT INTO {} ({}, {}, {}) VALUES (?, ?, ?)",
+            streaming_archive::cMetadataDB::ArchivesTimeIndexTableName,
+            streaming_archive::cMetadataDB::ArchiveTimeIndex::BeginTimestamp,
+            streaming_archive::cMetadataDB::ArchiveTimeIndex::EndTimestamp,
+            streaming_archive::cMetadataDB::ArchiveTimeIndex::ArchiveId
+    );
+    SPDLOG_DEBUG("{:.{}}", statement_buffer.data(), statement_buffer.size());
+    m_insert_archive_time_index_statement = std::make_unique<SQLitePreparedStatement>(
+            m_db.prepare_statement(statement_buffer.data(), statement_buffer.size())
+    );
+    statement_buffer.clear();
+
+    fmt::format_to(
+            statement_buffer_ix,
+            "SELECT {}, {} FROM {} WHERE {} = ?",
+            streaming_archive::cMetadataDB::Archive::BeginTimestamp,
+            streaming_archive::cMetadataDB::Archive::EndTimestamp,
+            streaming_archive::cMetadataDB::ArchivesTableName,
+            streaming_archive::cMetadataDB::Archive::Id
+    );
+    SPDLOG_DEBUG("{:.{}}", statement_buffer.data(), statement_buffer.size());
+    m_select_archive_time_range_statement = std::make_unique<SQLitePreparedStatement>(
+            m_db.prepare_statement(statement_buffer.data(), statement_buffer.size())
+    );
+    statement_buffer.clear();
+
+    // NOTE: The archive ID is an auxiliary column of the time index, so it can't be used to find
+    // the archive's entry. Instead, we find the entries whose time range contains the archive's
+    // (which the R*Tree's outward rounding preserves), and then filter them by archive ID.
+    fmt::format_to(
+            statement_buffer_ix,
+            "DELETE FROM {} WHERE {} <= ?1 AND {} >= ?2 AND {} = ?3",
+            streaming_archive::cMetadataDB::ArchivesTimeIndexTableName,
+            streaming_archive::cMetadataDB::ArchiveTimeIndex::BeginTimestamp,
+            streaming_archive::cMetadataDB::ArchiveTimeIndex::EndTimestamp,
+            streaming_archive::cMetadataDB::ArchiveTimeIndex::ArchiveId
+    );
+    SPDLOG_DEBUG("{:.{}}", statement_buffer.data(), statement_buffer.size());
+    m_delete_archive_time_index_statement = std::make_unique<SQLitePreparedStatement>(
+            m_db.prepare_statement(statement_buffer.data(), statement_buffer.size())
+    );
+    statement_buffer.clear();
+
     // Insert or on conflict, set all fields except the ID
     fmt::format_to(
             statement_buffer_ix,
@@ -431,6 +610,14 @@ void GlobalSQLiteMetadataDB::open() {
     );
     m_upsert_files_transaction_end_statement
             = std::make_unique<SQLitePreparedStatement>(m_db.prepare_statement("END TRANSACTION"));
+    m_archive_transaction_begin_statement = std::make_unique<SQLitePreparedStatement>(
+            m_db.prepare_statement("BEGIN TRANSACTION")
+    );
+    m_archive_transaction_end_statement
+            = std::make_unique<SQLitePreparedStatement>(m_db.prepare_statement("END TRANSACTION"));
+    m_archive_transaction_rollback_statement = std::make_unique<SQLitePreparedStatement>(
+            m_db.prepare_statement("ROLLBACK TRANSACTION")
+    );
 
     m_is_open = true;
 }
@@ -441,6 +628,12 @@ void GlobalSQLiteMetadataDB::close() {
     m_upsert_file_statement.reset(nullptr);
     m_upsert_files_transaction_begin_statement.reset(nullptr);
     m_upsert_files_transaction_end_statement.reset(nullptr);
+    m_select_archive_time_range_statement.reset(nullptr);
+    m_insert_archive_time_index_statement.reset(nullptr);
+    m_delete_archive_time_index_statement.reset(nullptr);
+    m_archive_transaction_begin_statement.reset(nullptr);
+    m_archive_transaction_end_statement.reset(nullptr);
+    m_archive_transaction_rollback_statement.reset(nullptr);
     if (false == m_db.close()) {
         throw OperationFailed(ErrorCode_Failure, __FILENAME__, __LINE__);
     }
@@ -455,6 +648,12 @@ void GlobalSQLiteMetadataDB::add_archive(
         throw OperationFailed(ErrorCode_NotInit, __FILENAME__, __LINE__);
     }
 
+    ScopedTransaction transaction(
+            *m_archive_transaction_begin_statement,
+            *m_archive_transaction_end_statement,
+            *m_archive_transaction_rollback_statement,
+            {m_insert_archive_statement.get(), m_insert_archive_time_index_statement.get()}
+    );
     m_insert_archive_statement
             ->bind_text(enum_to_underlying_type(ArchivesTableFieldIndexes::Id) + 1, id, false);
     m_insert_archive_statement->bind_int64(
@@ -484,6 +683,8 @@ void GlobalSQLiteMetadataDB::add_archive(
     );
     m_insert_archive_statement->step();
     m_insert_archive_statement->reset();
+    insert_archive_time_index(id, metadata);
+    transaction.commit();
 }
 
 void GlobalSQLiteMetadataDB::update_archive_metadata(
@@ -494,6 +695,18 @@ void GlobalSQLiteMetadataDB::update_archive_metadata(
         throw OperationFailed(ErrorCode_NotInit, __FILENAME__, __LINE__);
     }
 
+    ScopedTransaction transaction(
+            *m_archive_transaction_begin_statement,
+            *m_archive_transaction_end_statement,
+            *m_archive_transaction_rollback_statement,
+            {m_select_archive_time_range_statement.get(),
+             m_delete_archive_time_index_statement.get(),
+             m_update_archive_size_statement.get(),
+             m_insert_archive_time_index_statement.get()}
+    );
+    // Remove the archive's entry before its current time range is overwritten
+    remove_archive_time_index(archive_id);
+
     m_update_archive_size_statement->bind_int64(
             enum_to_underlying_type(UpdateArchiveSizeStmtFieldIndexes::BeginTimestamp) + 1,
             (int64_t)metadata.get_begin_timestamp()
@@ -517,6 +730,47 @@ void GlobalSQLiteMetadataDB::update_archive_metadata(
     );
     m_update_archive_size_statement->step();
     m_update_archive_size_statement->reset();
+    insert_archive_time_index(archive_id, metadata);
+    transaction.commit();
+}
+
+void GlobalSQLiteMetadataDB::remove_archive_time_index(string const& archive_id) {
+    m_select_archive_time_range_statement->bind_text(1, archive_id, false);
+    if (false == m_select_archive_time_range_statement->step()) {
+        m_select_archive_time_range_statement->reset();
+        return;
+    }
+    auto const begin_timestamp = m_select_archive_time_range_statement->column_int64(0);
+    auto const end_timestamp = m_select_archive_time_range_statement->column_int64(1);
+    m_select_archive_time_range_statement->reset();
+    if (begin_timestamp > end_timestamp) {
+        // The archive has no timestamps, so it isn't in the time index
+        return;
+    }
+
+    m_delete_archive_time_index_statement->bind_int64(1, begin_timestamp);
+    m_delete_archive_time_index_statement->bind_int64(2, end_timestamp);
+    m_delete_archive_time_index_statement->bind_text(3, archive_id, false);
+    m_delete_archive_time_index_statement->step();
+    m_delete_archive_time_index_statement->reset();
+}
+
+void GlobalSQLiteMetadataDB::insert_archive_time_index(
+        string const& archive_id,
+        streaming_archive::ArchiveMetadata const& metadata
+) {
+    auto const begin_timestamp = metadata.get_begin_timestamp();
+    auto const end_timestamp = metadata.get_end_timestamp();
+    if (begin_timestamp > end_timestamp) {
+        // The archive has no timestamps, so it can't be in any bounded time window
+        return;
+    }
+
+    m_insert_archive_time_index_statement->bind_int64(1, (int64_t)begin_timestamp);
+    m_insert_archive_time_index_statement->bind_int64(2, (int64_t)end_timestamp);
+    m_insert_archive_time_index_statement->bind_text(3, archive_id, false);
+    m_insert_archive_time_index_statement->step();
+    m_insert_archive_time_index_statement->reset();
 }
 
 void GlobalSQLiteMetadataDB::update_metadata_for_files(
@@ -103,6 +103,24 @@ public:
     ) override;
 
 private:
+    // Methods
+    /**
+     * Removes the given archive from the time index, using the archive's current time range in the
+     * archives table to find its entry
+     * @param archive_id
+     */
+    void remove_archive_time_index(std::string const& archive_id);
+
+    /**
+     * Adds the given archive to the time index, unless it has no timestamps
+     * @param archive_id
+     * @param metadata
+     */
+    void insert_archive_time_index(
+            std::string const& archive_id,
+            streaming_archive::ArchiveMetadata const& metadata
+    );
+
     // Variables
     std::string m_path;
 
@@ -113,6 +131,12 @@ private:
     std::unique_ptr<SQLitePreparedStatement> m_upsert_file_statement;
     std::unique_ptr<SQLitePreparedStatement> m_upsert_files_transaction_begin_statement;
     std::unique_ptr<SQLitePreparedStatement> m_upsert_files_transaction_end_statement;
+    std::unique_ptr<SQLitePreparedStatement> m_select_archive_time_range_statement;
+    std::unique_ptr<SQLitePreparedStatement> m_insert_archive_time_index_statement;
+    std::unique_ptr<SQLitePreparedStatement> m_delete_archive_time_index_statement;
+    std::unique_ptr<SQLitePreparedStatement> m_archive_transaction_begin_statement;
+    std::unique_ptr<SQLitePreparedStatement> m_archive_transaction_end_statement;
+    std::unique_ptr<SQLitePreparedStatement> m_archive_transaction_rollback_statement;
 };
 }  // namespace clp
 
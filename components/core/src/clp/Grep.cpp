@@ -78,6 +78,30 @@ Grep::calculate_sub_queries_relevant_to_file(File const& compressed_file, vector
     }
 }
 
+bool Grep::file_may_contain_match(
+        Archive const& archive,
+        string const& file_id,
+        vector<Query> const& queries
+) {
+    auto const* posting_list = archive.get_file_posting_lists().get_posting_list(file_id);
+    if (nullptr == posting_list) {
+        return true;
+    }
+
+    for (auto const& query : queries) {
+        if (false == query.contains_sub_queries()) {
+            // The query doesn't constrain the file's logtypes or variables
+            return true;
+        }
+        for (auto const& sub_query : query.get_sub_queries()) {
+            if (sub_query.may_match_file(posting_list->logtype_ids, posting_list->var_ids)) {
+                return true;
+            }
+        }
+    }
+    return false;
+}
+
 size_t Grep::search_and_output(
         Query const& query,
         size_t limit,
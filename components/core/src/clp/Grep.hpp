@@ -37,6 +37,20 @@ public:
             std::vector<Query>& queries
     );
 
+    /**
+     * Checks, using the archive's file posting lists, whether the given file may contain a match
+     * for any of the given queries. Files without a posting list may always contain a match.
+     * @param archive
+     * @param file_id
+     * @param queries
+     * @return true if the file may contain a match, false if it definitely doesn't
+     */
+    static bool file_may_contain_match(
+            streaming_archive::reader::Archive const& archive,
+            std::string const& file_id,
+            std::vector<Query> const& queries
+    );
+
     /**
      * Searches a file with the given query and outputs any results using the given method
      * @param query
@@ -0,0 +1,548 @@
+#include "IoUringFileReader.hpp"
+
+#include <sys/stat.h>
+#include <sys/types.h>
+#include <unistd.h>
+
+#include <algorithm>
+#include <cerrno>
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <memory>
+#include <span>
+#include <string>
+#include <tuple>
+#include <utility>
+
+#include "ErrorCode.hpp"
+
+#if defined(__APPLE__) || defined(__MACH__)
+namespace clp {
+// io_uring is Linux-only, so on macOS, readers always use the fallback.
+class IoUringFileReader::Ring {
+public:
+    struct Completion {
+        uint64_t block_idx;
+        int32_t result;
+    };
+
+    [[nodiscard]] static auto try_create(unsigned /*num_entries*/, std::span<char> /*buffer*/)
+            -> std::unique_ptr<Ring> {
+        return nullptr;
+    }
+
+    void queue_read(
+            int /*fd*/,
+            std::span<char> /*dst*/,
+            size_t /*offset*/,
+            uint64_t /*block_idx*/
+    ) {}
+
+    [[nodiscard]] auto submit_and_wait(unsigned /*min_complete*/) -> ErrorCode {
+        return ErrorCode_Unsupported;
+    }
+
+    [[nodiscard]] auto try_pop_completion(Completion& /*completion*/) -> bool { return false; }
+};
+}  // namespace clp
+#else
+#include <linux/io_uring.h>
+#include <sys/mman.h>
+#include <sys/syscall.h>
+#include <sys/uio.h>
+
+#include <atomic>
+#include <vector>
+
+namespace clp {
+/**
+ * A minimal io_uring instance (using the raw system calls) for submitting reads into a single
+ * buffer. The buffer is registered with the kernel if possible, so that it doesn't need to be
+ * mapped for each read.
+ */
+class IoUringFileReader::Ring {
+public:
+    // Types
+    struct Completion {
+        uint64_t block_idx;
+        int32_t result;
+    };
+
+    // Constructors
+    Ring() = default;
+
+    // Disable copy/move constructors/assignment operators
+    Ring(Ring const&) = delete;
+    Ring(Ring&&) = delete;
+    auto operator=(Ring const&) -> Ring& = delete;
+    auto operator=(Ring&&) -> Ring& = delete;
+
+    // Destructor
+    ~Ring() {
+        if (nullptr != m_sqes) {
+            ::munmap(m_sqes, m_sqes_size);
+        }
+        if (nullptr != m_cq_ring && m_cq_ring != m_sq_ring) {
+            ::munmap(m_cq_ring, m_cq_ring_size);
+        }
+        if (nullptr != m_sq_ring) {
+            ::munmap(m_sq_ring, m_sq_ring_size);
+        }
+        if (-1 != m_fd) {
+            ::close(m_fd);
+        }
+    }
+
+    // Methods
+    /**
+     * @param num_entries The maximum number of reads that will be in flight at once.
+     * @param buffer The buffer that all reads will be into.
+     * @return The ring, or nullptr if io_uring is unavailable.
+     */
+    [[nodiscard]] static auto try_create(unsigned num_entries, std::span<char> buffer)
+            -> std::unique_ptr<Ring> {
+        auto ring{std::make_unique<Ring>()};
+        io_uring_params params{};
+        ring->m_fd = static_cast<int>(::syscall(__NR_io_uring_setup, num_entries, &params));
+        if (-1 == ring->m_fd) {
+            return nullptr;
+        }
+
+        ring->m_sq_ring_size = params.sq_off.array + params.sq_entries * sizeof(unsigned);
+        ring->m_cq_ring_size = params.cq_off.cqes + params.cq_entries * sizeof(io_uring_cqe);
+        bool const is_single_mmap{0 != (params.features & IORING_FEAT_SINGLE_MMAP)};
+        if (is_single_mmap) {
+            ring->m_sq_ring_size = std::max(ring->m_sq_ring_size, ring->m_cq_ring_size);
+        }
+        ring->m_sq_ring = map(ring->m_fd, ring->m_sq_ring_size, IORING_OFF_SQ_RING);
+        if (nullptr == ring->m_sq_ring) {
+            return nullptr;
+        }
+        if (is_single_mmap) {
+            ring->m_cq_ring = ring->m_sq_ring;
+        } else {
+            ring->m_cq_ring = map(ring->m_fd, ring->m_cq_ring_size, IORING_OFF_CQ_RING);
+            if (nullptr == ring->m_cq_ring) {
+                return nullptr;
+            }
+        }
+        ring->m_sqes_size = params.sq_entries * sizeof(io_uring_sqe);
+        ring->m_sqes = static_cast<io_uring_sqe*>(
+                map(ring->m_fd, ring->m_sqes_size, IORING_OFF_SQES)
+        );
+        if (nullptr == ring->m_sqes) {
+            return nullptr;
+        }
+
+        auto* sq_ring{static_cast<char*>(ring->m_sq_ring)};
+        ring->m_sq_tail = reinterpret_cast<unsigned*>(sq_ring + params.sq_off.tail);
+        ring->m_sq_mask = *reinterpret_cast<unsigned*>(sq_ring + params.sq_off.ring_mask);
+        ring->m_sq_array = reinterpret_cast<unsigned*>(sq_ring + params.sq_off.array);
+        auto* cq_ring{static_cast<char*>(ring->m_cq_ring)};
+        ring->m_cq_head = reinterpret_cast<unsigned*>(cq_ring + params.cq_off.head);
+        ring->m_cq_tail = reinterpret_cast<unsigned*>(cq_ring + params.cq_off.tail);
+        ring->m_cq_mask = *reinterpret_cast<unsigned*>(cq_ring + params.cq_off.ring_mask);
+        ring->m_cqes = reinterpret_cast<io_uring_cqe*>(cq_ring + params.cq_off.cqes);
+
+        // Registering the buffer can fail (e.g., if it exceeds RLIMIT_MEMLOCK), in which case we
+        // fall back to unregistered reads.
+        iovec buffer_iovec{.iov_base = buffer.data(), .iov_len = buffer.size()};
+        auto const register_result{::syscall(
+                __NR_io_uring_register,
+                ring->m_fd,
+                IORING_REGISTER_BUFFERS,
+                &buffer_iovec,
+                1
+        )};
+        ring->m_is_buffer_registered = 0 == register_result;
+        ring->m_iovecs.resize(num_entries);
+        return ring;
+    }
+
+    /**
+     * Queues a read for submission with the next call to `submit_and_wait`.
+     * @param fd
+     * @param dst A range within the ring's buffer.
+     * @param offset
+     * @param block_idx An index (less than the ring's number of entries) identifying the read.
+     */
+    void queue_read(int fd, std::span<char> dst, size_t offset, uint64_t block_idx) {
+        auto const sq_tail{std::atomic_ref<unsigned>{*m_sq_tail}.load(std::memory_order_relaxed)};
+        auto const sqe_idx{sq_tail & m_sq_mask};
+        auto& sqe{m_sqes[sqe_idx]};
+        std::memset(&sqe, 0, sizeof(sqe));
+        sqe.fd = fd;
+        sqe.off = offset;
+        sqe.user_data = block_idx;
+        if (m_is_buffer_registered) {
+            sqe.opcode = IORING_OP_READ_FIXED;
+            sqe.addr = reinterpret_cast<uint64_t>(dst.data());
+            sqe.len = static_cast<uint32_t>(dst.size());
+            sqe.buf_index = 0;
+        } else {
+            auto& iov{m_iovecs[block_idx]};
+            iov.iov_base = dst.data();
+            iov.iov_len = dst.size();
+            sqe.opcode = IORING_OP_READV;
+            sqe.addr = reinterpret_cast<uint64_t>(&iov);
+            sqe.len = 1;
+        }
+        m_sq_array[sqe_idx] = sqe_idx;
+        std::atomic_ref<unsigned>{*m_sq_tail}.store(sq_tail + 1, std::memory_order_release);
+        ++m_num_queued_reads;
+    }
+
+    /**
+     * Submits all queued reads and waits until at least `min_complete` reads have completed.
+     * @param min_complete
+     * @return ErrorCode_errno on error
+     * @return ErrorCode_Success on success
+     */
+    [[nodiscard]] auto submit_and_wait(unsigned min_complete) -> ErrorCode {
+        while (true) {
+            auto const num_submitted{::syscall(
+                    __NR_io_uring_enter,
+                    m_fd,
+                    m_num_queued_reads,
+                    min_complete,
+                    0 == min_complete ? 0U : IORING_ENTER_GETEVENTS,
+                    nullptr,
+                    0
+            )};
+            if (num_submitted < 0) {
+                if (EINTR == errno) {
+                    continue;
+                }
+                return ErrorCode_errno;
+            }
+            m_num_queued_reads -= static_cast<unsigned>(num_submitted);
+            return ErrorCode_Success;
+        }
+    }
+
+    /**
+     * @param completion Returns the oldest completion that hasn't been popped.
+     * @return Whether there was a completion to pop.
+     */
+    [[nodiscard]] auto try_pop_completion(Completion& completion) -> bool {
+        auto const cq_head{std::atomic_ref<unsigned>{*m_cq_head}.load(std::memory_order_relaxed)};
+        if (cq_head == std::atomic_ref<unsigned>{*m_cq_tail}.load(std::memory_order_acquire)) {
+            return false;
+        }
+        auto const& cqe{m_cqes[cq_head & m_cq_mask]};
+        completion.block_idx = cqe.user_data;
+        completion.result = cqe.res;
+        std::atomic_ref<unsigned>{*m_cq_head}.store(cq_head + 1, std::memory_order_release);
+        return true;
+    }
+
+private:
+    // Methods
+    /**
+     * @param fd
+     * @param size
+     * @param offset
+     * @return The mapped region of the ring, or nullptr on failure.
+     */
+    [[nodiscard]] static auto map(int fd, size_t size, off_t offset) -> void* {
+        auto* region{
+                ::mmap(nullptr, size, PROT_READ | PROT_WRITE, MAP_SHARED | MAP_POPULATE, fd, offset)
+        };
+        return MAP_FAILED == region ? nullptr : region;
+    }
+
+    // Variables
+    int m_fd{-1};
+    void* m_sq_ring{nullptr};
+    size_t m_sq_ring_size{0};
+    void* m_cq_ring{nullptr};
+    size_t m_cq_ring_size{0};
+    io_uring_sqe* m_sqes{nullptr};
+    size_t m_sqes_size{0};
+
+    unsigned* m_sq_tail{nullptr};
+    unsigned m_sq_mask{0};
+    unsigned* m_sq_array{nullptr};
+    unsigned* m_cq_head{nullptr};
+    unsigned* m_cq_tail{nullptr};
+    unsigned m_cq_mask{0};
+    io_uring_cqe* m_cqes{nullptr};
+
+    bool m_is_buffer_registered{false};
+    // Used for unregistered reads
+    std::vector<iovec> m_iovecs;
+    unsigned m_num_queued_reads{0};
+};
+}  // namespace clp
+#endif
+
+namespace clp {
+IoUringFileReader::IoUringFileReader(
+        std::string path,
+        size_t block_size,
+        size_t queue_depth,
+        ReadMethod read_method
+)
+        : m_path{std::move(path)},
+          m_fd{m_path, FileDescriptor::OpenMode::ReadOnly},
+          m_block_size{block_size} {
+    if (0 == block_size || 0 == queue_depth) {
+        throw OperationFailed(ErrorCode_BadParam, __FILENAME__, __LINE__);
+    }
+
+    struct stat stat_buffer{};
+    if (ErrorCode_Success != m_fd.stat(stat_buffer)) {
+        throw OperationFailed(ErrorCode_errno, __FILENAME__, __LINE__);
+    }
+    // Other types of files (e.g., FIFOs) can't be read at an offset, so they can only be read
+    // sequentially
+    m_is_regular_file = S_ISREG(stat_buffer.st_mode);
+    if (ReadMethod::Direct == read_method || false == m_is_regular_file) {
+        return;
+    }
+
+    // Don't allocate read-ahead buffers beyond the end of the file
+    auto const file_size{static_cast<size_t>(stat_buffer.st_size)};
+    if (0 == file_size) {
+        return;
+    }
+    m_block_size = std::min(block_size, file_size);
+    auto const num_blocks{std::min(queue_depth, (file_size + m_block_size - 1) / m_block_size)};
+
+    auto const buffer_size{m_block_size * num_blocks};
+    m_buffers = std::make_unique_for_overwrite<char[]>(buffer_size);
+    m_ring = Ring::try_create(
+            static_cast<unsigned>(num_blocks),
+            std::span<char>{m_buffers.get(), buffer_size}
+    );
+    if (nullptr == m_ring) {
+        m_buffers.reset();
+        return;
+    }
+    m_blocks.resize(num_blocks);
+}
+
+IoUringFileReader::~IoUringFileReader() {
+    if (nullptr == m_ring) {
+        return;
+    }
+    // The kernel may still be reading into the buffers, so we need to wait for any in-flight reads
+    // before they're freed.
+    while (m_num_in_flight_reads > 0) {
+        reap_completions();
+        if (m_num_in_flight_reads > 0 && ErrorCode_Success != m_ring->submit_and_wait(1)) {
+            // Closing the ring cancels any reads it can and waits for the rest
+            m_ring.reset();
+            break;
+        }
+    }
+}
+
+auto IoUringFileReader::try_read(char* buf, size_t num_bytes_to_read, size_t& num_bytes_read)
+        -> ErrorCode {
+    if (nullptr == buf) {
+        return ErrorCode_BadParam;
+    }
+    if (nullptr == m_ring) {
+        return try_read_without_ring(buf, num_bytes_to_read, num_bytes_read);
+    }
+
+    num_bytes_read = 0;
+    while (num_bytes_read < num_bytes_to_read) {
+        if (auto const error_code{submit_reads()}; ErrorCode_Success != error_code) {
+            return error_code;
+        }
+        if (auto const error_code{wait_for_head_block()}; ErrorCode_Success != error_code) {
+            return error_code;
+        }
+
+        auto const& block{m_blocks[m_head_block_idx]};
+        if (block.result < 0) {
+            auto const read_errno{static_cast<int>(-block.result)};
+            // Discard the failed read so that the next read retries it
+            std::ignore = discard_blocks();
+            errno = read_errno;
+            return ErrorCode_errno;
+        }
+        auto const block_end{block.offset + static_cast<size_t>(block.result)};
+        if (m_pos >= block_end) {
+            // EOF
+            break;
+        }
+
+        auto const num_bytes_to_copy{
+                std::min(block_end - m_pos, num_bytes_to_read - num_bytes_read)
+        };
+        std::memcpy(
+                buf + num_bytes_read,
+                m_buffers.get() + m_head_block_idx * m_block_size + (m_pos - block.offset),
+                num_bytes_to_copy
+        );
+        m_pos += num_bytes_to_copy;
+        num_bytes_read += num_bytes_to_copy;
+        if (m_pos < block_end) {
+            continue;
+        }
+
+        if (static_cast<size_t>(block.result) < m_block_size) {
+            // A short read usually indicates EOF, but the file may have grown since, so restart
+            // reading at the read head rather than trusting the reads submitted after this one.
+            if (auto const error_code{discard_blocks()}; ErrorCode_Success != error_code) {
+                return error_code;
+            }
+        } else {
+            m_blocks[m_head_block_idx].is_complete = false;
+            m_head_block_idx = (m_head_block_idx + 1) % m_blocks.size();
+        }
+    }
+
+    if (0 == num_bytes_read) {
+        return ErrorCode_EndOfFile;
+    }
+    return ErrorCode_Success;
+}
+
+auto IoUringFileReader::try_seek_from_begin(size_t pos) -> ErrorCode {
+    if (pos == m_pos) {
+        return ErrorCode_Success;
+    }
+    if (false == m_is_regular_file) {
+        errno = ESPIPE;
+        return ErrorCode_errno;
+    }
+    if (nullptr == m_ring) {
+        m_pos = pos;
+        return ErrorCode_Success;
+    }
+
+    // Reads are submitted for consecutive blocks starting from the head block, so if the head
+    // block has been submitted, the data read ahead spans [head block's offset, next read offset)
+    auto const& head_block{m_blocks[m_head_block_idx]};
+    m_pos = pos;
+    if ((false == head_block.is_in_flight && false == head_block.is_complete)
+        || pos < head_block.offset || pos >= m_next_read_offset)
+    {
+        return discard_blocks();
+    }
+
+    // Keep the data read ahead from the block containing the new position onwards, and only
+    // recycle the blocks before it
+    while (m_pos >= m_blocks[m_head_block_idx].offset + m_block_size) {
+        if (auto const error_code{wait_for_head_block()}; ErrorCode_Success != error_code) {
+            return error_code;
+        }
+        m_blocks[m_head_block_idx].is_complete = false;
+        m_head_block_idx = (m_head_block_idx + 1) % m_blocks.size();
+    }
+    return ErrorCode_Success;
+}
+
+auto IoUringFileReader::try_get_pos(size_t& pos) -> ErrorCode {
+    pos = m_pos;
+    return ErrorCode_Success;
+}
+
+auto IoUringFileReader::submit_reads() -> ErrorCode {
+    // Idle blocks are always at the end of the queue, since blocks are only freed at its head
+    bool has_queued_reads{false};
+    for (size_t i = 0; i < m_blocks.size(); ++i) {
+        auto const block_idx{(m_head_block_idx + i) % m_blocks.size()};
+        auto& block{m_blocks[block_idx]};
+        if (block.is_in_flight || block.is_complete) {
+            continue;
+        }
+        block.offset = m_next_read_offset;
+        block.is_in_flight = true;
+        m_ring->queue_read(
+                m_fd.get_raw_fd(),
+                std::span<char>{m_buffers.get() + block_idx * m_block_size, m_block_size},
+                block.offset,
+                block_idx
+        );
+        m_next_read_offset += m_block_size;
+        ++m_num_in_flight_reads;
+        has_queued_reads = true;
+    }
+    if (false == has_queued_reads) {
+        return ErrorCode_Success;
+    }
+    return m_ring->submit_and_wait(0);
+}
+
+auto IoUringFileReader::wait_for_head_block() -> ErrorCode {
+    while (true) {
+        reap_completions();
+        if (m_blocks[m_head_block_idx].is_complete) {
+            return ErrorCode_Success;
+        }
+        if (auto const error_code{m_ring->submit_and_wait(1)}; ErrorCode_Success != error_code) {
+            return error_code;
+        }
+    }
+}
+
+void IoUringFileReader::reap_completions() {
+    Ring::Completion completion{};
+    while (m_ring->try_pop_completion(completion)) {
+        auto& block{m_blocks[completion.block_idx]};
+        block.result = completion.result;
+        block.is_in_flight = false;
+        block.is_complete = true;
+        --m_num_in_flight_reads;
+    }
+}
+
+auto IoUringFileReader::discard_blocks() -> ErrorCode {
+    while (m_num_in_flight_reads > 0) {
+        reap_completions();
+        if (m_num_in_flight_reads > 0) {
+            if (auto const error_code{m_ring->submit_and_wait(1)}; ErrorCode_Success != error_code)
+            {
+                return error_code;
+            }
+        }
+    }
+    for (auto& block : m_blocks) {
+        block.is_complete = false;
+    }
+    m_head_block_idx = 0;
+    m_next_read_offset = m_pos;
+    return ErrorCode_Success;
+}
+
+auto IoUringFileReader::try_read_without_ring(
+        char* buf,
+        size_t num_bytes_to_read,
+        size_t& num_bytes_read
+) -> ErrorCode {
+    num_bytes_read = 0;
+    std::span dst_view{buf, num_bytes_to_read};
+    while (false == dst_view.empty()) {
+        ssize_t bytes_read{};
+        if (m_is_regular_file) {
+            bytes_read = ::pread(
+                    m_fd.get_raw_fd(),
+                    dst_view.data(),
+                    dst_view.size(),
+                    static_cast<off_t>(m_pos)
+            );
+        } else {
+            bytes_read = ::read(m_fd.get_raw_fd(), dst_view.data(), dst_view.size());
+        }
+        if (0 == bytes_read) {
+            break;
+        }
+        if (bytes_read < 0) {
+            return ErrorCode_errno;
+        }
+        num_bytes_read += bytes_read;
+        m_pos += bytes_read;
+        dst_view = dst_view.subspan(bytes_read);
+    }
+    if (dst_view.size() == num_bytes_to_read) {
+        return ErrorCode_EndOfFile;
+    }
+    return ErrorCode_Success;
+}
+}  // namespace clp
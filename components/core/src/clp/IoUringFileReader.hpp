@@ -0,0 +1,197 @@
+#ifndef CLP_IOURINGFILEREADER_HPP
+#define CLP_IOURINGFILEREADER_HPP
+
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <string>
+#include <string_view>
+#include <vector>
+
+#include "ErrorCode.hpp"
+#include "FileDescriptor.hpp"
+#include "ReaderInterface.hpp"
+#include "TraceableException.hpp"
+
+namespace clp {
+/**
+ * Class for reading an on-disk file sequentially using io_uring. The reader keeps up to
+ * `queue_depth` block-sized reads in flight ahead of the read head (into buffers registered with
+ * the kernel, when possible), so that reading from fast storage isn't bound by the latency of
+ * individual `read` calls.
+ *
+ * If io_uring is unavailable (e.g., on kernels that don't support it, or if it's disabled), the
+ * reader falls back to reading directly from the file descriptor, like `clp::FileDescriptorReader`.
+ * The reader also falls back for empty files, since there's nothing to read ahead. Files that
+ * aren't regular files (e.g., FIFOs, or `/dev/stdin` when it's a pipe) are read with plain `read`
+ * calls, and can't be seeked.
+ *
+ * The read-ahead buffers are sized for the file when it's opened, so small files don't allocate
+ * more than they need.
+ *
+ * Seeking within the data read ahead keeps it, but seeking anywhere else discards it, so this class
+ * is best suited to files that are mostly read sequentially.
+ */
+class IoUringFileReader : public ReaderInterface {
+public:
+    // Types
+    class OperationFailed : public TraceableException {
+    public:
+        // Constructors
+        OperationFailed(ErrorCode error_code, char const* const filename, int line_number)
+                : TraceableException(error_code, filename, line_number) {}
+
+        // Methods
+        [[nodiscard]] auto what() const noexcept -> char const* override {
+            return "clp::IoUringFileReader operation failed";
+        }
+    };
+
+    enum class ReadMethod : uint8_t {
+        // Use io_uring if it's available, or otherwise fall back to reading from the file directly
+        IoUringIfAvailable,
+        // Always read from the file directly
+        Direct,
+    };
+
+    // Constants
+    static constexpr size_t cDefaultBlockSize{256UL * 1024};
+    static constexpr size_t cDefaultQueueDepth{4};
+
+    // Constructors
+    /**
+     * @param path
+     * @param block_size The size of each read submitted to the kernel. Capped at the file's size.
+     * @param queue_depth The maximum number of reads in flight. Capped at the number of blocks in
+     * the file.
+     * @param read_method
+     * @throw FileDescriptor::OperationFailed if the file can't be opened.
+     * @throw IoUringFileReader::OperationFailed if `block_size` or `queue_depth` is 0, or if the
+     * file's size can't be determined.
+     */
+    explicit IoUringFileReader(
+            std::string path,
+            size_t block_size = cDefaultBlockSize,
+            size_t queue_depth = cDefaultQueueDepth,
+            ReadMethod read_method = ReadMethod::IoUringIfAvailable
+    );
+
+    // Disable copy/move constructors/assignment operators
+    IoUringFileReader(IoUringFileReader const&) = delete;
+    IoUringFileReader(IoUringFileReader&&) = delete;
+    auto operator=(IoUringFileReader const&) -> IoUringFileReader& = delete;
+    auto operator=(IoUringFileReader&&) -> IoUringFileReader& = delete;
+
+    // Destructor
+    ~IoUringFileReader() override;
+
+    // Methods implementing the ReaderInterface
+    /**
+     * Tries to read up to a given number of bytes from the file.
+     * @param buf
+     * @param num_bytes_to_read The number of bytes to try and read
+     * @param num_bytes_read The actual number of bytes read
+     * @return ErrorCode_BadParam if buf is invalid
+     * @return ErrorCode_errno on error
+     * @return ErrorCode_EndOfFile on EOF
+     * @return ErrorCode_Success on success
+     */
+    [[nodiscard]] auto try_read(char* buf, size_t num_bytes_to_read, size_t& num_bytes_read)
+            -> ErrorCode override;
+
+    /**
+     * Tries to seek to the given position, relative to the beginning of the file.
+     * @param pos
+     * @return ErrorCode_errno on error, or with errno set to ESPIPE if the file isn't a regular
+     * file and `pos` isn't the current position
+     * @return ErrorCode_Success on success
+     */
+    [[nodiscard]] auto try_seek_from_begin(size_t pos) -> ErrorCode override;
+
+    /**
+     * @param pos Returns the position of the read head in the file.
+     * @return ErrorCode_Success
+     */
+    [[nodiscard]] auto try_get_pos(size_t& pos) -> ErrorCode override;
+
+    // Methods
+    [[nodiscard]] auto get_path() const -> std::string_view { return m_path; }
+
+    /**
+     * @return Whether reads are submitted using io_uring, rather than the fallback.
+     */
+    [[nodiscard]] auto is_using_io_uring() const -> bool { return nullptr != m_ring; }
+
+private:
+    // Types
+    class Ring;
+
+    struct Block {
+        size_t offset{0};
+        // The number of bytes read into the block, or the negated errno if the read failed
+        int64_t result{0};
+        bool is_in_flight{false};
+        bool is_complete{false};
+    };
+
+    // Methods
+    /**
+     * Submits reads for every idle block, continuing from the end of the last submitted read.
+     * @return ErrorCode_errno on error
+     * @return ErrorCode_Success on success
+     */
+    [[nodiscard]] auto submit_reads() -> ErrorCode;
+
+    /**
+     * Waits for the read into the block at the head of the queue to complete.
+     * @return ErrorCode_errno on error
+     * @return ErrorCode_Success on success
+     */
+    [[nodiscard]] auto wait_for_head_block() -> ErrorCode;
+
+    /**
+     * Records the results of all completed reads without waiting.
+     */
+    void reap_completions();
+
+    /**
+     * Waits for every in-flight read to complete and discards all read-ahead data, so that the next
+     * read restarts at the read head.
+     * @return ErrorCode_errno on error
+     * @return ErrorCode_Success on success
+     */
+    [[nodiscard]] auto discard_blocks() -> ErrorCode;
+
+    /**
+     * Reads from the file descriptor directly (used when io_uring is unavailable or the file isn't
+     * a regular file).
+     * @param buf
+     * @param num_bytes_to_read
+     * @param num_bytes_read
+     * @return Same as `IoUringFileReader::try_read`
+     */
+    [[nodiscard]] auto try_read_without_ring(
+            char* buf,
+            size_t num_bytes_to_read,
+            size_t& num_bytes_read
+    ) -> ErrorCode;
+
+    // Variables
+    std::string m_path;
+    FileDescriptor m_fd;
+    bool m_is_regular_file{true};
+    size_t m_block_size;
+    size_t m_pos{0};
+
+    // NOTE: The ring must be destroyed before the buffers it reads into
+    std::unique_ptr<char[]> m_buffers;
+    std::unique_ptr<Ring> m_ring;
+    // Blocks are consumed in order, starting from `m_head_block_idx`, and resubmitted once consumed
+    std::vector<Block> m_blocks;
+    size_t m_head_block_idx{0};
+    size_t m_next_read_offset{0};
+    size_t m_num_in_flight_reads{0};
+};
+}  // namespace clp
+
+#endif  // CLP_IOURINGFILEREADER_HPP
@@ -1,9 +1,11 @@
 #include "Query.hpp"
 
+#include <algorithm>
 #include <functional>
 #include <set>
 #include <string>
 #include <unordered_set>
+#include <vector>
 
 #include "Defs.h"
 
@@ -95,6 +97,33 @@ void QueryVar::remove_segments_that_dont_contain_dict_var(
     }
 }
 
+bool QueryVar::may_be_in_var_dict_ids(
+        std::vector<variable_dictionary_id_t> const& sorted_var_dict_ids
+) const {
+    if (false == m_is_dict_var) {
+        return true;
+    }
+
+    if (m_is_precise_var) {
+        return std::binary_search(
+                sorted_var_dict_ids.cbegin(),
+                sorted_var_dict_ids.cend(),
+                m_var_dict_id
+        );
+    }
+    return std::any_of(
+            m_possible_var_dict_ids.cbegin(),
+            m_possible_var_dict_ids.cend(),
+            [&](variable_dictionary_id_t var_dict_id) {
+                return std::binary_search(
+                        sorted_var_dict_ids.cbegin(),
+                        sorted_var_dict_ids.cend(),
+                        var_dict_id
+                );
+            }
+    );
+}
+
 void SubQuery::add_non_dict_var(encoded_variable_t precise_non_dict_var) {
     m_vars.emplace_back(precise_non_dict_var);
 }
@@ -145,6 +174,30 @@ void SubQuery::calculate_ids_of_matching_segments(
     }
 }
 
+bool SubQuery::may_match_file(
+        std::vector<logtype_dictionary_id_t> const& sorted_logtype_ids,
+        std::vector<variable_dictionary_id_t> const& sorted_var_dict_ids
+) const {
+    bool const contains_possible_logtype = std::any_of(
+            m_possible_logtypes.cbegin(),
+            m_possible_logtypes.cend(),
+            [&](logtype_dictionary_id_t logtype_id) {
+                return std::binary_search(
+                        sorted_logtype_ids.cbegin(),
+                        sorted_logtype_ids.cend(),
+                        logtype_id
+                );
+            }
+    );
+    if (false == contains_possible_logtype) {
+        return false;
+    }
+
+    return std::all_of(m_vars.cbegin(), m_vars.cend(), [&](QueryVar const& query_var) {
+        return query_var.may_be_in_var_dict_ids(sorted_var_dict_ids);
+    });
+}
+
 void SubQuery::clear() {
     m_vars.clear();
     m_possible_logtypes.clear();
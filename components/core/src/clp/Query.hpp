@@ -45,6 +45,15 @@ public:
                     get_segments_containing_var_dict_id
     ) const;
 
+    /**
+     * Checks if the given variable dictionary IDs may contain this variable. Non-dictionary
+     * variables are always considered contained.
+     * @param sorted_var_dict_ids Variable dictionary IDs in ascending order
+     * @return true if this variable may be among the given IDs, false otherwise
+     */
+    bool may_be_in_var_dict_ids(std::vector<variable_dictionary_id_t> const& sorted_var_dict_ids
+    ) const;
+
     bool is_precise_var() const { return m_is_precise_var; }
 
     bool is_dict_var() const { return m_is_dict_var; }
@@ -120,6 +129,18 @@ public:
                     get_segments_containing_var_dict_id
     );
 
+    /**
+     * Checks if a file containing only the given logtypes and dictionary variables may contain a
+     * match for this subquery
+     * @param sorted_logtype_ids Logtype IDs in ascending order
+     * @param sorted_var_dict_ids Variable dictionary IDs in ascending order
+     * @return true if the file may contain a match, false otherwise
+     */
+    bool may_match_file(
+            std::vector<logtype_dictionary_id_t> const& sorted_logtype_ids,
+            std::vector<variable_dictionary_id_t> const& sorted_var_dict_ids
+    ) const;
+
     void clear();
 
     bool wildcard_match_required() const { return m_wildcard_match_required; }
@@ -0,0 +1,322 @@
+#include "RangeNetworkReader.hpp"
+
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <cstddef>
+#include <cstring>
+#include <optional>
+#include <string>
+#include <string_view>
+#include <thread>
+#include <vector>
+
+#include <curl/curl.h>
+
+#include "CurlDownloadHandler.hpp"
+#include "CurlOperationFailed.hpp"
+#include "ErrorCode.hpp"
+
+namespace clp {
+namespace {
+// HTTP response codes
+constexpr long cHttpOk{200};
+constexpr long cHttpRangeNotSatisfiable{416};
+
+/**
+ * The destination of a download.
+ */
+struct DownloadBuffer {
+    std::vector<char>& data;
+    // The maximum number of bytes to download
+    size_t capacity;
+};
+
+/**
+ * libcurl progress callback which never aborts the download.
+ * NOTE: This function must have C linkage to be a libcurl callback.
+ * @param arg Unused
+ * @param dltotal Unused
+ * @param dlnow Unused
+ * @param ultotal Unused
+ * @param ulnow Unused
+ * @return 0
+ */
+extern "C" auto range_network_reader_progress_callback(
+        [[maybe_unused]] void* arg,
+        [[maybe_unused]] curl_off_t dltotal,
+        [[maybe_unused]] curl_off_t dlnow,
+        [[maybe_unused]] curl_off_t ultotal,
+        [[maybe_unused]] curl_off_t ulnow
+) -> int {
+    return 0;
+}
+
+/**
+ * libcurl write callback that appends downloaded data to a buffer.
+ * NOTE: This function must have C linkage to be a libcurl callback.
+ * @param ptr A pointer to the downloaded data
+ * @param size Always 1.
+ * @param nmemb The number of bytes downloaded.
+ * @param buffer_ptr A pointer to a `DownloadBuffer`.
+ * @return The number of bytes appended, which is less than `nmemb` (aborting the download) if the
+ * buffer's capacity was reached.
+ */
+extern "C" auto
+range_network_reader_write_callback(char* ptr, size_t size, size_t nmemb, void* buffer_ptr)
+        -> size_t {
+    auto& buffer = *static_cast<DownloadBuffer*>(buffer_ptr);
+    auto const num_bytes{std::min(size * nmemb, buffer.capacity - buffer.data.size())};
+    buffer.data.insert(buffer.data.end(), ptr, ptr + num_bytes);
+    return num_bytes;
+}
+}  // namespace
+
+RangeNetworkReader::RangeNetworkReader(
+        std::string_view src_url,
+        size_t block_size,
+        size_t max_num_cached_blocks,
+        size_t max_num_parallel_requests,
+        size_t max_coalescing_gap,
+        std::chrono::seconds overall_timeout,
+        std::chrono::seconds connection_timeout
+)
+        : m_src_url{src_url},
+          m_block_size{block_size},
+          m_max_num_cached_blocks{max_num_cached_blocks},
+          m_max_num_parallel_requests{max_num_parallel_requests},
+          m_max_coalescing_gap{max_coalescing_gap},
+          m_overall_timeout{overall_timeout},
+          m_connection_timeout{connection_timeout} {
+    if (0 == m_block_size || 0 == m_max_num_cached_blocks || 0 == m_max_num_parallel_requests) {
+        throw OperationFailed(ErrorCode_BadParam, __FILE__, __LINE__);
+    }
+}
+
+auto RangeNetworkReader::try_read(char* buf, size_t num_bytes_to_read, size_t& num_bytes_read)
+        -> ErrorCode {
+    num_bytes_read = 0;
+    while (num_bytes_read < num_bytes_to_read) {
+        if (m_size.has_value() && m_pos >= m_size.value()) {
+            break;
+        }
+
+        auto const block_idx{m_pos / m_block_size};
+        auto const* block{get_block(block_idx)};
+        if (nullptr == block) {
+            if (m_size.has_value() && m_pos >= m_size.value()) {
+                break;
+            }
+            return ErrorCode_Failure;
+        }
+
+        auto const offset_in_block{m_pos - block_idx * m_block_size};
+        if (offset_in_block >= block->data.size()) {
+            break;
+        }
+        auto const num_bytes_to_copy{
+                std::min(block->data.size() - offset_in_block, num_bytes_to_read - num_bytes_read)
+        };
+        if (nullptr != buf) {
+            std::memcpy(
+                    buf + num_bytes_read,
+                    block->data.data() + offset_in_block,
+                    num_bytes_to_copy
+            );
+        }
+        m_pos += num_bytes_to_copy;
+        num_bytes_read += num_bytes_to_copy;
+    }
+
+    if (0 == num_bytes_read && num_bytes_to_read > 0) {
+        return ErrorCode_EndOfFile;
+    }
+    return ErrorCode_Success;
+}
+
+auto RangeNetworkReader::prefetch(std::vector<ByteRange> const& ranges) -> ErrorCode {
+    auto const max_num_blocks{std::max<size_t>(m_max_num_cached_blocks / 2, 1)};
+    auto const max_coalescing_gap_num_blocks{m_max_coalescing_gap / m_block_size};
+
+    // Convert the ranges into requests for the uncached blocks they overlap, coalescing requests
+    // that are close together
+    std::vector<BlockRangeRequest> requests;
+    size_t num_blocks{0};
+    for (auto const& [begin, end] : ranges) {
+        if (begin >= end) {
+            continue;
+        }
+        auto const begin_block_idx{begin / m_block_size};
+        auto end_block_idx{(end - 1) / m_block_size + 1};
+        if (m_size.has_value()) {
+            end_block_idx
+                    = std::min(end_block_idx, (m_size.value() + m_block_size - 1) / m_block_size);
+        }
+
+        for (auto block_idx{begin_block_idx};
+             block_idx < end_block_idx && num_blocks < max_num_blocks;
+             ++block_idx)
+        {
+            if (m_cached_blocks.contains(block_idx)) {
+                continue;
+            }
+            if (false == requests.empty() && block_idx < requests.back().end_block_idx) {
+                continue;
+            }
+            // Coalescing downloads the blocks in the gap (if any) too, so we only coalesce if they
+            // don't exceed the limit
+            if (false == requests.empty()
+                && block_idx <= requests.back().end_block_idx + max_coalescing_gap_num_blocks
+                && num_blocks + (block_idx + 1 - requests.back().end_block_idx) <= max_num_blocks)
+            {
+                num_blocks += block_idx + 1 - requests.back().end_block_idx;
+                requests.back().end_block_idx = block_idx + 1;
+            } else {
+                requests.push_back({block_idx, block_idx + 1, {}});
+                ++num_blocks;
+            }
+        }
+    }
+    if (requests.empty()) {
+        return ErrorCode_Success;
+    }
+    m_num_requests += requests.size();
+
+    // Download the requests in parallel, with this thread acting as one of the downloaders
+    std::atomic_size_t next_request_idx{0};
+    auto const download_requests = [&]() {
+        for (auto request_idx{next_request_idx++}; request_idx < requests.size();
+             request_idx = next_request_idx++)
+        {
+            download(requests[request_idx]);
+        }
+    };
+    std::vector<std::thread> downloader_threads;
+    auto const num_downloaders{std::min(m_max_num_parallel_requests, requests.size())};
+    downloader_threads.reserve(num_downloaders - 1);
+    for (size_t i{1}; i < num_downloaders; ++i) {
+        downloader_threads.emplace_back(download_requests);
+    }
+    download_requests();
+    for (auto& thread : downloader_threads) {
+        thread.join();
+    }
+
+    auto error_code{ErrorCode_Success};
+    for (auto& request : requests) {
+        if (ErrorCode_Success != request.error_code) {
+            error_code = request.error_code;
+            continue;
+        }
+        cache_blocks(request);
+    }
+    return error_code;
+}
+
+void RangeNetworkReader::download(BlockRangeRequest& request) const {
+    auto const begin{request.begin_block_idx * m_block_size};
+    auto const end{request.end_block_idx * m_block_size};
+    request.data.clear();
+    // If the server ignores the range and returns all of the data, we only need the data up to the
+    // end of the range
+    DownloadBuffer buffer{request.data, end};
+    try {
+        CurlDownloadHandler curl_handler{
+                nullptr,
+                range_network_reader_progress_callback,
+                range_network_reader_write_callback,
+                static_cast<void*>(&buffer),
+                m_src_url,
+                begin,
+                false,
+                m_connection_timeout,
+                m_overall_timeout,
+                std::nullopt,
+                end,
+                m_curl_share_handle.get()
+        };
+        auto const ret_code{curl_handler.perform()};
+        auto const response_code{curl_handler.get_response_code()};
+        if (CURLE_HTTP_RETURNED_ERROR == ret_code && cHttpRangeNotSatisfiable == response_code) {
+            // The range begins past the end of the data
+            request.data.clear();
+            request.error_code = ErrorCode_Success;
+            return;
+        }
+        bool const reached_capacity{buffer.capacity == request.data.size()};
+        if (CURLE_OK != ret_code && false == (CURLE_WRITE_ERROR == ret_code && reached_capacity)) {
+            request.error_code = ErrorCode_Failure;
+            return;
+        }
+        if (cHttpOk == response_code) {
+            // The server returned the data from its beginning
+            auto const num_bytes_to_drop{std::min(begin, request.data.size())};
+            request.data.erase(request.data.begin(), request.data.begin() + num_bytes_to_drop);
+        }
+        request.error_code = ErrorCode_Success;
+    } catch (CurlOperationFailed const&) {
+        request.error_code = ErrorCode_Failure;
+    }
+}
+
+void RangeNetworkReader::cache_blocks(BlockRangeRequest& request) {
+    auto const num_requested_bytes{
+            (request.end_block_idx - request.begin_block_idx) * m_block_size
+    };
+    if (request.data.size() < num_requested_bytes) {
+        m_size = request.begin_block_idx * m_block_size + request.data.size();
+    }
+
+    for (auto block_idx{request.begin_block_idx}; block_idx < request.end_block_idx; ++block_idx) {
+        auto const offset{(block_idx - request.begin_block_idx) * m_block_size};
+        if (offset >= request.data.size()) {
+            // The remaining blocks are past the end of the data
+            break;
+        }
+        auto const block_end{std::min(offset + m_block_size, request.data.size())};
+        std::vector<char> block_data(
+                request.data.begin() + static_cast<std::ptrdiff_t>(offset),
+                request.data.begin() + static_cast<std::ptrdiff_t>(block_end)
+        );
+
+        if (auto it{m_cached_blocks.find(block_idx)}; m_cached_blocks.end() != it) {
+            it->second.data = std::move(block_data);
+            m_lru_block_indices.splice(
+                    m_lru_block_indices.begin(),
+                    m_lru_block_indices,
+                    it->second.lru_it
+            );
+            continue;
+        }
+
+        m_lru_block_indices.push_front(block_idx);
+        m_cached_blocks.emplace(
+                block_idx,
+                CachedBlock{std::move(block_data), m_lru_block_indices.begin()}
+        );
+        if (m_cached_blocks.size() > m_max_num_cached_blocks) {
+            m_cached_blocks.erase(m_lru_block_indices.back());
+            m_lru_block_indices.pop_back();
+        }
+    }
+}
+
+auto RangeNetworkReader::get_block(size_t block_idx) -> CachedBlock const* {
+    if (auto it{m_cached_blocks.find(block_idx)}; m_cached_blocks.end() != it) {
+        m_lru_block_indices
+                .splice(m_lru_block_indices.begin(), m_lru_block_indices, it->second.lru_it);
+        return &it->second;
+    }
+
+    BlockRangeRequest request{block_idx, block_idx + 1, {}};
+    ++m_num_requests;
+    download(request);
+    if (ErrorCode_Success != request.error_code) {
+        return nullptr;
+    }
+    cache_blocks(request);
+
+    auto const it{m_cached_blocks.find(block_idx)};
+    return m_cached_blocks.end() == it ? nullptr : &it->second;
+}
+}  // namespace clp
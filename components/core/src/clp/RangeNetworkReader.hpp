@@ -0,0 +1,208 @@
+#ifndef CLP_RANGENETWORKREADER_HPP
+#define CLP_RANGENETWORKREADER_HPP
+
+#include <chrono>
+#include <cstddef>
+#include <list>
+#include <optional>
+#include <string>
+#include <string_view>
+#include <unordered_map>
+#include <utility>
+#include <vector>
+
+#include "CurlDownloadHandler.hpp"
+#include "CurlGlobalInstance.hpp"
+#include "CurlShareHandle.hpp"
+#include "ErrorCode.hpp"
+#include "ReaderInterface.hpp"
+#include "TraceableException.hpp"
+
+namespace clp {
+/**
+ * This class implements the ReaderInterface to randomly access data at a given URL (e.g., a
+ * pre-signed S3 URL) using HTTP `Range` requests, so that callers only download the parts of the
+ * data that they read.
+ *
+ * Data is downloaded and cached in fixed-size blocks, with the least recently used blocks evicted
+ * once the cache is full. Reads of uncached blocks download them on demand. Callers that know which
+ * byte ranges they're about to read can call `prefetch` to download them up front, in which case
+ * nearby ranges are coalesced into a single request, and the requests are issued in parallel.
+ * All requests share a connection cache, so they reuse connections to the server.
+ */
+class RangeNetworkReader : public ReaderInterface {
+public:
+    // Types
+    /**
+     * The exception thrown by this class.
+     */
+    class OperationFailed : public TraceableException {
+    public:
+        OperationFailed(ErrorCode error_code, char const* const filename, int line_number)
+                : TraceableException(error_code, filename, line_number) {}
+
+        [[nodiscard]] auto what() const noexcept -> char const* override {
+            return "clp::RangeNetworkReader operation failed.";
+        }
+    };
+
+    /**
+     * A range of bytes, [begin, end).
+     */
+    using ByteRange = std::pair<size_t, size_t>;
+
+    // Constants
+    static constexpr size_t cDefaultBlockSize{1024ULL * 1024};
+    static constexpr size_t cDefaultMaxNumCachedBlocks{64};
+    static constexpr size_t cDefaultMaxNumParallelRequests{8};
+    // Ranges separated by at most this many bytes are downloaded in a single request, since
+    // downloading the gap costs less than the latency of another request.
+    static constexpr size_t cDefaultMaxCoalescingGap{256ULL * 1024};
+
+    // Constructors
+    /**
+     * NOTE: Like `NetworkReader`, this class maintains an instance of `CurlGlobalInstance`, but
+     * it's better for performance if the user instantiates one that outlives all readers.
+     * @param src_url
+     * @param block_size The size of each cached block.
+     * @param max_num_cached_blocks The maximum number of blocks to cache.
+     * @param max_num_parallel_requests The maximum number of requests to issue in parallel when
+     * prefetching.
+     * @param max_coalescing_gap The maximum gap between two ranges that are downloaded in a single
+     * request when prefetching.
+     * @param overall_timeout Maximum time that each request may take. Note that this includes
+     * `connection_timeout`. Doc: https://curl.se/libcurl/c/CURLOPT_TIMEOUT.html
+     * @param connection_timeout Maximum time that the connection phase of each request may take.
+     * Doc: https://curl.se/libcurl/c/CURLOPT_CONNECTTIMEOUT.html
+     * @throw RangeNetworkReader::OperationFailed if any of the sizes are 0.
+     * @throw CurlOperationFailed if the connection cache can't be created.
+     */
+    explicit RangeNetworkReader(
+            std::string_view src_url,
+            size_t block_size = cDefaultBlockSize,
+            size_t max_num_cached_blocks = cDefaultMaxNumCachedBlocks,
+            size_t max_num_parallel_requests = cDefaultMaxNumParallelRequests,
+            size_t max_coalescing_gap = cDefaultMaxCoalescingGap,
+            std::chrono::seconds overall_timeout = CurlDownloadHandler::cDefaultOverallTimeout,
+            std::chrono::seconds connection_timeout
+            = CurlDownloadHandler::cDefaultConnectionTimeout
+    );
+
+    // Methods implementing `clp::ReaderInterface`
+    /**
+     * Tries to read up to a given number of bytes, downloading any uncached blocks.
+     * @param buf
+     * @param num_bytes_to_read
+     * @param num_bytes_read Returns the number of bytes read.
+     * @return ErrorCode_EndOfFile if the read head is at the end of the data.
+     * @return ErrorCode_Failure if a download failed.
+     * @return ErrorCode_Success on success.
+     */
+    [[nodiscard]] auto try_read(char* buf, size_t num_bytes_to_read, size_t& num_bytes_read)
+            -> ErrorCode override;
+
+    /**
+     * Tries to seek to the given position, relative to the beginning of the data. Since the data
+     * is only downloaded when it's read, this method never fails; reads past the end of the data
+     * return ErrorCode_EndOfFile.
+     * @param pos
+     * @return ErrorCode_Success
+     */
+    [[nodiscard]] auto try_seek_from_begin(size_t pos) -> ErrorCode override {
+        m_pos = pos;
+        return ErrorCode_Success;
+    }
+
+    /**
+     * @param pos Returns the position of the read head.
+     * @return ErrorCode_Success
+     */
+    [[nodiscard]] auto try_get_pos(size_t& pos) -> ErrorCode override {
+        pos = m_pos;
+        return ErrorCode_Success;
+    }
+
+    // Methods
+    /**
+     * Downloads the uncached blocks overlapping the given ranges, coalescing nearby ranges and
+     * issuing the resulting requests in parallel. To avoid evicting blocks that are still being
+     * read, at most half of the cache's blocks are downloaded; any later blocks are left to be
+     * downloaded on demand (or by a later call).
+     * @param ranges The ranges to download, in ascending order.
+     * @return ErrorCode_Failure if a download failed.
+     * @return ErrorCode_Success on success.
+     */
+    [[nodiscard]] auto prefetch(std::vector<ByteRange> const& ranges) -> ErrorCode;
+
+    /**
+     * @return The number of HTTP requests this reader has issued.
+     */
+    [[nodiscard]] auto get_num_requests() const -> size_t { return m_num_requests; }
+
+    /**
+     * @return The size of the data, if the end of the data has been downloaded.
+     */
+    [[nodiscard]] auto get_size() const -> std::optional<size_t> { return m_size; }
+
+private:
+    // Types
+    struct CachedBlock {
+        std::vector<char> data;
+        std::list<size_t>::iterator lru_it;
+    };
+
+    /**
+     * A request for the blocks [begin_block_idx, end_block_idx), and the data it returned.
+     */
+    struct BlockRangeRequest {
+        size_t begin_block_idx;
+        size_t end_block_idx;
+        std::vector<char> data;
+        ErrorCode error_code{ErrorCode_Success};
+    };
+
+    // Methods
+    /**
+     * Downloads the blocks for the given request into its data buffer. This method may be called
+     * concurrently for different requests.
+     * @param request
+     */
+    void download(BlockRangeRequest& request) const;
+
+    /**
+     * Splits the data downloaded for the given request into blocks and adds them to the cache.
+     * @param request
+     */
+    void cache_blocks(BlockRangeRequest& request);
+
+    /**
+     * @param block_idx
+     * @return A pointer to the cached block, downloading it if it isn't cached, or nullptr if the
+     * download failed.
+     */
+    [[nodiscard]] auto get_block(size_t block_idx) -> CachedBlock const*;
+
+    // Variables
+    CurlGlobalInstance m_curl_global_instance;
+    CurlShareHandle m_curl_share_handle;
+
+    std::string m_src_url;
+    size_t m_block_size;
+    size_t m_max_num_cached_blocks;
+    size_t m_max_num_parallel_requests;
+    size_t m_max_coalescing_gap;
+    std::chrono::seconds m_overall_timeout;
+    std::chrono::seconds m_connection_timeout;
+
+    size_t m_pos{0};
+    // Known once a request returns fewer bytes than requested
+    std::optional<size_t> m_size;
+    size_t m_num_requests{0};
+
+    std::unordered_map<size_t, CachedBlock> m_cached_blocks;
+    // Indices of the cached blocks, from the most to the least recently used
+    std::list<size_t> m_lru_block_indices;
+};
+}  // namespace clp
+
+#endif  // CLP_RANGENETWORKREADER_HPP
@@ -1,7 +1,11 @@
 #include "TimestampPattern.hpp"
 
+#include <algorithm>
+#include <array>
 #include <chrono>
 #include <cstring>
+#include <limits>
+#include <span>
 #include <vector>
 
 #include <date/date.h>
@@ -15,6 +19,9 @@ using std::vector;
 // Static member default initialization
 std::unique_ptr<clp::TimestampPattern[]> clp::TimestampPattern::m_known_ts_patterns = nullptr;
 size_t clp::TimestampPattern::m_known_ts_patterns_len = 0;
+std::unique_ptr<clp::TimestampPattern::CharSet[]>
+        clp::TimestampPattern::m_known_ts_pattern_first_chars = nullptr;
+uint8_t clp::TimestampPattern::m_max_num_spaces_before_known_ts = 0;
 
 namespace {
 enum class ParserState {
@@ -197,6 +204,16 @@ void TimestampPattern::init() {
     for (size_t i = 0; i < patterns.size(); ++i) {
         m_known_ts_patterns[i] = patterns[i];
     }
+
+    m_known_ts_pattern_first_chars = std::make_unique<CharSet[]>(m_known_ts_patterns_len);
+    m_max_num_spaces_before_known_ts = 0;
+    for (size_t i = 0; i < m_known_ts_patterns_len; ++i) {
+        m_known_ts_pattern_first_chars[i] = m_known_ts_patterns[i].get_possible_first_chars();
+        m_max_num_spaces_before_known_ts = std::max(
+                m_max_num_spaces_before_known_ts,
+                m_known_ts_patterns[i].m_num_spaces_before_ts
+        );
+    }
 }
 
 TimestampPattern const* TimestampPattern::search_known_ts_patterns(
@@ -205,11 +222,40 @@ TimestampPattern const* TimestampPattern::search_known_ts_patterns(
         size_t& timestamp_begin_pos,
         size_t& timestamp_end_pos
 ) {
+    // Find where the timestamp would begin for each number of spaces before it, so that we can
+    // check each pattern's first character without parsing the line
+    size_t const line_length = line.length();
+    std::array<size_t, std::numeric_limits<uint8_t>::max() + 1> ts_begin_ix_for_num_spaces;
+    std::fill_n(
+            ts_begin_ix_for_num_spaces.begin(),
+            m_max_num_spaces_before_known_ts + 1,
+            string::npos
+    );
+    ts_begin_ix_for_num_spaces[0] = 0;
+    size_t num_spaces_found = 0;
+    for (size_t line_ix = 0;
+         line_ix < line_length && num_spaces_found < m_max_num_spaces_before_known_ts;
+         ++line_ix)
+    {
+        if (' ' == line[line_ix]) {
+            ++num_spaces_found;
+            ts_begin_ix_for_num_spaces[num_spaces_found] = line_ix + 1;
+        }
+    }
+
     for (size_t i = 0; i < m_known_ts_patterns_len; ++i) {
-        if (m_known_ts_patterns[i]
-                    .parse_timestamp(line, timestamp, timestamp_begin_pos, timestamp_end_pos))
+        auto const& pattern = m_known_ts_patterns[i];
+        auto const ts_begin_ix = ts_begin_ix_for_num_spaces[pattern.m_num_spaces_before_ts];
+        if (ts_begin_ix >= line_length
+            || false
+                       == m_known_ts_pattern_first_chars[i].test(
+                               static_cast<unsigned char>(line[ts_begin_ix])
+                       ))
         {
-            return &m_known_ts_patterns[i];
+            continue;
+        }
+        if (pattern.parse_timestamp(line, timestamp, timestamp_begin_pos, timestamp_end_pos)) {
+            return &pattern;
         }
     }
 
@@ -218,6 +264,10 @@ TimestampPattern const* TimestampPattern::search_known_ts_patterns(
     return nullptr;
 }
 
+std::span<TimestampPattern const> TimestampPattern::get_known_ts_patterns() {
+    return {m_known_ts_patterns.get(), m_known_ts_patterns_len};
+}
+
 string const& TimestampPattern::get_format() const {
     return m_format;
 }
@@ -235,6 +285,78 @@ void TimestampPattern::clear() {
     m_format.clear();
 }
 
+TimestampPattern::CharSet TimestampPattern::get_possible_first_chars() const {
+    CharSet first_chars;
+    if (m_format.empty()) {
+        first_chars.set();
+        return first_chars;
+    }
+    if ('%' != m_format[0]) {
+        first_chars.set(static_cast<unsigned char>(m_format[0]));
+        return first_chars;
+    }
+    if (m_format.length() < 2) {
+        first_chars.set();
+        return first_chars;
+    }
+
+    auto const set_digits = [&first_chars]() {
+        for (char c = '0'; c <= '9'; ++c) {
+            first_chars.set(static_cast<unsigned char>(c));
+        }
+    };
+    auto const set_first_chars_of = [&first_chars](char const* const* strs, int num_strs) {
+        for (int i = 0; i < num_strs; ++i) {
+            first_chars.set(static_cast<unsigned char>(strs[i][0]));
+        }
+    };
+    switch (m_format[1]) {
+        case '%':
+            first_chars.set('%');
+            break;
+        case 'y':
+        case 'Y':
+        case 'm':
+        case 'd':
+        case 'H':
+        case 'I':
+        case 'M':
+        case 'S':
+        case '3':
+            set_digits();
+            break;
+        case 'e':
+        case 'k':
+        case 'l':
+            set_digits();
+            first_chars.set(' ');
+            break;
+        case 'B':
+            set_first_chars_of(cMonthNames, cNumMonths);
+            break;
+        case 'b':
+            set_first_chars_of(cAbbrevMonthNames, cNumMonths);
+            break;
+        case 'a':
+            set_first_chars_of(cAbbrevDaysOfWeek, cNumDaysInWeek);
+            break;
+        case 'p':
+            first_chars.set('A');
+            first_chars.set('P');
+            break;
+        case '#':
+            // Relative timestamps can't have leading zeros
+            set_digits();
+            first_chars.reset('0');
+            break;
+        default:
+            // Be conservative for specifiers we don't know how to dispatch on
+            first_chars.set();
+            break;
+    }
+    return first_chars;
+}
+
 bool TimestampPattern::parse_timestamp(
         string const& line,
         epochtime_t& timestamp,
@@ -1,9 +1,11 @@
 #ifndef CLP_TIMESTAMPPATTERN_HPP
 #define CLP_TIMESTAMPPATTERN_HPP
 
+#include <bitset>
 #include <cstddef>
 #include <cstdint>
 #include <memory>
+#include <span>
 
 #include "Defs.h"
 #include "FileWriter.hpp"
@@ -74,7 +76,9 @@ public:
 
     /**
      * Searches for a known timestamp pattern which can parse the timestamp from the given line, and
-     * if found, parses the timestamp
+     * if found, parses the timestamp. Patterns are tried in the order they're defined in init(),
+     * but patterns that can't start with the character at their timestamp's position in the line
+     * are skipped without being parsed.
      * @param line
      * @param timestamp Parsed timestamp
      * @param timestamp_begin_pos
@@ -88,6 +92,12 @@ public:
             size_t& timestamp_end_pos
     );
 
+    /**
+     * Gets the known timestamp patterns in the order that search_known_ts_patterns tries them
+     * @return See description
+     */
+    static std::span<TimestampPattern const> get_known_ts_patterns();
+
     /**
      * Gets the timestamp pattern's format string
      * @return See description
@@ -148,9 +158,21 @@ public:
     friend bool operator!=(TimestampPattern const& lhs, TimestampPattern const& rhs);
 
 private:
+    // Types
+    using CharSet = std::bitset<256>;
+
+    // Methods
+    /**
+     * @return The set of characters that a timestamp matching this pattern can begin with.
+     */
+    CharSet get_possible_first_chars() const;
+
     // Variables
     static std::unique_ptr<TimestampPattern[]> m_known_ts_patterns;
     static size_t m_known_ts_patterns_len;
+    // Parallel to m_known_ts_patterns
+    static std::unique_ptr<CharSet[]> m_known_ts_pattern_first_chars;
+    static uint8_t m_max_num_spaces_before_known_ts;
 
     // The number of spaces before the timestamp in a message
     // E.g. in "localhost - - [01/Jan/2016:15:50:17", there are 3 spaces before the timestamp
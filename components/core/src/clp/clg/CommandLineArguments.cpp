@@ -71,6 +71,19 @@ CommandLineArguments::parse_arguments(int argc, char const* argv[]) {
                     ->value_name("CHAR")
                     ->default_value(output_method_input),
             "Use output method specified by CHAR (s - stdout, b - binary)"
+    )(
+            "ordered-output",
+            po::bool_switch(&m_ordered_output),
+            "When searching with multiple threads, output results in the same archive order as a"
+            " single-threaded search"
+    );
+
+    // Define performance options
+    po::options_description options_performance("Performance Options");
+    options_performance.add_options()(
+            "num-threads",
+            po::value<size_t>(&m_num_threads)->value_name("NUM")->default_value(m_num_threads),
+            "Number of threads to search archives with"
     );
 
     // Define match controls
@@ -107,6 +120,7 @@ CommandLineArguments::parse_arguments(int argc, char const* argv[]) {
     visible_options.add(options_input);
     visible_options.add(options_output);
     visible_options.add(options_match_control);
+    visible_options.add(options_performance);
 
     // Define hidden positional options (not shown in Boost's program options help message)
     po::options_description hidden_positional_options;
@@ -133,6 +147,7 @@ CommandLineArguments::parse_arguments(int argc, char const* argv[]) {
     all_options.add(options_input);
     all_options.add(options_output);
     all_options.add(options_match_control);
+    all_options.add(options_performance);
     all_options.add(hidden_positional_options);
 
     // Parse options
@@ -261,6 +276,10 @@ CommandLineArguments::parse_arguments(int argc, char const* argv[]) {
             }
         }
 
+        if (m_num_threads < 1) {
+            throw invalid_argument("num-threads must be non-zero.");
+        }
+
         switch (output_method_input) {
             case (char)OutputMethod::StdoutText:
             case (char)OutputMethod::StdoutBinary:
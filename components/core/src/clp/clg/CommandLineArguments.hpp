@@ -24,8 +24,10 @@ public:
             : CommandLineArgumentsBase(program_name),
               m_ignore_case(false),
               m_output_method(OutputMethod::StdoutText),
+              m_ordered_output(false),
               m_search_begin_ts(cEpochTimeMin),
-              m_search_end_ts(cEpochTimeMax) {}
+              m_search_end_ts(cEpochTimeMax),
+              m_num_threads(1) {}
 
     // Methods
     ParsingResult parse_arguments(int argc, char const* argv[]) override;
@@ -42,10 +44,14 @@ public:
 
     OutputMethod get_output_method() const { return m_output_method; }
 
+    bool ordered_output() const { return m_ordered_output; }
+
     epochtime_t get_search_begin_ts() const { return m_search_begin_ts; }
 
     epochtime_t get_search_end_ts() const { return m_search_end_ts; }
 
+    size_t get_num_threads() const { return m_num_threads; }
+
     std::optional<GlobalMetadataDBConfig> const& get_metadata_db_config() const {
         return m_metadata_db_config;
     }
@@ -61,7 +67,9 @@ private:
     std::string m_search_string;
     std::string m_file_path;
     OutputMethod m_output_method;
+    bool m_ordered_output;
     epochtime_t m_search_begin_ts, m_search_end_ts;
+    size_t m_num_threads;
     std::optional<GlobalMetadataDBConfig> m_metadata_db_config;
 };
 }  // namespace clp::clg
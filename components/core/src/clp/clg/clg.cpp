@@ -1,9 +1,19 @@
 #include <sys/stat.h>
 
+#include <algorithm>
+#include <atomic>
+#include <condition_variable>
+#include <cstdio>
 #include <cstring>
+#include <exception>
 #include <filesystem>
+#include <functional>
 #include <iostream>
+#include <map>
+#include <memory>
+#include <mutex>
 #include <set>
+#include <utility>
 
 #include <log_surgeon/Lexer.hpp>
 #include <spdlog/sinks/stdout_sinks.h>
@@ -16,6 +26,7 @@
 #include "../Profiler.hpp"
 #include "../spdlog_with_specializations.hpp"
 #include "../streaming_archive/Constants.hpp"
+#include "../Thread.hpp"
 #include "../Utils.hpp"
 #include "CommandLineArguments.hpp"
 
@@ -39,6 +50,7 @@ using clp::streaming_archive::reader::Archive;
 using clp::streaming_archive::reader::File;
 using clp::streaming_archive::reader::Message;
 using clp::string_utils::clean_up_wildcard_search_string;
+using clp::Thread;
 using clp::TraceableException;
 using clp::variable_dictionary_id_t;
 using std::cerr;
@@ -48,6 +60,236 @@ using std::string;
 using std::to_string;
 using std::vector;
 
+namespace {
+/**
+ * Class that merges the search results of archives searched by (potentially) multiple threads into
+ * stdout.
+ *
+ * Each archive's results are accumulated in a buffer and flushed through this class. If ordered
+ * output is enabled, results are written in the order the archives were returned by the global
+ * metadata DB: the results of the earliest incomplete archive are written as soon as they're
+ * flushed, while the results of any later archive are held until all archives before it have been
+ * completed. Otherwise, results are written as soon as they're flushed.
+ *
+ * To bound memory usage, a thread flushing held results blocks until its archive is next in order
+ * once either its own buffer or the results of completed archives held by this class exceed
+ * `cMaxNumHeldBytes`. This can't deadlock since archives are claimed in order, so the next archive
+ * is always being searched by a thread that never blocks.
+ */
+class OutputMerger {
+public:
+    // Constructors
+    explicit OutputMerger(bool ordered) : m_ordered{ordered} {}
+
+    // Methods
+    /**
+     * Flushes the given archive's buffered results to stdout, unless they must be held to preserve
+     * the output order. If holding the results would use too much memory, blocks until the archive
+     * is next in order.
+     * @param archive_idx
+     * @param results The archive's buffered results. Cleared if they were consumed.
+     * @param is_archive_complete Whether the archive has no more results
+     */
+    auto flush(size_t archive_idx, string& results, bool is_archive_complete) -> void;
+
+    /**
+     * Stops waiting for archives to be completed, discarding any results that are held or flushed
+     * afterwards. Must be called if the search fails, so that no thread waits for an archive that
+     * will never be completed.
+     */
+    auto abort() -> void;
+
+private:
+    // Constants
+    static constexpr size_t cMaxNumHeldBytes{64UL * 1024 * 1024};
+
+    // Methods
+    /**
+     * Writes the given results to stdout. The caller must hold `m_mutex`.
+     * @param results
+     */
+    static auto write(string const& results) -> void;
+
+    // Variables
+    bool m_ordered;
+    size_t m_next_archive_idx{0};
+    std::map<size_t, string> m_held_archive_results;
+    size_t m_num_held_bytes{0};
+    bool m_aborted{false};
+    std::mutex m_mutex;
+    std::condition_variable m_next_archive_changed;
+};
+
+/**
+ * Buffer for the search results of a single archive, which flushes itself through an
+ * `OutputMerger` once it's full.
+ */
+class ArchiveOutput {
+public:
+    // Constructors
+    ArchiveOutput(OutputMerger& output_merger, size_t archive_idx)
+            : m_output_merger{output_merger},
+              m_archive_idx{archive_idx} {}
+
+    // Methods
+    /**
+     * Appends the given bytes to the buffer, flushing the buffer each time another
+     * `cFlushThreshold` bytes have been buffered.
+     * @param data
+     * @param size
+     */
+    auto append(void const* data, size_t size) -> void {
+        m_buffer.append(static_cast<char const*>(data), size);
+        if (m_buffer.size() >= m_next_flush_size) {
+            m_output_merger.flush(m_archive_idx, m_buffer, false);
+            // If the results are being held, don't retry until another batch has been buffered
+            m_next_flush_size = m_buffer.size() + cFlushThreshold;
+        }
+    }
+
+    /**
+     * Flushes any remaining results and marks the archive's output as complete.
+     */
+    auto complete() -> void { m_output_merger.flush(m_archive_idx, m_buffer, true); }
+
+private:
+    // Constants
+    static constexpr size_t cFlushThreshold{64UL * 1024};
+
+    // Variables
+    OutputMerger& m_output_merger;
+    size_t m_archive_idx;
+    string m_buffer;
+    size_t m_next_flush_size{cFlushThreshold};
+};
+
+/**
+ * Thread that runs a search function, raising a shared failure flag if the search fails so that
+ * the other threads stop searching.
+ */
+class SearchThread : public Thread {
+public:
+    // Constructors
+    SearchThread(std::function<bool()> search_func, std::atomic_bool& search_failed)
+            : m_search_func{std::move(search_func)},
+              m_search_failed{search_failed} {}
+
+protected:
+    // Methods
+    void thread_method() override;
+
+private:
+    // Variables
+    std::function<bool()> m_search_func;
+    std::atomic_bool& m_search_failed;
+};
+
+auto OutputMerger::flush(size_t archive_idx, string& results, bool is_archive_complete) -> void {
+    std::unique_lock<std::mutex> lock{m_mutex};
+    if (m_aborted) {
+        results.clear();
+        return;
+    }
+    if (false == m_ordered) {
+        write(results);
+        results.clear();
+        return;
+    }
+
+    if (archive_idx != m_next_archive_idx) {
+        // Hold the results until all preceding archives have been completed, unless that would use
+        // too much memory
+        if (false == is_archive_complete) {
+            if (results.size() < cMaxNumHeldBytes) {
+                return;
+            }
+        } else if (m_num_held_bytes + results.size() <= cMaxNumHeldBytes) {
+            m_num_held_bytes += results.size();
+            m_held_archive_results.emplace(archive_idx, std::move(results));
+            results.clear();
+            return;
+        }
+        m_next_archive_changed.wait(lock, [&]() {
+            return m_aborted || archive_idx == m_next_archive_idx;
+        });
+        if (m_aborted) {
+            results.clear();
+            return;
+        }
+    }
+
+    write(results);
+    results.clear();
+    if (false == is_archive_complete) {
+        return;
+    }
+
+    // Write the results of any held archives that are now next in order
+    ++m_next_archive_idx;
+    for (auto it = m_held_archive_results.begin();
+         m_held_archive_results.end() != it && it->first == m_next_archive_idx;
+         it = m_held_archive_results.erase(it))
+    {
+        write(it->second);
+        m_num_held_bytes -= it->second.size();
+        ++m_next_archive_idx;
+    }
+    m_next_archive_changed.notify_all();
+}
+
+auto OutputMerger::abort() -> void {
+    {
+        std::lock_guard<std::mutex> const lock{m_mutex};
+        m_aborted = true;
+        m_held_archive_results.clear();
+        m_num_held_bytes = 0;
+    }
+    m_next_archive_changed.notify_all();
+}
+
+auto OutputMerger::write(string const& results) -> void {
+    if (results.empty()) {
+        return;
+    }
+    auto const num_elems_written = fwrite(results.data(), sizeof(char), results.size(), stdout);
+    if (num_elems_written < results.size()) {
+        SPDLOG_ERROR("Failed to write results, errno={}", errno);
+    }
+}
+
+void SearchThread::thread_method() {
+    // Exceptions can't cross the thread boundary, so log them and fail the search instead
+    try {
+        if (false == m_search_func()) {
+            m_search_failed = true;
+        }
+    } catch (TraceableException& e) {
+        auto const error_code = e.get_error_code();
+        if (ErrorCode_errno == error_code) {
+            SPDLOG_ERROR(
+                    "Search failed: {}:{} {}, errno={}",
+                    e.get_filename(),
+                    e.get_line_number(),
+                    e.what(),
+                    errno
+            );
+        } else {
+            SPDLOG_ERROR(
+                    "Search failed: {}:{} {}, error_code={}",
+                    e.get_filename(),
+                    e.get_line_number(),
+                    e.what(),
+                    error_code
+            );
+        }
+        m_search_failed = true;
+    } catch (std::exception& e) {
+        SPDLOG_ERROR("Search failed: Unexpected exception - {}", e.what());
+        m_search_failed = true;
+    }
+}
+}  // namespace
+
 /**
  * Opens the archive and reads the dictionaries
  * @param archive_path
@@ -73,20 +315,22 @@ static bool open_compressed_file(
  * @param output_method
  * @param archive
  * @param file_metadata_ix
+ * @param output
  * @return The total number of matches found across all files
  */
 static size_t search_files(
         vector<Query>& queries,
         CommandLineArguments::OutputMethod output_method,
         Archive& archive,
-        MetadataDB::FileIterator& file_metadata_ix
+        MetadataDB::FileIterator& file_metadata_ix,
+        ArchiveOutput& output
 );
 /**
- * Prints search result to stdout in text format
+ * Prints search result in text format to the archive's output
  * @param orig_file_path
  * @param compressed_msg
  * @param decompressed_msg
- * @param custom_arg Unused
+ * @param custom_arg The `ArchiveOutput` to print to
  */
 static void print_result_text(
         string const& orig_file_path,
@@ -95,11 +339,11 @@ static void print_result_text(
         void* custom_arg
 );
 /**
- * Prints search result to stdout in binary format
+ * Prints search result in binary format to the archive's output
  * @param orig_file_path
  * @param compressed_msg
  * @param decompressed_msg
- * @param custom_arg Unused
+ * @param custom_arg The `ArchiveOutput` to print to
  */
 static void print_result_binary(
         string const& orig_file_path,
@@ -108,6 +352,26 @@ static void print_result_binary(
         void* custom_arg
 );
 
+/**
+ * Searches the archives at the given paths, claiming one archive at a time until all archives have
+ * been claimed or the search has failed
+ * @param archive_paths
+ * @param next_archive_idx Index of the next unclaimed archive, shared by all searching threads
+ * @param search_failed Flag shared by all searching threads, set if any search fails
+ * @param search_strings
+ * @param command_line_args
+ * @param output_merger
+ * @return true on success, false otherwise
+ */
+static bool search_archives(
+        vector<std::filesystem::path> const& archive_paths,
+        std::atomic_size_t& next_archive_idx,
+        std::atomic_bool& search_failed,
+        vector<string> const& search_strings,
+        CommandLineArguments& command_line_args,
+        OutputMerger& output_merger
+);
+
 /**
  * Gets an archive iterator for the given file path or for all files if the file path is empty
  * @param global_metadata_db
@@ -200,7 +464,8 @@ static bool search(
         CommandLineArguments& command_line_args,
         Archive& archive,
         log_surgeon::lexers::ByteLexer& lexer,
-        bool use_heuristic
+        bool use_heuristic,
+        ArchiveOutput& output
 ) {
     ErrorCode error_code;
     auto search_begin_ts = command_line_args.get_search_begin_ts();
@@ -283,7 +548,8 @@ static bool search(
                         queries,
                         command_line_args.get_output_method(),
                         archive,
-                        *file_metadata_ix
+                        *file_metadata_ix,
+                        output
                 );
             } else {
                 auto file_metadata_ix_ptr = archive.get_file_iterator(
@@ -298,7 +564,8 @@ static bool search(
                         queries,
                         command_line_args.get_output_method(),
                         archive,
-                        file_metadata_ix
+                        file_metadata_ix,
+                        output
                 );
                 for (auto segment_id : ids_of_segments_to_search) {
                     file_metadata_ix.set_segment_id(segment_id);
@@ -306,7 +573,8 @@ static bool search(
                             queries,
                             command_line_args.get_output_method(),
                             archive,
-                            file_metadata_ix
+                            file_metadata_ix,
+                            output
                     );
                 }
             }
@@ -363,7 +631,8 @@ static size_t search_files(
         vector<Query>& queries,
         CommandLineArguments::OutputMethod const output_method,
         Archive& archive,
-        MetadataDB::FileIterator& file_metadata_ix
+        MetadataDB::FileIterator& file_metadata_ix,
+        ArchiveOutput& output
 ) {
     size_t num_matches = 0;
 
@@ -374,11 +643,11 @@ static size_t search_files(
     switch (output_method) {
         case CommandLineArguments::OutputMethod::StdoutText:
             output_func = print_result_text;
-            output_func_arg = nullptr;
+            output_func_arg = &output;
             break;
         case CommandLineArguments::OutputMethod::StdoutBinary:
             output_func = print_result_binary;
-            output_func_arg = nullptr;
+            output_func_arg = &output;
             break;
         default:
             SPDLOG_ERROR("Unknown output method - {}", (char)output_method);
@@ -386,7 +655,14 @@ static size_t search_files(
     }
 
     // Run all queries on each file
+    string file_id;
     for (; file_metadata_ix.has_next(); file_metadata_ix.next()) {
+        // Skip files that the archive's posting lists show can't contain a match
+        file_metadata_ix.get_id(file_id);
+        if (false == Grep::file_may_contain_match(archive, file_id, queries)) {
+            continue;
+        }
+
         if (open_compressed_file(file_metadata_ix, archive, compressed_file)) {
             Grep::calculate_sub_queries_relevant_to_file(compressed_file, queries);
 
@@ -414,7 +690,10 @@ static void print_result_text(
         string const& decompressed_msg,
         void* custom_arg
 ) {
-    printf("%s:%s", orig_file_path.c_str(), decompressed_msg.c_str());
+    auto& output = *static_cast<ArchiveOutput*>(custom_arg);
+    output.append(orig_file_path.data(), orig_file_path.length());
+    output.append(":", 1);
+    output.append(decompressed_msg.data(), decompressed_msg.length());
 }
 
 static void print_result_binary(
@@ -423,62 +702,110 @@ static void print_result_binary(
         string const& decompressed_msg,
         void* custom_arg
 ) {
-    bool write_successful = true;
-    do {
-        size_t length;
-        size_t num_elems_written;
-
-        // Write file path
-        length = orig_file_path.length();
-        num_elems_written = fwrite(&length, sizeof(length), 1, stdout);
-        if (num_elems_written < 1) {
-            write_successful = false;
-            break;
-        }
-        num_elems_written = fwrite(orig_file_path.c_str(), sizeof(char), length, stdout);
-        if (num_elems_written < length) {
-            write_successful = false;
-            break;
-        }
+    auto& output = *static_cast<ArchiveOutput*>(custom_arg);
+
+    // Write file path
+    size_t length = orig_file_path.length();
+    output.append(&length, sizeof(length));
+    output.append(orig_file_path.data(), length);
+
+    // Write timestamp
+    epochtime_t timestamp = compressed_msg.get_ts_in_milli();
+    output.append(&timestamp, sizeof(timestamp));
+
+    // Write logtype ID
+    auto logtype_id = compressed_msg.get_logtype_id();
+    output.append(&logtype_id, sizeof(logtype_id));
+
+    // Write message
+    length = decompressed_msg.length();
+    output.append(&length, sizeof(length));
+    output.append(decompressed_msg.data(), length);
+}
+
+static bool search_archives(
+        vector<std::filesystem::path> const& archive_paths,
+        std::atomic_size_t& next_archive_idx,
+        std::atomic_bool& search_failed,
+        vector<string> const& search_strings,
+        CommandLineArguments& command_line_args,
+        OutputMerger& output_merger
+) {
+    // TODO: if performance is too slow, can make this more efficient by only diffing files with the
+    // same checksum
+    uint32_t const max_map_schema_length = 100'000;
+    std::map<std::string, log_surgeon::lexers::ByteLexer> lexer_map;
+    log_surgeon::lexers::ByteLexer one_time_use_lexer;
+    log_surgeon::lexers::ByteLexer* lexer_ptr = &one_time_use_lexer;
 
-        // Write timestamp
-        epochtime_t timestamp = compressed_msg.get_ts_in_milli();
-        num_elems_written = fwrite(&timestamp, sizeof(timestamp), 1, stdout);
-        if (num_elems_written < 1) {
-            write_successful = false;
+    Archive archive_reader;
+    while (false == search_failed) {
+        auto const archive_idx = next_archive_idx++;
+        if (archive_idx >= archive_paths.size()) {
             break;
         }
+        auto const& archive_path = archive_paths[archive_idx];
+        ArchiveOutput output{output_merger, archive_idx};
 
-        // Write logtype ID
-        auto logtype_id = compressed_msg.get_logtype_id();
-        num_elems_written = fwrite(&logtype_id, sizeof(logtype_id), 1, stdout);
-        if (num_elems_written < 1) {
-            write_successful = false;
-            break;
+        // Open archive
+        if (!open_archive(archive_path.string(), archive_reader)) {
+            search_failed = true;
+            return false;
         }
 
-        // Write message
-        length = decompressed_msg.length();
-        num_elems_written = fwrite(&length, sizeof(length), 1, stdout);
-        if (num_elems_written < 1) {
-            write_successful = false;
-            break;
+        // Generate lexer if schema file exists
+        auto schema_file_path = archive_path / clp::streaming_archive::cSchemaFileName;
+        bool use_heuristic = true;
+        if (std::filesystem::exists(schema_file_path)) {
+            use_heuristic = false;
+
+            char buf[max_map_schema_length];
+            FileReader file_reader{schema_file_path};
+
+            size_t num_bytes_read;
+            file_reader.read(buf, max_map_schema_length, num_bytes_read);
+            if (num_bytes_read < max_map_schema_length) {
+                auto lexer_map_it = lexer_map.find(buf);
+                // if there is a chance there might be a difference make a new lexer as it's pretty
+                // fast to create
+                if (lexer_map_it == lexer_map.end()) {
+                    auto insert_result = lexer_map.emplace(buf, log_surgeon::lexers::ByteLexer());
+                    lexer_ptr = &insert_result.first->second;
+                    load_lexer_from_file(schema_file_path, *lexer_ptr);
+                } else {
+                    lexer_ptr = &lexer_map_it->second;
+                }
+            } else {
+                lexer_ptr = &one_time_use_lexer;
+                load_lexer_from_file(schema_file_path, one_time_use_lexer);
+            }
         }
-        num_elems_written = fwrite(decompressed_msg.c_str(), sizeof(char), length, stdout);
-        if (num_elems_written < length) {
-            write_successful = false;
-            break;
+
+        // Perform search
+        auto const search_succeeded = search(
+                search_strings,
+                command_line_args,
+                archive_reader,
+                *lexer_ptr,
+                use_heuristic,
+                output
+        );
+        if (false == search_succeeded) {
+            search_failed = true;
+            return false;
         }
-    } while (false);
-    if (!write_successful) {
-        SPDLOG_ERROR("Failed to write result in binary form, errno={}", errno);
+        archive_reader.close();
+        output.complete();
     }
+
+    return true;
 }
 
 int main(int argc, char const* argv[]) {
     // Program-wide initialization
     try {
-        auto stderr_logger = spdlog::stderr_logger_st("stderr");
+        // NOTE: The logger must be thread-safe since archives may be searched by multiple threads
+        auto stderr_logger = spdlog::stderr_logger_mt("stderr");
         spdlog::set_default_logger(stderr_logger);
         spdlog::set_pattern("%Y-%m-%d %H:%M:%S,%e [%l] %v");
     } catch (std::exception& e) {
@@ -542,15 +869,8 @@ int main(int argc, char const* argv[]) {
     }
     global_metadata_db->open();
 
-    // TODO: if performance is too slow, can make this more efficient by only diffing files with the
-    // same checksum
-    uint32_t const max_map_schema_length = 100'000;
-    std::map<std::string, log_surgeon::lexers::ByteLexer> lexer_map;
-    log_surgeon::lexers::ByteLexer one_time_use_lexer;
-    log_surgeon::lexers::ByteLexer* lexer_ptr;
-
+    vector<std::filesystem::path> archive_paths;
     string archive_id;
-    Archive archive_reader;
     for (auto archive_ix = std::unique_ptr<GlobalMetadataDB::ArchiveIterator>(get_archive_iterator(
                  *global_metadata_db,
                  command_line_args.get_file_path(),
@@ -572,44 +892,50 @@ int main(int argc, char const* argv[]) {
             continue;
         }
 
-        // Open archive
-        if (!open_archive(archive_path.string(), archive_reader)) {
-            return -1;
-        }
-
-        // Generate lexer if schema file exists
-        auto schema_file_path = archive_path / clp::streaming_archive::cSchemaFileName;
-        bool use_heuristic = true;
-        if (std::filesystem::exists(schema_file_path)) {
-            use_heuristic = false;
-
-            char buf[max_map_schema_length];
-            FileReader file_reader{schema_file_path};
+        archive_paths.emplace_back(std::move(archive_path));
+    }
 
-            size_t num_bytes_read;
-            file_reader.read(buf, max_map_schema_length, num_bytes_read);
-            if (num_bytes_read < max_map_schema_length) {
-                auto lexer_map_it = lexer_map.find(buf);
-                // if there is a chance there might be a difference make a new lexer as it's pretty
-                // fast to create
-                if (lexer_map_it == lexer_map.end()) {
-                    auto insert_result = lexer_map.emplace(buf, log_surgeon::lexers::ByteLexer());
-                    lexer_ptr = &insert_result.first->second;
-                    load_lexer_from_file(schema_file_path, *lexer_ptr);
-                } else {
-                    lexer_ptr = &lexer_map_it->second;
-                }
-            } else {
-                lexer_ptr = &one_time_use_lexer;
-                load_lexer_from_file(schema_file_path, one_time_use_lexer);
-            }
+    // Search the archives using up to `num_threads` threads (including this one), each with its own
+    // archive reader
+    OutputMerger output_merger{command_line_args.ordered_output()};
+    std::atomic_size_t next_archive_idx{0};
+    std::atomic_bool search_failed{false};
+    auto search_func = [&]() -> bool {
+        // Stop the output merger from waiting for archives that the failed search won't complete
+        bool search_succeeded{false};
+        try {
+            search_succeeded = search_archives(
+                    archive_paths,
+                    next_archive_idx,
+                    search_failed,
+                    search_strings,
+                    command_line_args,
+                    output_merger
+            );
+        } catch (...) {
+            output_merger.abort();
+            throw;
         }
-
-        // Perform search
-        if (!search(search_strings, command_line_args, archive_reader, *lexer_ptr, use_heuristic)) {
-            return -1;
+        if (false == search_succeeded) {
+            output_merger.abort();
         }
-        archive_reader.close();
+        return search_succeeded;
+    };
+    auto const num_threads = std::max<size_t>(
+            std::min(command_line_args.get_num_threads(), archive_paths.size()),
+            1
+    );
+    vector<std::unique_ptr<SearchThread>> search_threads;
+    for (size_t i = 1; i < num_threads; ++i) {
+        search_threads.emplace_back(std::make_unique<SearchThread>(search_func, search_failed));
+        search_threads.back()->start();
+    }
+    search_func();
+    for (auto& search_thread : search_threads) {
+        search_thread->join();
+    }
+    if (search_failed) {
+        return -1;
     }
 
     global_metadata_db->close();
@@ -1,8 +1,15 @@
 #include "compression.hpp"
 
+#include <algorithm>
+#include <atomic>
 #include <cstring>
+#include <exception>
+#include <functional>
 #include <iostream>
 #include <memory>
+#include <mutex>
+#include <span>
+#include <utility>
 
 #include <archive_entry.h>
 #include <boost/filesystem/operations.hpp>
@@ -12,6 +19,8 @@
 #include "../spdlog_with_specializations.hpp"
 #include "../streaming_archive/writer/Archive.hpp"
 #include "../streaming_archive/writer/utils.hpp"
+#include "../Thread.hpp"
+#include "../TraceableException.hpp"
 #include "../Utils.hpp"
 #include "FileCompressor.hpp"
 #include "utils.hpp"
@@ -22,11 +31,108 @@ using std::cout;
 using std::endl;
 using std::make_unique;
 using std::out_of_range;
+using std::span;
 using std::string;
 using std::unique_ptr;
 using std::vector;
 
 namespace clp::clp {
+namespace {
+/**
+ * A contiguous range of files that must be compressed by the same thread (i.e., into the same
+ * sequence of archives). This is either a single ungrouped file or all files of one group.
+ */
+using WorkUnit = span<FileToCompress const>;
+
+/**
+ * Class to report compression progress from (potentially) multiple threads.
+ */
+class ProgressReporter {
+public:
+    // Constructors
+    ProgressReporter(bool enabled, size_t num_files_to_compress)
+            : m_enabled{enabled},
+              m_num_files_to_compress{num_files_to_compress} {}
+
+    // Methods
+    /**
+     * Records that a file was compressed and prints the progress, if enabled.
+     */
+    auto report_file_compressed() -> void {
+        if (false == m_enabled) {
+            return;
+        }
+        std::lock_guard<std::mutex> const lock{m_mutex};
+        ++m_num_files_compressed;
+        cerr << "Compressed " << m_num_files_compressed << '/' << m_num_files_to_compress
+             << " files" << '\r';
+    }
+
+private:
+    // Variables
+    bool m_enabled;
+    size_t m_num_files_to_compress;
+    size_t m_num_files_compressed{0};
+    std::mutex m_mutex;
+};
+
+/**
+ * Thread that runs a compression function and records whether it succeeded.
+ */
+class CompressionThread : public Thread {
+public:
+    // Constructors
+    explicit CompressionThread(std::function<bool()> compression_func)
+            : m_compression_func{std::move(compression_func)} {}
+
+    // Methods
+    /**
+     * @return Whether the compression function succeeded. Only valid after the thread is joined.
+     */
+    [[nodiscard]] auto succeeded() const -> bool { return m_succeeded; }
+
+protected:
+    // Methods
+    void thread_method() override;
+
+private:
+    // Variables
+    std::function<bool()> m_compression_func;
+    bool m_succeeded{false};
+};
+
+void CompressionThread::thread_method() {
+    // Exceptions can't propagate out of the thread, so we log them here the same way the main
+    // thread would.
+    try {
+        m_succeeded = m_compression_func();
+    } catch (TraceableException& e) {
+        auto const error_code = e.get_error_code();
+        if (ErrorCode_errno == error_code) {
+            SPDLOG_ERROR(
+                    "Compression failed: {}:{} {}, errno={}",
+                    e.get_filename(),
+                    e.get_line_number(),
+                    e.what(),
+                    errno
+            );
+        } else {
+            SPDLOG_ERROR(
+                    "Compression failed: {}:{} {}, error_code={}",
+                    e.get_filename(),
+                    e.get_line_number(),
+                    e.what(),
+                    error_code
+            );
+        }
+        m_succeeded = false;
+    } catch (std::exception& e) {
+        SPDLOG_ERROR("Compression failed: Unexpected exception - {}", e.what());
+        m_succeeded = false;
+    }
+}
+}  // namespace
+
 // Local prototypes
 /**
  * Comparator to sort files based on their group ID
@@ -44,6 +150,45 @@ static bool file_group_id_comparator(FileToCompress const& lhs, FileToCompress c
 static bool
 file_gt_last_write_time_comparator(FileToCompress const& lhs, FileToCompress const& rhs);
 
+/**
+ * Splits the given files into work units, preserving their order. Ungrouped files each form their
+ * own work unit while grouped files form one work unit per group.
+ * @param files_to_compress
+ * @param grouped_files_to_compress Grouped files, sorted by group ID
+ * @return The work units
+ */
+static vector<WorkUnit> create_work_units(
+        vector<FileToCompress> const& files_to_compress,
+        vector<FileToCompress> const& grouped_files_to_compress
+);
+
+/**
+ * Compresses the files of work units into a sequence of archives, claiming work units in order
+ * until none remain. Multiple threads may call this concurrently, each with its own archive config,
+ * file compressor, and UUID generator.
+ * @param command_line_args
+ * @param work_units
+ * @param next_work_unit_idx Index of the next unclaimed work unit, shared between threads
+ * @param empty_directory_paths Empty directories to add to the first archive, if any
+ * @param target_encoded_file_size
+ * @param archive_user_config
+ * @param file_compressor
+ * @param progress_reporter
+ * @param use_heuristic
+ * @return true if all claimed files were compressed successfully, false otherwise
+ */
+static bool compress_work_units(
+        CommandLineArguments const& command_line_args,
+        vector<WorkUnit> const& work_units,
+        std::atomic_size_t& next_work_unit_idx,
+        vector<string> const* empty_directory_paths,
+        size_t target_encoded_file_size,
+        streaming_archive::writer::Archive::UserConfig& archive_user_config,
+        FileCompressor& file_compressor,
+        ProgressReporter& progress_reporter,
+        bool use_heuristic
+);
+
 static bool file_group_id_comparator(FileToCompress const& lhs, FileToCompress const& rhs) {
     return lhs.get_group_id() < rhs.get_group_id();
 }
@@ -54,6 +199,97 @@ file_gt_last_write_time_comparator(FileToCompress const& lhs, FileToCompress con
            > boost::filesystem::last_write_time(rhs.get_path());
 }
 
+static vector<WorkUnit> create_work_units(
+        vector<FileToCompress> const& files_to_compress,
+        vector<FileToCompress> const& grouped_files_to_compress
+) {
+    vector<WorkUnit> work_units;
+    span<FileToCompress const> const files{files_to_compress};
+    for (size_t i = 0; i < files.size(); ++i) {
+        work_units.emplace_back(files.subspan(i, 1));
+    }
+
+    span<FileToCompress const> const grouped_files{grouped_files_to_compress};
+    size_t group_begin_idx = 0;
+    for (size_t i = 1; i <= grouped_files.size(); ++i) {
+        if (grouped_files.size() == i
+            || grouped_files[i].get_group_id() != grouped_files[group_begin_idx].get_group_id())
+        {
+            work_units.emplace_back(grouped_files.subspan(group_begin_idx, i - group_begin_idx));
+            group_begin_idx = i;
+        }
+    }
+    return work_units;
+}
+
+static bool compress_work_units(
+        CommandLineArguments const& command_line_args,
+        vector<WorkUnit> const& work_units,
+        std::atomic_size_t& next_work_unit_idx,
+        vector<string> const* empty_directory_paths,
+        size_t target_encoded_file_size,
+        streaming_archive::writer::Archive::UserConfig& archive_user_config,
+        FileCompressor& file_compressor,
+        ProgressReporter& progress_reporter,
+        bool use_heuristic
+) {
+    streaming_archive::writer::Archive archive_writer;
+    // Set schema file if specified by user
+    if (false == command_line_args.get_use_heuristic()) {
+        archive_writer.m_schema_file_path = command_line_args.get_schema_file_path();
+    }
+
+    // The archive is only opened once there's something to add to it, so that a thread which
+    // doesn't claim any work units doesn't create an empty archive
+    bool is_archive_open = false;
+    auto open_archive = [&]() {
+        if (is_archive_open) {
+            return;
+        }
+        archive_writer.open(archive_user_config);
+        is_archive_open = true;
+    };
+
+    if (nullptr != empty_directory_paths) {
+        open_archive();
+        archive_writer.add_empty_directories(*empty_directory_paths);
+    }
+
+    bool all_files_compressed_successfully = true;
+    auto target_data_size_of_dictionaries
+            = command_line_args.get_target_data_size_of_dictionaries();
+    for (auto work_unit_idx = next_work_unit_idx++; work_unit_idx < work_units.size();
+         work_unit_idx = next_work_unit_idx++)
+    {
+        open_archive();
+        for (auto const& file_to_compress : work_units[work_unit_idx]) {
+            if (archive_writer.get_data_size_of_dictionaries() >= target_data_size_of_dictionaries)
+            {
+                split_archive(archive_user_config, archive_writer);
+            }
+            if (false
+                == file_compressor.compress_file(
+                        target_data_size_of_dictionaries,
+                        archive_user_config,
+                        target_encoded_file_size,
+                        file_to_compress,
+                        archive_writer,
+                        use_heuristic
+                ))
+            {
+                all_files_compressed_successfully = false;
+            }
+            progress_reporter.report_file_compressed();
+        }
+    }
+
+    if (is_archive_open) {
+        archive_writer.close();
+    }
+
+    return all_files_compressed_successfully;
+}
+
 bool compress(
         CommandLineArguments& command_line_args,
         vector<FileToCompress>& files_to_compress,
@@ -81,102 +317,94 @@ bool compress(
     if (nullptr == global_metadata_db) {
         return false;
     }
-
-    auto uuid_generator = boost::uuids::random_generator();
+    std::mutex global_metadata_db_mutex;
 
     // Setup config
-    streaming_archive::writer::Archive::UserConfig archive_user_config;
-    archive_user_config.id = uuid_generator();
-    archive_user_config.creator_id = uuid_generator();
-    archive_user_config.creation_num = 0;
-    archive_user_config.target_segment_uncompressed_size
+    streaming_archive::writer::Archive::UserConfig base_archive_user_config;
+    base_archive_user_config.creation_num = 0;
+    base_archive_user_config.target_segment_uncompressed_size
             = command_line_args.get_target_segment_uncompressed_size();
-    archive_user_config.compression_level = command_line_args.get_compression_level();
-    archive_user_config.output_dir = command_line_args.get_output_dir();
-    archive_user_config.global_metadata_db = global_metadata_db.get();
-    archive_user_config.print_archive_stats_progress
+    base_archive_user_config.compression_level = command_line_args.get_compression_level();
+    base_archive_user_config.output_dir = command_line_args.get_output_dir();
+    base_archive_user_config.global_metadata_db = global_metadata_db.get();
+    base_archive_user_config.global_metadata_db_mutex = &global_metadata_db_mutex;
+    base_archive_user_config.print_archive_stats_progress
             = command_line_args.print_archive_stats_progress();
+    base_archive_user_config.build_dictionary_substring_indexes
+            = command_line_args.build_dictionary_substring_indexes();
 
-    // Open Archive
-    streaming_archive::writer::Archive archive_writer;
-    // Set schema file if specified by user
-    if (false == command_line_args.get_use_heuristic()) {
-        archive_writer.m_schema_file_path = command_line_args.get_schema_file_path();
-    }
-    // Open archive
-    archive_writer.open(archive_user_config);
-
-    archive_writer.add_empty_directories(empty_directory_paths);
-
-    bool all_files_compressed_successfully = true;
-    FileCompressor file_compressor(uuid_generator, std::move(reader_parser));
-    auto target_data_size_of_dictionaries
-            = command_line_args.get_target_data_size_of_dictionaries();
-
-    // Compress all files
-    size_t num_files_compressed = 0;
-    size_t num_files_to_compress = 0;
-    if (command_line_args.show_progress()) {
-        num_files_to_compress = files_to_compress.size() + grouped_files_to_compress.size();
-    }
     if (command_line_args.sort_input_files()) {
         sort(files_to_compress.begin(),
              files_to_compress.end(),
              file_gt_last_write_time_comparator);
     }
-    for (auto it = files_to_compress.cbegin(); it != files_to_compress.cend(); ++it) {
-        if (archive_writer.get_data_size_of_dictionaries() >= target_data_size_of_dictionaries) {
-            split_archive(archive_user_config, archive_writer);
-        }
-        if (false
-            == file_compressor.compress_file(
-                    target_data_size_of_dictionaries,
-                    archive_user_config,
-                    target_encoded_file_size,
-                    *it,
-                    archive_writer,
-                    use_heuristic
-            ))
-        {
-            all_files_compressed_successfully = false;
-        }
-        if (command_line_args.show_progress()) {
-            ++num_files_compressed;
-            cerr << "Compressed " << num_files_compressed << '/' << num_files_to_compress
-                 << " files" << '\r';
-        }
-    }
-
     // Sort files by group ID to avoid spreading groups over multiple segments
     sort(grouped_files_to_compress.begin(),
          grouped_files_to_compress.end(),
          file_group_id_comparator);
-    // Compress grouped files
-    for (auto const& file_to_compress : grouped_files_to_compress) {
-        if (archive_writer.get_data_size_of_dictionaries() >= target_data_size_of_dictionaries) {
-            split_archive(archive_user_config, archive_writer);
+    auto const work_units = create_work_units(files_to_compress, grouped_files_to_compress);
+    std::atomic_size_t next_work_unit_idx{0};
+
+    ProgressReporter progress_reporter(
+            command_line_args.show_progress(),
+            files_to_compress.size() + grouped_files_to_compress.size()
+    );
+
+    // Each thread compresses into its own sequence of archives, so it needs its own archive config
+    // (with a distinct creator ID), file compressor, and reader-parser. Since threads claim work
+    // units in order, running a single thread compresses files in the same order as before.
+    auto const num_threads = std::max<size_t>(
+            1,
+            std::min(command_line_args.get_num_threads(), work_units.size())
+    );
+    vector<unique_ptr<log_surgeon::ReaderParser>> reader_parsers(num_threads);
+    reader_parsers[0] = std::move(reader_parser);
+    if (false == use_heuristic) {
+        for (size_t i = 1; i < num_threads; ++i) {
+            reader_parsers[i] = make_unique<log_surgeon::ReaderParser>(
+                    command_line_args.get_schema_file_path()
+            );
         }
-        if (false
-            == file_compressor.compress_file(
-                    target_data_size_of_dictionaries,
-                    archive_user_config,
-                    target_encoded_file_size,
-                    file_to_compress,
-                    archive_writer,
-                    use_heuristic
-            ))
-        {
+    }
+
+    auto compress_with_own_archives = [&](size_t thread_idx) -> bool {
+        auto uuid_generator = boost::uuids::random_generator();
+        auto archive_user_config = base_archive_user_config;
+        archive_user_config.id = uuid_generator();
+        archive_user_config.creator_id = uuid_generator();
+
+        FileCompressor file_compressor(uuid_generator, std::move(reader_parsers[thread_idx]));
+        return compress_work_units(
+                command_line_args,
+                work_units,
+                next_work_unit_idx,
+                0 == thread_idx ? &empty_directory_paths : nullptr,
+                target_encoded_file_size,
+                archive_user_config,
+                file_compressor,
+                progress_reporter,
+                use_heuristic
+        );
+    };
+
+    vector<unique_ptr<CompressionThread>> compression_threads;
+    for (size_t i = 1; i < num_threads; ++i) {
+        compression_threads.emplace_back(make_unique<CompressionThread>(
+                [&compress_with_own_archives, i]() -> bool { return compress_with_own_archives(i); }
+        ));
+        compression_threads.back()->start();
+    }
+
+    // The calling thread acts as the first compression thread. If it throws, the remaining threads
+    // are joined when they're destroyed.
+    bool all_files_compressed_successfully = compress_with_own_archives(0);
+    for (auto& compression_thread : compression_threads) {
+        compression_thread->join();
+        if (false == compression_thread->succeeded()) {
             all_files_compressed_successfully = false;
         }
-        if (command_line_args.show_progress()) {
-            ++num_files_compressed;
-            cerr << "Compressed " << num_files_compressed << '/' << num_files_to_compress
-                 << " files" << '\r';
-        }
     }
 
-    archive_writer.close();
-
     return all_files_compressed_successfully;
 }
 
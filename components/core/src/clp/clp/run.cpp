@@ -21,7 +21,8 @@ namespace clp::clp {
 int run(int argc, char const* argv[]) {
     // Program-wide initialization
     try {
-        auto stderr_logger = spdlog::stderr_logger_st("stderr");
+        // NOTE: We use a thread-safe logger since compression may run on multiple threads
+        auto stderr_logger = spdlog::stderr_logger_mt("stderr");
         spdlog::set_default_logger(stderr_logger);
         spdlog::set_pattern("%Y-%m-%d %H:%M:%S,%e [%l] %v");
     } catch (std::exception& e) {
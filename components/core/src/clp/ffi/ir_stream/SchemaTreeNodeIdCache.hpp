@@ -0,0 +1,87 @@
+#ifndef CLP_FFI_IR_STREAM_SCHEMATREENODEIDCACHE_HPP
+#define CLP_FFI_IR_STREAM_SCHEMATREENODEIDCACHE_HPP
+
+#include <cstddef>
+#include <utility>
+#include <vector>
+
+#include "../SchemaTree.hpp"
+
+namespace clp::ffi::ir_stream {
+/**
+ * Class that caches the schema-tree node IDs resolved while serializing the previous log event, so
+ * that log events sharing the same schema shape can skip searching the schema tree.
+ *
+ * The cache records the node IDs in the order they're resolved during a log event's depth-first
+ * traversal. When the next log event is traversed, each key is first compared against the cached
+ * node at the same position; only on a mismatch does the cache fall back to
+ * `SchemaTree::try_get_node_id` (which linearly scans the parent's children) and start recording
+ * the new shape from that position.
+ *
+ * NOTE: The cached IDs are only valid for the schema tree they were resolved from. Callers must
+ * call `clear` whenever the schema tree is reverted.
+ */
+class SchemaTreeNodeIdCache {
+public:
+    // Methods
+    /**
+     * Rewinds the cache to the beginning of the cached shape. This should be called before
+     * traversing each log event.
+     */
+    auto rewind() -> void { m_curr_pos = 0; }
+
+    /**
+     * Clears the cached shape.
+     */
+    auto clear() -> void {
+        m_node_ids.clear();
+        m_curr_pos = 0;
+    }
+
+    /**
+     * Gets the ID of the node identified by the given locator, inserting the node into the schema
+     * tree if it doesn't exist.
+     * @param schema_tree
+     * @param locator
+     * @return A pair:
+     * - The ID of the node.
+     * - Whether the node was newly inserted into the schema tree.
+     */
+    [[nodiscard]] auto
+    get_or_insert_node_id(SchemaTree& schema_tree, SchemaTree::NodeLocator const& locator)
+            -> std::pair<SchemaTree::Node::id_t, bool> {
+        if (m_curr_pos < m_node_ids.size()) {
+            auto const cached_node_id{m_node_ids[m_curr_pos]};
+            auto const& cached_node{schema_tree.get_node(cached_node_id)};
+            if (cached_node.get_parent_id() == locator.get_parent_id()
+                && cached_node.get_type() == locator.get_type()
+                && cached_node.get_key_name() == locator.get_key_name())
+            {
+                ++m_curr_pos;
+                return {cached_node_id, false};
+            }
+
+            // The shape diverges from here, so discard the rest of the cached shape
+            m_node_ids.resize(m_curr_pos);
+        }
+
+        bool is_new_node{false};
+        auto optional_node_id{schema_tree.try_get_node_id(locator)};
+        if (false == optional_node_id.has_value()) {
+            optional_node_id.emplace(schema_tree.insert_node(locator));
+            is_new_node = true;
+        }
+        auto const node_id{optional_node_id.value()};
+        m_node_ids.push_back(node_id);
+        ++m_curr_pos;
+        return {node_id, is_new_node};
+    }
+
+private:
+    // Variables
+    std::vector<SchemaTree::Node::id_t> m_node_ids;
+    size_t m_curr_pos{0};
+};
+}  // namespace clp::ffi::ir_stream
+
+#endif  // CLP_FFI_IR_STREAM_SCHEMATREENODEIDCACHE_HPP
@@ -1,5 +1,6 @@
 #include "Serializer.hpp"
 
+#include <algorithm>
 #include <concepts>
 #include <cstdint>
 #include <optional>
@@ -22,6 +23,7 @@
 #include "../SchemaTree.hpp"
 #include "encoding_methods.hpp"
 #include "protocol_constants.hpp"
+#include "SchemaTreeNodeIdCache.hpp"
 #include "utils.hpp"
 
 using std::optional;
@@ -237,6 +239,7 @@ template <typename encoded_variable_t>
  * @tparam EmptyMapSerializationMethod
  * @param msgpack_map
  * @param schema_tree
+ * @param node_id_cache The node ID cache of `schema_tree`, used to resolve schema-tree node IDs.
  * @param schema_tree_node_serialization_method
  * @param node_id_value_pair_serialization_method
  * @param empty_map_serialization_method
@@ -255,6 +258,7 @@ template <
 [[nodiscard]] auto serialize_msgpack_map_using_dfs(
         msgpack::object_map const& msgpack_map,
         SchemaTree& schema_tree,
+        SchemaTreeNodeIdCache& node_id_cache,
         SchemaTreeNodeSerializationMethod schema_tree_node_serialization_method,
         NodeIdValuePairSerializationMethod node_id_value_pair_serialization_method,
         EmptyMapSerializationMethod empty_map_serialization_method
@@ -447,10 +451,12 @@ template <
 [[nodiscard]] auto serialize_msgpack_map_using_dfs(
         msgpack::object_map const& msgpack_map,
         SchemaTree& schema_tree,
+        SchemaTreeNodeIdCache& node_id_cache,
         SchemaTreeNodeSerializationMethod schema_tree_node_serialization_method,
         NodeIdValuePairSerializationMethod node_id_value_pair_serialization_method,
         EmptyMapSerializationMethod empty_map_serialization_method
 ) -> ystdlib::error_handling::Result<void> {
+    node_id_cache.rewind();
     vector<MsgpackMapIterator> dfs_stack;
     dfs_stack.emplace_back(
             SchemaTree::cRootId,
@@ -482,12 +488,12 @@ template <
 
         // Get the schema-tree node that corresponds with the current kv-pair, or add it if it
         // doesn't exist.
-        auto opt_schema_tree_node_id{schema_tree.try_get_node_id(locator)};
-        if (false == opt_schema_tree_node_id.has_value()) {
-            opt_schema_tree_node_id.emplace(schema_tree.insert_node(locator));
+        auto const [schema_tree_node_id, is_new_node]{
+                node_id_cache.get_or_insert_node_id(schema_tree, locator)
+        };
+        if (is_new_node) {
             YSTDLIB_ERROR_HANDLING_TRYV(schema_tree_node_serialization_method(locator));
         }
-        auto const schema_tree_node_id{opt_schema_tree_node_id.value()};
 
         if (msgpack::type::MAP == val.type) {
             // Serialize map
@@ -576,16 +582,73 @@ auto Serializer<encoded_variable_t>::serialize_msgpack_map(
         msgpack::object_map const& auto_gen_kv_pairs_map,
         msgpack::object_map const& user_gen_kv_pairs_map
 ) -> ystdlib::error_handling::Result<void> {
+    m_auto_gen_keys_schema_tree.take_snapshot();
+    m_user_gen_keys_schema_tree.take_snapshot();
+    TransactionManager revert_manager{
+            []() noexcept -> void {},
+            [&]() noexcept -> void { revert_schema_trees(); }
+    };
+
+    YSTDLIB_ERROR_HANDLING_TRYV(
+            serialize_msgpack_map_pair(auto_gen_kv_pairs_map, user_gen_kv_pairs_map)
+    );
+
+    revert_manager.mark_success();
+    return success();
+}
+
+template <typename encoded_variable_t>
+auto Serializer<encoded_variable_t>::serialize_msgpack_map_batch(
+        span<MsgpackMapPair const> kv_pairs_maps
+) -> ystdlib::error_handling::Result<void> {
+    if (kv_pairs_maps.empty()) {
+        return success();
+    }
+
+    auto const ir_buf_size_before_batch{m_ir_buf.size()};
     m_auto_gen_keys_schema_tree.take_snapshot();
     m_user_gen_keys_schema_tree.take_snapshot();
     TransactionManager revert_manager{
             []() noexcept -> void {},
             [&]() noexcept -> void {
-                m_user_gen_keys_schema_tree.revert();
-                m_auto_gen_keys_schema_tree.revert();
+                revert_schema_trees();
+                m_ir_buf.resize(ir_buf_size_before_batch);
             }
     };
 
+    auto const& [first_auto_gen_kv_pairs_map, first_user_gen_kv_pairs_map]{kv_pairs_maps.front()};
+    YSTDLIB_ERROR_HANDLING_TRYV(
+            serialize_msgpack_map_pair(first_auto_gen_kv_pairs_map, first_user_gen_kv_pairs_map)
+    );
+
+    // Log events in a batch typically share the same schema shape, so we use the size of the first
+    // serialized log event to estimate the size of the entire batch. The first log event may also
+    // contain schema-tree node insertions, which makes the estimate slightly conservative.
+    auto const first_log_event_size{m_ir_buf.size() - ir_buf_size_before_batch};
+    auto const estimated_ir_buf_size{
+            ir_buf_size_before_batch + first_log_event_size * kv_pairs_maps.size()
+    };
+    // Grow geometrically so that serializing many batches into the same buffer doesn't reallocate
+    // it for every batch.
+    if (estimated_ir_buf_size > m_ir_buf.capacity()) {
+        m_ir_buf.reserve(std::max(estimated_ir_buf_size, 2 * m_ir_buf.capacity()));
+    }
+
+    for (auto const& [auto_gen_kv_pairs_map, user_gen_kv_pairs_map] : kv_pairs_maps.subspan(1)) {
+        YSTDLIB_ERROR_HANDLING_TRYV(
+                serialize_msgpack_map_pair(auto_gen_kv_pairs_map, user_gen_kv_pairs_map)
+        );
+    }
+
+    revert_manager.mark_success();
+    return success();
+}
+
+template <typename encoded_variable_t>
+auto Serializer<encoded_variable_t>::serialize_msgpack_map_pair(
+        msgpack::object_map const& auto_gen_kv_pairs_map,
+        msgpack::object_map const& user_gen_kv_pairs_map
+) -> ystdlib::error_handling::Result<void> {
     m_schema_tree_node_buf.clear();
     m_sequential_serialization_buf.clear();
     m_user_gen_val_group_buf.clear();
@@ -639,6 +702,7 @@ auto Serializer<encoded_variable_t>::serialize_msgpack_map(
         YSTDLIB_ERROR_HANDLING_TRYV(serialize_msgpack_map_using_dfs(
                 auto_gen_kv_pairs_map,
                 m_auto_gen_keys_schema_tree,
+                m_auto_gen_node_id_cache,
                 auto_gen_schema_tree_node_serialization_method,
                 auto_gen_node_id_value_pairs_serialization_method,
                 auto_gen_empty_map_serialization_method
@@ -696,6 +760,7 @@ auto Serializer<encoded_variable_t>::serialize_msgpack_map(
         YSTDLIB_ERROR_HANDLING_TRYV(serialize_msgpack_map_using_dfs(
                 user_gen_kv_pairs_map,
                 m_user_gen_keys_schema_tree,
+                m_user_gen_node_id_cache,
                 user_gen_schema_tree_node_serialization_method,
                 user_gen_node_id_value_pairs_serialization_method,
                 user_gen_empty_map_serialization_method
@@ -719,10 +784,17 @@ auto Serializer<encoded_variable_t>::serialize_msgpack_map(
             m_user_gen_val_group_buf.cend()
     );
 
-    revert_manager.mark_success();
     return success();
 }
 
+template <typename encoded_variable_t>
+auto Serializer<encoded_variable_t>::revert_schema_trees() noexcept -> void {
+    m_user_gen_keys_schema_tree.revert();
+    m_auto_gen_keys_schema_tree.revert();
+    m_user_gen_node_id_cache.clear();
+    m_auto_gen_node_id_cache.clear();
+}
+
 template <typename encoded_variable_t>
 template <bool is_auto_generated_node>
 auto Serializer<encoded_variable_t>::serialize_schema_tree_node(
@@ -788,6 +860,25 @@ template auto Serializer<four_byte_encoded_variable_t>::serialize_msgpack_map(
         msgpack::object_map const& user_gen_kv_pairs_map
 ) -> ystdlib::error_handling::Result<void>;
 
+template auto Serializer<eight_byte_encoded_variable_t>::serialize_msgpack_map_batch(
+        span<MsgpackMapPair const> kv_pairs_maps
+) -> ystdlib::error_handling::Result<void>;
+template auto Serializer<four_byte_encoded_variable_t>::serialize_msgpack_map_batch(
+        span<MsgpackMapPair const> kv_pairs_maps
+) -> ystdlib::error_handling::Result<void>;
+
+template auto Serializer<eight_byte_encoded_variable_t>::serialize_msgpack_map_pair(
+        msgpack::object_map const& auto_gen_kv_pairs_map,
+        msgpack::object_map const& user_gen_kv_pairs_map
+) -> ystdlib::error_handling::Result<void>;
+template auto Serializer<four_byte_encoded_variable_t>::serialize_msgpack_map_pair(
+        msgpack::object_map const& auto_gen_kv_pairs_map,
+        msgpack::object_map const& user_gen_kv_pairs_map
+) -> ystdlib::error_handling::Result<void>;
+
+template auto Serializer<eight_byte_encoded_variable_t>::revert_schema_trees() noexcept -> void;
+template auto Serializer<four_byte_encoded_variable_t>::revert_schema_trees() noexcept -> void;
+
 template auto Serializer<eight_byte_encoded_variable_t>::serialize_schema_tree_node<true>(
         SchemaTree::NodeLocator const& locator
 ) -> ystdlib::error_handling::Result<void>;
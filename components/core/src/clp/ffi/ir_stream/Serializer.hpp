@@ -5,6 +5,7 @@
 #include <optional>
 #include <span>
 #include <string>
+#include <utility>
 #include <vector>
 
 #include <msgpack.hpp>
@@ -14,6 +15,7 @@
 #include "../../time_types.hpp"
 #include "../SchemaTree.hpp"
 #include "IrSerializationError.hpp"
+#include "SchemaTreeNodeIdCache.hpp"
 
 namespace clp::ffi::ir_stream {
 /**
@@ -39,6 +41,11 @@ public:
     using Buffer = std::vector<int8_t>;
     using BufferView = std::span<int8_t const>;
 
+    /**
+     * A log event's auto-generated and user-generated kv-pairs, given as msgpack maps.
+     */
+    using MsgpackMapPair = std::pair<msgpack::object_map, msgpack::object_map>;
+
     // Factory functions
     /**
      * Creates an IR serializer and serializes the stream's preamble.
@@ -95,19 +102,58 @@ public:
      * @param auto_gen_kv_pairs_map
      * @param user_gen_kv_pairs_map
      * @return A void result on success, or an error code indicating the failure:
-     * - Forwards `serialize_schema_tree_node`'s return values on failure.
-     * - Forwards `serialize_msgpack_map_using_dfs`'s return values on failure.
+     * - Forwards `serialize_msgpack_map_pair`'s return values on failure.
      */
     [[nodiscard]] auto serialize_msgpack_map(
             msgpack::object_map const& auto_gen_kv_pairs_map,
             msgpack::object_map const& user_gen_kv_pairs_map
     ) -> ystdlib::error_handling::Result<void>;
 
+    /**
+     * Serializes the given msgpack map pairs as a batch of key-value pair log events.
+     *
+     * Compared to calling `serialize_msgpack_map` for each log event, this method reserves space in
+     * the IR buffer for the entire batch (estimated from the batch's first log event) so that the
+     * buffer isn't repeatedly reallocated.
+     *
+     * NOTE: The batch is serialized atomically. If any log event fails to be serialized, both the IR
+     * buffer and the schema trees are reverted to their states before this method was called.
+     * @param kv_pairs_maps
+     * @return A void result on success, or an error code indicating the failure:
+     * - Forwards `serialize_msgpack_map_pair`'s return values on failure.
+     */
+    [[nodiscard]] auto serialize_msgpack_map_batch(std::span<MsgpackMapPair const> kv_pairs_maps)
+            -> ystdlib::error_handling::Result<void>;
+
 private:
     // Constructors
     Serializer() = default;
 
     // Methods
+    /**
+     * Serializes the given msgpack maps as a key-value pair log event, appending the serialized
+     * bytes to `m_ir_buf` only if serialization succeeds.
+     *
+     * NOTE: This method doesn't revert the schema trees on failure; callers are responsible for
+     * taking snapshots of the schema trees and reverting them (along with clearing the node ID
+     * caches) on failure.
+     * @param auto_gen_kv_pairs_map
+     * @param user_gen_kv_pairs_map
+     * @return A void result on success, or an error code indicating the failure:
+     * - Forwards `serialize_schema_tree_node`'s return values on failure.
+     * - Forwards `serialize_msgpack_map_using_dfs`'s return values on failure.
+     */
+    [[nodiscard]] auto serialize_msgpack_map_pair(
+            msgpack::object_map const& auto_gen_kv_pairs_map,
+            msgpack::object_map const& user_gen_kv_pairs_map
+    ) -> ystdlib::error_handling::Result<void>;
+
+    /**
+     * Reverts the schema trees to their last snapshots and clears the node ID caches that may
+     * reference reverted nodes.
+     */
+    auto revert_schema_trees() noexcept -> void;
+
     /**
      * Serializes a schema tree node identified by the given locator into `m_schema_tree_node_buf`.
      * @tparam is_auto_generated_node
@@ -126,6 +172,8 @@ private:
     Buffer m_ir_buf;
     SchemaTree m_auto_gen_keys_schema_tree;
     SchemaTree m_user_gen_keys_schema_tree;
+    SchemaTreeNodeIdCache m_auto_gen_node_id_cache;
+    SchemaTreeNodeIdCache m_user_gen_node_id_cache;
 
     std::string m_logtype_buf;
     Buffer m_schema_tree_node_buf;
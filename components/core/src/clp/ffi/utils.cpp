@@ -84,7 +84,7 @@ auto validate_and_append_escaped_utf8_string(std::string_view src, std::string&
         }
     };
 
-    if (false == validate_utf8_string(src, escape_handler)) {
+    if (false == validate_utf8_string_for_json(src, escape_handler)) {
         return false;
     }
 
@@ -10,6 +10,9 @@ constexpr char cLogTypeDictFilename[] = "logtype.dict";
 constexpr char cVarDictFilename[] = "var.dict";
 constexpr char cLogTypeSegmentIndexFilename[] = "logtype.segindex";
 constexpr char cVarSegmentIndexFilename[] = "var.segindex";
+constexpr char cLogTypeSubstringIndexFilename[] = "logtype.substrindex";
+constexpr char cVarSubstringIndexFilename[] = "var.substrindex";
+constexpr char cFilePostingListsFilename[] = "file.postings";
 constexpr char cMetadataFileName[] = "metadata";
 constexpr char cMetadataDBFileName[] = "metadata.db";
 constexpr char cSchemaFileName[] = "schema.txt";
@@ -23,6 +26,7 @@ constexpr archive_format_version_t Version{VersionMajor << 24 | VersionMinor <<
 
 namespace cMetadataDB {
 constexpr char ArchivesTableName[] = "archives";
+constexpr char ArchivesTimeIndexTableName[] = "archives_time_index";
 constexpr char FilesTableName[] = "files";
 constexpr char EmptyDirectoriesTableName[] = "empty_directories";
 
@@ -36,6 +40,13 @@ constexpr char CreatorId[] = "creator_id";
 constexpr char CreationIx[] = "creation_ix";
 }  // namespace Archive
 
+namespace ArchiveTimeIndex {
+constexpr char Id[] = "id";
+constexpr char BeginTimestamp[] = "begin_timestamp";
+constexpr char EndTimestamp[] = "end_timestamp";
+constexpr char ArchiveId[] = "archive_id";
+}  // namespace ArchiveTimeIndex
+
 namespace File {
 constexpr char Id[] = "id";
 constexpr char OrigFileId[] = "orig_file_id";
@@ -97,6 +97,13 @@ void Archive::open(string const& path) {
     var_segment_index_path += cVarSegmentIndexFilename;
     m_var_dictionary.open(var_dict_path, var_segment_index_path);
 
+    // Read file posting lists if the archive has them
+    auto const file_posting_lists_path
+            = boost::filesystem::path(m_path) / cFilePostingListsFilename;
+    if (boost::filesystem::exists(file_posting_lists_path)) {
+        m_file_posting_lists.read_from_file(file_posting_lists_path.string());
+    }
+
     // Open segment manager
     m_segments_dir_path = m_path;
     m_segments_dir_path += '/';
@@ -112,6 +119,7 @@ void Archive::open(string const& path) {
 void Archive::close() {
     m_logtype_dictionary.close();
     m_var_dictionary.close();
+    m_file_posting_lists.clear();
     m_segment_manager.close();
     m_segments_dir_path.clear();
     m_metadata_db.close();
@@ -121,6 +129,21 @@ void Archive::close() {
 void Archive::refresh_dictionaries() {
     m_logtype_dictionary.read_new_entries();
     m_var_dictionary.read_new_entries();
+
+    // Read the dictionaries' substring indexes if the archive has them
+    auto const archive_path = boost::filesystem::path(m_path);
+    if (false == m_logtype_dictionary.has_substring_index()) {
+        auto const substring_index_path = archive_path / cLogTypeSubstringIndexFilename;
+        if (boost::filesystem::exists(substring_index_path)) {
+            m_logtype_dictionary.read_substring_index(substring_index_path.string());
+        }
+    }
+    if (false == m_var_dictionary.has_substring_index()) {
+        auto const substring_index_path = archive_path / cVarSubstringIndexFilename;
+        if (boost::filesystem::exists(substring_index_path)) {
+            m_var_dictionary.read_substring_index(substring_index_path.string());
+        }
+    }
 }
 
 ErrorCode Archive::open_file(File& file, MetadataDB::FileIterator const& file_metadata_ix) {
@@ -15,6 +15,7 @@
 #include "../../VariableDictionaryReader.hpp"
 #include "../MetadataDB.hpp"
 #include "File.hpp"
+#include "FilePostingLists.hpp"
 #include "Message.hpp"
 
 namespace clp::streaming_archive::reader {
@@ -40,18 +41,27 @@ public:
      * @throw streaming_archive::reader::Archive::OperationFailed if could not stat file or it
      * isn't a directory or metadata is corrupted
      * @throw FileReader::OperationFailed if failed to open any dictionary
+     * @throw FilePostingLists::OperationFailed if the file posting lists are corrupt
      */
     void open(std::string const& path);
     void close();
 
     /**
-     * Reads any new entries added to the dictionaries
+     * Reads any new entries added to the dictionaries, along with the dictionaries' substring
+     * indexes if they exist and haven't been read yet
      * @throw Same as LogTypeDictionary::read_from_file and VariableDictionary::read_from_file
+     * @throw DictionarySubstringIndex::OperationFailed if a substring index is corrupt
      */
     void refresh_dictionaries();
     LogTypeDictionaryReader const& get_logtype_dictionary() const;
     VariableDictionaryReader const& get_var_dictionary() const;
 
+    /**
+     * @return The archive's per-file posting lists, which are empty if the archive doesn't have
+     * any
+     */
+    FilePostingLists const& get_file_posting_lists() const { return m_file_posting_lists; }
+
     /**
      * Opens file with given path
      * @param file
@@ -193,6 +203,7 @@ private:
     std::string m_segments_dir_path;
     LogTypeDictionaryReader m_logtype_dictionary;
     VariableDictionaryReader m_var_dictionary;
+    FilePostingLists m_file_posting_lists;
 
     SegmentManager m_segment_manager;
 
@@ -0,0 +1,84 @@
+#include "FilePostingLists.hpp"
+
+#include <algorithm>
+#include <cstdint>
+#include <functional>
+#include <string>
+#include <vector>
+
+#include "../../FileReader.hpp"
+#include "../../streaming_compression/passthrough/Decompressor.hpp"
+#include "../../streaming_compression/zstd/Decompressor.hpp"
+
+namespace clp::streaming_archive::reader {
+namespace {
+/**
+ * Reads a list of IDs preceded by the number of IDs, validating that they're in ascending order
+ * @tparam IdType
+ * @param decompressor
+ * @param ids Returns the IDs
+ * @throw FilePostingLists::OperationFailed if the IDs aren't in ascending order
+ * @throw Same as ReaderInterface::read_numeric_value
+ */
+template <typename IdType>
+void read_sorted_ids(ReaderInterface& decompressor, std::vector<IdType>& ids);
+
+template <typename IdType>
+void read_sorted_ids(ReaderInterface& decompressor, std::vector<IdType>& ids) {
+    uint64_t num_ids{0};
+    decompressor.read_numeric_value(num_ids, false);
+    ids.resize(num_ids);
+    for (auto& id : ids) {
+        decompressor.read_numeric_value(id, false);
+    }
+    if (std::adjacent_find(ids.cbegin(), ids.cend(), std::greater_equal<IdType>{}) != ids.cend())
+    {
+        throw FilePostingLists::OperationFailed(ErrorCode_Corrupt, __FILENAME__, __LINE__);
+    }
+}
+}  // namespace
+
+void FilePostingLists::read_from_file(std::string const& path) {
+    constexpr size_t cDecompressorFileReadBufferCapacity = 64 * 1024;  // 64 KiB
+
+    m_file_id_to_posting_list.clear();
+
+    FileReader file_reader{path};
+    uint64_t num_files{0};
+    file_reader.read_numeric_value(num_files, false);
+    if (0 == num_files) {
+        return;
+    }
+
+#if USE_PASSTHROUGH_COMPRESSION
+    streaming_compression::passthrough::Decompressor decompressor;
+#elif USE_ZSTD_COMPRESSION
+    streaming_compression::zstd::Decompressor decompressor;
+#else
+    static_assert(false, "Unsupported compression mode.");
+#endif
+    decompressor.open(file_reader, cDecompressorFileReadBufferCapacity);
+
+    std::string file_id;
+    for (uint64_t i = 0; i < num_files; ++i) {
+        uint64_t file_id_length{0};
+        decompressor.read_numeric_value(file_id_length, false);
+        decompressor.read_string(file_id_length, file_id, false);
+
+        auto& posting_list = m_file_id_to_posting_list[file_id];
+        read_sorted_ids(decompressor, posting_list.logtype_ids);
+        read_sorted_ids(decompressor, posting_list.var_ids);
+    }
+
+    decompressor.close();
+}
+
+FilePostingLists::PostingList const* FilePostingLists::get_posting_list(std::string const& file_id
+) const {
+    auto const it = m_file_id_to_posting_list.find(file_id);
+    if (m_file_id_to_posting_list.cend() == it) {
+        return nullptr;
+    }
+    return &it->second;
+}
+}  // namespace clp::streaming_archive::reader
@@ -0,0 +1,65 @@
+#ifndef CLP_STREAMING_ARCHIVE_READER_FILEPOSTINGLISTS_HPP
+#define CLP_STREAMING_ARCHIVE_READER_FILEPOSTINGLISTS_HPP
+
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+#include "../../Defs.h"
+#include "../../ErrorCode.hpp"
+#include "../../TraceableException.hpp"
+
+namespace clp::streaming_archive::reader {
+/**
+ * Class for reading an archive's per-file posting lists (see
+ * streaming_archive::writer::FilePostingLists for the format)
+ */
+class FilePostingLists {
+public:
+    // Types
+    class OperationFailed : public TraceableException {
+    public:
+        // Constructors
+        OperationFailed(ErrorCode error_code, char const* const filename, int line_number)
+                : TraceableException(error_code, filename, line_number) {}
+
+        // Methods
+        char const* what() const noexcept override {
+            return "streaming_archive::reader::FilePostingLists operation failed";
+        }
+    };
+
+    /**
+     * IDs of the logtypes and dictionary variables that occur in a file, in ascending order
+     */
+    struct PostingList {
+        std::vector<logtype_dictionary_id_t> logtype_ids;
+        std::vector<variable_dictionary_id_t> var_ids;
+    };
+
+    // Methods
+    /**
+     * Reads the posting lists from the given file, replacing any that were previously read
+     * @param path
+     * @throw streaming_archive::reader::FilePostingLists::OperationFailed if the file is corrupt
+     * @throw FileReader::OperationFailed if reading the file fails
+     */
+    void read_from_file(std::string const& path);
+
+    void clear() { m_file_id_to_posting_list.clear(); }
+
+    bool empty() const { return m_file_id_to_posting_list.empty(); }
+
+    /**
+     * @param file_id
+     * @return The posting list of the given file, or nullptr if there is none
+     */
+    PostingList const* get_posting_list(std::string const& file_id) const;
+
+private:
+    // Variables
+    std::unordered_map<std::string, PostingList> m_file_id_to_posting_list;
+};
+}  // namespace clp::streaming_archive::reader
+
+#endif  // CLP_STREAMING_ARCHIVE_READER_FILEPOSTINGLISTS_HPP
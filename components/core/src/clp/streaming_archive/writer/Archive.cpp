@@ -4,6 +4,7 @@
 
 #include <cstdint>
 #include <filesystem>
+#include <mutex>
 #include <stdexcept>
 #include <string>
 #include <system_error>
@@ -58,6 +59,8 @@ void Archive::open(UserConfig const& user_config) {
     m_creator_id_as_string = boost::uuids::to_string(m_creator_id);
     m_creation_num = user_config.creation_num;
     m_print_archive_stats_progress = user_config.print_archive_stats_progress;
+    m_build_dictionary_substring_indexes = user_config.build_dictionary_substring_indexes;
+    m_dictionary_substring_indexes_size = 0;
 
     std::error_code std_error_code;
 
@@ -124,6 +127,11 @@ void Archive::open(UserConfig const& user_config) {
     m_next_segment_id = 0;
     m_compression_level = user_config.compression_level;
 
+    m_file_posting_lists.open(
+            archive_path_string + '/' + cFilePostingListsFilename,
+            m_compression_level
+    );
+
     /// TODO: add schema file size to m_stable_size???
     // Copy schema file into archive
     if (!m_schema_file_path.empty()) {
@@ -158,6 +166,7 @@ void Archive::open(UserConfig const& user_config) {
     }
 
     m_global_metadata_db = user_config.global_metadata_db;
+    m_global_metadata_db_mutex = user_config.global_metadata_db_mutex;
 
     m_file = nullptr;
 
@@ -220,12 +229,22 @@ void Archive::close() {
         m_var_ids_in_segment_for_files_without_timestamps.clear();
     }
 
+    // Build the dictionaries' substring indexes now that no more entries will be added
+    if (m_build_dictionary_substring_indexes) {
+        m_dictionary_substring_indexes_size = m_logtype_dict.write_substring_index(
+                m_path + '/' + cLogTypeSubstringIndexFilename
+        );
+        m_dictionary_substring_indexes_size
+                += m_var_dict.write_substring_index(m_path + '/' + cVarSubstringIndexFilename);
+    }
+
     // Persist all metadata including dictionaries
     write_dir_snapshot();
 
     m_logtype_dict.close();
     m_logtype_dict_entry.clear();
     m_var_dict.close();
+    m_file_posting_lists.close();
 
     if (::close(m_segments_dir_fd) != 0) {
         // We've already fsynced, so this error shouldn't affect us. Therefore, just log it.
@@ -238,6 +257,7 @@ void Archive::close() {
 
     update_global_metadata();
     m_global_metadata_db = nullptr;
+    m_global_metadata_db_mutex = nullptr;
 
     for (auto* file : m_file_metadata_for_global_update) {
         delete file;
@@ -553,6 +573,8 @@ void Archive::update_segment_indices(
         logtype_dictionary_id_t logtype_id,
         vector<variable_dictionary_id_t> const& var_ids
 ) {
+    m_logtype_ids_in_file.insert(logtype_id);
+    m_var_ids_in_file.insert(var_ids.cbegin(), var_ids.cend());
     if (m_file->has_ts_pattern()) {
         m_logtype_ids_in_segment_for_files_with_timestamps.insert(logtype_id);
         m_var_ids_in_segment_for_files_with_timestamps.insert_all(var_ids);
@@ -624,6 +646,13 @@ void Archive::append_file_to_segment() {
     }
     m_logtype_ids_for_file_with_unassigned_segment.clear();
     m_var_ids_for_file_with_unassigned_segment.clear();
+    m_file_posting_lists.add_file(
+            boost::uuids::to_string(m_file->get_id()),
+            m_logtype_ids_in_file,
+            m_var_ids_in_file
+    );
+    m_logtype_ids_in_file.clear();
+    m_var_ids_in_file.clear();
     // Make sure file pointer is nulled and cannot be accessed outside
     m_file = nullptr;
 }
@@ -663,9 +692,10 @@ void Archive::close_segment_and_persist_file_metadata(
     }
 #endif
 
-    // Flush dictionaries
+    // Flush dictionaries and posting lists
     m_logtype_dict.write_header_and_flush_to_disk();
     m_var_dict.write_header_and_flush_to_disk();
+    m_file_posting_lists.write_header_and_flush_to_disk();
 
     for (auto file : files) {
         file->mark_as_in_committed_segment();
@@ -687,7 +717,9 @@ void Archive::add_empty_directories(vector<string> const& empty_directory_paths)
 }
 
 uint64_t Archive::get_dynamic_compressed_size() {
-    uint64_t on_disk_size = m_logtype_dict.get_on_disk_size() + m_var_dict.get_on_disk_size();
+    uint64_t on_disk_size = m_logtype_dict.get_on_disk_size() + m_var_dict.get_on_disk_size()
+                            + m_dictionary_substring_indexes_size
+                            + m_file_posting_lists.get_on_disk_size();
 
     // Add size of unclosed segments
     if (m_segment_for_files_with_timestamps.is_open()) {
@@ -717,6 +749,10 @@ void Archive::update_local_metadata() {
 }
 
 auto Archive::update_global_metadata() -> void {
+    std::unique_lock<std::mutex> global_metadata_db_lock;
+    if (nullptr != m_global_metadata_db_mutex) {
+        global_metadata_db_lock = std::unique_lock<std::mutex>{*m_global_metadata_db_mutex};
+    }
     m_global_metadata_db->open();
     if (false == m_local_metadata.has_value()) {
         throw OperationFailed(ErrorCode_Failure, __FILENAME__, __LINE__);
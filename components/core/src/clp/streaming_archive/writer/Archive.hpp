@@ -3,6 +3,7 @@
 
 #include <filesystem>
 #include <memory>
+#include <mutex>
 #include <optional>
 #include <set>
 #include <string>
@@ -22,6 +23,7 @@
 #include "../../VariableDictionaryWriter.hpp"
 #include "../ArchiveMetadata.hpp"
 #include "../MetadataDB.hpp"
+#include "FilePostingLists.hpp"
 
 namespace clp::streaming_archive::writer {
 class Archive {
@@ -47,7 +49,11 @@ public:
         int compression_level;
         std::string output_dir;
         GlobalMetadataDB* global_metadata_db;
+        // Mutex guarding `global_metadata_db` when it's shared by archives written concurrently
+        std::mutex* global_metadata_db_mutex{nullptr};
         bool print_archive_stats_progress;
+        // Whether to build substring indexes over the dictionaries when the archive is closed
+        bool build_dictionary_substring_indexes{false};
     };
 
     class OperationFailed : public TraceableException {
@@ -75,6 +81,9 @@ public:
             : m_segments_dir_fd(-1),
               m_compression_level(0),
               m_global_metadata_db(nullptr),
+              m_global_metadata_db_mutex(nullptr),
+              m_build_dictionary_substring_indexes(false),
+              m_dictionary_substring_indexes_size(0),
               m_old_ts_pattern(nullptr),
               m_schema_file_path() {}
 
@@ -286,7 +295,8 @@ private:
     void update_local_metadata();
 
     /**
-     * Updates the archive's metadata in the global metadata database.
+     * Updates the archive's metadata in the global metadata database, holding the global metadata
+     * database's mutex (if any) for the duration of the update.
      */
     auto update_global_metadata() -> void;
 
@@ -348,6 +358,10 @@ private:
     // timestamp-less segment
     std::unordered_set<logtype_dictionary_id_t> m_logtype_ids_for_file_with_unassigned_segment;
     std::unordered_set<variable_dictionary_id_t> m_var_ids_for_file_with_unassigned_segment;
+    // Logtype and variable IDs in the current file, regardless of its segment
+    std::unordered_set<logtype_dictionary_id_t> m_logtype_ids_in_file;
+    std::unordered_set<variable_dictionary_id_t> m_var_ids_in_file;
+    FilePostingLists m_file_posting_lists;
     Segment m_segment_for_files_without_timestamps;
     ArrayBackedPosIntSet<logtype_dictionary_id_t>
             m_logtype_ids_in_segment_for_files_without_timestamps;
@@ -362,8 +376,12 @@ private:
     FileWriter m_metadata_file_writer;
 
     GlobalMetadataDB* m_global_metadata_db;
+    std::mutex* m_global_metadata_db_mutex;
 
     bool m_print_archive_stats_progress;
+
+    bool m_build_dictionary_substring_indexes;
+    uint64_t m_dictionary_substring_indexes_size;
 };
 }  // namespace clp::streaming_archive::writer
 
@@ -0,0 +1,102 @@
+#include "FilePostingLists.hpp"
+
+#include <algorithm>
+#include <string>
+#include <unordered_set>
+#include <vector>
+
+#include "../../Defs.h"
+#include "../../ErrorCode.hpp"
+#include "../../FileWriter.hpp"
+
+namespace clp::streaming_archive::writer {
+namespace {
+/**
+ * Writes the given IDs to the compressor in ascending order, preceded by the number of IDs
+ * @tparam IdType
+ * @param ids
+ * @param compressor
+ */
+template <typename IdType>
+void write_sorted_ids(
+        std::unordered_set<IdType> const& ids,
+        streaming_compression::Compressor& compressor
+);
+
+template <typename IdType>
+void write_sorted_ids(
+        std::unordered_set<IdType> const& ids,
+        streaming_compression::Compressor& compressor
+) {
+    std::vector<IdType> sorted_ids(ids.cbegin(), ids.cend());
+    std::sort(sorted_ids.begin(), sorted_ids.end());
+    compressor.write_numeric_value<uint64_t>(sorted_ids.size());
+    for (auto const id : sorted_ids) {
+        compressor.write_numeric_value(id);
+    }
+}
+}  // namespace
+
+void FilePostingLists::open(std::string const& path, int compression_level) {
+    if (m_is_open) {
+        throw OperationFailed(ErrorCode_NotReady, __FILENAME__, __LINE__);
+    }
+
+    m_file_writer.open(path, FileWriter::OpenMode::CREATE_FOR_WRITING);
+    // Write header
+    m_file_writer.write_numeric_value<uint64_t>(0);
+#if USE_PASSTHROUGH_COMPRESSION
+    m_compressor.open(m_file_writer);
+#elif USE_ZSTD_COMPRESSION
+    m_compressor.open(m_file_writer, compression_level);
+#else
+    static_assert(false, "Unsupported compression mode.");
+#endif
+    m_num_files = 0;
+
+    m_is_open = true;
+}
+
+void FilePostingLists::close() {
+    if (false == m_is_open) {
+        throw OperationFailed(ErrorCode_NotInit, __FILENAME__, __LINE__);
+    }
+
+    write_header_and_flush_to_disk();
+    m_compressor.close();
+    m_file_writer.close();
+
+    m_is_open = false;
+}
+
+void FilePostingLists::add_file(
+        std::string const& file_id,
+        std::unordered_set<logtype_dictionary_id_t> const& logtype_ids,
+        std::unordered_set<variable_dictionary_id_t> const& var_ids
+) {
+    if (false == m_is_open) {
+        throw OperationFailed(ErrorCode_NotInit, __FILENAME__, __LINE__);
+    }
+
+    m_compressor.write_numeric_value<uint64_t>(file_id.length());
+    m_compressor.write_string(file_id);
+    write_sorted_ids(logtype_ids, m_compressor);
+    write_sorted_ids(var_ids, m_compressor);
+    ++m_num_files;
+}
+
+void FilePostingLists::write_header_and_flush_to_disk() {
+    if (false == m_is_open) {
+        throw OperationFailed(ErrorCode_NotInit, __FILENAME__, __LINE__);
+    }
+
+    // Flush the posting lists before updating the header, so that the header never counts more
+    // posting lists than are on disk
+    m_compressor.flush();
+    auto const file_writer_pos = m_file_writer.get_pos();
+    m_file_writer.seek_from_begin(0);
+    m_file_writer.write_numeric_value<uint64_t>(m_num_files);
+    m_file_writer.seek_from_begin(file_writer_pos);
+    m_file_writer.flush();
+}
+}  // namespace clp::streaming_archive::writer
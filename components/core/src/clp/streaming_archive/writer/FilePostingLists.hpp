@@ -0,0 +1,100 @@
+#ifndef CLP_STREAMING_ARCHIVE_WRITER_FILEPOSTINGLISTS_HPP
+#define CLP_STREAMING_ARCHIVE_WRITER_FILEPOSTINGLISTS_HPP
+
+#include <cstdint>
+#include <string>
+#include <unordered_set>
+
+#include "../../Defs.h"
+#include "../../ErrorCode.hpp"
+#include "../../FileWriter.hpp"
+#include "../../streaming_compression/passthrough/Compressor.hpp"
+#include "../../streaming_compression/zstd/Compressor.hpp"
+#include "../../TraceableException.hpp"
+
+namespace clp::streaming_archive::writer {
+/**
+ * Class for writing an archive's per-file posting lists. A file's posting list contains the IDs of
+ * the logtypes and dictionary variables that occur in the file, so that a search can skip files
+ * that can't contain a match without decompressing them.
+ *
+ * The posting lists are stored as an uncompressed header containing the number of files, followed
+ * by a compressed stream with one record per file:
+ * - the length of the file's ID followed by the ID;
+ * - the number of logtype IDs followed by the IDs in ascending order;
+ * - the number of variable dictionary IDs followed by the IDs in ascending order.
+ */
+class FilePostingLists {
+public:
+    // Types
+    class OperationFailed : public TraceableException {
+    public:
+        // Constructors
+        OperationFailed(ErrorCode error_code, char const* const filename, int line_number)
+                : TraceableException(error_code, filename, line_number) {}
+
+        // Methods
+        char const* what() const noexcept override {
+            return "streaming_archive::writer::FilePostingLists operation failed";
+        }
+    };
+
+    // Constructors
+    FilePostingLists() : m_is_open(false), m_num_files(0) {}
+
+    // Methods
+    /**
+     * Creates the posting lists file at the given path
+     * @param path
+     * @param compression_level
+     * @throw streaming_archive::writer::FilePostingLists::OperationFailed if already open
+     * @throw FileWriter::OperationFailed on open or write failure
+     */
+    void open(std::string const& path, int compression_level);
+    /**
+     * Writes the header, flushes, and closes the posting lists file
+     * @throw streaming_archive::writer::FilePostingLists::OperationFailed if not open
+     */
+    void close();
+
+    /**
+     * Adds the posting list of the given file
+     * @param file_id
+     * @param logtype_ids IDs of the logtypes in the file
+     * @param var_ids IDs of the dictionary variables in the file
+     * @throw streaming_archive::writer::FilePostingLists::OperationFailed if not open
+     */
+    void add_file(
+            std::string const& file_id,
+            std::unordered_set<logtype_dictionary_id_t> const& logtype_ids,
+            std::unordered_set<variable_dictionary_id_t> const& var_ids
+    );
+
+    /**
+     * Writes the header and flushes any buffered posting lists to disk
+     * @throw streaming_archive::writer::FilePostingLists::OperationFailed if not open
+     */
+    void write_header_and_flush_to_disk();
+
+    /**
+     * @return The size of the posting lists on disk, in bytes
+     */
+    size_t get_on_disk_size() const { return m_file_writer.get_pos(); }
+
+private:
+    // Variables
+    bool m_is_open;
+    uint64_t m_num_files;
+
+    FileWriter m_file_writer;
+#if USE_PASSTHROUGH_COMPRESSION
+    streaming_compression::passthrough::Compressor m_compressor;
+#elif USE_ZSTD_COMPRESSION
+    streaming_compression::zstd::Compressor m_compressor;
+#else
+    static_assert(false, "Unsupported compression mode.");
+#endif
+};
+}  // namespace clp::streaming_archive::writer
+
+#endif  // CLP_STREAMING_ARCHIVE_WRITER_FILEPOSTINGLISTS_HPP
@@ -1,16 +1,232 @@
 #include "utf8_utils.hpp"
 
+#include <bit>
 #include <cstddef>
 #include <cstdint>
 #include <string_view>
 
+#if defined(__SSE2__)
+    #include <emmintrin.h>
+
+    #define CLP_UTF8_UTILS_USE_SIMD 1
+#elif defined(__ARM_NEON)
+    #include <arm_neon.h>
+
+    #define CLP_UTF8_UTILS_USE_SIMD 1
+#else
+    #define CLP_UTF8_UTILS_USE_SIMD 0
+#endif
+
 namespace clp {
+namespace {
+#if CLP_UTF8_UTILS_USE_SIMD
+constexpr size_t cSimdBlockSize{16};
+// Long runs of unmatched bytes are skipped this many blocks (64 bytes) at a time
+constexpr size_t cNumSimdBlocksPerStride{4};
+
+    #if defined(__SSE2__)
+using SimdBlock = __m128i;
+
+// `_mm_movemask_epi8` sets one bit per byte
+constexpr size_t cNumMatchMaskBitsPerByte{1};
+
+auto load_simd_block(char const* data) -> SimdBlock {
+    return _mm_loadu_si128(reinterpret_cast<SimdBlock const*>(data));
+}
+
+auto combine_simd_matches(SimdBlock lhs, SimdBlock rhs) -> SimdBlock {
+    return _mm_or_si128(lhs, rhs);
+}
+
+auto get_match_mask(SimdBlock matches) -> uint64_t {
+    return static_cast<uint32_t>(_mm_movemask_epi8(matches));
+}
+    #else
+using SimdBlock = uint8x16_t;
+
+// Narrowing each 16-bit lane by 4 bits sets four bits per byte
+constexpr size_t cNumMatchMaskBitsPerByte{4};
+
+auto load_simd_block(char const* data) -> SimdBlock {
+    return vld1q_u8(reinterpret_cast<uint8_t const*>(data));
+}
+
+auto combine_simd_matches(SimdBlock lhs, SimdBlock rhs) -> SimdBlock {
+    return vorrq_u8(lhs, rhs);
+}
+
+auto get_match_mask(SimdBlock matches) -> uint64_t {
+    constexpr int cNarrowingShift{4};
+    return vget_lane_u64(
+            vreinterpret_u64_u8(vshrn_n_u16(vreinterpretq_u16_u8(matches), cNarrowingShift)),
+            0
+    );
+}
+    #endif
+#endif
+
+/**
+ * Matches non-ASCII bytes.
+ */
+struct NonAsciiByteMatcher {
+#if CLP_UTF8_UTILS_USE_SIMD
+    static auto match_simd_block(SimdBlock block) -> SimdBlock;
+#endif
+    static auto match_byte(uint8_t byte) -> bool;
+};
+
+/**
+ * Matches non-ASCII bytes and ASCII characters that need to be escaped in JSON strings.
+ */
+struct NonAsciiOrJsonEscapeByteMatcher {
+#if CLP_UTF8_UTILS_USE_SIMD
+    static auto match_simd_block(SimdBlock block) -> SimdBlock;
+#endif
+    static auto match_byte(uint8_t byte) -> bool;
+};
+
+/**
+ * Finds the first byte in `str`, at or after `pos`, that matches. When SIMD instructions are
+ * available, the string is scanned a block at a time, with only the remainder scanned a byte at a
+ * time.
+ * @tparam Matcher
+ * @param str
+ * @param pos
+ * @return The position of the first matching byte, or `str.size()` if there's none.
+ */
+template <typename Matcher>
+auto find_first_matching_byte(std::string_view str, size_t pos) -> size_t;
+
+#if CLP_UTF8_UTILS_USE_SIMD
+auto NonAsciiByteMatcher::match_simd_block(SimdBlock block) -> SimdBlock {
+    #if defined(__SSE2__)
+    return _mm_cmplt_epi8(block, _mm_setzero_si128());
+    #else
+    return vcgtq_u8(block, vdupq_n_u8(cOneByteUtf8CharCodePointUpperBound));
+    #endif
+}
+#endif
+
+auto NonAsciiByteMatcher::match_byte(uint8_t byte) -> bool {
+    return false == utf8_utils_internal::is_ascii_char(byte);
+}
+
+#if CLP_UTF8_UTILS_USE_SIMD
+auto NonAsciiOrJsonEscapeByteMatcher::match_simd_block(SimdBlock block) -> SimdBlock {
+    #if defined(__SSE2__)
+    // Non-ASCII bytes are negative when compared as signed bytes, so they also compare less than
+    // the first printable ASCII character.
+    auto const matches{_mm_cmplt_epi8(block, _mm_set1_epi8(' '))};
+    auto const quotes{_mm_cmpeq_epi8(block, _mm_set1_epi8('"'))};
+    auto const backslashes{_mm_cmpeq_epi8(block, _mm_set1_epi8('\\'))};
+    return _mm_or_si128(matches, _mm_or_si128(quotes, backslashes));
+    #else
+    auto const matches{vorrq_u8(
+            vcltq_u8(block, vdupq_n_u8(' ')),
+            vcgtq_u8(block, vdupq_n_u8(cOneByteUtf8CharCodePointUpperBound))
+    )};
+    auto const quotes{vceqq_u8(block, vdupq_n_u8('"'))};
+    auto const backslashes{vceqq_u8(block, vdupq_n_u8('\\'))};
+    return vorrq_u8(matches, vorrq_u8(quotes, backslashes));
+    #endif
+}
+#endif
+
+auto NonAsciiOrJsonEscapeByteMatcher::match_byte(uint8_t byte) -> bool {
+    constexpr uint8_t cLargestControlCharacter{0x1F};
+    return false == utf8_utils_internal::is_ascii_char(byte) || cLargestControlCharacter >= byte
+           || '"' == byte || '\\' == byte;
+}
+
+template <typename Matcher>
+auto find_first_matching_byte(std::string_view str, size_t pos) -> size_t {
+    auto const* const data{str.data()};
+    auto const size{str.size()};
+
+#if CLP_UTF8_UTILS_USE_SIMD
+    constexpr size_t cSimdStrideSize{cSimdBlockSize * cNumSimdBlocksPerStride};
+    for (; pos + cSimdStrideSize <= size; pos += cSimdStrideSize) {
+        auto matches{Matcher::match_simd_block(load_simd_block(data + pos))};
+        for (size_t i{1}; i < cNumSimdBlocksPerStride; ++i) {
+            matches = combine_simd_matches(
+                    matches,
+                    Matcher::match_simd_block(load_simd_block(data + pos + i * cSimdBlockSize))
+            );
+        }
+        if (0 != get_match_mask(matches)) {
+            break;
+        }
+    }
+    for (; pos + cSimdBlockSize <= size; pos += cSimdBlockSize) {
+        auto const matches{Matcher::match_simd_block(load_simd_block(data + pos))};
+        if (auto const match_mask{get_match_mask(matches)}; 0 != match_mask) {
+            return pos + std::countr_zero(match_mask) / cNumMatchMaskBitsPerByte;
+        }
+    }
+#endif
+
+    for (; pos < size; ++pos) {
+        if (Matcher::match_byte(static_cast<uint8_t>(data[pos]))) {
+            return pos;
+        }
+    }
+    return size;
+}
+}  // namespace
+
 auto is_utf8_encoded(std::string_view str) -> bool {
     auto escape_handler = []([[maybe_unused]] std::string_view::const_iterator it) -> void {};
     return validate_utf8_string(str, escape_handler);
 }
 
 namespace utf8_utils_internal {
+auto find_non_ascii_byte(std::string_view str, size_t pos) -> size_t {
+    return find_first_matching_byte<NonAsciiByteMatcher>(str, pos);
+}
+
+auto find_non_ascii_or_json_escape_byte(std::string_view str, size_t pos) -> size_t {
+    return find_first_matching_byte<NonAsciiOrJsonEscapeByteMatcher>(str, pos);
+}
+
+auto validate_multi_byte_char(std::string_view str, size_t& pos) -> bool {
+    size_t num_continuation_bytes{};
+    uint32_t code_point{};
+    uint32_t code_point_lower_bound{};
+    uint32_t code_point_upper_bound{};
+    if (false
+        == parse_and_validate_lead_byte(
+                static_cast<uint8_t>(str[pos]),
+                num_continuation_bytes,
+                code_point,
+                code_point_lower_bound,
+                code_point_upper_bound
+        ))
+    {
+        return false;
+    }
+    if (str.size() - pos - 1 < num_continuation_bytes) {
+        // Incomplete UTF-8 character
+        return false;
+    }
+
+    auto const end_pos{pos + 1 + num_continuation_bytes};
+    for (auto continuation_byte_pos{pos + 1}; continuation_byte_pos < end_pos;
+         ++continuation_byte_pos)
+    {
+        auto const byte{static_cast<uint8_t>(str[continuation_byte_pos])};
+        if (false == is_valid_utf8_continuation_byte(byte)) {
+            return false;
+        }
+        code_point = parse_continuation_byte(code_point, byte);
+    }
+    if (code_point < code_point_lower_bound || code_point_upper_bound < code_point) {
+        return false;
+    }
+
+    pos = end_pos;
+    return true;
+}
+
 auto parse_and_validate_lead_byte(
         uint8_t byte,
         size_t& num_continuation_bytes,
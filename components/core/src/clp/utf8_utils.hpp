@@ -4,6 +4,7 @@
 #include <cstddef>
 #include <cstdint>
 #include <string_view>
+#include <type_traits>
 
 namespace clp {
 // Constants
@@ -43,6 +44,22 @@ template <typename EscapeHandler>
 requires std::is_invocable_v<EscapeHandler, std::string_view::const_iterator>
 [[nodiscard]] auto validate_utf8_string(std::string_view src, EscapeHandler escape_handler) -> bool;
 
+/**
+ * Validates whether the given string is UTF-8 encoded, escaping any ASCII characters that need to
+ * be escaped in JSON strings using the given handler.
+ *
+ * Unlike `validate_utf8_string`, the handler is only called for ASCII control characters, '"', and
+ * '\\', which allows runs of other characters to be skipped a block at a time.
+ * @tparam EscapeHandler Method to escape an ASCII character in the string.
+ * @param src
+ * @param escape_handler
+ * @return Whether the input is a valid UTF-8 encoded string.
+ */
+template <typename EscapeHandler>
+requires std::is_invocable_v<EscapeHandler, std::string_view::const_iterator>
+[[nodiscard]] auto
+validate_utf8_string_for_json(std::string_view src, EscapeHandler escape_handler) -> bool;
+
 /**
  * @param str
  * @return Whether the input is a valid UTF-8 encoded string.
@@ -50,6 +67,45 @@ requires std::is_invocable_v<EscapeHandler, std::string_view::const_iterator>
 [[nodiscard]] auto is_utf8_encoded(std::string_view str) -> bool;
 
 namespace utf8_utils_internal {
+/**
+ * Validates whether the given string is UTF-8 encoded one byte at a time, optionally escaping ASCII
+ * characters using the given handler. This is the reference implementation of
+ * `validate_utf8_string`.
+ * @tparam EscapeHandler Method to optionally escape any ASCII character in the string.
+ * @param src
+ * @param escape_handler
+ * @return Whether the input is a valid UTF-8 encoded string.
+ */
+template <typename EscapeHandler>
+requires std::is_invocable_v<EscapeHandler, std::string_view::const_iterator>
+[[nodiscard]] auto
+validate_utf8_string_bytewise(std::string_view src, EscapeHandler escape_handler) -> bool;
+
+/**
+ * @param str
+ * @param pos
+ * @return The position of the first non-ASCII byte in `str`, at or after `pos`, or `str.size()` if
+ * there's none.
+ */
+[[nodiscard]] auto find_non_ascii_byte(std::string_view str, size_t pos) -> size_t;
+
+/**
+ * @param str
+ * @param pos
+ * @return The position of the first byte in `str`, at or after `pos`, that's either non-ASCII or an
+ * ASCII character that needs to be escaped in JSON strings, or `str.size()` if there's none.
+ */
+[[nodiscard]] auto find_non_ascii_or_json_escape_byte(std::string_view str, size_t pos) -> size_t;
+
+/**
+ * Validates the multi-byte UTF-8 character that starts at the given position.
+ * @param str
+ * @param pos The position of the character's lead byte. Returns the position after the character
+ * if it's valid.
+ * @return Whether the character is valid.
+ */
+[[nodiscard]] auto validate_multi_byte_char(std::string_view str, size_t& pos) -> bool;
+
 /**
  * Validates whether the given byte is a valid lead byte for a multi-byte UTF-8 character, parses
  * the byte, and returns the parsed properties as well as associated properties.
@@ -96,6 +152,41 @@ namespace utf8_utils_internal {
 template <typename EscapeHandler>
 requires std::is_invocable_v<EscapeHandler, std::string_view::const_iterator>
 auto validate_utf8_string(std::string_view src, EscapeHandler escape_handler) -> bool {
+    size_t pos{0};
+    while (pos < src.size()) {
+        auto const non_ascii_byte_pos{utf8_utils_internal::find_non_ascii_byte(src, pos)};
+        for (; pos < non_ascii_byte_pos; ++pos) {
+            escape_handler(src.cbegin() + static_cast<std::ptrdiff_t>(pos));
+        }
+        if (pos < src.size() && false == utf8_utils_internal::validate_multi_byte_char(src, pos)) {
+            return false;
+        }
+    }
+    return true;
+}
+
+template <typename EscapeHandler>
+requires std::is_invocable_v<EscapeHandler, std::string_view::const_iterator>
+auto validate_utf8_string_for_json(std::string_view src, EscapeHandler escape_handler) -> bool {
+    size_t pos{0};
+    while (true) {
+        pos = utf8_utils_internal::find_non_ascii_or_json_escape_byte(src, pos);
+        if (src.size() == pos) {
+            return true;
+        }
+        if (utf8_utils_internal::is_ascii_char(static_cast<uint8_t>(src[pos]))) {
+            escape_handler(src.cbegin() + static_cast<std::ptrdiff_t>(pos));
+            ++pos;
+        } else if (false == utf8_utils_internal::validate_multi_byte_char(src, pos)) {
+            return false;
+        }
+    }
+}
+
+namespace utf8_utils_internal {
+template <typename EscapeHandler>
+requires std::is_invocable_v<EscapeHandler, std::string_view::const_iterator>
+auto validate_utf8_string_bytewise(std::string_view src, EscapeHandler escape_handler) -> bool {
     size_t num_continuation_bytes_to_validate{0};
     uint32_t code_point{};
     uint32_t code_point_lower_bound{};
@@ -105,10 +196,10 @@ auto validate_utf8_string(std::string_view src, EscapeHandler escape_handler) ->
     for (auto it{src.cbegin()}; it != src.cend(); ++it) {
         auto const byte{static_cast<uint8_t>(*it)};
         if (0 == num_continuation_bytes_to_validate) {
-            if (utf8_utils_internal::is_ascii_char(byte)) {
+            if (is_ascii_char(byte)) {
                 escape_handler(it);
             } else if (false
-                       == utf8_utils_internal::parse_and_validate_lead_byte(
+                       == parse_and_validate_lead_byte(
                                byte,
                                num_continuation_bytes_to_validate,
                                code_point,
@@ -119,10 +210,10 @@ auto validate_utf8_string(std::string_view src, EscapeHandler escape_handler) ->
                 return false;
             }
         } else {
-            if (false == utf8_utils_internal::is_valid_utf8_continuation_byte(byte)) {
+            if (false == is_valid_utf8_continuation_byte(byte)) {
                 return false;
             }
-            code_point = utf8_utils_internal::parse_continuation_byte(code_point, byte);
+            code_point = parse_continuation_byte(code_point, byte);
             --num_continuation_bytes_to_validate;
             if (0 == num_continuation_bytes_to_validate
                 && (code_point < code_point_lower_bound || code_point_upper_bound < code_point))
@@ -139,6 +230,7 @@ auto validate_utf8_string(std::string_view src, EscapeHandler escape_handler) ->
 
     return true;
 }
+}  // namespace utf8_utils_internal
 }  // namespace clp
 
 #endif  // CLP_UTF8_UTILS_HPP
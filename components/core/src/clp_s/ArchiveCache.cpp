@@ -0,0 +1,253 @@
+#include "ArchiveCache.hpp"
+
+#include <fcntl.h>
+#include <sys/file.h>
+#include <unistd.h>
+
+#include <algorithm>
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+#include <filesystem>
+#include <string>
+#include <string_view>
+#include <system_error>
+#include <utility>
+#include <vector>
+
+#include <fmt/format.h>
+#include <spdlog/spdlog.h>
+
+#include "ErrorCode.hpp"
+#include "FileReader.hpp"
+#include "FileWriter.hpp"
+
+namespace clp_s {
+namespace {
+constexpr std::string_view cLockFileName{".lock"};
+constexpr std::string_view cTempFilePrefix{".tmp-"};
+// Temporary files older than this are assumed to have been left behind by processes that exited
+// while writing them.
+constexpr std::chrono::hours cStaleTempFileAge{1};
+// The number of entries written between scans of the cache directory when the size estimate is
+// within the capacity. The first write always scans, to account for entries that already exist.
+constexpr size_t cNumWritesPerScan{64};
+
+/**
+ * Holds an exclusive advisory lock on a file (creating it if necessary) for its lifetime.
+ */
+class ScopedFileLock {
+public:
+    explicit ScopedFileLock(std::string const& path)
+            : m_fd{::open(path.c_str(), O_RDWR | O_CREAT | O_CLOEXEC, 0644)} {
+        if (-1 != m_fd && 0 != ::flock(m_fd, LOCK_EX)) {
+            ::close(m_fd);
+            m_fd = -1;
+        }
+    }
+
+    // Delete copy & move constructors and assignment operators
+    ScopedFileLock(ScopedFileLock const&) = delete;
+    ScopedFileLock(ScopedFileLock&&) = delete;
+    auto operator=(ScopedFileLock const&) -> ScopedFileLock& = delete;
+    auto operator=(ScopedFileLock&&) -> ScopedFileLock& = delete;
+
+    // Destructor
+    ~ScopedFileLock() {
+        if (-1 != m_fd) {
+            // Closing the file releases the lock
+            ::close(m_fd);
+        }
+    }
+
+    [[nodiscard]] auto is_locked() const -> bool { return -1 != m_fd; }
+
+private:
+    int m_fd;
+};
+
+/**
+ * @param str
+ * @return The 64-bit FNV-1a hash of the given string.
+ */
+auto fnv1a_hash(std::string_view str) -> uint64_t;
+
+auto fnv1a_hash(std::string_view str) -> uint64_t {
+    constexpr uint64_t cOffsetBasis{14'695'981'039'346'656'037ULL};
+    constexpr uint64_t cPrime{1'099'511'628'211ULL};
+    uint64_t hash{cOffsetBasis};
+    for (auto const c : str) {
+        hash ^= static_cast<uint8_t>(c);
+        hash *= cPrime;
+    }
+    return hash;
+}
+}  // namespace
+
+ArchiveCache::ArchiveCache(std::string cache_dir, size_t capacity)
+        : m_cache_dir{std::move(cache_dir)},
+          m_capacity{capacity} {
+    if (0 == m_capacity) {
+        throw OperationFailed(ErrorCodeBadParam, __FILENAME__, __LINE__);
+    }
+
+    std::error_code ec;
+    std::filesystem::create_directories(m_cache_dir, ec);
+    if (ec || false == std::filesystem::is_directory(m_cache_dir, ec)) {
+        SPDLOG_ERROR("Failed to create archive cache directory {} - {}", m_cache_dir, ec.message());
+        throw OperationFailed(ErrorCodeFailure, __FILENAME__, __LINE__);
+    }
+}
+
+auto ArchiveCache::contains(std::string_view archive_id, size_t begin, size_t end) const -> bool {
+    std::error_code ec;
+    return std::filesystem::exists(get_entry_path(archive_id, begin, end), ec);
+}
+
+auto ArchiveCache::try_read(
+        std::string_view archive_id,
+        size_t begin,
+        size_t end,
+        std::vector<char>& buf
+) const -> bool {
+    if (begin >= end) {
+        return false;
+    }
+    auto const entry_path{get_entry_path(archive_id, begin, end)};
+
+    // The entry may be evicted by another process at any point, but once it's open, it remains
+    // readable.
+    FileReader reader;
+    if (ErrorCodeSuccess != reader.try_open(entry_path)) {
+        return false;
+    }
+    buf.resize(end - begin);
+    if (ErrorCodeSuccess != reader.try_read_exact_length(buf.data(), buf.size())) {
+        return false;
+    }
+    char c{};
+    size_t num_bytes_read{0};
+    if (ErrorCodeEndOfFile != reader.try_read(&c, 1, num_bytes_read)) {
+        // The entry doesn't match the range
+        return false;
+    }
+    reader.close();
+
+    std::error_code ec;
+    std::filesystem::last_write_time(
+            entry_path,
+            std::filesystem::file_time_type::clock::now(),
+            ec
+    );
+    return true;
+}
+
+void ArchiveCache::write(std::string_view archive_id, size_t begin, size_t end, char const* data) {
+    if (begin >= end || end - begin > m_capacity) {
+        return;
+    }
+    auto const entry_path{get_entry_path(archive_id, begin, end)};
+    std::error_code ec;
+    if (std::filesystem::exists(entry_path, ec)) {
+        return;
+    }
+
+    auto const temp_path{fmt::format(
+            "{}/{}{}-{}",
+            m_cache_dir,
+            cTempFilePrefix,
+            ::getpid(),
+            m_num_temp_files_created++
+    )};
+    try {
+        FileWriter writer;
+        writer.open(temp_path, FileWriter::OpenMode::CreateForWriting);
+        writer.write(data, end - begin);
+        writer.close();
+    } catch (FileWriter::OperationFailed const& e) {
+        SPDLOG_WARN("Failed to write archive cache entry {} - {}", temp_path, e.what());
+        std::filesystem::remove(temp_path, ec);
+        return;
+    }
+
+    std::filesystem::rename(temp_path, entry_path, ec);
+    if (ec) {
+        SPDLOG_WARN("Failed to add archive cache entry {} - {}", entry_path, ec.message());
+        std::filesystem::remove(temp_path, ec);
+        return;
+    }
+
+    auto const num_entries_written{m_num_entries_written++};
+    auto const size_estimate{m_size_estimate += end - begin};
+    if (size_estimate > m_capacity || 0 == num_entries_written % cNumWritesPerScan) {
+        evict();
+    }
+}
+
+auto ArchiveCache::get_entry_path(std::string_view archive_id, size_t begin, size_t end) const
+        -> std::string {
+    return fmt::format("{}/{:016x}-{}-{}", m_cache_dir, fnv1a_hash(archive_id), begin, end);
+}
+
+void ArchiveCache::evict() {
+    struct Entry {
+        std::filesystem::path path;
+        size_t size;
+        std::filesystem::file_time_type last_used_time;
+    };
+
+    ScopedFileLock const lock{fmt::format("{}/{}", m_cache_dir, cLockFileName)};
+    if (false == lock.is_locked()) {
+        SPDLOG_WARN("Failed to lock archive cache {}", m_cache_dir);
+        return;
+    }
+
+    std::vector<Entry> entries;
+    size_t total_size{0};
+    auto const now{std::filesystem::file_time_type::clock::now()};
+    std::error_code ec;
+    for (std::filesystem::directory_iterator it{m_cache_dir, ec};
+         false == static_cast<bool>(ec) && std::filesystem::directory_iterator{} != it;
+         it.increment(ec))
+    {
+        auto const& path{it->path()};
+        std::error_code entry_ec;
+        auto const last_write_time{it->last_write_time(entry_ec)};
+        auto const size{it->file_size(entry_ec)};
+        if (entry_ec || false == it->is_regular_file(entry_ec)) {
+            // The entry was removed concurrently
+            continue;
+        }
+
+        auto const filename{path.filename().string()};
+        if (filename.starts_with(cTempFilePrefix)) {
+            if (now - last_write_time > cStaleTempFileAge) {
+                std::filesystem::remove(path, entry_ec);
+            }
+            continue;
+        }
+        if (filename.starts_with('.')) {
+            continue;
+        }
+        entries.emplace_back(path, size, last_write_time);
+        total_size += size;
+    }
+    if (total_size <= m_capacity) {
+        m_size_estimate = total_size;
+        return;
+    }
+
+    std::sort(entries.begin(), entries.end(), [](Entry const& lhs, Entry const& rhs) {
+        return lhs.last_used_time < rhs.last_used_time;
+    });
+    for (auto const& entry : entries) {
+        if (total_size <= m_capacity) {
+            break;
+        }
+        if (std::filesystem::remove(entry.path, ec)) {
+            total_size -= entry.size;
+        }
+    }
+    m_size_estimate = total_size;
+}
+}  // namespace clp_s
@@ -0,0 +1,117 @@
+#ifndef CLP_S_ARCHIVECACHE_HPP
+#define CLP_S_ARCHIVECACHE_HPP
+
+#include <atomic>
+#include <cstddef>
+#include <string>
+#include <string_view>
+#include <vector>
+
+#include "ErrorCode.hpp"
+#include "TraceableException.hpp"
+
+namespace clp_s {
+/**
+ * A cache of byte ranges (e.g., sections and packed streams) of remote archives, stored as files
+ * in a local directory. Since archives are immutable, each cached range is identified by the ID of
+ * its archive and its offsets within the archive.
+ *
+ * The cache is safe to share between processes:
+ * - Entries are written to temporary files that are atomically renamed into place, so readers
+ *   never see partially written entries.
+ * - Each entry's modification time records when it was last used. Whenever an entry is added and
+ *   the cache exceeds its size budget, the least recently used entries are removed while holding an
+ *   exclusive lock on the cache's lock file. Removing an entry doesn't affect processes that are
+ *   still reading it.
+ *
+ * To avoid scanning the cache directory on every write, each instance keeps a running estimate of
+ * the cache's size that only counts its own writes. The directory is scanned (and the estimate
+ * corrected) only when the estimate exceeds the capacity, or periodically to account for other
+ * processes' writes and evictions. So the cache may briefly exceed its capacity when several
+ * processes share it.
+ */
+class ArchiveCache {
+public:
+    // Types
+    class OperationFailed : public TraceableException {
+    public:
+        // Constructors
+        OperationFailed(ErrorCode error_code, char const* const filename, int line_number)
+                : TraceableException(error_code, filename, line_number) {}
+    };
+
+    // Constants
+    static constexpr size_t cDefaultCapacity{10ULL * 1024 * 1024 * 1024};  // 10 GiB
+
+    // Constructors
+    /**
+     * @param cache_dir The directory to store the cache in, which is created if it doesn't exist.
+     * @param capacity The maximum total size of the cached entries, in bytes.
+     * @throw ArchiveCache::OperationFailed if the capacity is 0 or the directory can't be created.
+     */
+    ArchiveCache(std::string cache_dir, size_t capacity);
+
+    // Methods
+    /**
+     * @param archive_id
+     * @param begin
+     * @param end
+     * @return Whether the range [begin, end) of the given archive is cached.
+     */
+    [[nodiscard]] auto
+    contains(std::string_view archive_id, size_t begin, size_t end) const -> bool;
+
+    /**
+     * Tries to read the range [begin, end) of the given archive from the cache, marking it as the
+     * most recently used entry.
+     * @param archive_id
+     * @param begin
+     * @param end
+     * @param buf Returns the contents of the range.
+     * @return Whether the range was cached.
+     */
+    [[nodiscard]] auto try_read(
+            std::string_view archive_id,
+            size_t begin,
+            size_t end,
+            std::vector<char>& buf
+    ) const -> bool;
+
+    /**
+     * Adds the range [begin, end) of the given archive to the cache, evicting the least recently
+     * used entries if the cache exceeds its capacity. Since caching is an optimization, failures
+     * are logged rather than reported.
+     * @param archive_id
+     * @param begin
+     * @param end
+     * @param data The contents of the range.
+     */
+    void write(std::string_view archive_id, size_t begin, size_t end, char const* data);
+
+private:
+    // Methods
+    /**
+     * @param archive_id
+     * @param begin
+     * @param end
+     * @return The path of the entry for the given range.
+     */
+    [[nodiscard]] auto
+    get_entry_path(std::string_view archive_id, size_t begin, size_t end) const -> std::string;
+
+    /**
+     * Removes the least recently used entries until the cache is within its capacity, along with
+     * any stale temporary files, and resets the size estimate to the cache's actual size.
+     */
+    void evict();
+
+    // Variables
+    std::string m_cache_dir;
+    size_t m_capacity;
+    std::atomic_size_t m_num_temp_files_created{0};
+    std::atomic_size_t m_num_entries_written{0};
+    std::atomic_size_t m_size_estimate{0};
+};
+}  // namespace clp_s
+
+#endif  // CLP_S_ARCHIVECACHE_HPP
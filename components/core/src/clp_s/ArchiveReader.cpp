@@ -2,7 +2,9 @@
 
 #include <cstddef>
 #include <cstdint>
+#include <limits>
 #include <memory>
+#include <span>
 #include <system_error>
 #include <utility>
 #include <vector>
@@ -21,7 +23,11 @@
 #include <clp_s/ReaderUtils.hpp>
 
 namespace clp_s {
-void ArchiveReader::open(Path const& archive_path, NetworkAuthOption const& network_auth) {
+void ArchiveReader::open(
+        Path const& archive_path,
+        NetworkAuthOption const& network_auth,
+        std::shared_ptr<ArchiveCache> archive_cache
+) {
     if (m_is_open) {
         throw OperationFailed(ErrorCodeNotReady, __FILENAME__, __LINE__);
     }
@@ -31,7 +37,11 @@ void ArchiveReader::open(Path const& archive_path, NetworkAuthOption const& netw
         throw OperationFailed(ErrorCodeBadParam, __FILENAME__, __LINE__);
     }
 
-    m_archive_reader_adaptor = std::make_shared<ArchiveReaderAdaptor>(archive_path, network_auth);
+    m_archive_reader_adaptor = std::make_shared<ArchiveReaderAdaptor>(
+            archive_path,
+            network_auth,
+            std::move(archive_cache)
+    );
     initialize_archive_reader();
 }
 
@@ -110,13 +120,36 @@ auto ArchiveReader::read_single_schema_metadata()
         return std::errc::io_error;
     }
 
-    return std::make_pair(
-            schema_id,
-            SchemaReader::SchemaMetadata{stream_id, stream_offset, num_messages}
-    );
+    SchemaReader::SchemaMetadata metadata{stream_id, stream_offset, num_messages};
+    if (get_header().has_schema_log_event_idx_ranges()) {
+        int64_t begin_log_event_idx{0};
+        if (auto const error{
+                    m_table_metadata_decompressor.try_read_numeric_value(begin_log_event_idx)
+            };
+            ErrorCodeSuccess != error)
+        {
+            return std::errc::io_error;
+        }
+
+        int64_t end_log_event_idx{0};
+        if (auto const error{
+                    m_table_metadata_decompressor.try_read_numeric_value(end_log_event_idx)
+            };
+            ErrorCodeSuccess != error)
+        {
+            return std::errc::io_error;
+        }
+        metadata.set_log_event_idx_range(begin_log_event_idx, end_log_event_idx);
+    }
+
+    return std::make_pair(schema_id, metadata);
 }
 
 auto ArchiveReader::read_metadata() -> ystdlib::error_handling::Result<void> {
+    if (m_is_metadata_read) {
+        return ystdlib::error_handling::success();
+    }
+
     constexpr size_t cDecompressorFileReadBufferCapacity{64 * 1024};  // 64 KiB
     auto table_metadata_reader = m_archive_reader_adaptor->checkout_reader_for_section(
             constants::cArchiveTableMetadataFile
@@ -182,6 +215,7 @@ auto ArchiveReader::read_metadata() -> ystdlib::error_handling::Result<void> {
     m_table_metadata_decompressor.close();
 
     m_archive_reader_adaptor->checkin_reader_for_section(constants::cArchiveTableMetadataFile);
+    m_is_metadata_read = true;
 
     return ystdlib::error_handling::success();
 }
@@ -199,6 +233,29 @@ void ArchiveReader::open_packed_streams() {
     m_stream_reader.open_packed_streams(m_archive_reader_adaptor);
 }
 
+void ArchiveReader::close_packed_streams() {
+    m_stream_reader.close_packed_streams();
+    m_cur_stream_id = 0;
+    m_stream_buffer.reset();
+    m_stream_buffer_size = 0ULL;
+}
+
+void ArchiveReader::prefetch_schema_tables(std::span<int32_t const> schema_ids) {
+    // Tables are packed into streams in schema order, so consecutive schemas may share a stream
+    std::vector<size_t> stream_ids;
+    for (auto const schema_id : schema_ids) {
+        auto const it{m_id_to_schema_metadata.find(schema_id)};
+        if (m_id_to_schema_metadata.end() == it) {
+            throw OperationFailed(ErrorCodeFileNotFound, __FILENAME__, __LINE__);
+        }
+        auto const stream_id{it->second.stream_id()};
+        if (stream_ids.empty() || stream_ids.back() != stream_id) {
+            stream_ids.push_back(stream_id);
+        }
+    }
+    m_stream_reader.prefetch_streams(std::move(stream_ids));
+}
+
 SchemaReader& ArchiveReader::read_schema_table(
         int32_t schema_id,
         bool should_extract_timestamp,
@@ -226,19 +283,58 @@ SchemaReader& ArchiveReader::read_schema_table(
 }
 
 std::vector<std::shared_ptr<SchemaReader>> ArchiveReader::read_all_tables() {
-    std::vector<std::shared_ptr<SchemaReader>> readers;
-    readers.reserve(m_id_to_schema_metadata.size());
+    return read_tables_in_log_event_idx_range(
+            std::numeric_limits<int64_t>::min(),
+            std::numeric_limits<int64_t>::max()
+    );
+}
+
+std::vector<std::shared_ptr<SchemaReader>> ArchiveReader::read_tables_in_log_event_idx_range(
+        int64_t begin_log_event_idx,
+        int64_t end_log_event_idx
+) {
+    auto readers = read_tables_in_log_event_idx_ranges({{begin_log_event_idx, end_log_event_idx}});
+    return std::move(readers.front());
+}
+
+std::vector<std::vector<std::shared_ptr<SchemaReader>>>
+ArchiveReader::read_tables_in_log_event_idx_ranges(
+        std::vector<std::pair<int64_t, int64_t>> const& log_event_idx_ranges
+) {
+    std::vector<std::vector<std::shared_ptr<SchemaReader>>> readers(log_event_idx_ranges.size());
     for (auto schema_id : m_schema_ids) {
-        auto schema_reader = std::make_shared<SchemaReader>();
-        initialize_schema_reader(*schema_reader, schema_id, true, true);
         auto const& schema_metadata = m_id_to_schema_metadata[schema_id];
-        auto stream_buffer = read_stream(schema_metadata.stream_id(), false);
-        schema_reader->load(
-                stream_buffer,
-                schema_metadata.stream_offset(),
-                schema_metadata.uncompressed_size()
-        );
-        readers.push_back(std::move(schema_reader));
+        std::shared_ptr<char[]> stream_buffer;
+        std::shared_ptr<SchemaReader> prev_schema_reader;
+        int64_t prev_begin_log_event_idx{};
+        for (size_t i = 0; i < log_event_idx_ranges.size(); ++i) {
+            auto const [begin_log_event_idx, end_log_event_idx] = log_event_idx_ranges[i];
+            if (false
+                == schema_metadata
+                           .overlaps_log_event_idx_range(begin_log_event_idx, end_log_event_idx))
+            {
+                continue;
+            }
+            if (nullptr == stream_buffer) {
+                stream_buffer = read_stream(schema_metadata.stream_id(), false);
+            }
+            auto schema_reader = std::make_shared<SchemaReader>();
+            initialize_schema_reader(*schema_reader, schema_id, true, true);
+            schema_reader->load(
+                    stream_buffer,
+                    schema_metadata.stream_offset(),
+                    schema_metadata.uncompressed_size()
+            );
+            // Continue from the previous range's position so that positioning every reader scans
+            // the table at most once
+            if (nullptr != prev_schema_reader && prev_begin_log_event_idx <= begin_log_event_idx) {
+                schema_reader->seek_to_message_of(*prev_schema_reader);
+            }
+            schema_reader->skip_to_log_event_idx(begin_log_event_idx);
+            prev_schema_reader = schema_reader;
+            prev_begin_log_event_idx = begin_log_event_idx;
+            readers[i].push_back(std::move(schema_reader));
+        }
     }
     return readers;
 }
@@ -443,6 +539,7 @@ void ArchiveReader::close() {
     m_stream_reader.close();
     m_archive_reader_adaptor.reset();
 
+    m_is_metadata_read = false;
     m_id_to_schema_metadata.clear();
     m_schema_ids.clear();
     m_cur_stream_id = 0;
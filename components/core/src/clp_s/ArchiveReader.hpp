@@ -2,6 +2,7 @@
 #define CLP_S_ARCHIVEREADER_HPP
 
 #include <cstddef>
+#include <cstdint>
 #include <map>
 #include <memory>
 #include <span>
@@ -13,6 +14,7 @@
 #include <nlohmann/json_fwd.hpp>
 #include <ystdlib/error_handling/Result.hpp>
 
+#include <clp_s/ArchiveCache.hpp>
 #include <clp_s/ArchiveReaderAdaptor.hpp>
 #include <clp_s/DictionaryEntry.hpp>
 #include <clp_s/DictionaryReader.hpp>
@@ -41,8 +43,13 @@ public:
      * Opens an archive for reading.
      * @param archive_path
      * @param network_auth
+     * @param archive_cache An optional cache for single-file archives read over the network.
      */
-    void open(Path const& archive_path, NetworkAuthOption const& network_auth);
+    void open(
+            Path const& archive_path,
+            NetworkAuthOption const& network_auth,
+            std::shared_ptr<ArchiveCache> archive_cache = nullptr
+    );
 
     /**
      * Opens a single-file archive for reading from an already open `clp::ReaderInterface`.
@@ -65,6 +72,21 @@ public:
      */
     void open_packed_streams();
 
+    /**
+     * Closes the packed streams, leaving the archive open so that it can be searched again without
+     * re-reading its metadata and dictionaries. Does nothing if the packed streams aren't open.
+     */
+    void close_packed_streams();
+
+    /**
+     * Starts decompressing the tables for the given schemas in the background, ahead of calls to
+     * `read_schema_table`. Must be invoked after `open_packed_streams` and before any table is
+     * read, after which only the given schemas' tables may be read, in the given order.
+     * @param schema_ids the schemas whose tables will be read, in the order of `get_schema_ids`
+     * @throws OperationFailed if any schema doesn't exist in the archive.
+     */
+    void prefetch_schema_tables(std::span<int32_t const> schema_ids);
+
     /**
      * Reads the variable dictionary from the archive.
      * @param lazy
@@ -96,7 +118,7 @@ public:
     }
 
     /**
-     * Reads the metadata from the archive.
+     * Reads the metadata from the archive. Does nothing if the metadata has already been read.
      * @return A void result on success, or an error code indicating the failure:
      * - Forwards `ArchiveReader::read_single_schema_metadata`'s return values on failure.
      * - Forwards `PackedStreamReader::read_metadata`'s return values on failure.
@@ -125,6 +147,31 @@ public:
      */
     std::vector<std::shared_ptr<SchemaReader>> read_all_tables();
 
+    /**
+     * Loads the tables that may contain records in the range [begin_log_event_idx,
+     * end_log_event_idx) and returns SchemaReaders for them. Only the streams containing these
+     * tables are decompressed. For archives without per-table log event index ranges, every table
+     * is loaded. Each reader is positioned on its first message at or after begin_log_event_idx.
+     * @param begin_log_event_idx
+     * @param end_log_event_idx
+     * @return the schema readers for the tables overlapping the range
+     */
+    std::vector<std::shared_ptr<SchemaReader>>
+    read_tables_in_log_event_idx_range(int64_t begin_log_event_idx, int64_t end_log_event_idx);
+
+    /**
+     * Loads a separate set of SchemaReaders for each of the given ranges of log event indices, as
+     * in `read_tables_in_log_event_idx_range`. Each stream is decompressed at most once and shared
+     * by every reader of its tables, so the sets of readers can be iterated independently (e.g.,
+     * by different threads). If the ranges are in ascending order, positioning every reader of a
+     * table scans it only once.
+     * @param log_event_idx_ranges The ranges as [begin, end) pairs
+     * @return the schema readers for the tables overlapping each range
+     */
+    std::vector<std::vector<std::shared_ptr<SchemaReader>>> read_tables_in_log_event_idx_ranges(
+            std::vector<std::pair<int64_t, int64_t>> const& log_event_idx_ranges
+    );
+
     std::string_view get_archive_id() { return m_archive_id; }
 
     std::shared_ptr<VariableDictionaryReader> get_variable_dictionary() { return m_var_dict; }
@@ -272,6 +319,7 @@ private:
     std::shared_ptr<char[]> read_stream(size_t stream_id, bool reuse_buffer);
 
     bool m_is_open;
+    bool m_is_metadata_read{false};
     std::string m_archive_id;
     std::shared_ptr<VariableDictionaryReader> m_var_dict;
     std::shared_ptr<LogTypeDictionaryReader> m_log_dict;
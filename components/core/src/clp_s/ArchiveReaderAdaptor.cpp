@@ -7,6 +7,7 @@
 #include <optional>
 #include <string>
 #include <string_view>
+#include <system_error>
 #include <utility>
 #include <vector>
 
@@ -17,21 +18,38 @@
 #include "../clp/BoundedReader.hpp"
 #include "../clp/ErrorCode.hpp"
 #include "../clp/FileReader.hpp"
+#include "../clp/IoUringFileReader.hpp"
 #include "archive_constants.hpp"
+#include "ArchiveCache.hpp"
+#include "CachedArchiveReader.hpp"
 #include "ErrorCode.hpp"
 #include "InputConfig.hpp"
 #include "RangeIndexWriter.hpp"
 #include "ReaderUtils.hpp"
 #include "SingleFileArchiveDefs.hpp"
 
+#if CLP_BUILD_CLP_S_ENABLE_CURL
+    #include "../clp/RangeNetworkReader.hpp"
+#endif
+
 namespace clp_s {
+namespace {
+// Sections smaller than a full read-ahead window don't benefit enough from io_uring to pay for
+// setting up a ring, so they're read with a plain file reader
+constexpr size_t cMinIoUringSectionSize{
+        clp::IoUringFileReader::cDefaultBlockSize * clp::IoUringFileReader::cDefaultQueueDepth
+};
+}  // namespace
+
 ArchiveReaderAdaptor::ArchiveReaderAdaptor(
         Path const& archive_path,
-        NetworkAuthOption const& network_auth
+        NetworkAuthOption const& network_auth,
+        std::shared_ptr<ArchiveCache> archive_cache
 )
         : m_archive_path{archive_path},
           m_network_auth{network_auth},
-          m_timestamp_dictionary{std::make_shared<TimestampDictionaryReader>()} {
+          m_timestamp_dictionary{std::make_shared<TimestampDictionaryReader>()},
+          m_archive_cache{std::move(archive_cache)} {
     if (InputSource::Filesystem != archive_path.source
         || std::filesystem::is_regular_file(archive_path.path))
     {
@@ -189,11 +207,13 @@ ErrorCode ArchiveReaderAdaptor::load_archive_metadata() {
         return ErrorCodeFileNotFound;
     }
 
+    prefetch_ranges({{0, sizeof(m_archive_header)}});
     if (auto const rc = try_read_header(*m_reader); ErrorCodeSuccess != rc) {
         return rc;
     }
 
     m_files_section_offset = sizeof(m_archive_header) + m_archive_header.metadata_section_size;
+    prefetch_ranges({{sizeof(m_archive_header), m_files_section_offset}});
     clp::BoundedReader bounded_reader{m_reader.get(), m_files_section_offset};
     ZstdDecompressor decompressor;
     decompressor.open(bounded_reader, cDecompressorFileReadBufferCapacity);
@@ -287,9 +307,25 @@ std::shared_ptr<clp::ReaderInterface> ArchiveReaderAdaptor::try_create_reader_at
             SPDLOG_ERROR("Failed to open archive header for reading - {}", e.what());
             return nullptr;
         }
-    } else {
-        return try_create_reader(m_archive_path, m_network_auth);
     }
+
+    auto reader{try_create_random_access_reader(m_archive_path, m_network_auth)};
+    if (nullptr == reader || nullptr == m_archive_cache
+        || InputSource::Network != m_archive_path.source)
+    {
+        return reader;
+    }
+
+    std::string archive_id;
+    if (false == get_archive_id_from_path(m_archive_path, archive_id)) {
+        return reader;
+    }
+    m_cached_reader = std::make_shared<CachedArchiveReader>(
+            m_archive_cache,
+            std::move(archive_id),
+            std::move(reader)
+    );
+    return m_cached_reader;
 }
 
 std::unique_ptr<clp::ReaderInterface> ArchiveReaderAdaptor::checkout_reader_for_section(
@@ -302,9 +338,16 @@ std::unique_ptr<clp::ReaderInterface> ArchiveReaderAdaptor::checkout_reader_for_
     m_current_reader_holder.emplace(section);
     if (m_single_file_archive) {
         return checkout_reader_for_sfa_section(section);
-    } else {
-        return std::make_unique<clp::FileReader>(m_archive_path.path + std::string{section});
     }
+
+    auto const section_path{m_archive_path.path + std::string{section}};
+    std::error_code ec;
+    if (auto const section_size{std::filesystem::file_size(section_path, ec)};
+        false == static_cast<bool>(ec) && section_size >= cMinIoUringSectionSize)
+    {
+        return std::make_unique<clp::IoUringFileReader>(section_path);
+    }
+    return std::make_unique<clp::FileReader>(section_path);
 }
 
 std::unique_ptr<clp::ReaderInterface> ArchiveReaderAdaptor::checkout_reader_for_sfa_section(
@@ -339,21 +382,55 @@ std::unique_ptr<clp::ReaderInterface> ArchiveReaderAdaptor::checkout_reader_for_
         next_file_offset = m_files_section_offset + it->o;
     }
 
-    if (curr_pos > file_offset) {
-        throw OperationFailed(ErrorCodeCorrupt, __FILENAME__, __LINE__);
-    }
-
     if (curr_pos != file_offset) {
+        // Readers that only support forward seeks fail to seek backward
         if (auto rc = m_reader->try_seek_from_begin(file_offset);
             clp::ErrorCode::ErrorCode_Success != rc)
         {
-            throw OperationFailed(ErrorCodeFailure, __FILENAME__, __LINE__);
+            throw OperationFailed(
+                    curr_pos > file_offset ? ErrorCodeCorrupt : ErrorCodeFailure,
+                    __FILENAME__,
+                    __LINE__
+            );
         }
     }
 
+    // The packed streams in the tables section are prefetched individually as they're read (see
+    // `PackedStreamReader`), so only the other sections are prefetched in full.
+    if (constants::cArchiveTablesFile != section) {
+        prefetch_ranges({{file_offset, next_file_offset}});
+    }
+
     return std::make_unique<clp::BoundedReader>(m_reader.get(), next_file_offset);
 }
 
+void ArchiveReaderAdaptor::prefetch_ranges(std::vector<std::pair<size_t, size_t>> const& ranges) {
+    [[maybe_unused]] auto* reader{m_reader.get()};
+    auto const* ranges_to_download{&ranges};
+    std::vector<std::pair<size_t, size_t>> uncached_ranges;
+    if (nullptr != m_cached_reader) {
+        uncached_ranges = m_cached_reader->add_ranges(ranges);
+        ranges_to_download = &uncached_ranges;
+        reader = m_cached_reader->get_reader().get();
+    }
+    if (ranges_to_download->empty()) {
+        return;
+    }
+
+#if CLP_BUILD_CLP_S_ENABLE_CURL
+    auto* range_network_reader{dynamic_cast<clp::RangeNetworkReader*>(reader)};
+    if (nullptr == range_network_reader) {
+        return;
+    }
+    // Any ranges that fail to download are downloaded again (and any error reported) when read
+    if (auto const rc{range_network_reader->prefetch(*ranges_to_download)};
+        clp::ErrorCode_Success != rc)
+    {
+        SPDLOG_WARN("Failed to prefetch archive ranges - {}", static_cast<int>(rc));
+    }
+#endif
+}
+
 void ArchiveReaderAdaptor::checkin_reader_for_section(std::string_view section) {
     if (false == m_current_reader_holder.has_value()) {
         throw OperationFailed(ErrorCodeNotInit, __FILENAME__, __LINE__);
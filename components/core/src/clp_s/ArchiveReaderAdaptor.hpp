@@ -18,6 +18,8 @@
 
 #include "../clp/BoundedReader.hpp"
 #include "../clp/ReaderInterface.hpp"
+#include "ArchiveCache.hpp"
+#include "CachedArchiveReader.hpp"
 #include "InputConfig.hpp"
 #include "SingleFileArchiveDefs.hpp"
 #include "TimestampDictionaryReader.hpp"
@@ -58,8 +60,14 @@ public:
      * Creates an adaptor for an archive identified by path and source type.
      * @param archive_path Path/URL for a directory archive or a single-file archive.
      * @param network_auth Authentication options for network inputs.
+     * @param archive_cache An optional cache for the sections and packed streams of single-file
+     * archives read over the network.
      */
-    explicit ArchiveReaderAdaptor(Path const& archive_path, NetworkAuthOption const& network_auth);
+    explicit ArchiveReaderAdaptor(
+            Path const& archive_path,
+            NetworkAuthOption const& network_auth,
+            std::shared_ptr<ArchiveCache> archive_cache = nullptr
+    );
 
     /**
      * Creates an adaptor around an already opened single-file archive reader.
@@ -85,6 +93,16 @@ public:
      */
     std::unique_ptr<clp::ReaderInterface> checkout_reader_for_section(std::string_view section);
 
+    /**
+     * Hints that the given byte ranges of a single-file archive are about to be read, allowing
+     * readers that support it (i.e., readers for archives accessed over the network) to download
+     * them in advance. If the archive is cached, each range is also cached as a unit. This is a
+     * no-op for other readers.
+     * @param ranges The ranges, [begin, end), as offsets from the beginning of the archive, in
+     * ascending order.
+     */
+    void prefetch_ranges(std::vector<std::pair<size_t, size_t>> const& ranges);
+
     /**
      * Checks in a reader for a given section of the archive.
      * @param section
@@ -164,7 +182,8 @@ private:
      * @param section
      * @return A ReaderInterface opened and pointing to the requested section.
      * @throw OperationFailed if the requested section does not exist in ArchiveFileInfo, if
-     *        checking out the section would force a backward seek, or on any I/O error.
+     *        checking out the section would force a backward seek that the underlying reader
+     *        doesn't support, or on any I/O error.
      */
     std::unique_ptr<clp::ReaderInterface> checkout_reader_for_sfa_section(std::string_view section);
 
@@ -194,6 +213,9 @@ private:
     std::optional<std::string> m_current_reader_holder;
     std::shared_ptr<TimestampDictionaryReader> m_timestamp_dictionary;
     std::shared_ptr<clp::ReaderInterface> m_reader;
+    std::shared_ptr<ArchiveCache> m_archive_cache;
+    // Set if `m_reader` reads through `m_archive_cache`
+    std::shared_ptr<CachedArchiveReader> m_cached_reader;
     std::vector<RangeIndexEntry> m_range_index;
     std::map<int64_t, nlohmann::json> m_non_empty_range_metadata_map;
 };
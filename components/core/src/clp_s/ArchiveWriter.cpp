@@ -219,23 +219,9 @@ void ArchiveWriter::write_archive_files(
         FileWriter& archive_writer,
         std::vector<ArchiveFileInfo> const& files
 ) {
-    FileReader reader;
     for (auto const& file : files) {
         std::string file_path = m_archive_path + file.n;
-        reader.open(file_path);
-        char read_buffer[cReadBlockSize];
-        while (true) {
-            size_t num_bytes_read{0};
-            ErrorCode const error_code
-                    = reader.try_read(read_buffer, cReadBlockSize, num_bytes_read);
-            if (ErrorCodeEndOfFile == error_code) {
-                break;
-            } else if (ErrorCodeSuccess != error_code) {
-                throw OperationFailed(error_code, __FILENAME__, __LINE__);
-            }
-            archive_writer.write(read_buffer, num_bytes_read);
-        }
-        reader.close();
+        archive_writer.write_file_contents(file_path);
         if (false == std::filesystem::remove(file_path)) {
             throw OperationFailed(ErrorCodeFileExists, __FILENAME__, __LINE__);
         }
@@ -263,7 +249,7 @@ ArchiveWriter::append_message(int32_t schema_id, Schema const& schema, ParsedMes
         it = m_id_to_schema_writer.emplace(schema_id, std::move(schema_writer)).first;
     }
 
-    m_encoded_message_size += it->second->append_message(message);
+    m_encoded_message_size += it->second->append_message(message, m_next_log_event_id);
     ++m_next_log_event_id;
 }
 
@@ -425,7 +411,9 @@ std::pair<size_t, size_t> ArchiveWriter::store_tables() {
                 current_stream_id,
                 current_stream_offset,
                 it->first,
-                it->second->get_num_messages()
+                it->second->get_num_messages(),
+                it->second->get_begin_log_event_idx(),
+                it->second->get_end_log_event_idx()
         );
         current_stream_offset += it->second->get_total_uncompressed_size();
 
@@ -459,6 +447,8 @@ std::pair<size_t, size_t> ArchiveWriter::store_tables() {
         m_table_metadata_compressor.write_numeric_value(schema.stream_offset);
         m_table_metadata_compressor.write_numeric_value(schema.schema_id);
         m_table_metadata_compressor.write_numeric_value(schema.num_messages);
+        m_table_metadata_compressor.write_numeric_value(schema.begin_log_event_idx);
+        m_table_metadata_compressor.write_numeric_value(schema.end_log_event_idx);
     }
     m_table_metadata_compressor.close();
 
@@ -124,17 +124,23 @@ public:
                 uint64_t stream_id,
                 uint64_t stream_offset,
                 int32_t schema_id,
-                uint64_t num_messages
+                uint64_t num_messages,
+                int64_t begin_log_event_idx,
+                int64_t end_log_event_idx
         )
                 : stream_id(stream_id),
                   stream_offset(stream_offset),
                   schema_id(schema_id),
-                  num_messages(num_messages) {}
+                  num_messages(num_messages),
+                  begin_log_event_idx(begin_log_event_idx),
+                  end_log_event_idx(end_log_event_idx) {}
 
         uint64_t stream_id{};
         uint64_t stream_offset{};
         int32_t schema_id{};
         uint64_t num_messages{};
+        int64_t begin_log_event_idx{};
+        int64_t end_log_event_idx{};
     };
 
     // Constructor
@@ -336,8 +342,6 @@ private:
      */
     void write_archive_header(FileWriter& archive_writer, size_t metadata_section_size);
 
-    static constexpr size_t cReadBlockSize = 4 * 1024;
-
     size_t m_encoded_message_size{};
     size_t m_uncompressed_size{};
     size_t m_compressed_size{};
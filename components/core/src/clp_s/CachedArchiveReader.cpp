@@ -0,0 +1,141 @@
+#include "CachedArchiveReader.hpp"
+
+#include <algorithm>
+#include <cstddef>
+#include <cstring>
+#include <iterator>
+#include <memory>
+#include <string>
+#include <utility>
+#include <vector>
+
+#include "../clp/ErrorCode.hpp"
+#include "ArchiveCache.hpp"
+#include "ErrorCode.hpp"
+
+namespace clp_s {
+CachedArchiveReader::CachedArchiveReader(
+        std::shared_ptr<ArchiveCache> archive_cache,
+        std::string archive_id,
+        std::shared_ptr<clp::ReaderInterface> reader
+)
+        : m_archive_cache{std::move(archive_cache)},
+          m_archive_id{std::move(archive_id)},
+          m_reader{std::move(reader)} {
+    if (nullptr == m_archive_cache || nullptr == m_reader) {
+        throw OperationFailed(ErrorCodeBadParam, __FILENAME__, __LINE__);
+    }
+}
+
+auto CachedArchiveReader::try_read(char* buf, size_t num_bytes_to_read, size_t& num_bytes_read)
+        -> clp::ErrorCode {
+    if (nullptr == buf) {
+        return clp::ErrorCode_BadParam;
+    }
+
+    num_bytes_read = 0;
+    while (num_bytes_read < num_bytes_to_read) {
+        auto const num_bytes_remaining{num_bytes_to_read - num_bytes_read};
+        auto const loaded_range_end{m_loaded_range_begin + m_loaded_range_data.size()};
+        if (m_pos >= m_loaded_range_begin && m_pos < loaded_range_end) {
+            auto const num_bytes_to_copy{std::min(num_bytes_remaining, loaded_range_end - m_pos)};
+            std::memcpy(
+                    buf + num_bytes_read,
+                    m_loaded_range_data.data() + (m_pos - m_loaded_range_begin),
+                    num_bytes_to_copy
+            );
+            m_pos += num_bytes_to_copy;
+            num_bytes_read += num_bytes_to_copy;
+            continue;
+        }
+
+        auto const next_range_it{m_ranges.upper_bound(m_pos)};
+        if (m_ranges.begin() != next_range_it && m_pos < std::prev(next_range_it)->second) {
+            auto const [begin, end] = *std::prev(next_range_it);
+            if (auto const rc{try_load_range(begin, end)}; clp::ErrorCode_Success != rc) {
+                return rc;
+            }
+            continue;
+        }
+
+        // The position isn't in any registered range, so read directly from the underlying reader,
+        // stopping at the next registered range
+        auto num_bytes_to_read_directly{num_bytes_remaining};
+        if (m_ranges.end() != next_range_it) {
+            num_bytes_to_read_directly
+                    = std::min(num_bytes_to_read_directly, next_range_it->first - m_pos);
+        }
+        if (auto const rc{m_reader->try_seek_from_begin(m_pos)}; clp::ErrorCode_Success != rc) {
+            return rc;
+        }
+        size_t num_bytes_read_directly{0};
+        auto const rc{m_reader->try_read(
+                buf + num_bytes_read,
+                num_bytes_to_read_directly,
+                num_bytes_read_directly
+        )};
+        if (clp::ErrorCode_EndOfFile == rc) {
+            break;
+        }
+        if (clp::ErrorCode_Success != rc) {
+            return rc;
+        }
+        m_pos += num_bytes_read_directly;
+        num_bytes_read += num_bytes_read_directly;
+    }
+
+    if (0 == num_bytes_read && num_bytes_to_read > 0) {
+        return clp::ErrorCode_EndOfFile;
+    }
+    return clp::ErrorCode_Success;
+}
+
+auto CachedArchiveReader::add_ranges(std::vector<std::pair<size_t, size_t>> const& ranges)
+        -> std::vector<std::pair<size_t, size_t>> {
+    std::vector<std::pair<size_t, size_t>> uncached_ranges;
+    for (auto const& [begin, end] : ranges) {
+        if (begin >= end) {
+            continue;
+        }
+
+        auto const next_range_it{m_ranges.upper_bound(begin)};
+        if (m_ranges.begin() != next_range_it && std::prev(next_range_it)->second > begin) {
+            auto const [prev_begin, prev_end] = *std::prev(next_range_it);
+            if (prev_begin != begin || prev_end != end) {
+                // The range overlaps a different registered range
+                continue;
+            }
+        } else if (m_ranges.end() != next_range_it && next_range_it->first < end) {
+            // The range overlaps the next registered range
+            continue;
+        } else {
+            m_ranges.emplace_hint(next_range_it, begin, end);
+        }
+
+        if (false == m_archive_cache->contains(m_archive_id, begin, end)) {
+            uncached_ranges.emplace_back(begin, end);
+        }
+    }
+    return uncached_ranges;
+}
+
+auto CachedArchiveReader::try_load_range(size_t begin, size_t end) -> clp::ErrorCode {
+    std::vector<char> data;
+    if (false == m_archive_cache->try_read(m_archive_id, begin, end, data)) {
+        data.resize(end - begin);
+        if (auto const rc{m_reader->try_seek_from_begin(begin)}; clp::ErrorCode_Success != rc) {
+            return rc;
+        }
+        if (auto const rc{m_reader->try_read_exact_length(data.data(), data.size())};
+            clp::ErrorCode_Success != rc)
+        {
+            return rc;
+        }
+        m_archive_cache->write(m_archive_id, begin, end, data.data());
+    }
+
+    m_loaded_range_begin = begin;
+    m_loaded_range_data = std::move(data);
+    return clp::ErrorCode_Success;
+}
+}  // namespace clp_s
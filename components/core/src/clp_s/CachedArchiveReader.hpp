@@ -0,0 +1,122 @@
+#ifndef CLP_S_CACHEDARCHIVEREADER_HPP
+#define CLP_S_CACHEDARCHIVEREADER_HPP
+
+#include <cstddef>
+#include <map>
+#include <memory>
+#include <string>
+#include <utility>
+#include <vector>
+
+#include "../clp/ErrorCode.hpp"
+#include "../clp/ReaderInterface.hpp"
+#include "ArchiveCache.hpp"
+#include "ErrorCode.hpp"
+#include "TraceableException.hpp"
+
+namespace clp_s {
+/**
+ * A reader for a single-file archive that serves registered byte ranges of the archive (e.g.,
+ * sections and packed streams) from an `ArchiveCache`, only reading a range from the underlying
+ * reader (and adding it to the cache) if it isn't cached. Reads outside of the registered ranges
+ * are always served by the underlying reader.
+ *
+ * The most recently read range is kept in memory, so reading a range in several parts only reads
+ * it from the cache once.
+ */
+class CachedArchiveReader : public clp::ReaderInterface {
+public:
+    // Types
+    class OperationFailed : public TraceableException {
+    public:
+        // Constructors
+        OperationFailed(ErrorCode error_code, char const* const filename, int line_number)
+                : TraceableException(error_code, filename, line_number) {}
+    };
+
+    // Constructors
+    /**
+     * @param archive_cache
+     * @param archive_id
+     * @param reader The underlying reader for the archive, which must support seeking backward.
+     * @throw CachedArchiveReader::OperationFailed if `archive_cache` or `reader` are null.
+     */
+    CachedArchiveReader(
+            std::shared_ptr<ArchiveCache> archive_cache,
+            std::string archive_id,
+            std::shared_ptr<clp::ReaderInterface> reader
+    );
+
+    // Methods implementing `clp::ReaderInterface`
+    /**
+     * @param buf
+     * @param num_bytes_to_read
+     * @param num_bytes_read Returns the number of bytes read.
+     * @return clp::ErrorCode_BadParam if `buf` is null.
+     * @return clp::ErrorCode_EndOfFile if the read head is at the end of the archive.
+     * @return Any error returned by the underlying reader.
+     * @return clp::ErrorCode_Success on success.
+     */
+    [[nodiscard]] auto try_read(char* buf, size_t num_bytes_to_read, size_t& num_bytes_read)
+            -> clp::ErrorCode override;
+
+    /**
+     * Seeks to the given position. Since data is only read from the underlying reader when it's
+     * needed, this method never fails.
+     * @param pos
+     * @return clp::ErrorCode_Success
+     */
+    [[nodiscard]] auto try_seek_from_begin(size_t pos) -> clp::ErrorCode override {
+        m_pos = pos;
+        return clp::ErrorCode_Success;
+    }
+
+    /**
+     * @param pos Returns the position of the read head.
+     * @return clp::ErrorCode_Success
+     */
+    [[nodiscard]] auto try_get_pos(size_t& pos) -> clp::ErrorCode override {
+        pos = m_pos;
+        return clp::ErrorCode_Success;
+    }
+
+    // Methods
+    /**
+     * Registers byte ranges of the archive that should be cached. Ranges that overlap a registered
+     * range (other than identical ones) are ignored, so they're never cached.
+     * @param ranges The ranges, [begin, end), as offsets from the beginning of the archive.
+     * @return The given ranges that are registered (including ones that were already registered)
+     * but aren't cached yet.
+     */
+    [[nodiscard]] auto add_ranges(std::vector<std::pair<size_t, size_t>> const& ranges)
+            -> std::vector<std::pair<size_t, size_t>>;
+
+    [[nodiscard]] auto get_reader() const -> std::shared_ptr<clp::ReaderInterface> const& {
+        return m_reader;
+    }
+
+private:
+    // Methods
+    /**
+     * Loads the given range into memory, from the cache if possible, or otherwise from the
+     * underlying reader (adding it to the cache).
+     * @param begin
+     * @param end
+     * @return clp::ErrorCode_Success on success, or the error returned by the underlying reader.
+     */
+    [[nodiscard]] auto try_load_range(size_t begin, size_t end) -> clp::ErrorCode;
+
+    // Variables
+    std::shared_ptr<ArchiveCache> m_archive_cache;
+    std::string m_archive_id;
+    std::shared_ptr<clp::ReaderInterface> m_reader;
+
+    // Maps the beginning of each registered range to its end
+    std::map<size_t, size_t> m_ranges;
+    size_t m_pos{0};
+    size_t m_loaded_range_begin{0};
+    std::vector<char> m_loaded_range_data;
+};
+}  // namespace clp_s
+
+#endif  // CLP_S_CACHEDARCHIVEREADER_HPP
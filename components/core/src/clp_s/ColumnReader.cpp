@@ -1,5 +1,7 @@
 #include "ColumnReader.hpp"
 
+#include <array>
+#include <charconv>
 #include <cstddef>
 #include <cstdint>
 #include <string>
@@ -21,6 +23,23 @@
 #include <clp_s/Utils.hpp>
 
 namespace clp_s {
+namespace {
+/**
+ * Appends the decimal representation of an integer to the buffer without allocating a temporary
+ * string.
+ * @param value
+ * @param buffer
+ */
+auto append_int64(int64_t value, std::string& buffer) -> void;
+
+auto append_int64(int64_t value, std::string& buffer) -> void {
+    // 19 digits and a sign
+    std::array<char, 20> digits{};
+    auto const result{std::to_chars(digits.data(), digits.data() + digits.size(), value)};
+    buffer.append(digits.data(), result.ptr);
+}
+}  // namespace
+
 auto Int64ColumnReader::load(BufferViewReader& reader, uint64_t num_messages) -> void {
     m_values = reader.read_unaligned_span_u64<int64_t>(num_messages);
 }
@@ -70,14 +89,14 @@ auto FormattedFloatColumnReader::load(BufferViewReader& reader, uint64_t num_mes
 
 auto Int64ColumnReader::extract_string_value_into_buffer(uint64_t cur_message, std::string& buffer)
         -> void {
-    buffer.append(std::to_string(m_values[cur_message]));
+    append_int64(m_values[cur_message], buffer);
 }
 
 auto DeltaEncodedInt64ColumnReader::extract_string_value_into_buffer(
         uint64_t cur_message,
         std::string& buffer
 ) -> void {
-    buffer.append(std::to_string(get_value_at_idx(cur_message)));
+    append_int64(get_value_at_idx(cur_message), buffer);
 }
 
 auto FloatColumnReader::extract_value(uint64_t cur_message)
@@ -174,9 +193,9 @@ auto ClpStringColumnReader::extract_escaped_string_value_into_buffer(
 ) -> void {
     if (false == m_is_array) {
         // TODO: escape while decoding instead of after.
-        std::string tmp;
-        extract_string_value_into_buffer(cur_message, tmp);
-        StringUtils::escape_json_string(buffer, tmp);
+        m_unescaped_value_buffer.clear();
+        extract_string_value_into_buffer(cur_message, m_unescaped_value_buffer);
+        StringUtils::escape_json_string(buffer, m_unescaped_value_buffer);
     } else {
         extract_string_value_into_buffer(cur_message, buffer);
     }
@@ -188,9 +207,9 @@ auto ClpStringColumnReader::extract_escaped_string_value_into_buffer(
         SimdJsonStringEscaper& escaper
 ) -> void {
     if (false == m_is_array) {
-        std::string tmp;
-        extract_string_value_into_buffer(cur_message, tmp);
-        escaper.escape(buffer, tmp);
+        m_unescaped_value_buffer.clear();
+        extract_string_value_into_buffer(cur_message, m_unescaped_value_buffer);
+        escaper.escape(buffer, m_unescaped_value_buffer);
     } else {
         extract_string_value_into_buffer(cur_message, buffer);
     }
@@ -143,6 +143,16 @@ public:
      */
     [[nodiscard]] auto get_value_at_idx(size_t idx) -> int64_t;
 
+    /**
+     * Positions this reader on the index that `other` is positioned on, so that getting values near
+     * that index doesn't require summing the deltas from the start of the column.
+     * @param other A reader loaded from the same column
+     */
+    auto seek_to_idx_of(DeltaEncodedInt64ColumnReader const& other) -> void {
+        m_cur_idx = other.m_cur_idx;
+        m_cur_value = other.m_cur_value;
+    }
+
 private:
     UnalignedMemSpan<int64_t> m_values;
     int64_t m_cur_value{};
@@ -299,6 +309,9 @@ private:
 
     UnalignedMemSpan<uint64_t> m_logtypes;
     UnalignedMemSpan<int64_t> m_encoded_vars;
+    // Scratch buffer for the unescaped value, reused across messages to avoid an allocation per
+    // escaped value
+    std::string m_unescaped_value_buffer;
 
     bool m_is_array;
 };
@@ -0,0 +1,222 @@
+#include "ColumnarBatchSerializer.hpp"
+
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <span>
+#include <string>
+#include <string_view>
+#include <variant>
+
+#include <msgpack.hpp>
+
+#include "ColumnReader.hpp"
+#include "Schema.hpp"
+#include "SchemaReader.hpp"
+#include "SchemaTree.hpp"
+#include "search/OutputHandler.hpp"
+
+namespace clp_s {
+namespace {
+using Packer = msgpack::packer<msgpack::sbuffer>;
+
+/**
+ * Packs a string.
+ * @param packer
+ * @param str
+ */
+auto pack_string(Packer& packer, std::string_view str) -> void;
+
+/**
+ * Packs fixed-width values as a bin.
+ * @tparam T
+ * @param packer
+ * @param values
+ */
+template <typename T>
+auto pack_fixed_width_values(Packer& packer, std::span<T const> values) -> void;
+
+/**
+ * Packs the values of a column for the given messages as a bin of fixed-width values.
+ * @tparam T The type of the values, which must be the type held in the column reader's extracted
+ * value variant.
+ * @param packer
+ * @param column
+ * @param message_idxs
+ * @param buffer A scratch buffer for the values
+ */
+template <typename T>
+auto pack_extracted_values(
+        Packer& packer,
+        BaseColumnReader& column,
+        std::span<uint64_t const> message_idxs,
+        std::string& buffer
+) -> void;
+
+auto pack_string(Packer& packer, std::string_view str) -> void {
+    packer.pack_str(static_cast<uint32_t>(str.size()));
+    packer.pack_str_body(str.data(), static_cast<uint32_t>(str.size()));
+}
+
+template <typename T>
+auto pack_fixed_width_values(Packer& packer, std::span<T const> values) -> void {
+    auto const num_bytes{static_cast<uint32_t>(values.size_bytes())};
+    packer.pack_bin(num_bytes);
+    packer.pack_bin_body(reinterpret_cast<char const*>(values.data()), num_bytes);
+}
+
+template <typename T>
+auto pack_extracted_values(
+        Packer& packer,
+        BaseColumnReader& column,
+        std::span<uint64_t const> message_idxs,
+        std::string& buffer
+) -> void {
+    buffer.resize(message_idxs.size() * sizeof(T));
+    for (size_t i{0}; i < message_idxs.size(); ++i) {
+        auto const value{std::get<T>(column.extract_value(message_idxs[i]))};
+        std::memcpy(buffer.data() + i * sizeof(T), &value, sizeof(T));
+    }
+    auto const num_bytes{static_cast<uint32_t>(buffer.size())};
+    packer.pack_bin(num_bytes);
+    packer.pack_bin_body(buffer.data(), num_bytes);
+}
+}  // namespace
+
+auto ColumnarBatchSerializer::serialize(search::ColumnarBatch const& batch, msgpack::sbuffer& buffer)
+        -> void {
+    Packer packer{buffer};
+    if (false == m_archive_serialized || batch.archive_id != m_archive_id) {
+        m_archive_id = batch.archive_id;
+        m_archive_serialized = true;
+        m_serialized_variable_ids.clear();
+        serialize_archive(batch, packer);
+    }
+
+    constexpr uint32_t cNumBatchFields{8};
+    packer.pack_map(cNumBatchFields);
+    pack_string(packer, "type");
+    pack_string(packer, "batch");
+    pack_string(packer, "archive_id");
+    pack_string(packer, batch.archive_id);
+    pack_string(packer, "schema_id");
+    packer.pack(batch.reader.get_schema_id());
+    pack_string(packer, "num_records");
+    packer.pack(static_cast<uint64_t>(batch.message_idxs.size()));
+    pack_string(packer, "timestamps");
+    pack_fixed_width_values(packer, batch.timestamps);
+    pack_string(packer, "log_event_idxs");
+    pack_fixed_width_values(packer, batch.log_event_idxs);
+
+    m_new_variables.clear();
+    auto const& columns{batch.reader.get_columns()};
+    pack_string(packer, "columns");
+    packer.pack_array(static_cast<uint32_t>(columns.size()));
+    for (size_t column_idx{0}; column_idx < columns.size(); ++column_idx) {
+        auto* column{columns[column_idx]};
+        constexpr uint32_t cNumColumnFields{3};
+        packer.pack_map(cNumColumnFields);
+        pack_string(packer, "node_id");
+        packer.pack(column->get_id());
+        pack_string(packer, "node_type");
+        packer.pack(static_cast<uint8_t>(column->get_type()));
+        pack_string(packer, "values");
+        serialize_column_values(batch, column_idx, packer);
+    }
+
+    pack_string(packer, "variable_dictionary");
+    packer.pack_array(static_cast<uint32_t>(m_new_variables.size()));
+    for (auto const& [id, value] : m_new_variables) {
+        packer.pack_array(2);
+        packer.pack(id);
+        pack_string(packer, value);
+    }
+}
+
+auto ColumnarBatchSerializer::serialize_archive(
+        search::ColumnarBatch const& batch,
+        msgpack::packer<msgpack::sbuffer>& packer
+) -> void {
+    constexpr uint32_t cNumArchiveFields{4};
+    packer.pack_map(cNumArchiveFields);
+    pack_string(packer, "type");
+    pack_string(packer, "archive");
+    pack_string(packer, "archive_id");
+    pack_string(packer, batch.archive_id);
+
+    auto const& nodes{batch.schema_tree.get_nodes()};
+    pack_string(packer, "schema_tree");
+    packer.pack_array(static_cast<uint32_t>(nodes.size()));
+    for (auto const& node : nodes) {
+        constexpr uint32_t cNumNodeFields{4};
+        packer.pack_array(cNumNodeFields);
+        packer.pack(node.get_id());
+        packer.pack(node.get_parent_id());
+        packer.pack(static_cast<uint8_t>(node.get_type()));
+        pack_string(packer, node.get_key_name());
+    }
+
+    pack_string(packer, "schemas");
+    packer.pack_array(static_cast<uint32_t>(batch.schemas.size()));
+    for (auto const& [schema_id, schema] : batch.schemas) {
+        constexpr uint32_t cNumSchemaFields{3};
+        packer.pack_array(cNumSchemaFields);
+        packer.pack(schema_id);
+        packer.pack(static_cast<uint64_t>(schema.get_num_ordered()));
+        packer.pack_array(static_cast<uint32_t>(schema.size()));
+        for (auto const entry : schema) {
+            packer.pack(entry);
+        }
+    }
+}
+
+auto ColumnarBatchSerializer::serialize_column_values(
+        search::ColumnarBatch const& batch,
+        size_t column_idx,
+        msgpack::packer<msgpack::sbuffer>& packer
+) -> void {
+    auto& column{*batch.reader.get_columns()[column_idx]};
+    auto const message_idxs{batch.message_idxs};
+    switch (column.get_type()) {
+        case NodeType::Integer:
+        case NodeType::DeltaInteger:
+            pack_extracted_values<int64_t>(packer, column, message_idxs, m_value_buffer);
+            break;
+        case NodeType::Float:
+        case NodeType::FormattedFloat:
+        case NodeType::DictionaryFloat:
+            pack_extracted_values<double>(packer, column, message_idxs, m_value_buffer);
+            break;
+        case NodeType::Boolean:
+            pack_extracted_values<uint8_t>(packer, column, message_idxs, m_value_buffer);
+            break;
+        case NodeType::VarString: {
+            auto& var_string_column{static_cast<VariableStringColumnReader&>(column)};
+            m_value_buffer.resize(message_idxs.size() * sizeof(uint64_t));
+            for (size_t i{0}; i < message_idxs.size(); ++i) {
+                auto const id{var_string_column.get_variable_id(message_idxs[i])};
+                std::memcpy(m_value_buffer.data() + i * sizeof(id), &id, sizeof(id));
+                if (m_serialized_variable_ids.emplace(id).second) {
+                    m_new_variables.emplace_back(id, std::string{});
+                    var_string_column.extract_string_value_into_buffer(
+                            message_idxs[i],
+                            m_new_variables.back().second
+                    );
+                }
+            }
+            auto const num_bytes{static_cast<uint32_t>(m_value_buffer.size())};
+            packer.pack_bin(num_bytes);
+            packer.pack_bin_body(m_value_buffer.data(), num_bytes);
+            break;
+        }
+        default:
+            packer.pack_array(static_cast<uint32_t>(message_idxs.size()));
+            for (auto const message_idx : message_idxs) {
+                m_value_buffer.clear();
+                column.extract_string_value_into_buffer(message_idx, m_value_buffer);
+                pack_string(packer, m_value_buffer);
+            }
+            break;
+    }
+}
+}  // namespace clp_s
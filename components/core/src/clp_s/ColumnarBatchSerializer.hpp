@@ -0,0 +1,97 @@
+#ifndef CLP_S_COLUMNARBATCHSERIALIZER_HPP
+#define CLP_S_COLUMNARBATCHSERIALIZER_HPP
+
+#include <cstdint>
+#include <string>
+#include <unordered_set>
+#include <utility>
+#include <vector>
+
+#include <msgpack.hpp>
+
+#include "search/OutputHandler.hpp"
+
+namespace clp_s {
+/**
+ * Serializes columnar batches of search results into a stream of msgpack maps, so that consumers
+ * can process results without generating and reparsing JSON for every record.
+ *
+ * The first batch from each archive is preceded by an archive map:
+ * - "type": "archive"
+ * - "archive_id": The archive's ID
+ * - "schema_tree": An array of [node_id, parent_id, node_type, key_name] for every node in the
+ *   archive's schema tree, where node_type is the underlying value of `NodeType`
+ * - "schemas": An array of [schema_id, num_ordered, entries] for every schema in the archive, where
+ *   entries is the schema's full list of entries as stored in the archive (see `Schema`):
+ *   - The first num_ordered entries are the IDs of the record's nodes outside of structured
+ *     arrays, including nodes without a column (e.g., null values and empty objects).
+ *   - The remaining entries describe the record's structured arrays. An entry with a non-zero most
+ *     significant byte is a delimiter whose most significant byte is the `NodeType` of an array or
+ *     object, and whose remaining bits are the number of entries that follow it in that array or
+ *     object.
+ *   A batch's columns are the schema's entries that have values, in order.
+ *
+ * Each batch is then serialized as a batch map:
+ * - "type": "batch"
+ * - "archive_id": The archive's ID
+ * - "schema_id": The ID of the table the records belong to
+ * - "num_records": The number of records in the batch
+ * - "timestamps": A bin of `num_records` int64 timestamps
+ * - "log_event_idxs": A bin of `num_records` int64 log event indices
+ * - "columns": An array of maps, one per column, containing "node_id", "node_type", and "values"
+ * - "variable_dictionary": An array of [id, value] for each variable dictionary entry referenced
+ *   by a VarString column that wasn't sent in an earlier batch from the same archive
+ *
+ * Column values are encoded according to the node type:
+ * - Integer and DeltaInteger: a bin of int64 values;
+ * - Float, FormattedFloat, and DictionaryFloat: a bin of doubles;
+ * - Boolean: a bin of uint8 values;
+ * - VarString: a bin of uint64 variable dictionary IDs;
+ * - all other types: an array of the values' string representations.
+ *
+ * Fixed-width values are stored in the host's byte order.
+ */
+class ColumnarBatchSerializer {
+public:
+    // Methods
+    /**
+     * Serializes the batch, preceded by the archive map if this is the first batch from the
+     * batch's archive, and appends it to the given buffer.
+     * @param batch
+     * @param buffer
+     */
+    auto serialize(search::ColumnarBatch const& batch, msgpack::sbuffer& buffer) -> void;
+
+private:
+    // Methods
+    /**
+     * Serializes the archive map of the batch's archive.
+     * @param batch
+     * @param packer
+     */
+    static auto
+    serialize_archive(search::ColumnarBatch const& batch, msgpack::packer<msgpack::sbuffer>& packer)
+            -> void;
+
+    /**
+     * Serializes the values of one column of the batch.
+     * @param batch
+     * @param column_idx
+     * @param packer
+     */
+    auto serialize_column_values(
+            search::ColumnarBatch const& batch,
+            size_t column_idx,
+            msgpack::packer<msgpack::sbuffer>& packer
+    ) -> void;
+
+    // Variables
+    std::string m_archive_id;
+    bool m_archive_serialized{false};
+    std::unordered_set<uint64_t> m_serialized_variable_ids;
+    std::vector<std::pair<uint64_t, std::string>> m_new_variables;
+    std::string m_value_buffer;
+};
+}  // namespace clp_s
+
+#endif  // CLP_S_COLUMNARBATCHSERIALIZER_HPP
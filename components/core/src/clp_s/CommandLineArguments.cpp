@@ -1,10 +1,12 @@
 #include "CommandLineArguments.hpp"
 
 #include <algorithm>
+#include <array>
 #include <filesystem>
 #include <iostream>
 #include <optional>
 #include <string_view>
+#include <utility>
 
 #include <boost/program_options.hpp>
 #include <fmt/format.h>
@@ -302,11 +304,13 @@ CommandLineArguments::parse_arguments(int argc, char const** argv) {
                 std::cerr << "  c - compress" << std::endl;
                 std::cerr << "  x - decompress" << std::endl;
                 std::cerr << "  s - search" << std::endl;
+                std::cerr << "  d - serve searches from a resident process" << std::endl;
                 std::cerr << std::endl;
                 std::cerr << "Try "
                           << " c --help OR"
                           << " x --help OR"
-                          << " s --help for command-specific details." << std::endl;
+                          << " s --help OR"
+                          << " d --help for command-specific details." << std::endl;
 
                 po::options_description visible_options;
                 visible_options.add(general_options);
@@ -321,6 +325,7 @@ CommandLineArguments::parse_arguments(int argc, char const** argv) {
             case (char)Command::Compress:
             case (char)Command::Extract:
             case (char)Command::Search:
+            case (char)Command::Serve:
                 m_command = (Command)command_input;
                 break;
             default:
@@ -598,6 +603,24 @@ CommandLineArguments::parse_arguments(int argc, char const** argv) {
                     "print-ordered-chunk-stats",
                     po::bool_switch(&m_print_ordered_chunk_stats),
                     "Print statistics (ndjson) about each chunk file after it's extracted."
+            )(
+                    "begin-log-event-idx",
+                    po::value<int64_t>(&m_begin_log_event_idx)
+                            ->default_value(m_begin_log_event_idx)
+                            ->value_name("IDX"),
+                    "Index of the first log event to decompress when decompressing records in log"
+                    " order."
+            )(
+                    "end-log-event-idx",
+                    po::value<int64_t>(&m_end_log_event_idx)->value_name("IDX"),
+                    "Index one past the last log event to decompress when decompressing records in"
+                    " log order. Defaults to the end of the archive."
+            )(
+                    "num-threads",
+                    po::value<size_t>(&m_num_decompression_threads)
+                            ->default_value(m_num_decompression_threads)
+                            ->value_name("NUM"),
+                    "Number of threads to use to decompress records in log order."
             )(
                     "archive-id",
                     po::value<std::string>(&archive_id)->value_name("ID"),
@@ -685,6 +708,19 @@ CommandLineArguments::parse_arguments(int argc, char const** argv) {
                     );
                 }
 
+                if (1 != m_num_decompression_threads) {
+                    throw std::invalid_argument("num-threads must be used with ordered argument");
+                }
+
+                if (0 != m_begin_log_event_idx
+                    || parsed_command_line_options.count("end-log-event-idx") > 0)
+                {
+                    throw std::invalid_argument(
+                            "begin-log-event-idx and end-log-event-idx must be used with ordered"
+                            " argument"
+                    );
+                }
+
                 if (false == m_mongodb_uri.empty()) {
                     throw std::invalid_argument(
                             "Recording decompression metadata only supported for ordered"
@@ -693,6 +729,19 @@ CommandLineArguments::parse_arguments(int argc, char const** argv) {
                 }
             }
 
+            if (0 == m_num_decompression_threads) {
+                throw std::invalid_argument("num-threads must be non-zero");
+            }
+
+            if (m_begin_log_event_idx < 0) {
+                throw std::invalid_argument("begin-log-event-idx cannot be negative");
+            }
+            if (m_begin_log_event_idx >= m_end_log_event_idx) {
+                throw std::invalid_argument(
+                        "end-log-event-idx must be greater than begin-log-event-idx"
+                );
+            }
+
             // We use xor to check that these arguments are either both specified or both
             // unspecified.
             if (m_mongodb_uri.empty() ^ m_mongodb_collection.empty()) {
@@ -768,6 +817,18 @@ CommandLineArguments::parse_arguments(int argc, char const** argv) {
                 "Type of authentication required for network requests (s3 | none). Authentication"
                 " with s3 requires the AWS_ACCESS_KEY_ID and AWS_SECRET_ACCESS_KEY environment"
                 " variables, and optionally the AWS_SESSION_TOKEN environment variable."
+            )(
+                "archive-cache-dir",
+                po::value<std::string>(&m_archive_cache_dir)->value_name("DIR"),
+                "Cache the sections of archives read over the network in DIR, which may be shared"
+                " by concurrent searches"
+            )(
+                "archive-cache-size",
+                po::value<size_t>(&m_archive_cache_size)
+                    ->value_name("SIZE")
+                    ->default_value(m_archive_cache_size),
+                "Maximum size of the archive cache (B), beyond which the least recently used"
+                " sections are evicted"
             );
             // clang-format on
             search_options.add(match_options);
@@ -781,6 +842,28 @@ CommandLineArguments::parse_arguments(int argc, char const** argv) {
                 "count-by-time",
                 po::value<int64_t>(&m_count_by_time_bucket_size_ms)->value_name("SIZE"),
                 "Count the number of results in each time span of the given size (ms)"
+            )(
+                "sum",
+                po::value<std::string>()->value_name("FIELD"),
+                "Sum the numeric values of the given field across results"
+            )(
+                "min",
+                po::value<std::string>()->value_name("FIELD"),
+                "Find the minimum numeric value of the given field across results"
+            )(
+                "max",
+                po::value<std::string>()->value_name("FIELD"),
+                "Find the maximum numeric value of the given field across results"
+            )(
+                "avg",
+                po::value<std::string>()->value_name("FIELD"),
+                "Average the numeric values of the given field across results"
+            )(
+                "group-by",
+                po::value<std::vector<std::string>>(&m_group_by_fields)->value_name("FIELD"),
+                "Compute the sum/min/max/avg aggregation separately for each distinct value of the"
+                " given field. Can be specified multiple times to group by several fields. Records"
+                " where the field is missing are grouped under the tag \"undefined\"."
             );
             // clang-format on
             search_options.add(aggregation_options);
@@ -799,6 +882,10 @@ CommandLineArguments::parse_arguments(int argc, char const** argv) {
                     "port",
                     po::value<int>(&network_options.port)->value_name("PORT"),
                     "Network destination port"
+            )(
+                    "columnar",
+                    po::bool_switch(&network_options.columnar),
+                    "Send results as columnar batches instead of as individual records"
             );
             // clang-format on
 
@@ -863,6 +950,10 @@ CommandLineArguments::parse_arguments(int argc, char const** argv) {
                     "path",
                     po::value<std::string>(&file_options.output_path)->value_name("PATH"),
                     "File output path"
+            )(
+                    "columnar",
+                    po::bool_switch(&file_options.columnar),
+                    "Write results as columnar batches instead of as individual records"
             );
 
             std::vector<std::string> unrecognized_options
@@ -936,6 +1027,17 @@ CommandLineArguments::parse_arguments(int argc, char const** argv) {
                           << " --job-id 1" << std::endl;
                 std::cerr << std::endl;
 
+                std::cerr << "  # Search archives in archives-dir for logs matching a KQL query"
+                             R"( "level: INFO" and output the average latency of each service to)"
+                             " the reducer"
+                          << std::endl;
+                std::cerr << "  " << m_program_name << R"( s archives-dir "level: INFO")"
+                          << " --avg latency --group-by service"
+                          << " " << cReducerOutputHandlerName << " --host localhost"
+                          << " --port 14009"
+                          << " --job-id 1" << std::endl;
+                std::cerr << std::endl;
+
                 std::cerr << "  # Search archives in archives-dir for logs matching a KQL query"
                              R"( "level: INFO" and output a count aggregation to the results cache)"
                           << std::endl;
@@ -1002,6 +1104,13 @@ CommandLineArguments::parse_arguments(int argc, char const** argv) {
 
             validate_network_auth(auth, m_network_auth);
 
+            if (0 == m_archive_cache_size) {
+                throw std::invalid_argument("archive-cache-size must be greater than 0");
+            }
+            m_archive_cache_specified
+                    = parsed_command_line_options.count("archive-cache-dir") > 0
+                      || false == parsed_command_line_options["archive-cache-size"].defaulted();
+
             if (m_query.empty()) {
                 throw std::invalid_argument("No query specified");
             }
@@ -1026,10 +1135,7 @@ CommandLineArguments::parse_arguments(int argc, char const** argv) {
                 throw std::invalid_argument("clp-s only supports one output handler at a time");
             }
 
-            m_aggregation_type = parse_aggregation_options(
-                    parsed_command_line_options,
-                    m_count_by_time_bucket_size_ms
-            );
+            parse_aggregation_options(parsed_command_line_options);
 
             for (auto const& [output_handler_name, output_handler_options] : output_options_map) {
                 if (cNetworkOutputHandlerName == output_handler_name) {
@@ -1067,6 +1173,7 @@ CommandLineArguments::parse_arguments(int argc, char const** argv) {
                         )};
                         throw std::invalid_argument(error_msg);
                     }
+                    reject_field_aggregation_for_handler(cStdoutCacheOutputHandlerName);
                     m_output_handler_options.emplace<StdoutOutputHandlerOptions>();
                 } else if (cFileOutputHandlerName == output_handler_name) {
                     parse_file_output_handler_options(
@@ -1083,6 +1190,97 @@ CommandLineArguments::parse_arguments(int argc, char const** argv) {
                     throw std::invalid_argument("Unknown OUTPUT_HANDLER: " + output_handler_name);
                 }
             }
+        } else if ((char)Command::Serve == command_input) {
+            po::options_description serve_positional_options;
+            // clang-format off
+            serve_positional_options.add_options()(
+                    "socket-path",
+                    po::value<std::string>(&m_socket_path),
+                    "Path of the Unix domain socket to listen for search requests on"
+            );
+            // clang-format on
+            po::positional_options_description positional_options;
+            positional_options.add("socket-path", 1);
+
+            po::options_description serve_options("Search Server Options");
+            // clang-format off
+            serve_options.add_options()(
+                    "max-open-archives",
+                    po::value<size_t>(&m_max_open_archives)
+                        ->value_name("NUM")
+                        ->default_value(m_max_open_archives),
+                    "Maximum number of archives to keep open between searches, beyond which the"
+                    " least recently searched archives are closed"
+            )(
+                    "archive-cache-dir",
+                    po::value<std::string>(&m_archive_cache_dir)->value_name("DIR"),
+                    "Cache the sections of archives read over the network in DIR, which may be"
+                    " shared by concurrent searches"
+            )(
+                    "archive-cache-size",
+                    po::value<size_t>(&m_archive_cache_size)
+                        ->value_name("SIZE")
+                        ->default_value(m_archive_cache_size),
+                    "Maximum size of the archive cache (B), beyond which the least recently used"
+                    " sections are evicted"
+            );
+            // clang-format on
+            serve_positional_options.add(serve_options);
+
+            std::vector<std::string> unrecognized_options
+                    = po::collect_unrecognized(parsed.options, po::include_positional);
+            unrecognized_options.erase(unrecognized_options.begin());
+            po::store(
+                    po::command_line_parser(unrecognized_options)
+                            .options(serve_positional_options)
+                            .positional(positional_options)
+                            .run(),
+                    parsed_command_line_options
+            );
+
+            po::notify(parsed_command_line_options);
+
+            if (parsed_command_line_options.count("help")) {
+                print_serve_usage();
+
+                std::cerr << "Each connection to the socket should send a single search request: a"
+                             " JSON array containing the arguments of the search command (i.e.,"
+                             " the arguments that follow \"s\"), terminated by a newline. Results"
+                             " that would be written to stdout are written to the connection,"
+                             " which is closed once the search completes."
+                          << std::endl;
+                std::cerr << std::endl;
+
+                std::cerr << "Examples:" << std::endl;
+                std::cerr << "  # Serve searches on /tmp/clp-s.sock" << std::endl;
+                std::cerr << "  " << m_program_name << " d /tmp/clp-s.sock" << std::endl;
+                std::cerr << std::endl;
+
+                std::cerr << "  # Search archives in archives-dir for logs matching a KQL query"
+                             R"( "level: INFO" using the server)"
+                          << std::endl;
+                std::cerr << R"(  echo '["archives-dir", "level: INFO"]' | nc -U /tmp/clp-s.sock)"
+                          << std::endl;
+                std::cerr << std::endl;
+
+                po::options_description visible_options;
+                visible_options.add(general_options);
+                visible_options.add(serve_options);
+                std::cerr << visible_options << '\n';
+                return ParsingResult::InfoCommand;
+            }
+
+            if (m_socket_path.empty()) {
+                throw std::invalid_argument("No socket path specified");
+            }
+
+            if (0 == m_max_open_archives) {
+                throw std::invalid_argument("max-open-archives must be greater than 0");
+            }
+
+            if (0 == m_archive_cache_size) {
+                throw std::invalid_argument("archive-cache-size must be greater than 0");
+            }
         }
     } catch (std::exception& e) {
         SPDLOG_ERROR("{}", e.what());
@@ -1120,10 +1318,15 @@ void CommandLineArguments::parse_network_dest_output_handler_options(
     }
 }
 
-auto CommandLineArguments::parse_aggregation_options(
-        po::variables_map const& parsed_options,
-        int64_t count_by_time_bucket_size_ms
-) -> std::optional<AggregationType> {
+auto CommandLineArguments::parse_aggregation_options(po::variables_map const& parsed_options)
+        -> void {
+    constexpr std::array<std::pair<std::string_view, AggregationType>, 4> cFieldAggregations{
+            {{"sum", AggregationType::Sum},
+             {"min", AggregationType::Min},
+             {"max", AggregationType::Max},
+             {"avg", AggregationType::Avg}}
+    };
+
     std::optional<AggregationType> aggregation_type;
     if (parsed_options.count("count")) {
         aggregation_type = AggregationType::Count;
@@ -1135,13 +1338,44 @@ auto CommandLineArguments::parse_aggregation_options(
             );
         }
 
-        if (count_by_time_bucket_size_ms <= 0) {
+        if (m_count_by_time_bucket_size_ms <= 0) {
             throw std::invalid_argument("Value for count-by-time must be greater than zero.");
         }
 
         aggregation_type = AggregationType::CountByTime;
     }
-    return aggregation_type;
+    for (auto const& [option_name, field_aggregation_type] : cFieldAggregations) {
+        std::string const option{option_name};
+        if (0 == parsed_options.count(option)) {
+            continue;
+        }
+        if (aggregation_type.has_value()) {
+            throw std::invalid_argument(
+                    "The --count, --count-by-time, --sum, --min, --max, and --avg options are"
+                    " mutually exclusive."
+            );
+        }
+
+        m_aggregation_field = parsed_options[option].as<std::string>();
+        if (m_aggregation_field.empty()) {
+            throw std::invalid_argument(fmt::format("Field for {} cannot be empty.", option));
+        }
+        aggregation_type = field_aggregation_type;
+    }
+
+    if (false == m_group_by_fields.empty()) {
+        if (m_aggregation_field.empty()) {
+            throw std::invalid_argument(
+                    "The --group-by option requires one of --sum, --min, --max, or --avg."
+            );
+        }
+        for (auto const& field : m_group_by_fields) {
+            if (field.empty()) {
+                throw std::invalid_argument("Field for group-by cannot be empty.");
+            }
+        }
+    }
+    m_aggregation_type = aggregation_type;
 }
 
 auto CommandLineArguments::reject_aggregation_for_handler(std::string_view handler_name) const
@@ -1153,6 +1387,16 @@ auto CommandLineArguments::reject_aggregation_for_handler(std::string_view handl
     }
 }
 
+auto CommandLineArguments::reject_field_aggregation_for_handler(std::string_view handler_name) const
+        -> void {
+    if (false == m_aggregation_field.empty()) {
+        throw std::invalid_argument(fmt::format(
+                "The {} output handler does not support sum, min, max, or avg aggregations.",
+                handler_name
+        ));
+    }
+}
+
 void CommandLineArguments::parse_reducer_output_handler_options(
         po::options_description const& options_description,
         std::vector<std::string> const& options,
@@ -1185,8 +1429,8 @@ void CommandLineArguments::parse_reducer_output_handler_options(
 
     if (false == m_aggregation_type.has_value()) {
         throw std::invalid_argument(
-                "The reducer output handler currently only supports count and count-by-time"
-                " aggregations."
+                "The reducer output handler requires a count, count-by-time, sum, min, max, or"
+                " avg aggregation."
         );
     }
 }
@@ -1199,6 +1443,8 @@ void CommandLineArguments::parse_results_cache_output_handler_options(
     po::variables_map parsed_options;
     parse_subcommand_options(options_description, options, parsed_options);
 
+    reject_field_aggregation_for_handler(cResultsCacheOutputHandlerName);
+
     if (parsed_options.count("uri") == 0) {
         throw std::invalid_argument("uri must be specified.");
     }
@@ -1260,4 +1506,8 @@ void CommandLineArguments::print_search_usage() const {
                  " [OUTPUT_HANDLER [OUTPUT_HANDLER_OPTIONS]]"
               << std::endl;
 }
+
+void CommandLineArguments::print_serve_usage() const {
+    std::cerr << "Usage: " << m_program_name << " d [OPTIONS] SOCKET_PATH" << std::endl;
+}
 }  // namespace clp_s
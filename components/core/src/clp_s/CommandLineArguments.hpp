@@ -1,6 +1,9 @@
 #ifndef CLP_S_COMMANDLINEARGUMENTS_HPP
 #define CLP_S_COMMANDLINEARGUMENTS_HPP
 
+#include <cstddef>
+#include <cstdint>
+#include <limits>
 #include <optional>
 #include <string>
 #include <string_view>
@@ -12,6 +15,7 @@
 #include <boost/program_options/variables_map.hpp>
 
 #include "../reducer/types.hpp"
+#include "ArchiveCache.hpp"
 #include "Defs.hpp"
 #include "InputConfig.hpp"
 
@@ -28,12 +32,17 @@ public:
     enum class Command : char {
         Compress = 'c',
         Extract = 'x',
-        Search = 's'
+        Search = 's',
+        Serve = 'd'
     };
 
     enum class AggregationType : uint8_t {
         Count,
         CountByTime,
+        Sum,
+        Min,
+        Max,
+        Avg,
     };
 
     struct ResultsCacheOutputHandlerOptions {
@@ -46,11 +55,13 @@ public:
 
     struct FileOutputHandlerOptions {
         std::string output_path;
+        bool columnar{false};
     };
 
     struct NetworkOutputHandlerOptions {
         std::string host;
         int port{};
+        bool columnar{false};
     };
 
     struct ReducerOutputHandlerOptions {
@@ -119,6 +130,24 @@ public:
 
     [[nodiscard]] auto get_enable_telemetry() const -> bool { return m_enable_telemetry; }
 
+    [[nodiscard]] auto get_archive_cache_dir() const -> std::string const& {
+        return m_archive_cache_dir;
+    }
+
+    [[nodiscard]] auto get_archive_cache_size() const -> size_t { return m_archive_cache_size; }
+
+    /**
+     * @return Whether the archive cache was configured explicitly (rather than left at its
+     * defaults) by the search command's arguments.
+     */
+    [[nodiscard]] auto get_archive_cache_specified() const -> bool {
+        return m_archive_cache_specified;
+    }
+
+    [[nodiscard]] auto get_socket_path() const -> std::string const& { return m_socket_path; }
+
+    [[nodiscard]] auto get_max_open_archives() const -> size_t { return m_max_open_archives; }
+
     auto get_output_handler_options() const -> OutputHandlerOptionsVariant const& {
         return m_output_handler_options;
     }
@@ -131,6 +160,14 @@ public:
         return m_count_by_time_bucket_size_ms;
     }
 
+    [[nodiscard]] auto get_aggregation_field() const -> std::string const& {
+        return m_aggregation_field;
+    }
+
+    [[nodiscard]] auto get_group_by_fields() const -> std::vector<std::string> const& {
+        return m_group_by_fields;
+    }
+
     [[nodiscard]] auto get_retain_float_format() const -> bool {
         return false == m_no_retain_float_format;
     }
@@ -143,6 +180,14 @@ public:
 
     size_t get_target_ordered_chunk_size() const { return m_target_ordered_chunk_size; }
 
+    [[nodiscard]] auto get_begin_log_event_idx() const -> int64_t { return m_begin_log_event_idx; }
+
+    [[nodiscard]] auto get_end_log_event_idx() const -> int64_t { return m_end_log_event_idx; }
+
+    [[nodiscard]] auto get_num_decompression_threads() const -> size_t {
+        return m_num_decompression_threads;
+    }
+
     size_t get_minimum_table_size() const { return m_minimum_table_size; }
 
     std::vector<std::string> const& get_projection_columns() const { return m_projection_columns; }
@@ -165,17 +210,14 @@ private:
     );
 
     /**
-     * Validates the aggregation options (count and count-by-time) for output handlers that
-     * support aggregations.
+     * Validates the aggregation options (count, count-by-time, sum, min, max, avg, and group-by)
+     * for output handlers that support aggregations, and stores the requested aggregation type and
+     * field.
      * @param parsed_options
-     * @param count_by_time_bucket_size_ms The parsed value of the count-by-time option; only
-     * validated when that option was specified.
-     * @return The requested aggregation type, or std::nullopt if no aggregation was requested.
+     * @throws std::invalid_argument if the aggregation options are invalid.
      */
-    [[nodiscard]] static auto parse_aggregation_options(
-            boost::program_options::variables_map const& parsed_options,
-            int64_t count_by_time_bucket_size_ms
-    ) -> std::optional<AggregationType>;
+    auto parse_aggregation_options(boost::program_options::variables_map const& parsed_options)
+            -> void;
 
     /**
      * Throws if an aggregation was requested.
@@ -184,6 +226,13 @@ private:
      */
     auto reject_aggregation_for_handler(std::string_view handler_name) const -> void;
 
+    /**
+     * Throws if an aggregation over a field (sum, min, max, or avg) was requested.
+     * @param handler_name The name of the output handler, used in the error message.
+     * @throws std::invalid_argument if an aggregation over a field was requested.
+     */
+    auto reject_field_aggregation_for_handler(std::string_view handler_name) const -> void;
+
     /**
      * Validates output options related to the Reducer output handler.
      * @param options_description
@@ -232,6 +281,8 @@ private:
 
     void print_search_usage() const;
 
+    void print_serve_usage() const;
+
     // Variables
     std::string m_program_name;
     Command m_command;
@@ -253,6 +304,9 @@ private:
     bool m_ordered_decompression{false};
     size_t m_target_ordered_chunk_size{};
     bool m_print_ordered_chunk_stats{false};
+    int64_t m_begin_log_event_idx{0};
+    int64_t m_end_log_event_idx{std::numeric_limits<int64_t>::max()};
+    size_t m_num_decompression_threads{1};
     size_t m_minimum_table_size{1ULL * 1024 * 1024};  // 1 MiB
     bool m_disable_log_order{false};
     std::string m_mongodb_uri;
@@ -267,10 +321,19 @@ private:
     std::optional<epochtime_t> m_search_end_ts;
     bool m_ignore_case{false};
     bool m_enable_telemetry{false};
+    std::string m_archive_cache_dir;
+    size_t m_archive_cache_size{ArchiveCache::cDefaultCapacity};
+    bool m_archive_cache_specified{false};
     std::vector<std::string> m_projection_columns;
 
     std::optional<AggregationType> m_aggregation_type;
     int64_t m_count_by_time_bucket_size_ms{};
+    std::string m_aggregation_field;
+    std::vector<std::string> m_group_by_fields;
+
+    // Search server variables
+    std::string m_socket_path;
+    size_t m_max_open_archives{64};
 };
 }  // namespace clp_s
 
@@ -47,7 +47,8 @@ public:
     void close();
 
     /**
-     * Reads all entries from disk
+     * Reads all entries from disk. Does nothing if the entries have already been read, unless they
+     * were read lazily and `lazy` is false.
      */
     void read_entries(bool lazy = false);
 
@@ -95,6 +96,8 @@ protected:
     std::string m_dictionary_path;
     ZstdDecompressor m_dictionary_decompressor;
     std::vector<EntryType> m_entries;
+    bool m_are_entries_read{false};
+    bool m_are_entries_read_lazily{false};
 };
 
 using VariableDictionaryReader
@@ -118,6 +121,8 @@ void DictionaryReader<DictionaryIdType, EntryType>::close() {
         throw OperationFailed(ErrorCodeNotReady, __FILENAME__, __LINE__);
     }
     m_is_open = false;
+    m_are_entries_read = false;
+    m_are_entries_read_lazily = false;
 }
 
 template <typename DictionaryIdType, typename EntryType>
@@ -125,6 +130,9 @@ void DictionaryReader<DictionaryIdType, EntryType>::read_entries(bool lazy) {
     if (false == m_is_open) {
         throw OperationFailed(ErrorCodeNotInit, __FILENAME__, __LINE__);
     }
+    if (m_are_entries_read && (lazy || false == m_are_entries_read_lazily)) {
+        return;
+    }
 
     constexpr size_t cDecompressorFileReadBufferCapacity = 64 * 1024;  // 64 KiB
     auto dictionary_reader = m_adaptor.checkout_reader_for_section(m_dictionary_path);
@@ -142,6 +150,8 @@ void DictionaryReader<DictionaryIdType, EntryType>::read_entries(bool lazy) {
 
     m_dictionary_decompressor.close();
     m_adaptor.checkin_reader_for_section(m_dictionary_path);
+    m_are_entries_read = true;
+    m_are_entries_read_lazily = lazy;
 }
 
 template <typename DictionaryIdType, typename EntryType>
@@ -6,9 +6,13 @@
 #include <unistd.h>
 
 #include <cerrno>
+#include <cstddef>
+#include <memory>
 
 #include <spdlog/spdlog.h>
 
+#include "../clp/FileDescriptor.hpp"
+
 using std::string;
 
 namespace clp_s {
@@ -108,6 +112,90 @@ ErrorCode FileWriter::try_seek_from_current(off_t offset) {
     return ErrorCodeSuccess;
 }
 
+void FileWriter::write_file_contents(
+        string const& path,
+        [[maybe_unused]] CopyMethod copy_method
+) {
+    if (nullptr == m_file) {
+        throw OperationFailed(ErrorCodeNotInit, __FILENAME__, __LINE__);
+    }
+
+    // Flush buffered writes, since the copy below bypasses the stream
+    if (0 != fflush(m_file)) {
+        throw OperationFailed(ErrorCodeErrno, __FILENAME__, __LINE__);
+    }
+    auto const begin_pos{get_pos()};
+
+    clp::FileDescriptor const src_fd{path, clp::FileDescriptor::OpenMode::ReadOnly};
+    auto const src_size{src_fd.get_size()};
+    off_t src_pos{0};
+    off_t dest_pos{static_cast<off_t>(begin_pos)};
+
+#if defined(__linux__)
+    while (CopyMethod::KernelIfAvailable == copy_method && static_cast<size_t>(src_pos) < src_size)
+    {
+        auto const num_bytes_copied{copy_file_range(
+                src_fd.get_raw_fd(),
+                &src_pos,
+                m_fd,
+                &dest_pos,
+                src_size - static_cast<size_t>(src_pos),
+                0
+        )};
+        if (num_bytes_copied < 0) {
+            if (EINTR == errno) {
+                continue;
+            }
+            if (EXDEV == errno || ENOSYS == errno || EOPNOTSUPP == errno || EINVAL == errno) {
+                // The kernel can't copy between these files, so copy the rest through a buffer
+                break;
+            }
+            throw OperationFailed(ErrorCodeErrno, __FILENAME__, __LINE__);
+        }
+        if (0 == num_bytes_copied) {
+            break;
+        }
+    }
+#endif
+
+    if (static_cast<size_t>(src_pos) < src_size) {
+        auto const buffer{std::make_unique<char[]>(cCopyBufferSize)};
+        while (true) {
+            auto const num_bytes_read
+                    = pread(src_fd.get_raw_fd(), buffer.get(), cCopyBufferSize, src_pos);
+            if (num_bytes_read < 0) {
+                if (EINTR == errno) {
+                    continue;
+                }
+                throw OperationFailed(ErrorCodeErrno, __FILENAME__, __LINE__);
+            }
+            if (0 == num_bytes_read) {
+                break;
+            }
+            src_pos += num_bytes_read;
+            for (ssize_t num_bytes_written{0}; num_bytes_written < num_bytes_read;) {
+                auto const rc{pwrite(
+                        m_fd,
+                        buffer.get() + num_bytes_written,
+                        num_bytes_read - num_bytes_written,
+                        dest_pos
+                )};
+                if (rc < 0) {
+                    if (EINTR == errno) {
+                        continue;
+                    }
+                    throw OperationFailed(ErrorCodeErrno, __FILENAME__, __LINE__);
+                }
+                num_bytes_written += rc;
+                dest_pos += rc;
+            }
+        }
+    }
+
+    // Move the stream's write head past the copied data
+    seek_from_begin(static_cast<size_t>(dest_pos));
+}
+
 void FileWriter::open(string const& path, OpenMode open_mode) {
     if (nullptr != m_file) {
         throw OperationFailed(ErrorCodeNotInit, __FILENAME__, __LINE__);
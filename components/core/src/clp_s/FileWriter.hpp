@@ -3,6 +3,8 @@
 #ifndef CLP_S_FILEWRITER_HPP
 #define CLP_S_FILEWRITER_HPP
 
+#include <cstddef>
+#include <cstdint>
 #include <cstdio>
 #include <string>
 #include <utility>
@@ -20,6 +22,13 @@ public:
         CreateIfNonexistentForSeekableWriting,
     };
 
+    enum class CopyMethod : uint8_t {
+        // Copy within the kernel if it can copy between the files, or otherwise through a buffer
+        KernelIfAvailable,
+        // Always copy through a buffer
+        Buffered,
+    };
+
     class OperationFailed : public TraceableException {
     public:
         // Constructors
@@ -118,6 +127,24 @@ public:
     ErrorCode try_seek_from_current(off_t offset);
 
     // Methods
+    /**
+     * Writes the entire contents of another file at the current position of the write head.
+     *
+     * On Linux, the data is copied within the kernel using `copy_file_range`, which also lets
+     * filesystems that support reflinks share the data's extents instead of duplicating them.
+     * Elsewhere, or if the kernel can't copy between the two files (even part way through the
+     * copy), the rest of the data is copied through a buffer. The file must not have been opened
+     * for appending.
+     * @param path
+     * @param copy_method
+     * @throw FileWriter::OperationFailed on failure
+     * @throw clp::FileDescriptor::OperationFailed if the file can't be opened
+     */
+    void write_file_contents(
+            std::string const& path,
+            CopyMethod copy_method = CopyMethod::KernelIfAvailable
+    );
+
     /**
      * Opens a file for writing
      * @param path
@@ -133,6 +160,8 @@ public:
     void close();
 
 private:
+    static constexpr size_t cCopyBufferSize{64UL * 1024};
+
     FILE* m_file;
     int m_fd;
 };
@@ -11,6 +11,7 @@
 #include <memory>
 #include <optional>
 #include <string>
+#include <system_error>
 #include <thread>
 #include <vector>
 
@@ -21,16 +22,19 @@
 #include "../clp/ErrorCode.hpp"
 #include "../clp/ffi/ir_stream/protocol_constants.hpp"
 #include "../clp/FileReader.hpp"
+#include "../clp/IoUringFileReader.hpp"
 #include "../clp/ReaderInterface.hpp"
 #include "../clp/spdlog_with_specializations.hpp"
 #include "../clp/streaming_compression/Decompressor.hpp"
 #include "../clp/streaming_compression/zstd/Decompressor.hpp"
+#include "../clp/TraceableException.hpp"
 #include "../clp/utf8_utils.hpp"
 #include "Utils.hpp"
 
 #if CLP_BUILD_CLP_S_ENABLE_CURL
     #include "../clp/aws/AwsAuthenticationSigner.hpp"
     #include "../clp/NetworkReader.hpp"
+    #include "../clp/RangeNetworkReader.hpp"
 #endif
 
 namespace clp_s {
@@ -186,8 +190,14 @@ auto could_be_logtext(char const* peek_buf, size_t peek_size) -> bool;
 auto try_create_file_reader(std::string_view const file_path)
         -> std::shared_ptr<clp::ReaderInterface> {
     try {
+        // Only regular files can be read ahead, so other files (e.g., FIFOs and process
+        // substitutions) are read sequentially
+        std::error_code ec;
+        if (std::filesystem::is_regular_file(file_path, ec)) {
+            return std::make_shared<clp::IoUringFileReader>(std::string{file_path});
+        }
         return std::make_shared<clp::FileReader>(std::string{file_path});
-    } catch (clp::FileReader::OperationFailed const& e) {
+    } catch (clp::TraceableException const& e) {
         SPDLOG_ERROR("Failed to open file for reading - {} - {}", file_path, e.what());
         return nullptr;
     }
@@ -230,19 +240,22 @@ auto try_sign_url(std::string& url) -> bool {
     return true;
 }
 
-auto try_create_network_reader(std::string_view const url, NetworkAuthOption const& auth)
-        -> std::shared_ptr<clp::ReaderInterface> {
-    std::string request_url{url};
+auto try_authenticate_url(std::string& url, NetworkAuthOption const& auth) -> bool {
     switch (auth.method) {
         case AuthMethod::S3PresignedUrlV4:
-            if (false == try_sign_url(request_url)) {
-                return nullptr;
-            }
-            break;
+            return try_sign_url(url);
         case AuthMethod::None:
-            break;
+            return true;
         default:
-            return nullptr;
+            return false;
+    }
+}
+
+auto try_create_network_reader(std::string_view const url, NetworkAuthOption const& auth)
+        -> std::shared_ptr<clp::ReaderInterface> {
+    std::string request_url{url};
+    if (false == try_authenticate_url(request_url, auth)) {
+        return nullptr;
     }
 
     try {
@@ -252,6 +265,21 @@ auto try_create_network_reader(std::string_view const url, NetworkAuthOption con
         return nullptr;
     }
 }
+
+auto try_create_range_network_reader(std::string_view const url, NetworkAuthOption const& auth)
+        -> std::shared_ptr<clp::ReaderInterface> {
+    std::string request_url{url};
+    if (false == try_authenticate_url(request_url, auth)) {
+        return nullptr;
+    }
+
+    try {
+        return std::make_shared<clp::RangeNetworkReader>(request_url);
+    } catch (clp::RangeNetworkReader::OperationFailed const& e) {
+        SPDLOG_ERROR("Failed to open url for reading - {}", e.what());
+        return nullptr;
+    }
+}
 #else
 auto try_create_network_reader(
         [[maybe_unused]] std::string_view const url,
@@ -260,6 +288,11 @@ auto try_create_network_reader(
     SPDLOG_ERROR("This build of clp-s does not support network inputs (libcurl excluded).");
     return nullptr;
 }
+
+auto try_create_range_network_reader(std::string_view const url, NetworkAuthOption const& auth)
+        -> std::shared_ptr<clp::ReaderInterface> {
+    return try_create_network_reader(url, auth);
+}
 #endif
 
 auto could_be_zstd(char const* peek_buf, size_t peek_size) -> bool {
@@ -406,6 +439,14 @@ auto try_create_reader(Path const& path, NetworkAuthOption const& network_auth)
     }
 }
 
+auto try_create_random_access_reader(Path const& path, NetworkAuthOption const& network_auth)
+        -> std::shared_ptr<clp::ReaderInterface> {
+    if (InputSource::Network == path.source) {
+        return try_create_range_network_reader(path.path, network_auth);
+    }
+    return try_create_reader(path, network_auth);
+}
+
 [[nodiscard]] auto try_deduce_reader_type(std::shared_ptr<clp::ReaderInterface> reader)
         -> std::pair<std::vector<std::shared_ptr<clp::ReaderInterface>>, FileType> {
     constexpr size_t cFileReadBufferCapacity = 64 * 1024;  // 64 KiB
@@ -138,6 +138,18 @@ get_input_archives_for_raw_path(std::string_view const path, std::vector<Path>&
 [[nodiscard]] auto try_create_reader(Path const& path, NetworkAuthOption const& network_auth)
         -> std::shared_ptr<clp::ReaderInterface>;
 
+/**
+ * Tries to open a clp::ReaderInterface that supports seeking in both directions using the given
+ * Path and NetworkAuthOption. Network inputs are read using HTTP range requests, so only the parts
+ * of the input that are read get downloaded.
+ * @param path
+ * @param network_auth
+ * @return the opened clp::ReaderInterface or nullptr on error
+ */
+[[nodiscard]] auto
+try_create_random_access_reader(Path const& path, NetworkAuthOption const& network_auth)
+        -> std::shared_ptr<clp::ReaderInterface>;
+
 /**
  * Tries to deduce the underlying file-type of the file opened by `reader`, and returns a
  * (potentially new) reader for underlying JSON or KV-IR content by unwrapping layers of
@@ -1,8 +1,20 @@
 #include "JsonConstructor.hpp"
 
+#include <algorithm>
+#include <condition_variable>
+#include <cstddef>
+#include <cstdint>
+#include <exception>
 #include <filesystem>
-#include <queue>
+#include <memory>
+#include <mutex>
+#include <optional>
+#include <string>
+#include <string_view>
 #include <system_error>
+#include <thread>
+#include <utility>
+#include <vector>
 
 #include <fmt/format.h>
 #include <mongocxx/client.hpp>
@@ -14,9 +26,244 @@
 
 #include "archive_constants.hpp"
 #include "ErrorCode.hpp"
+#include "LoserTree.hpp"
+#include "SchemaReader.hpp"
 #include "TraceableException.hpp"
 
 namespace clp_s {
+namespace {
+// Number of ranges of log event indices to marshal per thread. Using more ranges than threads
+// balances the load when some ranges are more expensive to marshal than others.
+constexpr size_t cNumRangesPerThread{4};
+// Maximum number of ranges per thread that can be marshalled ahead of the range being written,
+// which bounds the memory used by marshalled records.
+constexpr size_t cMaxNumRangesAheadPerThread{2};
+
+/**
+ * Records marshalled from a range of log event indices, in log order.
+ */
+struct MarshalledRange {
+    std::string records;
+    // The log_event_idx and the end offset in `records` of each record
+    std::vector<std::pair<int64_t, size_t>> record_ends;
+};
+
+/**
+ * Merges the records in [begin_log_event_idx, end_log_event_idx) from the given tables in log
+ * order, releasing each table once all of its records in the range have been merged.
+ * @tparam RecordHandler Signature: (int64_t log_event_idx, std::string_view record) -> void
+ * @param tables
+ * @param begin_log_event_idx
+ * @param end_log_event_idx
+ * @param handle_record
+ */
+template <typename RecordHandler>
+auto merge_tables_in_order(
+        std::vector<std::shared_ptr<SchemaReader>>& tables,
+        int64_t begin_log_event_idx,
+        int64_t end_log_event_idx,
+        RecordHandler&& handle_record
+) -> void;
+
+/**
+ * Splits [begin_log_event_idx, end_log_event_idx) into ranges, marshals the records of each range
+ * in log order on `num_threads` worker threads, and hands the marshalled records to
+ * `handle_record` on the calling thread in log order.
+ *
+ * NOTE: The archive's dictionaries must already be fully read, since the workers read them
+ * concurrently.
+ * @tparam RecordHandler Signature: (int64_t log_event_idx, std::string_view record) -> void
+ * @param archive_reader
+ * @param begin_log_event_idx
+ * @param end_log_event_idx
+ * @param num_threads
+ * @param handle_record
+ * @throw Any exception thrown while marshalling or by `handle_record`
+ */
+template <typename RecordHandler>
+auto merge_tables_in_order_in_parallel(
+        ArchiveReader& archive_reader,
+        int64_t begin_log_event_idx,
+        int64_t end_log_event_idx,
+        size_t num_threads,
+        RecordHandler&& handle_record
+) -> void;
+
+template <typename RecordHandler>
+auto merge_tables_in_order(
+        std::vector<std::shared_ptr<SchemaReader>>& tables,
+        int64_t begin_log_event_idx,
+        int64_t end_log_event_idx,
+        RecordHandler&& handle_record
+) -> void {
+    std::vector<int64_t> next_log_event_idxs;
+    next_log_event_idxs.reserve(tables.size());
+    for (auto const& table : tables) {
+        // NOTE: Tables loaded by `ArchiveReader` are already positioned, so this doesn't rescan them
+        table->skip_to_log_event_idx(begin_log_event_idx);
+        next_log_event_idxs.push_back(
+                table->done() ? LoserTree::cExhaustedKey : table->get_next_log_event_idx()
+        );
+    }
+    LoserTree loser_tree{std::move(next_log_event_idxs)};
+
+    std::string record;
+    while (loser_tree.get_winning_key() < end_log_event_idx) {
+        auto& table = tables[loser_tree.get_winner()];
+        // Keep taking records from the winning table while they're consecutive, since nothing else
+        // can come between them
+        auto log_event_idx{loser_tree.get_winning_key()};
+        while (true) {
+            table->get_next_message(record);
+            handle_record(log_event_idx, std::string_view{record});
+            if (table->done()) {
+                log_event_idx = LoserTree::cExhaustedKey;
+                break;
+            }
+            auto const next_log_event_idx{table->get_next_log_event_idx()};
+            if (log_event_idx + 1 != next_log_event_idx || next_log_event_idx >= end_log_event_idx)
+            {
+                log_event_idx = next_log_event_idx;
+                break;
+            }
+            log_event_idx = next_log_event_idx;
+        }
+        if (LoserTree::cExhaustedKey == log_event_idx) {
+            table.reset();
+        }
+        loser_tree.update_winning_key(log_event_idx);
+    }
+    tables.clear();
+}
+
+template <typename RecordHandler>
+auto merge_tables_in_order_in_parallel(
+        ArchiveReader& archive_reader,
+        int64_t begin_log_event_idx,
+        int64_t end_log_event_idx,
+        size_t num_threads,
+        RecordHandler&& handle_record
+) -> void {
+    auto const num_log_events{static_cast<uint64_t>(end_log_event_idx - begin_log_event_idx)};
+    auto const num_ranges{std::min<uint64_t>(num_threads * cNumRangesPerThread, num_log_events)};
+    std::vector<std::pair<int64_t, int64_t>> ranges;
+    ranges.reserve(num_ranges);
+    auto range_begin{begin_log_event_idx};
+    for (uint64_t i = 0; i < num_ranges; ++i) {
+        auto const range_size{
+                num_log_events / num_ranges + (i < num_log_events % num_ranges ? 1 : 0)
+        };
+        ranges.emplace_back(range_begin, range_begin + static_cast<int64_t>(range_size));
+        range_begin += static_cast<int64_t>(range_size);
+    }
+    auto tables_per_range{archive_reader.read_tables_in_log_event_idx_ranges(ranges)};
+
+    std::mutex mutex;
+    std::condition_variable cv;
+    std::vector<std::optional<MarshalledRange>> marshalled_ranges(num_ranges);
+    size_t next_range_to_marshal{0};
+    size_t next_range_to_write{0};
+    bool stop{false};
+    std::exception_ptr worker_exception;
+    auto const max_num_ranges_ahead{num_threads * cMaxNumRangesAheadPerThread};
+
+    auto marshal_ranges = [&]() {
+        while (true) {
+            size_t range_ix{};
+            {
+                std::unique_lock lock{mutex};
+                cv.wait(lock, [&]() {
+                    return stop || next_range_to_marshal >= num_ranges
+                           || next_range_to_marshal < next_range_to_write + max_num_ranges_ahead;
+                });
+                if (stop || next_range_to_marshal >= num_ranges) {
+                    return;
+                }
+                range_ix = next_range_to_marshal++;
+            }
+
+            MarshalledRange range;
+            try {
+                auto const [range_begin, range_end] = ranges[range_ix];
+                merge_tables_in_order(
+                        tables_per_range[range_ix],
+                        range_begin,
+                        range_end,
+                        [&](int64_t log_event_idx, std::string_view record) {
+                            range.records.append(record);
+                            range.record_ends.emplace_back(log_event_idx, range.records.size());
+                        }
+                );
+            } catch (...) {
+                std::lock_guard const lock{mutex};
+                if (nullptr == worker_exception) {
+                    worker_exception = std::current_exception();
+                }
+                stop = true;
+                cv.notify_all();
+                return;
+            }
+
+            std::lock_guard const lock{mutex};
+            marshalled_ranges[range_ix].emplace(std::move(range));
+            cv.notify_all();
+        }
+    };
+
+    std::vector<std::thread> threads;
+    threads.reserve(num_threads);
+    auto stop_and_join_threads = [&]() {
+        {
+            std::lock_guard const lock{mutex};
+            stop = true;
+        }
+        cv.notify_all();
+        for (auto& thread : threads) {
+            thread.join();
+        }
+    };
+
+    try {
+        for (size_t i = 0; i < num_threads; ++i) {
+            threads.emplace_back(marshal_ranges);
+        }
+
+        for (size_t range_ix = 0; range_ix < num_ranges; ++range_ix) {
+            MarshalledRange range;
+            {
+                std::unique_lock lock{mutex};
+                cv.wait(lock, [&]() { return stop || marshalled_ranges[range_ix].has_value(); });
+                if (stop) {
+                    break;
+                }
+                range = std::move(marshalled_ranges[range_ix].value());
+                marshalled_ranges[range_ix].reset();
+                ++next_range_to_write;
+            }
+            cv.notify_all();
+
+            std::string_view const records{range.records};
+            size_t record_begin{0};
+            for (auto const& [log_event_idx, record_end] : range.record_ends) {
+                handle_record(
+                        log_event_idx,
+                        records.substr(record_begin, record_end - record_begin)
+                );
+                record_begin = record_end;
+            }
+        }
+    } catch (...) {
+        stop_and_join_threads();
+        throw;
+    }
+    stop_and_join_threads();
+
+    if (nullptr != worker_exception) {
+        std::rethrow_exception(worker_exception);
+    }
+}
+}  // namespace
+
 JsonConstructor::JsonConstructor(JsonConstructorOption const& option) : m_option{option} {
     std::error_code error_code;
     if (false == std::filesystem::create_directory(option.output_dir, error_code) && error_code) {
@@ -62,16 +309,15 @@ void JsonConstructor::store() {
 }
 
 void JsonConstructor::construct_in_order() {
-    std::string buffer;
-    auto tables = m_archive_reader->read_all_tables();
-    using ReaderPointer = std::shared_ptr<SchemaReader>;
-    auto cmp = [](ReaderPointer& left, ReaderPointer& right) {
-        return left->get_next_log_event_idx() > right->get_next_log_event_idx();
-    };
-    std::priority_queue record_queue(tables.begin(), tables.end(), cmp);
-    // Clear tables vector so that memory gets deallocated after we have marshalled all records for
-    // a given table
-    tables.clear();
+    // Log event indices are assigned consecutively from zero, so the archive's last log event index
+    // is one less than its number of records
+    int64_t num_log_events{0};
+    for (auto const schema_id : m_archive_reader->get_schema_ids()) {
+        num_log_events
+                += static_cast<int64_t>(m_archive_reader->get_num_messages_for_schema(schema_id));
+    }
+    auto const begin_log_event_idx{m_option.begin_log_event_idx};
+    auto const end_log_event_idx{std::min(m_option.end_log_event_idx, num_log_events)};
 
     int64_t first_idx{};
     int64_t last_idx{};
@@ -148,19 +394,13 @@ void JsonConstructor::construct_in_order() {
         }
     };
 
-    while (false == record_queue.empty()) {
-        ReaderPointer next = record_queue.top();
-        record_queue.pop();
-        last_idx = next->get_next_log_event_idx();
+    auto write_record = [&](int64_t log_event_idx, std::string_view record) {
+        last_idx = log_event_idx;
         if (0 == chunk_size) {
             first_idx = last_idx;
         }
-        next->get_next_message(buffer);
-        if (false == next->done()) {
-            record_queue.emplace(std::move(next));
-        }
-        writer.write(buffer.c_str(), buffer.length());
-        chunk_size += buffer.length();
+        writer.write(record.data(), record.length());
+        chunk_size += record.length();
 
         if (0 != m_option.target_ordered_chunk_size
             && chunk_size >= m_option.target_ordered_chunk_size)
@@ -168,6 +408,22 @@ void JsonConstructor::construct_in_order() {
             finalize_chunk(true);
             chunk_size = 0;
         }
+    };
+
+    if (m_option.num_threads <= 1 || end_log_event_idx - begin_log_event_idx <= 1) {
+        auto tables = m_archive_reader->read_tables_in_log_event_idx_range(
+                begin_log_event_idx,
+                end_log_event_idx
+        );
+        merge_tables_in_order(tables, begin_log_event_idx, end_log_event_idx, write_record);
+    } else {
+        merge_tables_in_order_in_parallel(
+                *m_archive_reader,
+                begin_log_event_idx,
+                end_log_event_idx,
+                m_option.num_threads,
+                write_record
+        );
     }
 
     if (chunk_size > 0) {
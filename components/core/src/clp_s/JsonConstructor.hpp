@@ -1,6 +1,8 @@
 #ifndef CLP_S_JSONCONSTRUCTOR_HPP
 #define CLP_S_JSONCONSTRUCTOR_HPP
 
+#include <cstdint>
+#include <limits>
 #include <optional>
 #include <set>
 #include <string>
@@ -28,6 +30,12 @@ struct JsonConstructorOption {
     bool ordered{false};
     bool print_ordered_chunk_stats{false};
     size_t target_ordered_chunk_size{};
+    // Range of log event indices to decompress, [begin_log_event_idx, end_log_event_idx). Only used
+    // for ordered decompression.
+    int64_t begin_log_event_idx{0};
+    int64_t end_log_event_idx{std::numeric_limits<int64_t>::max()};
+    // Number of threads used to marshal records for ordered decompression
+    size_t num_threads{1};
     std::optional<MetadataDbOption> metadata_db{std::nullopt};
 };
 
@@ -62,8 +70,8 @@ public:
 
 private:
     /**
-     * Reads all of the tables from m_archive_reader and writes all of the records
-     * they contain to writer in log order.
+     * Reads the tables from m_archive_reader that overlap the configured range of log event indices
+     * and writes the records they contain within that range to writer in log order.
      */
     void construct_in_order();
 
@@ -1,14 +1,24 @@
 #ifndef CLP_S_JSONSERIALIZER_HPP
 #define CLP_S_JSONSERIALIZER_HPP
 
+#include <cstdint>
 #include <string>
 #include <string_view>
+#include <utility>
 #include <vector>
 
 #include "ColumnReader.hpp"
 #include "Utils.hpp"
 
 namespace clp_s {
+/**
+ * Serializes records into JSON by replaying a list of operations generated once per schema.
+ *
+ * Each record is appended directly to a caller-provided buffer, so callers can reuse one buffer
+ * across records (or append several records to the same buffer) without extra allocations or
+ * copies. The keys of a schema's fields are escaped and formatted as `"key":` fragments when the
+ * operations are generated, rather than once per record.
+ */
 class JsonSerializer {
 public:
     enum Op : uint8_t {
@@ -34,19 +44,13 @@ public:
         AddLiteralField,
     };
 
-    static int64_t const cReservedLength = 4096;
-
-    explicit JsonSerializer(int64_t reserved_length = cReservedLength) {
-        m_json_string.reserve(cReservedLength);
-    }
-
-    std::string& get_serialized_string() { return m_json_string; }
-
     /**
      * Resets the JsonSerializer for the next record.
+     * @param output The buffer to append the next record to. It must outlive the serialization of
+     * the record.
      */
-    void reset() {
-        m_json_string.clear();
+    void reset(std::string& output) {
+        m_json_string = &output;
         m_op_list_index = 0;
         m_special_keys_index = 0;
     }
@@ -55,7 +59,9 @@ public:
      * Clears the contents of the JsonSerializer to make room for a new set of operations.
      */
     void clear() {
-        reset();
+        m_json_string = nullptr;
+        m_op_list_index = 0;
+        m_special_keys_index = 0;
         m_op_list.clear();
         m_special_keys.clear();
     }
@@ -72,24 +78,30 @@ public:
         return false;
     }
 
+    /**
+     * Adds the key of the next operation that has a key, in the order that the operations will be
+     * replayed.
+     * @param key
+     */
     void add_special_key(std::string_view const key) {
-        std::string tmp;
-        StringUtils::escape_json_string(tmp, key);
-        m_special_keys.emplace_back(tmp);
+        std::string key_fragment{"\""};
+        StringUtils::escape_json_string(key_fragment, key);
+        key_fragment += "\":";
+        m_special_keys.emplace_back(std::move(key_fragment));
     }
 
     void begin_object() {
         append_key();
-        m_json_string += "{";
+        m_json_string->push_back('{');
     }
 
-    void begin_document() { m_json_string += "{"; }
+    void begin_document() { m_json_string->push_back('{'); }
 
     void end_document() {
-        if ('{' != m_json_string.back()) {
-            m_json_string[m_json_string.size() - 1] = '}';
+        if ('{' != m_json_string->back()) {
+            m_json_string->back() = '}';
         } else {
-            m_json_string += '}';
+            m_json_string->push_back('}');
         }
     }
 
@@ -97,64 +109,52 @@ public:
         if (m_op_list[m_op_list_index - 2] != BeginObject
             && m_op_list[m_op_list_index - 2] != BeginUnnamedObject)
         {
-            m_json_string.pop_back();
+            m_json_string->pop_back();
         }
-        m_json_string += "},";
+        m_json_string->append("},");
     }
 
-    void begin_array_document() { m_json_string += "["; }
+    void begin_array_document() { m_json_string->push_back('['); }
 
     void begin_array() {
         append_key();
-        m_json_string += "[";
+        m_json_string->push_back('[');
     }
 
     void end_array() {
         if (m_op_list[m_op_list_index - 2] != BeginArray
             && m_op_list[m_op_list_index - 2] != BeginUnnamedArray)
         {
-            m_json_string.pop_back();
+            m_json_string->pop_back();
         }
-        m_json_string += "],";
+        m_json_string->append("],");
     }
 
-    void append_key() { append_escaped_key(m_special_keys[m_special_keys_index++]); }
-
-    void append_key(std::string_view const key) {
-        m_json_string += "\"";
-        StringUtils::escape_json_string(m_json_string, key);
-        m_json_string += "\":";
-    }
+    void append_key() { m_json_string->append(m_special_keys[m_special_keys_index++]); }
 
     void append_value(std::string_view const value) {
-        m_json_string += value;
-        m_json_string += ",";
+        m_json_string->append(value);
+        m_json_string->push_back(',');
     }
 
     void append_value_from_column(clp_s::BaseColumnReader* column, uint64_t cur_message) {
-        column->extract_string_value_into_buffer(cur_message, m_json_string);
-        m_json_string += ",";
+        column->extract_string_value_into_buffer(cur_message, *m_json_string);
+        m_json_string->push_back(',');
     }
 
     void
     append_value_from_column_with_quotes(clp_s::BaseColumnReader* column, uint64_t cur_message) {
-        m_json_string += "\"";
+        m_json_string->push_back('"');
         column->extract_escaped_string_value_into_buffer(
                 cur_message,
-                m_json_string,
+                *m_json_string,
                 m_string_value_escaper
         );
-        m_json_string += "\",";
+        m_json_string->append("\",");
     }
 
 private:
-    void append_escaped_key(std::string_view const key) {
-        m_json_string.push_back('"');
-        m_json_string.append(key);
-        m_json_string.append("\":");
-    }
-
-    std::string m_json_string;
+    std::string* m_json_string{nullptr};
     std::vector<Op> m_op_list;
     std::vector<std::string> m_special_keys;
     SimdJsonStringEscaper m_string_value_escaper;
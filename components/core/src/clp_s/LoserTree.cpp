@@ -0,0 +1,47 @@
+#include "LoserTree.hpp"
+
+#include <cstddef>
+#include <cstdint>
+#include <utility>
+#include <vector>
+
+namespace clp_s {
+LoserTree::LoserTree(std::vector<int64_t> keys)
+        : m_keys{std::move(keys)},
+          m_losers(m_keys.size(), 0) {
+    auto const num_sources{m_keys.size()};
+    if (num_sources <= 1) {
+        return;
+    }
+
+    // Play the matches bottom-up, recording the winner of each node's match so that it can play
+    // the match at the node's parent
+    std::vector<size_t> winners(2 * num_sources);
+    for (size_t i = 0; i < num_sources; ++i) {
+        winners[num_sources + i] = i;
+    }
+    for (auto node = num_sources - 1; node > 0; --node) {
+        auto const lhs{winners[2 * node]};
+        auto const rhs{winners[2 * node + 1]};
+        if (beats(lhs, rhs)) {
+            winners[node] = lhs;
+            m_losers[node] = rhs;
+        } else {
+            winners[node] = rhs;
+            m_losers[node] = lhs;
+        }
+    }
+    m_winner = winners[1];
+}
+
+auto LoserTree::update_winning_key(int64_t key) -> void {
+    m_keys[m_winner] = key;
+    auto winner{m_winner};
+    for (auto node = (m_keys.size() + winner) / 2; node > 0; node /= 2) {
+        if (beats(m_losers[node], winner)) {
+            std::swap(m_losers[node], winner);
+        }
+    }
+    m_winner = winner;
+}
+}  // namespace clp_s
@@ -0,0 +1,73 @@
+#ifndef CLP_S_LOSERTREE_HPP
+#define CLP_S_LOSERTREE_HPP
+
+#include <cstddef>
+#include <cstdint>
+#include <limits>
+#include <vector>
+
+namespace clp_s {
+/**
+ * A tournament tree of losers for k-way merging sources keyed by an int64_t (e.g., the next
+ * log_event_idx of each table being merged).
+ *
+ * Each internal node stores the source that lost the match played at that node, and the overall
+ * winner (the source with the smallest key) is stored separately. After the winner's key changes,
+ * restoring the tree only replays the matches on the path from the winner's leaf to the root,
+ * i.e., one comparison per level, compared to the two per level needed to sift down a binary heap.
+ * Ties are broken by source index, so the merge order is deterministic.
+ */
+class LoserTree {
+public:
+    // Constants
+    // Key of a source that has no more values
+    static constexpr int64_t cExhaustedKey{std::numeric_limits<int64_t>::max()};
+
+    // Constructors
+    /**
+     * @param keys The initial key of each source. Use `cExhaustedKey` for empty sources.
+     */
+    explicit LoserTree(std::vector<int64_t> keys);
+
+    // Methods
+    /**
+     * @return The index of the source with the smallest key
+     */
+    [[nodiscard]] auto get_winner() const -> size_t { return m_winner; }
+
+    /**
+     * @return The key of the source with the smallest key, or `cExhaustedKey` if every source is
+     * exhausted
+     */
+    [[nodiscard]] auto get_winning_key() const -> int64_t {
+        return m_keys.empty() ? cExhaustedKey : m_keys[m_winner];
+    }
+
+    /**
+     * Updates the key of the current winner (after consuming one or more of its values) and
+     * replays the matches along its path to find the new winner.
+     * @param key The winner's new key, or `cExhaustedKey` if it has no more values
+     */
+    auto update_winning_key(int64_t key) -> void;
+
+private:
+    // Methods
+    /**
+     * @param lhs
+     * @param rhs
+     * @return Whether source `lhs` beats source `rhs`
+     */
+    [[nodiscard]] auto beats(size_t lhs, size_t rhs) const -> bool {
+        return m_keys[lhs] < m_keys[rhs] || (m_keys[lhs] == m_keys[rhs] && lhs < rhs);
+    }
+
+    // Variables
+    std::vector<int64_t> m_keys;
+    // The loser of the match at each internal node, where node `i` has children `2i` and `2i + 1`,
+    // and source `j` is the leaf at node `j + m_keys.size()`. Node 0 is unused.
+    std::vector<size_t> m_losers;
+    size_t m_winner{0};
+};
+}  // namespace clp_s
+
+#endif  // CLP_S_LOSERTREE_HPP
@@ -0,0 +1,64 @@
+#include "OpenArchiveCache.hpp"
+
+#include <cstddef>
+#include <memory>
+#include <string>
+#include <utility>
+
+#include <fmt/format.h>
+
+#include "ArchiveCache.hpp"
+#include "ArchiveReader.hpp"
+#include "ErrorCode.hpp"
+#include "InputConfig.hpp"
+
+namespace clp_s {
+OpenArchiveCache::OpenArchiveCache(size_t capacity, std::shared_ptr<ArchiveCache> archive_cache)
+        : m_capacity{capacity},
+          m_archive_cache{std::move(archive_cache)} {
+    if (0 == m_capacity) {
+        throw OperationFailed(ErrorCodeBadParam, __FILENAME__, __LINE__);
+    }
+}
+
+auto OpenArchiveCache::get(Path const& archive_path, NetworkAuthOption const& network_auth)
+        -> std::shared_ptr<ArchiveReader> {
+    auto key{get_key(archive_path, network_auth)};
+    if (auto const it{m_key_to_archive.find(key)}; m_key_to_archive.end() != it) {
+        m_archives.splice(m_archives.begin(), m_archives, it->second);
+        auto const& archive_reader{it->second->second};
+        archive_reader->close_packed_streams();
+        return archive_reader;
+    }
+
+    auto archive_reader{std::make_shared<ArchiveReader>()};
+    archive_reader->open(archive_path, network_auth, m_archive_cache);
+
+    if (m_archives.size() == m_capacity) {
+        m_key_to_archive.erase(m_archives.back().first);
+        m_archives.pop_back();
+    }
+    m_archives.emplace_front(key, archive_reader);
+    m_key_to_archive.emplace(std::move(key), m_archives.begin());
+    return archive_reader;
+}
+
+void OpenArchiveCache::erase(Path const& archive_path, NetworkAuthOption const& network_auth) {
+    auto const it{m_key_to_archive.find(get_key(archive_path, network_auth))};
+    if (m_key_to_archive.end() == it) {
+        return;
+    }
+    m_archives.erase(it->second);
+    m_key_to_archive.erase(it);
+}
+
+auto OpenArchiveCache::get_key(Path const& archive_path, NetworkAuthOption const& network_auth)
+        -> std::string {
+    return fmt::format(
+            "{}:{}:{}",
+            static_cast<int>(archive_path.source),
+            static_cast<int>(network_auth.method),
+            archive_path.path
+    );
+}
+}  // namespace clp_s
@@ -0,0 +1,95 @@
+#ifndef CLP_S_OPENARCHIVECACHE_HPP
+#define CLP_S_OPENARCHIVECACHE_HPP
+
+#include <cstddef>
+#include <list>
+#include <memory>
+#include <string>
+#include <unordered_map>
+#include <utility>
+
+#include "ArchiveCache.hpp"
+#include "ArchiveReader.hpp"
+#include "ErrorCode.hpp"
+#include "InputConfig.hpp"
+#include "TraceableException.hpp"
+
+namespace clp_s {
+/**
+ * A least-recently-used cache of open archives, which lets a long-running search process reuse the
+ * schema tree, schema map, timestamp dictionary, table metadata, and any dictionaries read by
+ * previous searches of an archive, so that repeated searches skip straight to scanning its tables.
+ *
+ * Since archives are immutable, each cached archive is identified by its path, along with the
+ * authentication it was opened with, so that a request never reuses an archive opened with another
+ * request's credentials. The cache isn't thread-safe.
+ */
+class OpenArchiveCache {
+public:
+    // Types
+    class OperationFailed : public TraceableException {
+    public:
+        // Constructors
+        OperationFailed(ErrorCode error_code, char const* const filename, int line_number)
+                : TraceableException(error_code, filename, line_number) {}
+    };
+
+    // Constructors
+    /**
+     * @param capacity The maximum number of archives to keep open.
+     * @param archive_cache An optional cache for single-file archives read over the network, used
+     * when opening archives.
+     * @throw OpenArchiveCache::OperationFailed if the capacity is 0.
+     */
+    explicit OpenArchiveCache(
+            size_t capacity,
+            std::shared_ptr<ArchiveCache> archive_cache = nullptr
+    );
+
+    // Methods
+    /**
+     * Gets a reader for the given archive, opening the archive if it isn't cached and evicting the
+     * least recently used archive if the cache is full. Any packed streams left open by a previous
+     * search of a cached archive are closed. Evicted archives remain usable by anyone still holding
+     * their readers.
+     * @param archive_path
+     * @param network_auth
+     * @return The archive's reader.
+     * @throw ArchiveReader::OperationFailed if the archive can't be opened.
+     */
+    [[nodiscard]] auto get(Path const& archive_path, NetworkAuthOption const& network_auth)
+            -> std::shared_ptr<ArchiveReader>;
+
+    /**
+     * Removes the given archive from the cache (e.g., if a search of it failed, leaving its reader
+     * in an unknown state).
+     * @param archive_path
+     * @param network_auth
+     */
+    void erase(Path const& archive_path, NetworkAuthOption const& network_auth);
+
+    [[nodiscard]] auto size() const -> size_t { return m_archives.size(); }
+
+private:
+    // Types
+    using ArchiveList = std::list<std::pair<std::string, std::shared_ptr<ArchiveReader>>>;
+
+    // Methods
+    /**
+     * @param archive_path
+     * @param network_auth
+     * @return The key of the given archive opened with the given authentication.
+     */
+    [[nodiscard]] static auto
+    get_key(Path const& archive_path, NetworkAuthOption const& network_auth) -> std::string;
+
+    // Variables
+    size_t m_capacity;
+    std::shared_ptr<ArchiveCache> m_archive_cache;
+    // Ordered from most to least recently used
+    ArchiveList m_archives;
+    std::unordered_map<std::string, ArchiveList::iterator> m_key_to_archive;
+};
+}  // namespace clp_s
+
+#endif  // CLP_S_OPENARCHIVECACHE_HPP
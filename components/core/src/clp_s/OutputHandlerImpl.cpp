@@ -1,8 +1,15 @@
 #include "OutputHandlerImpl.hpp"
 
+#include <sys/uio.h>
+
+#include <algorithm>
+#include <cerrno>
+#include <cstddef>
+#include <cstdint>
 #include <sstream>
 #include <string>
 #include <string_view>
+#include <variant>
 #include <vector>
 
 #include <mongocxx/client.hpp>
@@ -15,10 +22,16 @@
 #include <spdlog/spdlog.h>
 
 #include "../clp/networking/socket_utils.hpp"
+#include "../reducer/AggregateOperator.hpp"
 #include "../reducer/CountOperator.hpp"
 #include "../reducer/network_utils.hpp"
 #include "../reducer/Record.hpp"
 #include "archive_constants.hpp"
+#include "ColumnReader.hpp"
+#include "Schema.hpp"
+#include "SchemaReader.hpp"
+#include "SchemaTree.hpp"
+#include "search/ast/SearchUtils.hpp"
 #include "search/OutputHandler.hpp"
 #include "TraceableException.hpp"
 
@@ -50,8 +63,183 @@ auto connect_to_results_cache(string_view uri, string_view collection, mongocxx:
         throw OperationFailedT(ErrorCode::ErrorCodeBadParamDbUri, __FILENAME__, __LINE__);
     }
 }
+
+/**
+ * Packs the part of a log event's msgpack result tuple that precedes its message. Writing the
+ * prefix, the message, and the suffix (see `pack_result_suffix`) produces the same bytes as packing
+ * the whole tuple.
+ * @tparam Stream
+ * @param stream
+ * @param timestamp
+ * @param message_size
+ */
+template <typename Stream>
+auto pack_result_prefix(Stream& stream, epochtime_t timestamp, size_t message_size) -> void;
+
+/**
+ * Packs the part of a log event's msgpack result tuple that follows its message.
+ * @tparam Stream
+ * @param stream
+ * @param archive_id
+ * @param log_event_idx
+ */
+template <typename Stream>
+auto pack_result_suffix(Stream& stream, string_view archive_id, int64_t log_event_idx) -> void;
+
+/**
+ * Writes every buffer described by `iovecs` to `fd`, retrying on partial writes.
+ * @param fd
+ * @param iovecs Returns the buffers in an unspecified state
+ * @return Whether every buffer was written
+ */
+auto writev_all(int fd, std::vector<iovec>& iovecs) -> bool;
+
+/**
+ * @param type
+ * @return Whether values of the given node type are numbers that can be aggregated
+ */
+auto is_numeric_node_type(NodeType type) -> bool;
+
+/**
+ * @param type
+ * @return Whether values of the given node type are output as JSON strings
+ */
+auto is_string_node_type(NodeType type) -> bool;
+
+/**
+ * @param schema_tree
+ * @param node_id
+ * @param root_id The ID of the object node at the root of the field path's namespace
+ * @param tokens The keys on the path from the root to the field
+ * @return Whether the given node is at the end of the given path from the root
+ */
+auto is_node_at_path(
+        SchemaTree const& schema_tree,
+        int32_t node_id,
+        int32_t root_id,
+        std::vector<string> const& tokens
+) -> bool;
+
+// The number of fields in a result tuple: timestamp, message, original path, archive ID, and log
+// event index
+constexpr uint32_t cNumResultTupleFields{5};
+// Linux's limit on the number of buffers in a single `writev` call
+constexpr size_t cMaxNumIovecsPerWrite{1024};
+
+template <typename Stream>
+auto pack_result_prefix(Stream& stream, epochtime_t timestamp, size_t message_size) -> void {
+    msgpack::packer<Stream> packer{stream};
+    packer.pack_array(cNumResultTupleFields);
+    packer.pack(timestamp);
+    packer.pack_str(static_cast<uint32_t>(message_size));
+}
+
+template <typename Stream>
+auto pack_result_suffix(Stream& stream, string_view archive_id, int64_t log_event_idx) -> void {
+    // The original file path is always empty
+    msgpack::packer<Stream> packer{stream};
+    packer.pack_str(0);
+    packer.pack_str(static_cast<uint32_t>(archive_id.size()));
+    packer.pack_str_body(archive_id.data(), static_cast<uint32_t>(archive_id.size()));
+    packer.pack(log_event_idx);
+}
+
+auto writev_all(int fd, std::vector<iovec>& iovecs) -> bool {
+    size_t next_iovec_idx{0};
+    while (next_iovec_idx < iovecs.size()) {
+        auto const num_iovecs{std::min(iovecs.size() - next_iovec_idx, cMaxNumIovecsPerWrite)};
+        auto const num_bytes_written{
+                writev(fd, &iovecs[next_iovec_idx], static_cast<int>(num_iovecs))
+        };
+        if (-1 == num_bytes_written) {
+            if (EINTR == errno) {
+                continue;
+            }
+            return false;
+        }
+
+        // Skip the buffers that were fully written and advance into any partially written one
+        auto num_bytes_remaining{static_cast<size_t>(num_bytes_written)};
+        while (next_iovec_idx < iovecs.size()
+               && iovecs[next_iovec_idx].iov_len <= num_bytes_remaining)
+        {
+            num_bytes_remaining -= iovecs[next_iovec_idx].iov_len;
+            ++next_iovec_idx;
+        }
+        if (num_bytes_remaining > 0) {
+            auto& iov{iovecs[next_iovec_idx]};
+            iov.iov_base = static_cast<char*>(iov.iov_base) + num_bytes_remaining;
+            iov.iov_len -= num_bytes_remaining;
+        }
+    }
+    return true;
+}
+
+auto is_numeric_node_type(NodeType type) -> bool {
+    switch (type) {
+        case NodeType::Integer:
+        case NodeType::DeltaInteger:
+        case NodeType::Float:
+        case NodeType::FormattedFloat:
+        case NodeType::DictionaryFloat:
+            return true;
+        default:
+            return false;
+    }
+}
+
+auto is_string_node_type(NodeType type) -> bool {
+    switch (type) {
+        case NodeType::ClpString:
+        case NodeType::VarString:
+        case NodeType::DeprecatedDateString:
+            return true;
+        default:
+            return false;
+    }
+}
+
+auto is_node_at_path(
+        SchemaTree const& schema_tree,
+        int32_t node_id,
+        int32_t root_id,
+        std::vector<string> const& tokens
+) -> bool {
+    auto cur_node_id{node_id};
+    for (auto token_it{tokens.crbegin()}; tokens.crend() != token_it; ++token_it) {
+        if (cur_node_id < 0 || root_id == cur_node_id) {
+            return false;
+        }
+        auto const& node{schema_tree.get_node(cur_node_id)};
+        if (node.get_key_name() != *token_it) {
+            return false;
+        }
+        cur_node_id = node.get_parent_id();
+    }
+    return root_id == cur_node_id;
+}
 }  // namespace
 
+void StandardOutputHandler::write_batch(search::LogEventBatch const& batch) {
+    if (false == should_output_metadata()) {
+        // The messages are contiguous, so they can be written at once
+        auto const messages{batch.get_messages()};
+        std::cout.write(messages.data(), static_cast<std::streamsize>(messages.size()));
+        return;
+    }
+
+    auto const archive_id{batch.get_archive_id()};
+    for (size_t i{0}; i < batch.size(); ++i) {
+        auto const log_event{batch.get_log_event(i)};
+        std::cout << archive_id << ": " << log_event.log_event_idx << ": " << log_event.timestamp
+                  << " ";
+        std::cout.write(
+                log_event.message.data(),
+                static_cast<std::streamsize>(log_event.message.size())
+        );
+    }
+}
+
 void FileOutputHandler::write(
         string_view message,
         epochtime_t timestamp,
@@ -64,12 +252,33 @@ void FileOutputHandler::write(
     msgpack::pack(m_file_writer, src);
 }
 
+void FileOutputHandler::write_batch(search::LogEventBatch const& batch) {
+    auto const archive_id{batch.get_archive_id()};
+    for (size_t i{0}; i < batch.size(); ++i) {
+        auto const log_event{batch.get_log_event(i)};
+        pack_result_prefix(m_file_writer, log_event.timestamp, log_event.message.size());
+        m_file_writer.write(log_event.message.data(), log_event.message.size());
+        pack_result_suffix(m_file_writer, archive_id, log_event.log_event_idx);
+    }
+}
+
+void FileOutputHandler::write_columnar_batch(search::ColumnarBatch const& batch) {
+    m_columnar_batch_buffer.clear();
+    m_columnar_batch_serializer.serialize(batch, m_columnar_batch_buffer);
+    m_file_writer.write(m_columnar_batch_buffer.data(), m_columnar_batch_buffer.size());
+}
+
 NetworkOutputHandler::NetworkOutputHandler(
         string const& host,
         int port,
-        bool should_output_timestamp
+        bool should_output_timestamp,
+        bool should_output_columnar_batches
 )
-        : ::clp_s::search::OutputHandler(should_output_timestamp, true) {
+        : ::clp_s::search::OutputHandler(
+                  should_output_timestamp || should_output_columnar_batches,
+                  false == should_output_columnar_batches,
+                  should_output_columnar_batches
+          ) {
     m_socket_fd = clp::networking::connect_to_server(host, std::to_string(port));
     if (-1 == m_socket_fd) {
         SPDLOG_ERROR("Failed to connect to the server, errno={}", errno);
@@ -94,6 +303,50 @@ void NetworkOutputHandler::write(
     }
 }
 
+void NetworkOutputHandler::write_batch(search::LogEventBatch const& batch) {
+    if (batch.empty()) {
+        return;
+    }
+
+    // Pack the framing of every tuple first, since the scratch buffer may be reallocated
+    auto const archive_id{batch.get_archive_id()};
+    m_framing_buffer.clear();
+    m_framing_offsets.clear();
+    for (size_t i{0}; i < batch.size(); ++i) {
+        auto const log_event{batch.get_log_event(i)};
+        m_framing_offsets.push_back(m_framing_buffer.size());
+        pack_result_prefix(m_framing_buffer, log_event.timestamp, log_event.message.size());
+        m_framing_offsets.push_back(m_framing_buffer.size());
+        pack_result_suffix(m_framing_buffer, archive_id, log_event.log_event_idx);
+    }
+    m_framing_offsets.push_back(m_framing_buffer.size());
+
+    auto const get_framing_iovec = [&](size_t framing_idx) -> iovec {
+        auto const begin{m_framing_offsets[framing_idx]};
+        return {m_framing_buffer.data() + begin, m_framing_offsets[framing_idx + 1] - begin};
+    };
+    m_iovecs.clear();
+    for (size_t i{0}; i < batch.size(); ++i) {
+        auto const message{batch.get_log_event(i).message};
+        m_iovecs.push_back(get_framing_iovec(2 * i));
+        m_iovecs.push_back({const_cast<char*>(message.data()), message.size()});
+        m_iovecs.push_back(get_framing_iovec(2 * i + 1));
+    }
+    if (false == writev_all(m_socket_fd, m_iovecs)) {
+        throw OperationFailed(ErrorCode::ErrorCodeFailureNetwork, __FILENAME__, __LINE__);
+    }
+}
+
+void NetworkOutputHandler::write_columnar_batch(search::ColumnarBatch const& batch) {
+    m_columnar_batch_buffer.clear();
+    m_columnar_batch_serializer.serialize(batch, m_columnar_batch_buffer);
+    m_iovecs.clear();
+    m_iovecs.push_back({m_columnar_batch_buffer.data(), m_columnar_batch_buffer.size()});
+    if (false == writev_all(m_socket_fd, m_iovecs)) {
+        throw OperationFailed(ErrorCode::ErrorCodeFailureNetwork, __FILENAME__, __LINE__);
+    }
+}
+
 ResultsCacheOutputHandler::ResultsCacheOutputHandler(
         string_view uri,
         string_view collection,
@@ -237,6 +490,150 @@ auto CountByTimeReducerOutputHandler::finish() -> ErrorCode {
     return ErrorCode::ErrorCodeSuccess;
 }
 
+AggregateReducerOutputHandler::AggregateReducerOutputHandler(
+        int reducer_socket_fd,
+        string const& field,
+        std::vector<string> const& group_by_fields
+)
+        : search::OutputHandler{false, false, true},
+          m_reducer_socket_fd{reducer_socket_fd} {
+    auto const tokenize = [](string const& descriptor) -> FieldPath {
+        FieldPath path;
+        if (false
+            == search::ast::tokenize_column_descriptor(
+                    descriptor,
+                    path.tokens,
+                    path.descriptor_namespace
+            ))
+        {
+            SPDLOG_ERROR("Can not tokenize invalid column: \"{}\"", descriptor);
+            throw OperationFailed(ErrorCode::ErrorCodeBadParam, __FILENAME__, __LINE__);
+        }
+        return path;
+    };
+
+    m_field_path = tokenize(field);
+    for (auto const& group_by_field : group_by_fields) {
+        m_group_by_field_paths.emplace_back(tokenize(group_by_field));
+    }
+    m_group_by_columns.resize(m_group_by_field_paths.size());
+    m_tags.resize(m_group_by_field_paths.size());
+}
+
+auto AggregateReducerOutputHandler::write_columnar_batch(search::ColumnarBatch const& batch)
+        -> void {
+    if (&batch.schema_tree != m_resolved_schema_tree) {
+        resolve_columns(batch.schema_tree);
+    }
+
+    BaseColumnReader* field_column{nullptr};
+    std::fill(m_group_by_columns.begin(), m_group_by_columns.end(), nullptr);
+    for (auto* column : batch.reader.get_columns()) {
+        auto const node_id{column->get_id()};
+        if (nullptr == field_column && m_field_node_ids.contains(node_id)
+            && is_numeric_node_type(column->get_type()))
+        {
+            field_column = column;
+        }
+        if (auto const it{m_group_by_field_idxs.find(node_id)}; m_group_by_field_idxs.end() != it) {
+            m_group_by_columns[it->second] = column;
+        }
+    }
+    if (nullptr == field_column) {
+        return;
+    }
+
+    // A group-by field without a column is either missing or null in every record of the table
+    for (size_t i{0}; i < m_group_by_columns.size(); ++i) {
+        if (nullptr == m_group_by_columns[i]) {
+            m_tags[i] = cMissingGroupByFieldTag;
+        }
+    }
+    auto const& schema{batch.schemas.at(batch.reader.get_schema_id())};
+    for (size_t i{0}; i < schema.get_num_ordered(); ++i) {
+        auto const node_id{schema[i]};
+        if (auto const it{m_group_by_field_idxs.find(node_id)};
+            m_group_by_field_idxs.end() != it
+            && NodeType::NullValue == batch.schema_tree.get_node(node_id).get_type())
+        {
+            m_tags[it->second] = "null";
+        }
+    }
+
+    for (auto const message_idx : batch.message_idxs) {
+        double value{};
+        auto const extracted_value{field_column->extract_value(message_idx)};
+        if (auto const* int_value{std::get_if<int64_t>(&extracted_value)}; nullptr != int_value) {
+            value = static_cast<double>(*int_value);
+        } else {
+            value = std::get<double>(extracted_value);
+        }
+
+        for (size_t i{0}; i < m_group_by_columns.size(); ++i) {
+            auto* column{m_group_by_columns[i]};
+            if (nullptr == column) {
+                continue;
+            }
+            m_tags[i].clear();
+            if (is_string_node_type(column->get_type())) {
+                m_tags[i].push_back('"');
+                column->extract_escaped_string_value_into_buffer(message_idx, m_tags[i]);
+                m_tags[i].push_back('"');
+            } else {
+                column->extract_string_value_into_buffer(message_idx, m_tags[i]);
+            }
+        }
+        m_aggregate_operator.add_value(m_tags, value);
+    }
+}
+
+auto AggregateReducerOutputHandler::finish() -> ErrorCode {
+    if (false
+        == reducer::send_pipeline_results(
+                m_reducer_socket_fd,
+                m_aggregate_operator.get_stored_result_iterator()
+        ))
+    {
+        return ErrorCode::ErrorCodeFailureNetwork;
+    }
+    return ErrorCode::ErrorCodeSuccess;
+}
+
+auto AggregateReducerOutputHandler::resolve_columns(SchemaTree const& schema_tree) -> void {
+    m_resolved_schema_tree = &schema_tree;
+    m_field_node_ids.clear();
+    m_group_by_field_idxs.clear();
+
+    auto const field_root_id{
+            schema_tree.get_object_subtree_node_id_for_namespace(m_field_path.descriptor_namespace)
+    };
+    std::vector<int32_t> group_by_root_ids;
+    for (auto const& path : m_group_by_field_paths) {
+        group_by_root_ids.emplace_back(
+                schema_tree.get_object_subtree_node_id_for_namespace(path.descriptor_namespace)
+        );
+    }
+
+    for (auto const& node : schema_tree.get_nodes()) {
+        auto const node_id{node.get_id()};
+        if (is_node_at_path(schema_tree, node_id, field_root_id, m_field_path.tokens)) {
+            m_field_node_ids.emplace(node_id);
+        }
+        for (size_t i{0}; i < m_group_by_field_paths.size(); ++i) {
+            if (is_node_at_path(
+                        schema_tree,
+                        node_id,
+                        group_by_root_ids[i],
+                        m_group_by_field_paths[i].tokens
+                ))
+            {
+                m_group_by_field_idxs.emplace(node_id, i);
+                break;
+            }
+        }
+    }
+}
+
 auto CountStdoutOutputHandler::finish() -> ErrorCode {
     if (0 == m_count) {
         return ErrorCode::ErrorCodeSuccess;
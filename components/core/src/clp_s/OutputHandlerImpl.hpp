@@ -3,8 +3,11 @@
 
 #include <netdb.h>
 #include <sys/socket.h>
+#include <sys/uio.h>
 #include <unistd.h>
 
+#include <cstddef>
+#include <cstdint>
 #include <iostream>
 #include <map>
 #include <queue>
@@ -12,13 +15,20 @@
 #include <string_view>
 #include <vector>
 
+#include <absl/container/flat_hash_map.h>
+#include <absl/container/flat_hash_set.h>
 #include <mongocxx/client.hpp>
 #include <mongocxx/collection.hpp>
+#include <msgpack.hpp>
 
 #include <clp_s/CommandLineArguments.hpp>
 
+#include "../reducer/AggregateOperator.hpp"
+#include "../reducer/GroupTags.hpp"
 #include "../reducer/Pipeline.hpp"
 #include "../reducer/RecordGroupIterator.hpp"
+#include "ColumnarBatchSerializer.hpp"
+#include "ColumnReader.hpp"
 #include "Defs.hpp"
 #include "FileWriter.hpp"
 #include "search/OutputHandler.hpp"
@@ -45,6 +55,8 @@ public:
     }
 
     void write(std::string_view message) override { std::cout << message; }
+
+    void write_batch(::clp_s::search::LogEventBatch const& batch) override;
 };
 
 /**
@@ -53,8 +65,22 @@ public:
 class FileOutputHandler : public ::clp_s::search::OutputHandler {
 public:
     // Constructors
-    explicit FileOutputHandler(std::string const& path, bool should_output_metadata = false)
-            : ::clp_s::search::OutputHandler(should_output_metadata, true),
+    /**
+     * @param path
+     * @param should_output_metadata
+     * @param should_output_columnar_batches Whether to write results as columnar batches (see
+     * `ColumnarBatchSerializer`) instead of as one msgpack tuple per result
+     */
+    explicit FileOutputHandler(
+            std::string const& path,
+            bool should_output_metadata = false,
+            bool should_output_columnar_batches = false
+    )
+            : ::clp_s::search::OutputHandler(
+                      should_output_metadata || should_output_columnar_batches,
+                      false == should_output_columnar_batches,
+                      should_output_columnar_batches
+              ),
               m_file_writer() {
         m_file_writer.open(path, FileWriter::OpenMode::CreateForWriting);
     }
@@ -71,8 +97,19 @@ public:
 
     void write(std::string_view message) override { write(message, 0, {}, 0); }
 
+    /**
+     * Writes each log event's msgpack result tuple, copying its message directly from the batch
+     * rather than building the tuple first.
+     * @param batch
+     */
+    void write_batch(::clp_s::search::LogEventBatch const& batch) override;
+
+    void write_columnar_batch(::clp_s::search::ColumnarBatch const& batch) override;
+
 private:
     FileWriter m_file_writer;
+    ColumnarBatchSerializer m_columnar_batch_serializer;
+    msgpack::sbuffer m_columnar_batch_buffer;
 };
 
 /**
@@ -89,10 +126,19 @@ public:
     };
 
     // Constructors
+    /**
+     * @param host
+     * @param port
+     * @param should_output_metadata
+     * @param should_output_columnar_batches Whether to send results as columnar batches (see
+     * `ColumnarBatchSerializer`) instead of as one msgpack tuple per result
+     * @throw NetworkOutputHandler::OperationFailed if the connection to the server fails
+     */
     explicit NetworkOutputHandler(
             std::string const& host,
             int port,
-            bool should_output_metadata = false
+            bool should_output_metadata = false,
+            bool should_output_columnar_batches = false
     );
 
     // Destructor
@@ -112,10 +158,30 @@ public:
 
     void write(std::string_view message) override { write(message, 0, {}, 0); }
 
+    /**
+     * Sends the msgpack result tuples of every log event in the batch with vectored writes. Only
+     * the tuples' framing is packed into a scratch buffer; the messages are sent directly from the
+     * batch.
+     * @param batch
+     * @throw NetworkOutputHandler::OperationFailed on network failure
+     */
+    void write_batch(::clp_s::search::LogEventBatch const& batch) override;
+
+    /**
+     * @param batch
+     * @throw NetworkOutputHandler::OperationFailed on network failure
+     */
+    void write_columnar_batch(::clp_s::search::ColumnarBatch const& batch) override;
+
 private:
     std::string m_host;
     std::string m_port;
     int m_socket_fd;
+    msgpack::sbuffer m_framing_buffer;
+    std::vector<size_t> m_framing_offsets;
+    std::vector<iovec> m_iovecs;
+    ColumnarBatchSerializer m_columnar_batch_serializer;
+    msgpack::sbuffer m_columnar_batch_buffer;
 };
 
 /**
@@ -287,6 +353,95 @@ private:
     int64_t m_count_by_time_bucket_size_ms;
 };
 
+/**
+ * Output handler that computes partial sum, min, max, and avg aggregates of a numeric field,
+ * optionally grouped by one or more other fields, and sends one record group per group to a
+ * reducer.
+ *
+ * Matching records are received as columnar batches so that only the aggregated and group-by
+ * columns are read, and no record is ever marshalled. Records where the aggregated field is missing
+ * or isn't numeric are skipped.
+ *
+ * Each group's tag for a group-by field is the field's value as it's output with `--json` (e.g.,
+ * strings are quoted and escaped), or `cMissingGroupByFieldTag` if the field is missing, so that
+ * a missing field is never grouped with a value.
+ */
+class AggregateReducerOutputHandler : public search::OutputHandler {
+public:
+    // Types
+    class OperationFailed : public TraceableException {
+    public:
+        // Constructors
+        OperationFailed(ErrorCode error_code, char const* const filename, int line_number)
+                : TraceableException(error_code, filename, line_number) {}
+    };
+
+    // Constants
+    // Not valid JSON, so that it's distinct from the tag of every value
+    static constexpr std::string_view cMissingGroupByFieldTag{"undefined"};
+
+    // Constructors
+    /**
+     * @param reducer_socket_fd
+     * @param field The column descriptor of the field to aggregate.
+     * @param group_by_fields The column descriptors of the fields to group by.
+     * @throws OperationFailed if any of the column descriptors can't be tokenized.
+     */
+    AggregateReducerOutputHandler(
+            int reducer_socket_fd,
+            std::string const& field,
+            std::vector<std::string> const& group_by_fields
+    );
+
+    // Methods implementing OutputHandler
+    auto write(
+            std::string_view message,
+            epochtime_t timestamp,
+            std::string_view archive_id,
+            int64_t log_event_idx
+    ) -> void override {}
+
+    auto write(std::string_view message) -> void override {}
+
+    // Methods overriding OutputHandler
+    auto write_columnar_batch(search::ColumnarBatch const& batch) -> void override;
+
+    /**
+     * Flushes the partial aggregates.
+     * @return ErrorCodeSuccess on success
+     * @return ErrorCodeFailureNetwork on network error
+     */
+    auto finish() -> ErrorCode override;
+
+private:
+    // Types
+    struct FieldPath {
+        std::string descriptor_namespace;
+        std::vector<std::string> tokens;
+    };
+
+    // Methods
+    /**
+     * Finds the nodes in the schema tree that hold the aggregated field and the group-by fields.
+     * @param schema_tree
+     */
+    auto resolve_columns(SchemaTree const& schema_tree) -> void;
+
+    // Data members
+    int m_reducer_socket_fd;
+    FieldPath m_field_path;
+    std::vector<FieldPath> m_group_by_field_paths;
+
+    SchemaTree const* m_resolved_schema_tree{nullptr};
+    absl::flat_hash_set<int32_t> m_field_node_ids;
+    // Maps the ID of each node holding a group-by field to the index of that field
+    absl::flat_hash_map<int32_t, size_t> m_group_by_field_idxs;
+
+    std::vector<BaseColumnReader*> m_group_by_columns;
+    reducer::GroupTags m_tags;
+    reducer::AggregateOperator m_aggregate_operator;
+};
+
 /**
  * Output handler that performs a count aggregation and writes the results to the results cache.
  */
@@ -1,7 +1,15 @@
 #include "PackedStreamReader.hpp"
 
+#include <algorithm>
 #include <cstddef>
 #include <cstdint>
+#include <exception>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <tuple>
+#include <utility>
+#include <vector>
 
 #include <ystdlib/error_handling/Result.hpp>
 
@@ -14,6 +22,65 @@
 #include "TraceableException.hpp"
 
 namespace clp_s {
+auto PackedStreamReader::BufferPool::acquire(size_t min_size)
+        -> std::pair<std::shared_ptr<char[]>, size_t> {
+    std::unique_ptr<char[]> buf;
+    size_t buf_size{0};
+    {
+        std::lock_guard const lock{m_mutex};
+        auto const free_buffer_it = std::find_if(
+                m_free_buffers.begin(),
+                m_free_buffers.end(),
+                [&](auto const& free_buffer) { return free_buffer.second >= min_size; }
+        );
+        if (m_free_buffers.end() != free_buffer_it) {
+            buf = std::move(free_buffer_it->first);
+            buf_size = free_buffer_it->second;
+            m_free_buffers.erase(free_buffer_it);
+        } else if (false == m_free_buffers.empty()) {
+            // Free a buffer that's too small rather than keeping it alongside the new one
+            m_free_buffers.pop_back();
+        }
+    }
+    if (nullptr == buf) {
+        buf = std::make_unique_for_overwrite<char[]>(min_size);
+        buf_size = min_size;
+    }
+
+    // The deleter only holds a weak reference so that the pool is freed along with the reader,
+    // after which released buffers are simply freed
+    auto* const raw_buf = buf.release();
+    std::shared_ptr<char[]> pooled_buf{
+            raw_buf,
+            [pool = weak_from_this(), buf_size](char* released_buf) {
+                std::unique_ptr<char[]> owned_buf{released_buf};
+                if (auto const locked_pool = pool.lock(); nullptr != locked_pool) {
+                    locked_pool->release(std::move(owned_buf), buf_size);
+                }
+            }
+    };
+    return {std::move(pooled_buf), buf_size};
+}
+
+auto PackedStreamReader::BufferPool::release(std::unique_ptr<char[]> buf, size_t buf_size)
+        -> void {
+    std::lock_guard const lock{m_mutex};
+    if (m_free_buffers.size() < m_max_num_free_buffers) {
+        m_free_buffers.emplace_back(std::move(buf), buf_size);
+    }
+}
+
+PackedStreamReader::PrefetchState::~PrefetchState() {
+    {
+        std::lock_guard const lock{mutex};
+        stop = true;
+    }
+    cv.notify_all();
+    if (thread.joinable()) {
+        thread.join();
+    }
+}
+
 auto PackedStreamReader::read_metadata(ZstdDecompressor& decompressor)
         -> ystdlib::error_handling::Result<void> {
     switch (m_state) {
@@ -81,7 +148,56 @@ void PackedStreamReader::open_packed_streams(std::shared_ptr<ArchiveReaderAdapto
     }
 }
 
+void PackedStreamReader::prefetch_streams(
+        std::vector<size_t> stream_ids,
+        size_t max_num_prefetched_streams
+) {
+    if (PackedStreamReaderState::PackedStreamsOpened != m_state || nullptr != m_prefetch_state) {
+        throw OperationFailed(ErrorCodeNotReady, __FILENAME__, __LINE__);
+    }
+    if (0 == max_num_prefetched_streams) {
+        throw OperationFailed(ErrorCodeBadParam, __FILENAME__, __LINE__);
+    }
+    for (size_t i{0}; i < stream_ids.size(); ++i) {
+        if (stream_ids[i] >= m_stream_metadata.size()) {
+            throw OperationFailed(ErrorCodeCorrupt, __FILENAME__, __LINE__);
+        }
+        if (i > 0 && stream_ids[i - 1] >= stream_ids[i]) {
+            throw OperationFailed(ErrorCodeBadParam, __FILENAME__, __LINE__);
+        }
+    }
+    if (stream_ids.empty()) {
+        return;
+    }
+
+    m_prefetch_state
+            = std::make_unique<PrefetchState>(std::move(stream_ids), max_num_prefetched_streams);
+    m_prefetch_state->thread = std::thread{[this]() { prefetch_streams_in_background(); }};
+}
+
+void PackedStreamReader::close_packed_streams() {
+    switch (m_state) {
+        case PackedStreamReaderState::PackedStreamsOpened:
+        case PackedStreamReaderState::ReadingPackedStreams:
+            break;
+        default:
+            return;
+    }
+
+    // Stop prefetching before the tables section's reader is checked back in
+    m_prefetch_state.reset();
+    m_packed_stream_reader.reset();
+    m_adaptor->checkin_reader_for_section(constants::cArchiveTablesFile);
+    m_adaptor.reset();
+    m_prev_stream_id = 0ULL;
+    m_begin_offset = 0ULL;
+    m_state = PackedStreamReaderState::MetadataRead;
+}
+
 void PackedStreamReader::close() {
+    // Stop prefetching before the tables section's reader is checked back in
+    m_prefetch_state.reset();
+
     bool needs_checkin{false};
     switch (m_state) {
         case PackedStreamReaderState::PackedStreamsOpened:
@@ -104,7 +220,6 @@ void PackedStreamReader::close() {
 
 void
 PackedStreamReader::read_stream(size_t stream_id, std::shared_ptr<char[]>& buf, size_t& buf_size) {
-    constexpr size_t cDecompressorFileReadBufferCapacity = 64 * 1024;  // 64 KiB
     if (stream_id >= m_stream_metadata.size()) {
         throw OperationFailed(ErrorCodeCorrupt, __FILENAME__, __LINE__);
     }
@@ -123,25 +238,27 @@ PackedStreamReader::read_stream(size_t stream_id, std::shared_ptr<char[]>& buf,
     }
     m_prev_stream_id = stream_id;
 
-    auto& [file_offset, uncompressed_size] = m_stream_metadata[stream_id];
-    size_t adjusted_file_offset = m_begin_offset + file_offset;
-    if (auto error = m_packed_stream_reader->try_seek_from_begin(adjusted_file_offset);
+    if (nullptr != m_prefetch_state) {
+        read_prefetched_stream(stream_id, buf, buf_size);
+    } else {
+        decompress_stream(stream_id, buf, buf_size);
+    }
+}
+
+void PackedStreamReader::decompress_stream(
+        size_t stream_id,
+        std::shared_ptr<char[]>& buf,
+        size_t& buf_size
+) {
+    constexpr size_t cDecompressorFileReadBufferCapacity = 64 * 1024;  // 64 KiB
+    auto const uncompressed_size{m_stream_metadata[stream_id].uncompressed_size};
+    auto const [begin_pos, end_pos] = get_stream_range(stream_id);
+    m_adaptor->prefetch_ranges({{begin_pos, end_pos}});
+    if (auto error = m_packed_stream_reader->try_seek_from_begin(begin_pos);
         clp::ErrorCode::ErrorCode_Success != error)
     {
         throw OperationFailed(static_cast<ErrorCode>(error), __FILENAME__, __LINE__);
     }
-
-    auto const end_pos_result{
-            ReaderUtils::try_uint64_to_size_t(m_adaptor->get_header().compressed_size)
-    };
-    if (end_pos_result.has_error()) {
-        throw OperationFailed(ErrorCodeOutOfBounds, __FILENAME__, __LINE__);
-    }
-    size_t end_pos{end_pos_result.value()};
-
-    if ((stream_id + 1) < m_stream_metadata.size()) {
-        end_pos = m_begin_offset + m_stream_metadata[stream_id + 1].file_offset;
-    }
     clp::BoundedReader bounded_reader{m_packed_stream_reader.get(), end_pos};
 
     m_packed_stream_decompressor.open(bounded_reader, cDecompressorFileReadBufferCapacity);
@@ -159,4 +276,100 @@ PackedStreamReader::read_stream(size_t stream_id, std::shared_ptr<char[]>& buf,
     }
     m_packed_stream_decompressor.close_for_reuse();
 }
+
+auto PackedStreamReader::get_stream_range(size_t stream_id) const -> std::pair<size_t, size_t> {
+    auto const begin_pos{m_begin_offset + m_stream_metadata[stream_id].file_offset};
+    if ((stream_id + 1) < m_stream_metadata.size()) {
+        return {begin_pos, m_begin_offset + m_stream_metadata[stream_id + 1].file_offset};
+    }
+
+    auto const end_pos_result{
+            ReaderUtils::try_uint64_to_size_t(m_adaptor->get_header().compressed_size)
+    };
+    if (end_pos_result.has_error()) {
+        throw OperationFailed(ErrorCodeOutOfBounds, __FILENAME__, __LINE__);
+    }
+    return {begin_pos, end_pos_result.value()};
+}
+
+void PackedStreamReader::prefetch_streams_in_background() {
+    // The number of upcoming streams whose compressed bytes are fetched ahead of decompression, for
+    // archives that are read over the network.
+    constexpr size_t cNumStreamsToFetchAhead{16};
+
+    auto& state = *m_prefetch_state;
+
+    std::vector<std::pair<size_t, size_t>> ranges_to_fetch;
+    for (size_t i{0}; i < state.stream_ids.size(); ++i) {
+        auto const stream_id{state.stream_ids[i]};
+        {
+            std::unique_lock lock{state.mutex};
+            state.cv.wait(lock, [&]() {
+                return state.stop
+                       || state.prefetched_streams.size() < state.max_num_prefetched_streams;
+            });
+            if (state.stop) {
+                return;
+            }
+        }
+
+        PrefetchedStream prefetched_stream{stream_id, nullptr, 0, nullptr};
+        try {
+            ranges_to_fetch.clear();
+            auto const fetch_end_idx{
+                    std::min(i + cNumStreamsToFetchAhead, state.stream_ids.size())
+            };
+            for (size_t j{i}; j < fetch_end_idx; ++j) {
+                ranges_to_fetch.emplace_back(get_stream_range(state.stream_ids[j]));
+            }
+            m_adaptor->prefetch_ranges(ranges_to_fetch);
+
+            std::tie(prefetched_stream.buf, prefetched_stream.buf_size)
+                    = state.buffer_pool->acquire(m_stream_metadata[stream_id].uncompressed_size);
+            decompress_stream(stream_id, prefetched_stream.buf, prefetched_stream.buf_size);
+        } catch (...) {
+            prefetched_stream.exception = std::current_exception();
+        }
+
+        bool const failed{nullptr != prefetched_stream.exception};
+        {
+            std::lock_guard const lock{state.mutex};
+            state.prefetched_streams.emplace_back(std::move(prefetched_stream));
+        }
+        state.cv.notify_all();
+        if (failed) {
+            return;
+        }
+    }
+}
+
+void PackedStreamReader::read_prefetched_stream(
+        size_t stream_id,
+        std::shared_ptr<char[]>& buf,
+        size_t& buf_size
+) {
+    auto& state = *m_prefetch_state;
+    if (false == std::binary_search(state.stream_ids.cbegin(), state.stream_ids.cend(), stream_id))
+    {
+        throw OperationFailed(ErrorCodeBadParam, __FILENAME__, __LINE__);
+    }
+
+    std::unique_lock lock{state.mutex};
+    while (true) {
+        state.cv.wait(lock, [&]() { return false == state.prefetched_streams.empty(); });
+        auto prefetched_stream = std::move(state.prefetched_streams.front());
+        state.prefetched_streams.pop_front();
+        state.cv.notify_all();
+
+        if (nullptr != prefetched_stream.exception) {
+            std::rethrow_exception(prefetched_stream.exception);
+        }
+        if (stream_id == prefetched_stream.stream_id) {
+            buf = std::move(prefetched_stream.buf);
+            buf_size = prefetched_stream.buf_size;
+            return;
+        }
+        // Otherwise, the caller skipped this stream
+    }
+}
 }  // namespace clp_s
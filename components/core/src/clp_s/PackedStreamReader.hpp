@@ -1,9 +1,15 @@
 #ifndef CLP_S_PACKEDSTREAMREADER_HPP
 #define CLP_S_PACKEDSTREAMREADER_HPP
 
+#include <condition_variable>
 #include <cstddef>
+#include <deque>
+#include <exception>
 #include <memory>
+#include <mutex>
 #include <string>
+#include <thread>
+#include <utility>
 #include <vector>
 
 #include <ystdlib/error_handling/Result.hpp>
@@ -19,9 +25,16 @@ namespace clp_s {
  * read the tables section without loading the tables metadata, and any attempt to read tables
  * section out of order will throw. As well, any incorrect usage of this class (e.g. closing without
  * opening) will throw.
+ *
+ * Streams can optionally be prefetched: once the caller knows which streams it'll read, they're
+ * decompressed on a background thread into a bounded pool of buffers, so that decompression
+ * overlaps with the caller's processing of earlier streams.
  */
 class PackedStreamReader {
 public:
+    // Constants
+    static constexpr size_t cDefaultMaxNumPrefetchedStreams{2};
+
     class OperationFailed : public TraceableException {
     public:
         // Constructors
@@ -54,6 +67,28 @@ public:
      */
     void open_packed_streams(std::shared_ptr<ArchiveReaderAdaptor> adaptor);
 
+    /**
+     * Starts decompressing the given streams on a background thread, ahead of calls to
+     * `read_stream`. Must be invoked after `open_packed_streams` and before any stream is read.
+     *
+     * While prefetching, `read_stream` may only be called for the given streams (any of which may
+     * be skipped), and returns buffers from a pool. Each buffer returns to the pool for reuse once
+     * the caller releases its last reference to it.
+     * @param stream_ids the streams to prefetch, in strictly ascending order
+     * @param max_num_prefetched_streams the maximum number of decompressed streams to hold ahead of
+     * the caller
+     */
+    void prefetch_streams(
+            std::vector<size_t> stream_ids,
+            size_t max_num_prefetched_streams = cDefaultMaxNumPrefetchedStreams
+    );
+
+    /**
+     * Closes the file reader for the tables section, keeping the metadata so that the packed
+     * streams can be opened again. Does nothing if the packed streams aren't open.
+     */
+    void close_packed_streams();
+
     /**
      * Closes the file reader for the tables section.
      */
@@ -69,7 +104,8 @@ public:
      * where the caller wants to re-use the same buffer for multiple streams to avoid allocations
      * when they already have a sufficiently large buffer. If no buffer is provided or the provided
      * buffer is too small calling read_stream will create a buffer exactly as large as the stream
-     * being decompressed.
+     * being decompressed. If streams are being prefetched, the provided buffer is replaced by the
+     * buffer the stream was prefetched into.
      *
      * @param stream_id
      * @param buf a shared ptr to the buffer where the stream will be read. The buffer gets resized
@@ -91,6 +127,110 @@ private:
         ReadingPackedStreams
     };
 
+    /**
+     * A pool of buffers for decompressing prefetched streams into. The buffers handed out are
+     * returned to the pool when their last reference is released, which may happen on any thread
+     * and after the reader is closed.
+     */
+    class BufferPool : public std::enable_shared_from_this<BufferPool> {
+    public:
+        // Constructors
+        explicit BufferPool(size_t max_num_free_buffers)
+                : m_max_num_free_buffers{max_num_free_buffers} {}
+
+        // Methods
+        /**
+         * @param min_size
+         * @return A buffer of at least `min_size` bytes and its size, reusing a released buffer if
+         * possible.
+         */
+        [[nodiscard]] auto acquire(size_t min_size) -> std::pair<std::shared_ptr<char[]>, size_t>;
+
+    private:
+        /**
+         * Returns a buffer to the pool, or frees it if the pool is full.
+         * @param buf
+         * @param buf_size
+         */
+        auto release(std::unique_ptr<char[]> buf, size_t buf_size) -> void;
+
+        std::mutex m_mutex;
+        std::vector<std::pair<std::unique_ptr<char[]>, size_t>> m_free_buffers;
+        size_t m_max_num_free_buffers;
+    };
+
+    struct PrefetchedStream {
+        size_t stream_id;
+        std::shared_ptr<char[]> buf;
+        size_t buf_size;
+        // Set if decompressing the stream failed
+        std::exception_ptr exception;
+    };
+
+    /**
+     * State shared between the reader and its prefetching thread. Destroying the state stops the
+     * thread.
+     */
+    struct PrefetchState {
+        PrefetchState(std::vector<size_t> stream_ids, size_t max_num_prefetched_streams)
+                : stream_ids{std::move(stream_ids)},
+                  max_num_prefetched_streams{max_num_prefetched_streams},
+                  // Enough buffers for the prefetched streams, the stream the caller is currently
+                  // processing, and the one it's about to release
+                  buffer_pool{std::make_shared<BufferPool>(max_num_prefetched_streams + 2)} {}
+
+        // Delete copy & move constructors and assignment operators
+        PrefetchState(PrefetchState const&) = delete;
+        PrefetchState(PrefetchState&&) = delete;
+        auto operator=(PrefetchState const&) -> PrefetchState& = delete;
+        auto operator=(PrefetchState&&) -> PrefetchState& = delete;
+
+        ~PrefetchState();
+
+        std::vector<size_t> const stream_ids;
+        size_t const max_num_prefetched_streams;
+
+        std::mutex mutex;
+        std::condition_variable cv;
+        std::deque<PrefetchedStream> prefetched_streams;
+        bool stop{false};
+
+        std::shared_ptr<BufferPool> const buffer_pool;
+
+        std::thread thread;
+    };
+
+    /**
+     * @param stream_id
+     * @return The range of the given stream's compressed bytes, [begin, end), as offsets from the
+     * beginning of the archive.
+     * @throw OperationFailed if the archive's size can't be represented as a size_t.
+     */
+    [[nodiscard]] auto get_stream_range(size_t stream_id) const -> std::pair<size_t, size_t>;
+
+    /**
+     * Decompresses a stream into the given buffer, growing the buffer if it's too small.
+     * @param stream_id
+     * @param buf
+     * @param buf_size
+     */
+    void decompress_stream(size_t stream_id, std::shared_ptr<char[]>& buf, size_t& buf_size);
+
+    /**
+     * Decompresses each stream to prefetch in turn, waiting whenever the maximum number of
+     * prefetched streams haven't been read yet. Runs on the prefetching thread.
+     */
+    void prefetch_streams_in_background();
+
+    /**
+     * Waits for the prefetching thread to decompress the given stream, skipping any prefetched
+     * streams before it.
+     * @param stream_id
+     * @param buf Returns the buffer containing the stream
+     * @param buf_size Returns the size of the buffer
+     */
+    void read_prefetched_stream(size_t stream_id, std::shared_ptr<char[]>& buf, size_t& buf_size);
+
     std::vector<PackedStreamMetadata> m_stream_metadata;
     std::shared_ptr<ArchiveReaderAdaptor> m_adaptor;
     std::unique_ptr<clp::ReaderInterface> m_packed_stream_reader;
@@ -98,6 +238,7 @@ private:
     PackedStreamReaderState m_state{PackedStreamReaderState::Uninitialized};
     size_t m_begin_offset{};
     size_t m_prev_stream_id{0ULL};
+    std::unique_ptr<PrefetchState> m_prefetch_state;
 };
 }  // namespace clp_s
 
@@ -62,6 +62,28 @@ int64_t SchemaReader::get_next_log_event_idx() const {
     return 0;
 }
 
+void SchemaReader::skip_to_log_event_idx(int64_t log_event_idx) {
+    if (nullptr == m_log_event_idx_column) {
+        return;
+    }
+    // A linear scan is as fast as a binary search here since the log_event_idx column is delta
+    // encoded
+    while (m_cur_message < m_num_messages && get_next_log_event_idx() < log_event_idx) {
+        ++m_cur_message;
+    }
+}
+
+void SchemaReader::seek_to_message_of(SchemaReader const& other) {
+    m_cur_message = other.m_cur_message;
+    auto* log_event_idx_column
+            = dynamic_cast<DeltaEncodedInt64ColumnReader*>(m_log_event_idx_column);
+    auto const* other_log_event_idx_column
+            = dynamic_cast<DeltaEncodedInt64ColumnReader const*>(other.m_log_event_idx_column);
+    if (nullptr != log_event_idx_column && nullptr != other_log_event_idx_column) {
+        log_event_idx_column->seek_to_idx_of(*other_log_event_idx_column);
+    }
+}
+
 void
 SchemaReader::load(std::shared_ptr<char[]> stream_buffer, size_t offset, size_t uncompressed_size) {
     m_stream_buffer = stream_buffer;
@@ -74,8 +96,8 @@ SchemaReader::load(std::shared_ptr<char[]> stream_buffer, size_t offset, size_t
     }
 }
 
-auto SchemaReader::generate_json_string(uint64_t message_index) -> std::string {
-    m_json_serializer.reset();
+auto SchemaReader::append_json_string(uint64_t message_index, std::string& buffer) -> void {
+    m_json_serializer.reset(buffer);
     m_json_serializer.begin_document();
     size_t column_id_index = 0;
     BaseColumnReader* column;
@@ -108,24 +130,18 @@ auto SchemaReader::generate_json_string(uint64_t message_index) -> std::string {
             }
             case JsonSerializer::Op::AddIntField: {
                 column = m_reordered_columns[column_id_index++];
-                auto name = m_global_schema_tree->get_node(column->get_id()).get_key_name();
-                m_json_serializer.append_key(name);
-                m_json_serializer.append_value(
-                        std::to_string(std::get<int64_t>(column->extract_value(message_index)))
-                );
+                m_json_serializer.append_key();
+                m_json_serializer.append_value_from_column(column, message_index);
                 break;
             }
             case JsonSerializer::Op::AddIntValue: {
                 column = m_reordered_columns[column_id_index++];
-                m_json_serializer.append_value(
-                        std::to_string(std::get<int64_t>(column->extract_value(message_index)))
-                );
+                m_json_serializer.append_value_from_column(column, message_index);
                 break;
             }
             case JsonSerializer::Op::AddFloatField: {
                 column = m_reordered_columns[column_id_index++];
-                auto name = m_global_schema_tree->get_node(column->get_id()).get_key_name();
-                m_json_serializer.append_key(name);
+                m_json_serializer.append_key();
                 m_json_serializer.append_value(
                         std::to_string(std::get<double>(column->extract_value(message_index)))
                 );
@@ -140,8 +156,7 @@ auto SchemaReader::generate_json_string(uint64_t message_index) -> std::string {
             }
             case JsonSerializer::Op::AddFormattedFloatField: {
                 column = m_reordered_columns[column_id_index++];
-                auto name = m_global_schema_tree->get_node(column->get_id()).get_key_name();
-                m_json_serializer.append_key(name);
+                m_json_serializer.append_key();
                 m_json_serializer.append_value_from_column(column, message_index);
                 break;
             }
@@ -152,8 +167,7 @@ auto SchemaReader::generate_json_string(uint64_t message_index) -> std::string {
             }
             case JsonSerializer::Op::AddBoolField: {
                 column = m_reordered_columns[column_id_index++];
-                auto name = m_global_schema_tree->get_node(column->get_id()).get_key_name();
-                m_json_serializer.append_key(name);
+                m_json_serializer.append_key();
                 m_json_serializer.append_value(
                         std::get<uint8_t>(column->extract_value(message_index)) != 0 ? "true"
                                                                                      : "false"
@@ -170,8 +184,7 @@ auto SchemaReader::generate_json_string(uint64_t message_index) -> std::string {
             }
             case JsonSerializer::Op::AddStringField: {
                 column = m_reordered_columns[column_id_index++];
-                auto name = m_global_schema_tree->get_node(column->get_id()).get_key_name();
-                m_json_serializer.append_key(name);
+                m_json_serializer.append_key();
                 m_json_serializer.append_value_from_column_with_quotes(column, message_index);
                 break;
             }
@@ -182,9 +195,7 @@ auto SchemaReader::generate_json_string(uint64_t message_index) -> std::string {
             }
             case JsonSerializer::Op::AddArrayField: {
                 column = m_reordered_columns[column_id_index++];
-                m_json_serializer.append_key(
-                        m_global_schema_tree->get_node(column->get_id()).get_key_name()
-                );
+                m_json_serializer.append_key();
                 m_json_serializer.append_value_from_column(column, message_index);
                 break;
             }
@@ -199,8 +210,7 @@ auto SchemaReader::generate_json_string(uint64_t message_index) -> std::string {
             }
             case JsonSerializer::Op::AddLiteralField: {
                 column = m_reordered_columns[column_id_index++];
-                auto const key{m_global_schema_tree->get_node(column->get_id()).get_key_name()};
-                m_json_serializer.append_key(key);
+                m_json_serializer.append_key();
                 m_json_serializer.append_value_from_column(column, message_index);
                 break;
             }
@@ -208,10 +218,14 @@ auto SchemaReader::generate_json_string(uint64_t message_index) -> std::string {
     }
 
     m_json_serializer.end_document();
-    return m_json_serializer.get_serialized_string();
 }
 
 bool SchemaReader::get_next_message(std::string& message) {
+    message.clear();
+    return append_next_message(message);
+}
+
+bool SchemaReader::append_next_message(std::string& buffer) {
     if (m_cur_message >= m_num_messages) {
         return false;
     }
@@ -219,17 +233,19 @@ bool SchemaReader::get_next_message(std::string& message) {
     if (false == m_serializer_initialized) {
         initialize_serializer();
     }
-    message = generate_json_string(m_cur_message);
-
-    if (message.back() != '\n') {
-        message += '\n';
-    }
+    append_json_string(m_cur_message, buffer);
+    buffer.push_back('\n');
 
     ++m_cur_message;
     return true;
 }
 
 bool SchemaReader::get_next_message(std::string& message, FilterClass& filter) {
+    message.clear();
+    return append_next_message(message, filter);
+}
+
+bool SchemaReader::append_next_message(std::string& buffer, FilterClass& filter) {
     while (m_cur_message < m_num_messages && false == filter.filter(m_cur_message)) {
         ++m_cur_message;
     }
@@ -242,11 +258,8 @@ bool SchemaReader::get_next_message(std::string& message, FilterClass& filter) {
         if (false == m_serializer_initialized) {
             initialize_serializer();
         }
-        message = generate_json_string(m_cur_message);
-
-        if (message.back() != '\n') {
-            message += '\n';
-        }
+        append_json_string(m_cur_message, buffer);
+        buffer.push_back('\n');
     }
 
     ++m_cur_message;
@@ -266,11 +279,9 @@ bool SchemaReader::get_next_message_with_metadata(
         if (false == m_serializer_initialized) {
             initialize_serializer();
         }
-        message = generate_json_string(m_cur_message);
-
-        if (message.back() != '\n') {
-            message += '\n';
-        }
+        message.clear();
+        append_json_string(m_cur_message, message);
+        message.push_back('\n');
     }
 
     timestamp = m_get_timestamp();
@@ -285,6 +296,16 @@ bool SchemaReader::get_next_message_with_metadata(
         epochtime_t& timestamp,
         int64_t& log_event_idx,
         FilterClass& filter
+) {
+    message.clear();
+    return append_next_message_with_metadata(message, timestamp, log_event_idx, filter);
+}
+
+bool SchemaReader::append_next_message_with_metadata(
+        std::string& buffer,
+        epochtime_t& timestamp,
+        int64_t& log_event_idx,
+        FilterClass& filter
 ) {
     // TODO: If we already get max_num_results messages, we can skip messages
     // with the timestamp less than the smallest timestamp in the priority queue
@@ -300,13 +321,32 @@ bool SchemaReader::get_next_message_with_metadata(
         if (false == m_serializer_initialized) {
             initialize_serializer();
         }
-        message = generate_json_string(m_cur_message);
+        append_json_string(m_cur_message, buffer);
+        buffer.push_back('\n');
+    }
 
-        if (message.back() != '\n') {
-            message += '\n';
-        }
+    timestamp = m_get_timestamp();
+    log_event_idx = get_next_log_event_idx();
+
+    ++m_cur_message;
+    return true;
+}
+
+bool SchemaReader::get_next_matching_message_idx(
+        uint64_t& message_idx,
+        epochtime_t& timestamp,
+        int64_t& log_event_idx,
+        FilterClass& filter
+) {
+    while (m_cur_message < m_num_messages && false == filter.filter(m_cur_message)) {
+        ++m_cur_message;
+    }
+
+    if (m_cur_message >= m_num_messages) {
+        return false;
     }
 
+    message_idx = m_cur_message;
     timestamp = m_get_timestamp();
     log_event_idx = get_next_log_event_idx();
 
@@ -580,28 +620,33 @@ size_t SchemaReader::generate_structured_object_template(
                 case NodeType::DeltaInteger:
                 case NodeType::Integer: {
                     m_json_serializer.add_op(JsonSerializer::Op::AddIntField);
+                    m_json_serializer.add_special_key(node.get_key_name());
                     m_reordered_columns.push_back(m_columns[column_idx++]);
                     break;
                 }
                 case NodeType::Float: {
                     m_json_serializer.add_op(JsonSerializer::Op::AddFloatField);
+                    m_json_serializer.add_special_key(node.get_key_name());
                     m_reordered_columns.push_back(m_columns[column_idx++]);
                     break;
                 }
                 case NodeType::FormattedFloat:
                 case NodeType::DictionaryFloat: {
                     m_json_serializer.add_op(JsonSerializer::Op::AddFormattedFloatField);
+                    m_json_serializer.add_special_key(node.get_key_name());
                     m_reordered_columns.push_back(m_columns[column_idx++]);
                     break;
                 }
                 case NodeType::Boolean: {
                     m_json_serializer.add_op(JsonSerializer::Op::AddBoolField);
+                    m_json_serializer.add_special_key(node.get_key_name());
                     m_reordered_columns.push_back(m_columns[column_idx++]);
                     break;
                 }
                 case NodeType::ClpString:
                 case NodeType::VarString: {
                     m_json_serializer.add_op(JsonSerializer::Op::AddStringField);
+                    m_json_serializer.add_special_key(node.get_key_name());
                     m_reordered_columns.push_back(m_columns[column_idx++]);
                     break;
                 }
@@ -674,6 +719,7 @@ void SchemaReader::generate_json_template(int32_t id) {
             }
             case NodeType::UnstructuredArray: {
                 m_json_serializer.add_op(JsonSerializer::Op::AddArrayField);
+                m_json_serializer.add_special_key(key);
                 m_reordered_columns.push_back(m_column_map[child_global_id]);
                 break;
             }
@@ -696,22 +742,26 @@ void SchemaReader::generate_json_template(int32_t id) {
             case NodeType::DeltaInteger:
             case NodeType::Integer: {
                 m_json_serializer.add_op(JsonSerializer::Op::AddIntField);
+                m_json_serializer.add_special_key(key);
                 m_reordered_columns.push_back(m_column_map[child_global_id]);
                 break;
             }
             case NodeType::Float: {
                 m_json_serializer.add_op(JsonSerializer::Op::AddFloatField);
+                m_json_serializer.add_special_key(key);
                 m_reordered_columns.push_back(m_column_map[child_global_id]);
                 break;
             }
             case NodeType::FormattedFloat:
             case NodeType::DictionaryFloat: {
                 m_json_serializer.add_op(JsonSerializer::Op::AddFormattedFloatField);
+                m_json_serializer.add_special_key(key);
                 m_reordered_columns.push_back(m_column_map[child_global_id]);
                 break;
             }
             case NodeType::Boolean: {
                 m_json_serializer.add_op(JsonSerializer::Op::AddBoolField);
+                m_json_serializer.add_special_key(key);
                 m_reordered_columns.push_back(m_column_map[child_global_id]);
                 break;
             }
@@ -719,11 +769,13 @@ void SchemaReader::generate_json_template(int32_t id) {
             case NodeType::VarString:
             case NodeType::DeprecatedDateString: {
                 m_json_serializer.add_op(JsonSerializer::Op::AddStringField);
+                m_json_serializer.add_special_key(key);
                 m_reordered_columns.push_back(m_column_map[child_global_id]);
                 break;
             }
             case NodeType::Timestamp: {
                 m_json_serializer.add_op(JsonSerializer::Op::AddLiteralField);
+                m_json_serializer.add_special_key(key);
                 m_reordered_columns.emplace_back(m_column_map.at(child_global_id));
                 break;
             }
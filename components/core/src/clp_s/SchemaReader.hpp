@@ -3,6 +3,7 @@
 
 #include <cstddef>
 #include <cstdint>
+#include <limits>
 #include <memory>
 #include <span>
 #include <string>
@@ -94,12 +95,39 @@ public:
             m_uncompressed_size = uncompressed_size;
         }
 
+        /**
+         * Sets the range of log event indices of the schema's messages. Without a range, the
+         * schema is assumed to overlap every range.
+         * @param begin_log_event_idx
+         * @param end_log_event_idx One past the log event index of the schema's last message
+         */
+        auto set_log_event_idx_range(int64_t begin_log_event_idx, int64_t end_log_event_idx)
+                -> void {
+            m_begin_log_event_idx = begin_log_event_idx;
+            m_end_log_event_idx = end_log_event_idx;
+        }
+
+        /**
+         * @param begin_log_event_idx
+         * @param end_log_event_idx
+         * @return Whether the schema may contain messages in the range
+         * [begin_log_event_idx, end_log_event_idx)
+         */
+        [[nodiscard]] auto
+        overlaps_log_event_idx_range(int64_t begin_log_event_idx, int64_t end_log_event_idx) const
+                -> bool {
+            return begin_log_event_idx < m_end_log_event_idx
+                   && m_begin_log_event_idx < end_log_event_idx;
+        }
+
     private:
         // Members
         size_t m_stream_id{0};
         size_t m_stream_offset{0};
         uint64_t m_num_messages{0};
         size_t m_uncompressed_size{0};
+        int64_t m_begin_log_event_idx{std::numeric_limits<int64_t>::min()};
+        int64_t m_end_log_event_idx{std::numeric_limits<int64_t>::max()};
     };
 
     // Constructor
@@ -170,6 +198,13 @@ public:
 
     size_t get_column_size() { return m_columns.size(); }
 
+    /**
+     * @return The readers of every column in the schema, each of which holds one value per message
+     */
+    [[nodiscard]] auto get_columns() const -> std::vector<BaseColumnReader*> const& {
+        return m_columns;
+    }
+
     /**
      * Marks an unordered object for the purpose of marshalling records.
      * @param column_reader_start,
@@ -196,11 +231,19 @@ public:
     uint64_t get_num_messages() const { return m_num_messages; }
 
     /**
-     * Generates a JSON string from the encoded columns
+     * Generates a JSON string from the encoded columns and appends it to the given buffer. The
+     * serializer must have been initialized with `initialize_serializer`.
      * @param message_index The index of the message to generate the JSON string for.
-     * @return The generated JSON string
+     * @param buffer
      */
-    [[nodiscard]] auto generate_json_string(uint64_t message_index) -> std::string;
+    auto append_json_string(uint64_t message_index, std::string& buffer) -> void;
+
+    /**
+     * Appends the next message, followed by a newline, to the given buffer
+     * @param buffer
+     * @return true if there is a next message
+     */
+    bool append_next_message(std::string& buffer);
 
     /**
      * Gets the next message
@@ -245,6 +288,48 @@ public:
             FilterClass& filter
     );
 
+    /**
+     * Appends the next message matching a filter, followed by a newline, to the given buffer.
+     * Nothing is appended if records aren't being marshalled.
+     * @param buffer
+     * @param filter
+     * @return true if there is a next message
+     */
+    bool append_next_message(std::string& buffer, FilterClass& filter);
+
+    /**
+     * Appends the next message matching a filter, followed by a newline, to the given buffer, and
+     * gets its timestamp and log event index. Nothing is appended if records aren't being
+     * marshalled.
+     * @param buffer
+     * @param timestamp
+     * @param log_event_idx
+     * @param filter
+     * @return true if there is a next message
+     */
+    bool append_next_message_with_metadata(
+            std::string& buffer,
+            epochtime_t& timestamp,
+            int64_t& log_event_idx,
+            FilterClass& filter
+    );
+
+    /**
+     * Gets the index of the next message matching a filter as well as its timestamp and log event
+     * index, without marshalling the message.
+     * @param message_idx
+     * @param timestamp
+     * @param log_event_idx
+     * @param filter
+     * @return true if there is a next message
+     */
+    bool get_next_matching_message_idx(
+            uint64_t& message_idx,
+            epochtime_t& timestamp,
+            int64_t& log_event_idx,
+            FilterClass& filter
+    );
+
     /**
      * Initializes the filter
      * @param filter
@@ -296,6 +381,22 @@ public:
      */
     int64_t get_next_log_event_idx() const;
 
+    /**
+     * Skips the messages with a log_event_idx less than the given index. Since messages are stored
+     * in log order, this positions m_cur_message on the first message at or after the given index.
+     * Does nothing if there is no log_event_idx in this table.
+     * @param log_event_idx
+     */
+    void skip_to_log_event_idx(int64_t log_event_idx);
+
+    /**
+     * Positions this reader on the message that `other` is positioned on. Unlike
+     * `skip_to_log_event_idx`, this doesn't rescan the log_event_idx column from the start of the
+     * table.
+     * @param other A reader of the same table, loaded from the same stream
+     */
+    void seek_to_message_of(SchemaReader const& other);
+
     /**
      * @return true if all records in this table have been iterated over, false otherwise
      */
@@ -8,7 +8,7 @@ void SchemaWriter::append_column(std::unique_ptr<BaseColumnWriter> column_writer
     m_columns.emplace_back(std::move(column_writer));
 }
 
-size_t SchemaWriter::append_message(ParsedMessage& message) {
+size_t SchemaWriter::append_message(ParsedMessage& message, int64_t log_event_idx) {
     int count{};
     size_t total_size{};
     for (auto& i : message.get_content()) {
@@ -21,6 +21,12 @@ size_t SchemaWriter::append_message(ParsedMessage& message) {
         ++count;
     }
 
+    // Messages are appended in log order
+    if (0 == m_num_messages) {
+        m_begin_log_event_idx = log_event_idx;
+    }
+    m_end_log_event_idx = log_event_idx + 1;
+
     m_num_messages++;
     m_total_uncompressed_size += total_size;
     return total_size;
@@ -1,6 +1,7 @@
 #ifndef CLP_S_SCHEMAWRITER_HPP
 #define CLP_S_SCHEMAWRITER_HPP
 
+#include <cstdint>
 #include <memory>
 #include <vector>
 
@@ -34,9 +35,10 @@ public:
     /**
      * Appends a message to the schema writer.
      * @param message
+     * @param log_event_idx The index of the message in the archive
      * @return The size of the message in bytes.
      */
-    size_t append_message(ParsedMessage& message);
+    size_t append_message(ParsedMessage& message, int64_t log_event_idx);
 
     /**
      * Stores the columns to disk.
@@ -46,6 +48,16 @@ public:
 
     uint64_t get_num_messages() const { return m_num_messages; }
 
+    /**
+     * @return The log event index of the first message in the schema
+     */
+    int64_t get_begin_log_event_idx() const { return m_begin_log_event_idx; }
+
+    /**
+     * @return One past the log event index of the last message in the schema
+     */
+    int64_t get_end_log_event_idx() const { return m_end_log_event_idx; }
+
     /**
      * @return the uncompressed in-memory size of the data that will be written to the compressor
      */
@@ -54,6 +66,8 @@ public:
 private:
     uint64_t m_num_messages;
     size_t m_total_uncompressed_size{};
+    int64_t m_begin_log_event_idx{};
+    int64_t m_end_log_event_idx{};
 
     std::vector<std::unique_ptr<BaseColumnWriter>> m_columns;
 };
@@ -0,0 +1,227 @@
+#include "SearchServer.hpp"
+
+#include <sys/socket.h>
+#include <sys/time.h>
+#include <sys/un.h>
+#include <unistd.h>
+
+#include <algorithm>
+#include <array>
+#include <cerrno>
+#include <chrono>
+#include <cstddef>
+#include <cstring>
+#include <exception>
+#include <filesystem>
+#include <iostream>
+#include <optional>
+#include <string>
+#include <string_view>
+#include <system_error>
+#include <tuple>
+#include <utility>
+#include <vector>
+
+#include <fmt/format.h>
+#include <nlohmann/json.hpp>
+#include <spdlog/spdlog.h>
+
+namespace clp_s {
+namespace {
+/**
+ * Writes all of the given data to the given file descriptor.
+ * @param fd
+ * @param data
+ * @return Whether all of the data was written.
+ */
+auto write_all(int fd, std::string_view data) -> bool;
+
+auto write_all(int fd, std::string_view data) -> bool {
+    while (false == data.empty()) {
+        auto const num_bytes_written{::write(fd, data.data(), data.size())};
+        if (num_bytes_written < 0) {
+            if (EINTR == errno) {
+                continue;
+            }
+            return false;
+        }
+        data.remove_prefix(static_cast<size_t>(num_bytes_written));
+    }
+    return true;
+}
+}  // namespace
+
+SearchServer::SearchServer(
+        std::string socket_path,
+        SearchFunction search,
+        std::chrono::milliseconds request_timeout
+)
+        : m_socket_path{std::move(socket_path)},
+          m_search{std::move(search)},
+          m_request_timeout{request_timeout} {}
+
+SearchServer::~SearchServer() {
+    if (-1 != m_listen_fd) {
+        ::close(m_listen_fd);
+    }
+}
+
+auto SearchServer::listen() -> bool {
+    sockaddr_un address{};
+    if (m_socket_path.size() >= sizeof(address.sun_path)) {
+        SPDLOG_ERROR("Socket path '{}' is too long", m_socket_path);
+        return false;
+    }
+    address.sun_family = AF_UNIX;
+    std::memcpy(address.sun_path, m_socket_path.c_str(), m_socket_path.size());
+
+    // Remove any socket left behind by a previous server
+    std::error_code ec;
+    if (std::filesystem::is_socket(m_socket_path, ec)) {
+        std::filesystem::remove(m_socket_path, ec);
+    }
+
+    m_listen_fd = ::socket(AF_UNIX, SOCK_STREAM | SOCK_CLOEXEC, 0);
+    if (-1 == m_listen_fd) {
+        SPDLOG_ERROR("Failed to create socket - errno={}", errno);
+        return false;
+    }
+    // NOLINTNEXTLINE(cppcoreguidelines-pro-type-reinterpret-cast)
+    if (0 != ::bind(m_listen_fd, reinterpret_cast<sockaddr*>(&address), sizeof(address))
+        || 0 != ::listen(m_listen_fd, SOMAXCONN))
+    {
+        SPDLOG_ERROR("Failed to listen on '{}' - errno={}", m_socket_path, errno);
+        ::close(m_listen_fd);
+        m_listen_fd = -1;
+        return false;
+    }
+    return true;
+}
+
+auto SearchServer::serve() -> bool {
+    while (false == m_stopped) {
+        int const connection_fd{::accept4(m_listen_fd, nullptr, nullptr, SOCK_CLOEXEC)};
+        if (-1 == connection_fd) {
+            if (m_stopped) {
+                break;
+            }
+            if (EINTR == errno || ECONNABORTED == errno) {
+                continue;
+            }
+            SPDLOG_ERROR("Failed to accept connection - errno={}", errno);
+            return false;
+        }
+        serve_connection(connection_fd);
+        ::close(connection_fd);
+    }
+    return true;
+}
+
+auto SearchServer::stop() -> void {
+    m_stopped = true;
+    // Wake up `serve` if it's waiting for a connection
+    ::shutdown(m_listen_fd, SHUT_RDWR);
+}
+
+auto SearchServer::serve_connection(int connection_fd) -> void {
+    std::string status_line;
+    if (auto const error_message{try_serve_connection(connection_fd)}; error_message.has_value())
+    {
+        SPDLOG_ERROR("Failed to serve search request - {}", error_message.value());
+        status_line = fmt::format("{}{}\n", cErrorStatusPrefix, error_message.value());
+    } else {
+        status_line = fmt::format("{}\n", cSuccessStatusLine);
+    }
+    // The client may have disconnected, in which case there's no one to report the status to
+    std::ignore = write_all(connection_fd, status_line);
+}
+
+auto SearchServer::try_serve_connection(int connection_fd) -> std::optional<std::string> {
+    std::string request;
+    if (auto error_message{read_request(connection_fd, request)}; error_message.has_value()) {
+        return error_message;
+    }
+
+    std::vector<std::string> search_args;
+    try {
+        // NOTE: Brace-initializing a `nlohmann::json` from another treats it as an initializer
+        // list, which turns a two-element array into an object.
+        auto const request_json = nlohmann::json::parse(request);
+        if (false == request_json.is_array()) {
+            return "Search request must be a JSON array of arguments";
+        }
+        for (auto const& arg : request_json) {
+            search_args.emplace_back(arg.get<std::string>());
+        }
+    } catch (std::exception const& e) {
+        return fmt::format("Failed to parse search request - {}", e.what());
+    }
+
+    std::cout.flush();
+    int const stdout_fd{::dup(STDOUT_FILENO)};
+    if (-1 == stdout_fd || -1 == ::dup2(connection_fd, STDOUT_FILENO)) {
+        if (-1 != stdout_fd) {
+            ::close(stdout_fd);
+        }
+        return fmt::format("Failed to redirect stdout to the connection - errno={}", errno);
+    }
+    std::optional<std::string> error_message;
+    try {
+        if (false == m_search(search_args)) {
+            error_message = fmt::format("Search {} failed", request);
+        }
+    } catch (std::exception const& e) {
+        error_message = fmt::format("Search {} failed - {}", request, e.what());
+    }
+    std::cout.flush();
+    ::dup2(stdout_fd, STDOUT_FILENO);
+    ::close(stdout_fd);
+    // Writing to a client that disconnected leaves stdout in a failed state
+    std::cout.clear();
+    return error_message;
+}
+
+auto SearchServer::read_request(int connection_fd, std::string& request) const
+        -> std::optional<std::string> {
+    constexpr size_t cReadBufferSize{4096};
+
+    // Bound how long a client that never finishes its request can hold up the server
+    auto const timeout_us{
+            std::chrono::duration_cast<std::chrono::microseconds>(m_request_timeout).count()
+    };
+    timeval timeout{};
+    timeout.tv_sec = static_cast<time_t>(timeout_us / 1'000'000);
+    timeout.tv_usec = static_cast<suseconds_t>(timeout_us % 1'000'000);
+    if (0 != ::setsockopt(connection_fd, SOL_SOCKET, SO_RCVTIMEO, &timeout, sizeof(timeout))) {
+        return fmt::format("Failed to set the request timeout - errno={}", errno);
+    }
+
+    request.clear();
+    std::array<char, cReadBufferSize> read_buffer{};
+    while (std::string::npos == request.find('\n')) {
+        auto const num_bytes_read{::read(connection_fd, read_buffer.data(), read_buffer.size())};
+        if (num_bytes_read < 0) {
+            if (EINTR == errno) {
+                continue;
+            }
+            if (EAGAIN == errno || EWOULDBLOCK == errno) {
+                return fmt::format(
+                        "Timed out after {} ms waiting for the search request",
+                        m_request_timeout.count()
+                );
+            }
+            return fmt::format("Failed to read search request - errno={}", errno);
+        }
+        if (0 == num_bytes_read) {
+            // The client finished sending without a trailing newline
+            break;
+        }
+        request.append(read_buffer.data(), static_cast<size_t>(num_bytes_read));
+        if (request.size() > cMaxRequestSize) {
+            return fmt::format("Search request exceeds {} bytes", cMaxRequestSize);
+        }
+    }
+    request.resize(std::min(request.find('\n'), request.size()));
+    return std::nullopt;
+}
+}  // namespace clp_s
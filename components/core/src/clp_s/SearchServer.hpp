@@ -0,0 +1,112 @@
+#ifndef CLP_S_SEARCHSERVER_HPP
+#define CLP_S_SEARCHSERVER_HPP
+
+#include <atomic>
+#include <chrono>
+#include <cstddef>
+#include <functional>
+#include <optional>
+#include <string>
+#include <string_view>
+#include <vector>
+
+namespace clp_s {
+/**
+ * A server that receives search requests on a Unix domain socket and serves them one at a time.
+ *
+ * Each connection sends a single request: a JSON array containing the arguments of the search
+ * command, terminated by a newline. The server writes anything the search writes to stdout to the
+ * connection, followed by a status line, and then closes the connection. The status line is
+ * `cSuccessStatusLine` if the request succeeded; otherwise, it's `cErrorStatusPrefix` followed by
+ * the reason the request failed. Since the status line is always the last line of the response,
+ * clients can tell it apart from the results.
+ */
+class SearchServer {
+public:
+    // Types
+    /**
+     * Serves a search with the given arguments, writing its results to stdout.
+     * @return Whether the search succeeded.
+     */
+    using SearchFunction = std::function<bool(std::vector<std::string> const& search_args)>;
+
+    // Constants
+    static constexpr std::string_view cSuccessStatusLine{"CLP_S_STATUS OK"};
+    static constexpr std::string_view cErrorStatusPrefix{"CLP_S_STATUS ERROR "};
+    static constexpr std::chrono::milliseconds cDefaultRequestTimeout{30'000};
+    static constexpr size_t cMaxRequestSize{1024ULL * 1024};  // 1 MiB
+
+    // Constructors
+    /**
+     * @param socket_path
+     * @param search
+     * @param request_timeout The maximum time to wait for each part of a request to be received.
+     */
+    SearchServer(
+            std::string socket_path,
+            SearchFunction search,
+            std::chrono::milliseconds request_timeout = cDefaultRequestTimeout
+    );
+
+    // Delete copy & move constructors and assignment operators
+    SearchServer(SearchServer const&) = delete;
+    SearchServer(SearchServer&&) = delete;
+    auto operator=(SearchServer const&) -> SearchServer& = delete;
+    auto operator=(SearchServer&&) -> SearchServer& = delete;
+
+    // Destructor
+    ~SearchServer();
+
+    // Methods
+    /**
+     * Starts listening on the socket, replacing any socket left behind by a previous server.
+     * @return Whether the server started listening.
+     */
+    [[nodiscard]] auto listen() -> bool;
+
+    /**
+     * Serves requests until `stop` is called. Must be called after `listen`.
+     * @return Whether the server stopped without encountering an error.
+     */
+    [[nodiscard]] auto serve() -> bool;
+
+    /**
+     * Makes `serve` return once the request being served (if any) is complete. This method may be
+     * called from any thread.
+     */
+    auto stop() -> void;
+
+private:
+    // Methods
+    /**
+     * Serves the request received on the given connection, ending the response with a status line.
+     * @param connection_fd
+     */
+    auto serve_connection(int connection_fd) -> void;
+
+    /**
+     * Reads and serves the request received on the given connection.
+     * @param connection_fd
+     * @return std::nullopt on success, or the reason the request failed.
+     */
+    [[nodiscard]] auto try_serve_connection(int connection_fd) -> std::optional<std::string>;
+
+    /**
+     * Reads a request, up to its terminating newline.
+     * @param connection_fd
+     * @param request Returns the request, without its terminating newline.
+     * @return std::nullopt on success, or the reason the request couldn't be read.
+     */
+    [[nodiscard]] auto read_request(int connection_fd, std::string& request) const
+            -> std::optional<std::string>;
+
+    // Variables
+    std::string m_socket_path;
+    SearchFunction m_search;
+    std::chrono::milliseconds m_request_timeout;
+    int m_listen_fd{-1};
+    std::atomic_bool m_stopped{false};
+};
+}  // namespace clp_s
+
+#endif  // CLP_S_SEARCHSERVER_HPP
@@ -1,6 +1,8 @@
 #include "TimestampDictionaryWriter.hpp"
 
+#include <cstddef>
 #include <cstdint>
+#include <optional>
 #include <sstream>
 #include <string>
 #include <string_view>
@@ -46,21 +48,22 @@ auto TimestampDictionaryWriter::ingest_string_timestamp(
         bool is_json_literal
 ) -> std::pair<epochtime_t, uint64_t> {
     auto& [_, timestamp_entry] = *m_column_id_to_range.try_emplace(node_id, key, node_id).first;
+    auto& column_state{m_column_id_to_string_column_state[node_id]};
 
-    // Try parsing the timestamp as one of the previously seen timestamp patterns
-    for (auto const& [quoted_pattern, pattern_id] : m_string_pattern_and_id_pairs) {
-        auto const parsing_result{timestamp_parser::parse_timestamp(
-                timestamp,
-                quoted_pattern,
-                is_json_literal,
-                m_generated_pattern
-        )};
-        if (parsing_result.has_error()) {
-            continue;
-        }
-        auto const epoch_timestamp{parsing_result.value().first};
-        timestamp_entry.ingest_timestamp(epoch_timestamp);
-        return {epoch_timestamp, pattern_id};
+    // Repeated values parse the same way, so they can reuse the last value's result
+    if (column_state.last_pattern_idx.has_value() && timestamp == column_state.last_timestamp
+        && is_json_literal == column_state.last_timestamp_is_json_literal)
+    {
+        timestamp_entry.ingest_timestamp(column_state.last_result.first);
+        return column_state.last_result;
+    }
+
+    auto const seen_pattern_result{
+            parse_with_seen_string_patterns(timestamp, is_json_literal, column_state)
+    };
+    if (seen_pattern_result.has_value()) {
+        timestamp_entry.ingest_timestamp(seen_pattern_result->first);
+        return seen_pattern_result.value();
     }
 
     // Fall back to consulting all known timestamp patterns
@@ -89,6 +92,10 @@ auto TimestampDictionaryWriter::ingest_string_timestamp(
     }
 
     auto const new_pattern_id{m_next_id++};
+    column_state.last_pattern_idx = m_string_pattern_and_id_pairs.size();
+    column_state.last_timestamp = timestamp;
+    column_state.last_timestamp_is_json_literal = is_json_literal;
+    column_state.last_result = {epoch_timestamp, new_pattern_id};
     m_string_pattern_and_id_pairs.emplace_back(
             std::move(quoted_pattern_result.value()),
             new_pattern_id
@@ -212,5 +219,46 @@ void TimestampDictionaryWriter::clear() {
     m_string_pattern_and_id_pairs.clear();
     m_numeric_pattern_to_id.clear();
     m_column_id_to_range.clear();
+    m_column_id_to_string_column_state.clear();
+}
+
+auto TimestampDictionaryWriter::parse_with_seen_string_patterns(
+        std::string_view timestamp,
+        bool is_json_literal,
+        StringTimestampColumnState& column_state
+) -> std::optional<std::pair<epochtime_t, uint64_t>> {
+    auto const try_pattern = [&](size_t pattern_idx) -> bool {
+        auto const& [quoted_pattern, pattern_id] = m_string_pattern_and_id_pairs[pattern_idx];
+        auto const parsing_result{timestamp_parser::parse_timestamp(
+                timestamp,
+                quoted_pattern,
+                is_json_literal,
+                m_generated_pattern
+        )};
+        if (parsing_result.has_error()) {
+            return false;
+        }
+        column_state.last_pattern_idx = pattern_idx;
+        column_state.last_timestamp = timestamp;
+        column_state.last_timestamp_is_json_literal = is_json_literal;
+        column_state.last_result = {parsing_result.value().first, pattern_id};
+        return true;
+    };
+
+    // Most columns use a single pattern, so try the one that parsed the column's last value first
+    auto const last_pattern_idx{column_state.last_pattern_idx};
+    if (last_pattern_idx.has_value() && try_pattern(last_pattern_idx.value())) {
+        return column_state.last_result;
+    }
+    for (size_t pattern_idx{0}; pattern_idx < m_string_pattern_and_id_pairs.size(); ++pattern_idx)
+    {
+        if (last_pattern_idx == pattern_idx) {
+            continue;
+        }
+        if (try_pattern(pattern_idx)) {
+            return column_state.last_result;
+        }
+    }
+    return std::nullopt;
 }
 }  // namespace clp_s
@@ -1,8 +1,10 @@
 #ifndef CLP_S_TIMESTAMPDICTIONARYWRITER_HPP
 #define CLP_S_TIMESTAMPDICTIONARYWRITER_HPP
 
+#include <cstddef>
 #include <cstdint>
 #include <map>
+#include <optional>
 #include <sstream>
 #include <string>
 #include <string_view>
@@ -104,6 +106,36 @@ public:
     void clear();
 
 private:
+    // Types
+    /**
+     * State used to speed up parsing the values of a string timestamp column, since a column's
+     * values usually share a pattern and often repeat (e.g., when many log events are generated in
+     * the same second).
+     */
+    struct StringTimestampColumnState {
+        // Index in `m_string_pattern_and_id_pairs` of the pattern that parsed the last value
+        std::optional<size_t> last_pattern_idx;
+        std::string last_timestamp;
+        bool last_timestamp_is_json_literal{false};
+        std::pair<epochtime_t, uint64_t> last_result;
+    };
+
+    // Methods
+    /**
+     * Parses a timestamp using the previously seen string timestamp patterns, starting with the
+     * pattern that parsed the column's last value.
+     * @param timestamp
+     * @param is_json_literal
+     * @param column_state
+     * @return A pair containing the timestamp in epoch nanoseconds and the ID of the pattern that
+     * parsed it, or std::nullopt if none of the patterns can parse the timestamp.
+     */
+    [[nodiscard]] auto parse_with_seen_string_patterns(
+            std::string_view timestamp,
+            bool is_json_literal,
+            StringTimestampColumnState& column_state
+    ) -> std::optional<std::pair<epochtime_t, uint64_t>>;
+
     // Variables
     std::vector<std::pair<timestamp_parser::TimestampPattern, uint64_t>>
             m_string_pattern_and_id_pairs;
@@ -112,6 +144,7 @@ private:
     uint64_t m_next_id{};
 
     std::unordered_map<int32_t, TimestampEntry> m_column_id_to_range;
+    std::unordered_map<int32_t, StringTimestampColumnState> m_column_id_to_string_column_state;
 
     std::string m_generated_pattern;
     std::vector<timestamp_parser::TimestampPattern> m_quoted_timestamp_patterns;
@@ -1,3 +1,6 @@
+#include <unistd.h>
+
+#include <csignal>
 #include <cstdlib>
 #include <exception>
 #include <filesystem>
@@ -9,6 +12,7 @@
 #include <system_error>
 #include <utility>
 #include <variant>
+#include <vector>
 
 #include <fmt/format.h>
 #include <mongocxx/instance.hpp>
@@ -26,12 +30,15 @@
 #include "../clp/ir/constants.hpp"
 #include "../clp/streaming_archive/ArchiveMetadata.hpp"
 #include "../reducer/network_utils.hpp"
+#include "ArchiveCache.hpp"
 #include "CommandLineArguments.hpp"
 #include "Defs.hpp"
 #include "JsonConstructor.hpp"
 #include "JsonParser.hpp"
 #include "kv_ir_search.hpp"
+#include "OpenArchiveCache.hpp"
 #include "OutputHandlerImpl.hpp"
+#include "SearchServer.hpp"
 #include "search/AddTimestampConditions.hpp"
 #include "search/ast/EmptyExpr.hpp"
 #include "search/ast/Expression.hpp"
@@ -87,6 +94,54 @@ bool search_archive(
         std::shared_ptr<SearchTelemetrySpan> const& telemetry_span
 );
 
+/**
+ * Creates the archive cache specified by the command line arguments, if any.
+ * @param command_line_arguments
+ * @param archive_cache Returns the archive cache, or null if no cache was specified.
+ * @return Whether the archive cache was created successfully.
+ */
+bool create_archive_cache(
+        CommandLineArguments const& command_line_arguments,
+        std::shared_ptr<clp_s::ArchiveCache>& archive_cache
+);
+
+/**
+ * Searches the archives and IR streams specified by the given search command line arguments.
+ * @param command_line_arguments
+ * @param archive_cache An optional cache for single-file archives read over the network.
+ * @param open_archive_cache An optional cache of open archives to reuse between searches. If null,
+ * each archive is opened for this search only.
+ * @return Whether the search succeeded.
+ */
+bool search(
+        CommandLineArguments const& command_line_arguments,
+        std::shared_ptr<clp_s::ArchiveCache> const& archive_cache,
+        clp_s::OpenArchiveCache* open_archive_cache
+);
+
+/**
+ * Serves search requests received on the Unix domain socket specified by the command line
+ * arguments, keeping the archives searched open between requests. Requests are served one at a
+ * time until the process is terminated.
+ * @param command_line_arguments
+ * @return false if the server couldn't be started.
+ */
+bool serve(CommandLineArguments const& command_line_arguments);
+
+/**
+ * Serves a search request received by the server. Requests may not configure the archive cache,
+ * since it's configured by the server's arguments.
+ * @param search_args The arguments of the search command.
+ * @param archive_cache
+ * @param open_archive_cache
+ * @return Whether the search succeeded.
+ */
+bool serve_search_request(
+        std::vector<std::string> const& search_args,
+        std::shared_ptr<clp_s::ArchiveCache> const& archive_cache,
+        clp_s::OpenArchiveCache& open_archive_cache
+);
+
 bool compress(CommandLineArguments const& command_line_arguments) {
     auto archives_dir = std::filesystem::path(command_line_arguments.get_archives_dir());
 
@@ -297,14 +352,17 @@ bool search_archive(
                         [&](CommandLineArguments::FileOutputHandlerOptions const& options) -> void {
                             output_handler = std::make_unique<clp_s::FileOutputHandler>(
                                     options.output_path,
-                                    true
+                                    true,
+                                    options.columnar
                             );
                         },
                         [&](CommandLineArguments::NetworkOutputHandlerOptions const& options)
                                 -> void {
                             output_handler = std::make_unique<clp_s::NetworkOutputHandler>(
                                     options.host,
-                                    options.port
+                                    options.port,
+                                    false,
+                                    options.columnar
                             );
                         },
                         [&](CommandLineArguments::ReducerOutputHandlerOptions const&) -> void {
@@ -322,6 +380,22 @@ bool search_archive(
                                                 command_line_arguments
                                                         .get_count_by_time_bucket_size_ms()
                                         );
+                            } else if (CommandLineArguments::AggregationType::Sum == aggregation_type
+                                       || CommandLineArguments::AggregationType::Min
+                                                  == aggregation_type
+                                       || CommandLineArguments::AggregationType::Max
+                                                  == aggregation_type
+                                       || CommandLineArguments::AggregationType::Avg
+                                                  == aggregation_type)
+                            {
+                                // The reducer finalizes every aggregate from the same partials, so
+                                // the handler doesn't need to know which one was requested.
+                                output_handler
+                                        = std::make_unique<clp_s::AggregateReducerOutputHandler>(
+                                                reducer_socket_fd,
+                                                command_line_arguments.get_aggregation_field(),
+                                                command_line_arguments.get_group_by_fields()
+                                        );
                             } else {
                                 SPDLOG_ERROR("Unhandled aggregation type.");
                                 output_handler = nullptr;
@@ -421,11 +495,232 @@ bool search_archive(
     }
     return success;
 }
+
+bool create_archive_cache(
+        CommandLineArguments const& command_line_arguments,
+        std::shared_ptr<clp_s::ArchiveCache>& archive_cache
+) {
+    if (command_line_arguments.get_archive_cache_dir().empty()) {
+        return true;
+    }
+    try {
+        archive_cache = std::make_shared<clp_s::ArchiveCache>(
+                command_line_arguments.get_archive_cache_dir(),
+                command_line_arguments.get_archive_cache_size()
+        );
+    } catch (std::exception const& e) {
+        SPDLOG_ERROR("Failed to open archive cache - {}", e.what());
+        return false;
+    }
+    return true;
+}
+
+bool search(
+        CommandLineArguments const& command_line_arguments,
+        std::shared_ptr<clp_s::ArchiveCache> const& archive_cache,
+        clp_s::OpenArchiveCache* open_archive_cache
+) {
+    auto const& query = command_line_arguments.get_query();
+    auto query_stream = std::istringstream(query);
+    auto expr = kql::parse_kql_expression(query_stream);
+    if (nullptr == expr) {
+        return false;
+    }
+
+    if (std::dynamic_pointer_cast<ast::EmptyExpr>(expr)) {
+        SPDLOG_ERROR("Query '{}' is logically false", query);
+        return false;
+    }
+
+    int reducer_socket_fd{-1};
+    if (std::holds_alternative<CommandLineArguments::ReducerOutputHandlerOptions>(
+                command_line_arguments.get_output_handler_options()
+        ))
+    {
+        auto const& options{std::get<CommandLineArguments::ReducerOutputHandlerOptions>(
+                command_line_arguments.get_output_handler_options()
+        )};
+        reducer_socket_fd
+                = reducer::connect_to_reducer(options.host, options.port, options.job_id);
+        if (-1 == reducer_socket_fd) {
+            SPDLOG_ERROR("Failed to connect to reducer");
+            return false;
+        }
+    }
+
+    bool success{true};
+    for (auto const& input_path : command_line_arguments.get_input_paths()) {
+        if (std::string::npos != input_path.path.find(clp::ir::cIrFileExtension)) {
+            auto const result{clp_s::search_kv_ir_stream(
+                    input_path,
+                    command_line_arguments,
+                    expr->copy(),
+                    reducer_socket_fd
+            )};
+            if (false == result.has_error()) {
+                continue;
+            }
+
+            auto const error{result.error()};
+            if (std::errc::result_out_of_range == error) {
+                // To support real-time search, we will allow incomplete IR streams.
+                // TODO: Use dedicated error code for this case once issue #904 is resolved.
+                SPDLOG_WARN("IR stream `{}` is truncated", input_path.path);
+                continue;
+            }
+
+            if (KvIrSearchError{KvIrSearchErrorEnum::ProjectionSupportNotImplemented} == error
+                || KvIrSearchError{KvIrSearchErrorEnum::UnsupportedOutputHandlerType} == error
+                || KvIrSearchError{KvIrSearchErrorEnum::CountSupportNotImplemented} == error)
+            {
+                // These errors are treated as non-fatal because they result from unsupported
+                // features. However, this approach may cause archives with this extension to be
+                // skipped if the search uses advanced features that are not yet implemented. To
+                // mitigate this, we log a warning and proceed to search the input as an
+                // archive.
+                SPDLOG_WARN(
+                        "Attempted to search an IR stream using unsupported features. Falling"
+                        " back to searching the input as an archive."
+                );
+            } else if (KvIrSearchError{KvIrSearchErrorEnum::DeserializerCreationFailure}
+                       != error)
+            {
+                // If the error is `DeserializerCreationFailure`, we may continue to treat the
+                // input as an archive and retry. Otherwise, it should be considered as a
+                // non-recoverable failure and return directly.
+                SPDLOG_ERROR(
+                        "Failed to search '{}' as an IR stream, error_category={}, error={}",
+                        input_path.path,
+                        error.category().name(),
+                        error.message()
+                );
+                success = false;
+                break;
+            }
+        }
+
+        std::shared_ptr<SearchTelemetrySpan> telemetry_span;
+        if (command_line_arguments.get_enable_telemetry()) {
+            telemetry_span = std::make_shared<SearchTelemetrySpan>();
+        }
+        std::shared_ptr<clp_s::ArchiveReader> archive_reader;
+        try {
+            if (nullptr != open_archive_cache) {
+                archive_reader = open_archive_cache->get(
+                        input_path,
+                        command_line_arguments.get_network_auth()
+                );
+            } else {
+                archive_reader = std::make_shared<clp_s::ArchiveReader>();
+                archive_reader->open(
+                        input_path,
+                        command_line_arguments.get_network_auth(),
+                        archive_cache
+                );
+            }
+        } catch (std::exception const& e) {
+            SPDLOG_ERROR("Failed to open archive - {}", e.what());
+            if (nullptr != telemetry_span) {
+                telemetry_span->set_error("failed to open archive");
+            }
+            success = false;
+            break;
+        }
+
+        bool archive_search_succeeded{false};
+        try {
+            archive_search_succeeded = search_archive(
+                    command_line_arguments,
+                    archive_reader,
+                    expr->copy(),
+                    reducer_socket_fd,
+                    telemetry_span
+            );
+        } catch (std::exception const& e) {
+            SPDLOG_ERROR("Failed to search archive - {}", e.what());
+        }
+        if (false == archive_search_succeeded) {
+            // The archive may have been left in an unknown state
+            if (nullptr != open_archive_cache) {
+                open_archive_cache->erase(input_path, command_line_arguments.get_network_auth());
+            }
+            success = false;
+            break;
+        }
+        if (nullptr == open_archive_cache) {
+            archive_reader->close();
+        }
+    }
+
+    if (-1 != reducer_socket_fd) {
+        ::close(reducer_socket_fd);
+    }
+    return success;
+}
+
+bool serve(CommandLineArguments const& command_line_arguments) {
+    std::shared_ptr<clp_s::ArchiveCache> archive_cache;
+    if (false == create_archive_cache(command_line_arguments, archive_cache)) {
+        return false;
+    }
+    clp_s::OpenArchiveCache open_archive_cache{
+            command_line_arguments.get_max_open_archives(),
+            archive_cache
+    };
+
+    auto const& socket_path{command_line_arguments.get_socket_path()};
+    clp_s::SearchServer server{
+            socket_path,
+            [&](std::vector<std::string> const& search_args) -> bool {
+                return serve_search_request(search_args, archive_cache, open_archive_cache);
+            }
+    };
+    if (false == server.listen()) {
+        return false;
+    }
+
+    // Clients may disconnect before their results are written, which shouldn't stop the server
+    std::signal(SIGPIPE, SIG_IGN);
+
+    SPDLOG_INFO("Serving searches on '{}'", socket_path);
+    return server.serve();
+}
+
+bool serve_search_request(
+        std::vector<std::string> const& search_args,
+        std::shared_ptr<clp_s::ArchiveCache> const& archive_cache,
+        clp_s::OpenArchiveCache& open_archive_cache
+) {
+    std::vector<char const*> argv{"clp-s"};
+    std::string const command(1, static_cast<char>(CommandLineArguments::Command::Search));
+    argv.reserve(search_args.size() + 2);
+    argv.push_back(command.c_str());
+    for (auto const& arg : search_args) {
+        argv.push_back(arg.c_str());
+    }
+
+    CommandLineArguments command_line_arguments("clp-s");
+    if (CommandLineArguments::ParsingResult::Success
+        != command_line_arguments.parse_arguments(static_cast<int>(argv.size()), argv.data()))
+    {
+        return false;
+    }
+    // The archive cache is shared by every request, so it can only be configured when the server
+    // is started
+    if (command_line_arguments.get_archive_cache_specified()) {
+        SPDLOG_ERROR(
+                "The archive cache can't be configured per search request - set "
+                "--archive-cache-dir and --archive-cache-size when starting the server."
+        );
+        return false;
+    }
+    return search(command_line_arguments, archive_cache, &open_archive_cache);
+}
 }  // namespace
 
 int main(int argc, char const* argv[]) {
     try {
-        auto stderr_logger = spdlog::stderr_logger_st("stderr");
+        auto stderr_logger = spdlog::stderr_logger_mt("stderr");
         spdlog::set_default_logger(stderr_logger);
         spdlog::set_pattern("%Y-%m-%dT%H:%M:%S.%e%z [%l] %v");
     } catch (std::exception& e) {
@@ -470,6 +765,9 @@ int main(int argc, char const* argv[]) {
         option.ordered = command_line_arguments.get_ordered_decompression();
         option.target_ordered_chunk_size = command_line_arguments.get_target_ordered_chunk_size();
         option.print_ordered_chunk_stats = command_line_arguments.print_ordered_chunk_stats();
+        option.begin_log_event_idx = command_line_arguments.get_begin_log_event_idx();
+        option.end_log_event_idx = command_line_arguments.get_end_log_event_idx();
+        option.num_threads = command_line_arguments.get_num_decompression_threads();
         option.network_auth = command_line_arguments.get_network_auth();
         if (false == command_line_arguments.get_mongodb_uri().empty()) {
             option.metadata_db
@@ -486,110 +784,17 @@ int main(int argc, char const* argv[]) {
             SPDLOG_ERROR("Encountered error during decompression - {}", e.what());
             return 1;
         }
-    } else {
-        auto const& query = command_line_arguments.get_query();
-        auto query_stream = std::istringstream(query);
-        auto expr = kql::parse_kql_expression(query_stream);
-        if (nullptr == expr) {
+    } else if (CommandLineArguments::Command::Serve == command_line_arguments.get_command()) {
+        if (false == serve(command_line_arguments)) {
             return 1;
         }
-
-        if (std::dynamic_pointer_cast<ast::EmptyExpr>(expr)) {
-            SPDLOG_ERROR("Query '{}' is logically false", query);
+    } else {
+        std::shared_ptr<clp_s::ArchiveCache> archive_cache;
+        if (false == create_archive_cache(command_line_arguments, archive_cache)) {
             return 1;
         }
-
-        int reducer_socket_fd{-1};
-        if (std::holds_alternative<CommandLineArguments::ReducerOutputHandlerOptions>(
-                    command_line_arguments.get_output_handler_options()
-            ))
-        {
-            auto const& options{std::get<CommandLineArguments::ReducerOutputHandlerOptions>(
-                    command_line_arguments.get_output_handler_options()
-            )};
-            reducer_socket_fd
-                    = reducer::connect_to_reducer(options.host, options.port, options.job_id);
-            if (-1 == reducer_socket_fd) {
-                SPDLOG_ERROR("Failed to connect to reducer");
-                return 1;
-            }
-        }
-
-        auto archive_reader = std::make_shared<clp_s::ArchiveReader>();
-        for (auto const& input_path : command_line_arguments.get_input_paths()) {
-            if (std::string::npos != input_path.path.find(clp::ir::cIrFileExtension)) {
-                auto const result{clp_s::search_kv_ir_stream(
-                        input_path,
-                        command_line_arguments,
-                        expr->copy(),
-                        reducer_socket_fd
-                )};
-                if (false == result.has_error()) {
-                    continue;
-                }
-
-                auto const error{result.error()};
-                if (std::errc::result_out_of_range == error) {
-                    // To support real-time search, we will allow incomplete IR streams.
-                    // TODO: Use dedicated error code for this case once issue #904 is resolved.
-                    SPDLOG_WARN("IR stream `{}` is truncated", input_path.path);
-                    continue;
-                }
-
-                if (KvIrSearchError{KvIrSearchErrorEnum::ProjectionSupportNotImplemented} == error
-                    || KvIrSearchError{KvIrSearchErrorEnum::UnsupportedOutputHandlerType} == error
-                    || KvIrSearchError{KvIrSearchErrorEnum::CountSupportNotImplemented} == error)
-                {
-                    // These errors are treated as non-fatal because they result from unsupported
-                    // features. However, this approach may cause archives with this extension to be
-                    // skipped if the search uses advanced features that are not yet implemented. To
-                    // mitigate this, we log a warning and proceed to search the input as an
-                    // archive.
-                    SPDLOG_WARN(
-                            "Attempted to search an IR stream using unsupported features. Falling"
-                            " back to searching the input as an archive."
-                    );
-                } else if (KvIrSearchError{KvIrSearchErrorEnum::DeserializerCreationFailure}
-                           != error)
-                {
-                    // If the error is `DeserializerCreationFailure`, we may continue to treat the
-                    // input as an archive and retry. Otherwise, it should be considered as a
-                    // non-recoverable failure and return directly.
-                    SPDLOG_ERROR(
-                            "Failed to search '{}' as an IR stream, error_category={}, error={}",
-                            input_path.path,
-                            error.category().name(),
-                            error.message()
-                    );
-                    return 1;
-                }
-            }
-
-            std::shared_ptr<SearchTelemetrySpan> telemetry_span;
-            if (command_line_arguments.get_enable_telemetry()) {
-                telemetry_span = std::make_shared<SearchTelemetrySpan>();
-            }
-            try {
-                archive_reader->open(input_path, command_line_arguments.get_network_auth());
-            } catch (std::exception const& e) {
-                SPDLOG_ERROR("Failed to open archive - {}", e.what());
-                if (nullptr != telemetry_span) {
-                    telemetry_span->set_error("failed to open archive");
-                }
-                return 1;
-            }
-            if (false
-                == search_archive(
-                        command_line_arguments,
-                        archive_reader,
-                        expr->copy(),
-                        reducer_socket_fd,
-                        telemetry_span
-                ))
-            {
-                return 1;
-            }
-            archive_reader->close();
+        if (false == search(command_line_arguments, archive_cache, nullptr)) {
+            return 1;
         }
     }
 
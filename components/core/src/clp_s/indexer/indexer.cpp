@@ -11,7 +11,7 @@ using clp_s::indexer::CommandLineArguments;
 
 int main(int argc, char const* argv[]) {
     try {
-        auto stderr_logger = spdlog::stderr_logger_st("stderr");
+        auto stderr_logger = spdlog::stderr_logger_mt("stderr");
         spdlog::set_default_logger(stderr_logger);
         spdlog::set_pattern("%Y-%m-%dT%H:%M:%S.%e%z [%l] %v");
     } catch (std::exception& e) {
@@ -90,7 +90,7 @@ auto convert_files(CommandLineArguments const& command_line_arguments) -> bool {
 
 auto main(int argc, char const** argv) -> int {
     try {
-        auto stderr_logger = spdlog::stderr_logger_st("stderr");
+        auto stderr_logger = spdlog::stderr_logger_mt("stderr");
         spdlog::set_default_logger(stderr_logger);
         spdlog::set_pattern("%Y-%m-%dT%H:%M:%S.%e%z [%l] %v");
     } catch (std::exception& e) {
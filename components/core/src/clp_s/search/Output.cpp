@@ -1,5 +1,6 @@
 #include "Output.hpp"
 
+#include <cstdint>
 #include <memory>
 #include <vector>
 
@@ -77,7 +78,6 @@ bool Output::filter() {
     EvaluateTimestampIndex timestamp_index(m_archive_reader->get_timestamp_dictionary());
     if (EvaluatedValue::False == timestamp_index.run(m_expr)) {
         m_termination_stage = cTerminationStageTimeRangeMatchingAfterColumnResolution;
-        m_archive_reader->close();
         return true;
     }
 
@@ -95,14 +95,25 @@ bool Output::filter() {
     m_query_runner.global_init();
     m_archive_reader->open_packed_streams();
 
-    std::string message;
-    auto const archive_id = m_archive_reader->get_archive_id();
-    bool scanned_any_ert{false};
+    // Find the schemas whose ERTs need to be scanned up front, so that their tables can be
+    // decompressed in the background while earlier ERTs are scanned. Each schema's context is saved
+    // so that it doesn't need to be initialized again before its ERT is scanned.
+    std::vector<int32_t> schema_ids_to_scan;
+    std::vector<QueryRunner::SchemaContext> schema_contexts;
     for (int32_t schema_id : matched_schemas) {
-        if (EvaluatedValue::False == m_query_runner.schema_init(schema_id)) {
-            continue;
+        if (EvaluatedValue::False != m_query_runner.schema_init(schema_id)) {
+            schema_ids_to_scan.push_back(schema_id);
+            schema_contexts.emplace_back(m_query_runner.save_schema_context());
         }
-        scanned_any_ert = true;
+    }
+    m_archive_reader->prefetch_schema_tables(schema_ids_to_scan);
+
+    auto const archive_id = m_archive_reader->get_archive_id();
+    LogEventBatch batch{archive_id};
+    bool const scanned_any_ert{false == schema_ids_to_scan.empty()};
+    for (size_t i{0}; i < schema_ids_to_scan.size(); ++i) {
+        auto const schema_id{schema_ids_to_scan[i]};
+        m_query_runner.restore_schema_context(std::move(schema_contexts[i]));
 
         auto& reader = m_archive_reader->read_schema_table(
                 schema_id,
@@ -111,23 +122,11 @@ bool Output::filter() {
         );
         auto& filter = m_query_runner.prepare_filter(reader);
 
-        bool schema_has_match{false};
-        if (m_output_handler->should_output_metadata()) {
-            epochtime_t timestamp{};
-            int64_t log_event_idx{};
-            while (reader.get_next_message_with_metadata(message, timestamp, log_event_idx, filter))
-            {
-                schema_has_match = true;
-                ++m_result_metrics.num_records_matching_query;
-                m_output_handler->write(message, timestamp, archive_id, log_event_idx);
-            }
-        } else {
-            while (reader.get_next_message(message, filter)) {
-                schema_has_match = true;
-                ++m_result_metrics.num_records_matching_query;
-                m_output_handler->write(message);
-            }
-        }
+        bool const schema_has_match{
+                m_output_handler->should_output_columnar_batches()
+                        ? write_columnar_batches(reader, filter, archive_id)
+                        : write_log_event_batches(reader, filter, batch)
+        };
         if (schema_has_match) {
             ++m_result_metrics.num_schemas_with_matches;
         }
@@ -152,4 +151,89 @@ bool Output::filter() {
     }
     return true;
 }
+
+auto Output::write_log_event_batches(
+        SchemaReader& reader,
+        FilterClass& filter,
+        LogEventBatch& batch
+) -> bool {
+    // Matching messages are marshalled directly into the batch's buffer, and the batch is handed to
+    // the output handler whenever it fills up and at the end of the table
+    bool const should_output_metadata{m_output_handler->should_output_metadata()};
+    bool schema_has_match{false};
+    while (true) {
+        auto& message_buffer{batch.get_message_buffer()};
+        auto const message_begin{message_buffer.size()};
+        epochtime_t timestamp{};
+        int64_t log_event_idx{};
+        bool const has_match{
+                should_output_metadata ? reader.append_next_message_with_metadata(
+                                                 message_buffer,
+                                                 timestamp,
+                                                 log_event_idx,
+                                                 filter
+                                         )
+                                       : reader.append_next_message(message_buffer, filter)
+        };
+        if (false == has_match) {
+            break;
+        }
+        schema_has_match = true;
+        ++m_result_metrics.num_records_matching_query;
+        batch.add_log_event(message_begin, timestamp, log_event_idx);
+        if (batch.get_messages().size() >= cMaxBatchMessagesSize
+            || batch.size() >= cMaxNumLogEventsPerBatch)
+        {
+            m_output_handler->write_batch(batch);
+            batch.clear();
+        }
+    }
+    if (false == batch.empty()) {
+        m_output_handler->write_batch(batch);
+        batch.clear();
+    }
+    return schema_has_match;
+}
+
+auto Output::write_columnar_batches(
+        SchemaReader& reader,
+        FilterClass& filter,
+        std::string_view archive_id
+) -> bool {
+    auto const schema_tree{m_archive_reader->get_schema_tree()};
+    auto const schema_map{m_archive_reader->get_schema_map()};
+    bool schema_has_match{false};
+    auto write_batch = [&]() -> void {
+        m_output_handler->write_columnar_batch(
+                {archive_id,
+                 *schema_tree,
+                 *schema_map,
+                 reader,
+                 m_columnar_message_idxs,
+                 m_columnar_timestamps,
+                 m_columnar_log_event_idxs}
+        );
+        m_columnar_message_idxs.clear();
+        m_columnar_timestamps.clear();
+        m_columnar_log_event_idxs.clear();
+    };
+
+    uint64_t message_idx{};
+    epochtime_t timestamp{};
+    int64_t log_event_idx{};
+    while (reader.get_next_matching_message_idx(message_idx, timestamp, log_event_idx, filter)) {
+        schema_has_match = true;
+        ++m_result_metrics.num_records_matching_query;
+        m_columnar_message_idxs.push_back(message_idx);
+        m_columnar_timestamps.push_back(timestamp);
+        m_columnar_log_event_idxs.push_back(log_event_idx);
+        if (m_columnar_message_idxs.size() >= cMaxNumRecordsPerColumnarBatch) {
+            write_batch();
+        }
+    }
+    if (false == m_columnar_message_idxs.empty()) {
+        write_batch();
+    }
+    return schema_has_match;
+}
 }  // namespace clp_s::search
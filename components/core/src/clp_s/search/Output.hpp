@@ -1,6 +1,7 @@
 #ifndef CLP_S_SEARCH_OUTPUT_HPP
 #define CLP_S_SEARCH_OUTPUT_HPP
 
+#include <cstddef>
 #include <map>
 #include <set>
 #include <stack>
@@ -9,6 +10,7 @@
 #include <unordered_map>
 #include <unordered_set>
 #include <utility>
+#include <vector>
 
 #include <clp_s/search/SearchTelemetry.hpp>
 
@@ -64,6 +66,41 @@ public:
     }
 
 private:
+    // Constants
+    // A batch of matching log events is written to the output handler once its messages reach this
+    // size, or once it contains this many log events (for handlers that don't marshal records)
+    static constexpr size_t cMaxBatchMessagesSize{1024ULL * 1024};
+    static constexpr size_t cMaxNumLogEventsPerBatch{4096};
+    // The maximum number of records in each columnar batch written to the output handler
+    static constexpr size_t cMaxNumRecordsPerColumnarBatch{64ULL * 1024};
+
+    // Methods
+    /**
+     * Marshals the records in a table that match the query and writes them to the output handler in
+     * batches.
+     * @param reader
+     * @param filter
+     * @param batch A reusable batch, empty on return
+     * @return Whether any record in the table matched
+     */
+    auto write_log_event_batches(SchemaReader& reader, FilterClass& filter, LogEventBatch& batch)
+            -> bool;
+
+    /**
+     * Writes the records in a table that match the query to the output handler as columnar
+     * batches.
+     * @param reader
+     * @param filter
+     * @param archive_id
+     * @return Whether any record in the table matched
+     */
+    auto write_columnar_batches(
+            SchemaReader& reader,
+            FilterClass& filter,
+            std::string_view archive_id
+    ) -> bool;
+
+    // Variables
     QueryRunner m_query_runner;
     std::shared_ptr<ArchiveReader> m_archive_reader;
     std::shared_ptr<ast::Expression> m_expr;
@@ -72,6 +109,9 @@ private:
     bool m_should_marshal_records{true};
     SearchResultMetrics m_result_metrics;
     std::string_view m_termination_stage{cTerminationStageErtScan};
+    std::vector<uint64_t> m_columnar_message_idxs;
+    std::vector<epochtime_t> m_columnar_timestamps;
+    std::vector<int64_t> m_columnar_log_event_idxs;
 };
 }  // namespace clp_s::search
 
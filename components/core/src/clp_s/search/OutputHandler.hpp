@@ -1,22 +1,144 @@
 #ifndef CLP_S_SEARCH_OUTPUTHANDLER_HPP
 #define CLP_S_SEARCH_OUTPUTHANDLER_HPP
 
+#include <cstddef>
+#include <cstdint>
+#include <map>
+#include <span>
+#include <string>
 #include <string_view>
 #include <vector>
 
 #include "../Defs.hpp"
 #include "../ErrorCode.hpp"
+#include "../TraceableException.hpp"
+
+namespace clp_s {
+class Schema;
+class SchemaReader;
+class SchemaTree;
+}  // namespace clp_s
 
 namespace clp_s::search {
+/**
+ * The records matching a query in one table, for output handlers that emit results as columnar
+ * batches rather than as marshalled records. The values are read directly from the table's column
+ * readers, which are only valid for the duration of the `write_columnar_batch` call.
+ */
+struct ColumnarBatch {
+    std::string_view archive_id;
+    SchemaTree const& schema_tree;
+    // The archive's schemas, indexed by schema ID (i.e., `ReaderUtils::SchemaMap`)
+    std::map<int32_t, Schema> const& schemas;
+    SchemaReader& reader;
+    // The indices of the matching records within the table
+    std::span<uint64_t const> message_idxs;
+    std::span<epochtime_t const> timestamps;
+    std::span<int64_t const> log_event_idxs;
+};
+
+/**
+ * A batch of log events from one archive whose messages are stored back-to-back in one contiguous
+ * buffer, so that an output handler can emit many log events at once without copying each message.
+ */
+class LogEventBatch {
+public:
+    // Types
+    struct LogEvent {
+        std::string_view message;
+        epochtime_t timestamp{};
+        int64_t log_event_idx{};
+    };
+
+    // Constructors
+    explicit LogEventBatch(std::string_view archive_id) : m_archive_id{archive_id} {}
+
+    // Methods
+    /**
+     * @return The buffer that the next log event's message should be appended to
+     */
+    [[nodiscard]] auto get_message_buffer() -> std::string& { return m_messages; }
+
+    /**
+     * Adds a log event whose message was appended to the end of the message buffer.
+     * @param message_begin The offset of the message in the message buffer
+     * @param timestamp
+     * @param log_event_idx
+     */
+    auto add_log_event(size_t message_begin, epochtime_t timestamp, int64_t log_event_idx)
+            -> void {
+        m_log_events.push_back(
+                {message_begin, m_messages.size() - message_begin, timestamp, log_event_idx}
+        );
+    }
+
+    /**
+     * @param i
+     * @return A view of the `i`th log event, valid until the batch is modified
+     */
+    [[nodiscard]] auto get_log_event(size_t i) const -> LogEvent {
+        auto const& location{m_log_events[i]};
+        return {std::string_view{m_messages}.substr(location.message_begin, location.message_size),
+                location.timestamp,
+                location.log_event_idx};
+    }
+
+    /**
+     * @return The messages of every log event in the batch, in order
+     */
+    [[nodiscard]] auto get_messages() const -> std::string_view { return m_messages; }
+
+    [[nodiscard]] auto get_archive_id() const -> std::string_view { return m_archive_id; }
+
+    [[nodiscard]] auto size() const -> size_t { return m_log_events.size(); }
+
+    [[nodiscard]] auto empty() const -> bool { return m_log_events.empty(); }
+
+    /**
+     * Removes every log event from the batch, keeping the allocated buffers for reuse.
+     */
+    auto clear() -> void {
+        m_messages.clear();
+        m_log_events.clear();
+    }
+
+private:
+    // Types
+    struct LogEventLocation {
+        size_t message_begin{};
+        size_t message_size{};
+        epochtime_t timestamp{};
+        int64_t log_event_idx{};
+    };
+
+    // Variables
+    std::string_view m_archive_id;
+    std::string m_messages;
+    std::vector<LogEventLocation> m_log_events;
+};
+
 /**
  * Abstract class for handling search output.
  */
 class OutputHandler {
 public:
+    // Types
+    class OperationFailed : public TraceableException {
+    public:
+        // Constructors
+        OperationFailed(ErrorCode error_code, char const* const filename, int line_number)
+                : TraceableException(error_code, filename, line_number) {}
+    };
+
     // Constructors
-    explicit OutputHandler(bool should_output_metadata, bool should_marshal_records)
+    explicit OutputHandler(
+            bool should_output_metadata,
+            bool should_marshal_records,
+            bool should_output_columnar_batches = false
+    )
             : m_should_output_metadata(should_output_metadata),
-              m_should_marshal_records(should_marshal_records) {}
+              m_should_marshal_records(should_marshal_records),
+              m_should_output_columnar_batches(should_output_columnar_batches) {}
 
     // Destructor
     virtual ~OutputHandler() = default;
@@ -42,6 +164,35 @@ public:
      */
     virtual void write(std::string_view message) = 0;
 
+    /**
+     * Writes a batch of log events to the output handler. By default, each log event is written
+     * individually; handlers that can emit many log events at once should override this.
+     * @param batch
+     */
+    virtual void write_batch(LogEventBatch const& batch) {
+        for (size_t i{0}; i < batch.size(); ++i) {
+            auto const log_event{batch.get_log_event(i)};
+            if (m_should_output_metadata) {
+                write(log_event.message,
+                      log_event.timestamp,
+                      batch.get_archive_id(),
+                      log_event.log_event_idx);
+            } else {
+                write(log_event.message);
+            }
+        }
+    }
+
+    /**
+     * Writes a columnar batch of matching records to the output handler. Only called if the handler
+     * was constructed to output columnar batches, so handlers that are must override this.
+     * @param batch
+     * @throw OutputHandler::OperationFailed if the handler doesn't support columnar batches
+     */
+    virtual void write_columnar_batch(ColumnarBatch const& batch) {
+        throw OperationFailed(ErrorCodeUnsupported, __FILENAME__, __LINE__);
+    }
+
     /**
      * Flushes the output handler after each table that gets searched.
      * @return ErrorCodeSuccess on success or relevant error code on error
@@ -58,9 +209,14 @@ public:
 
     [[nodiscard]] auto should_marshal_records() const -> bool { return m_should_marshal_records; }
 
+    [[nodiscard]] auto should_output_columnar_batches() const -> bool {
+        return m_should_output_columnar_batches;
+    }
+
 private:
     bool m_should_output_metadata{};
     bool m_should_marshal_records{};
+    bool m_should_output_columnar_batches{};
 };
 }  // namespace clp_s::search
 
@@ -62,6 +62,34 @@ auto QueryRunner::schema_init(int32_t schema_id) -> EvaluatedValue {
     return m_expression_value;
 }
 
+auto QueryRunner::save_schema_context() -> SchemaContext {
+    SchemaContext context;
+    context.m_schema = m_schema;
+    context.m_expr = std::move(m_expr);
+    context.m_expression_value = m_expression_value;
+    context.m_expr_clp_query = std::move(m_expr_clp_query);
+    context.m_expr_var_match_map = std::move(m_expr_var_match_map);
+    context.m_wildcard_columns = std::move(m_wildcard_columns);
+    context.m_wildcard_to_searched_basic_columns = std::move(m_wildcard_to_searched_basic_columns);
+    context.m_wildcard_type_mask = m_wildcard_type_mask;
+    m_expr_clp_query.clear();
+    m_expr_var_match_map.clear();
+    m_wildcard_columns.clear();
+    m_wildcard_to_searched_basic_columns.clear();
+    return context;
+}
+
+void QueryRunner::restore_schema_context(SchemaContext context) {
+    m_schema = context.m_schema;
+    m_expr = std::move(context.m_expr);
+    m_expression_value = context.m_expression_value;
+    m_expr_clp_query = std::move(context.m_expr_clp_query);
+    m_expr_var_match_map = std::move(context.m_expr_var_match_map);
+    m_wildcard_columns = std::move(context.m_wildcard_columns);
+    m_wildcard_to_searched_basic_columns = std::move(context.m_wildcard_to_searched_basic_columns);
+    m_wildcard_type_mask = context.m_wildcard_type_mask;
+}
+
 void QueryRunner::clear_readers() {
     m_clp_string_readers.clear();
     m_var_string_readers.clear();
@@ -45,6 +45,26 @@ namespace clp_s::search {
  */
 class QueryRunner : public FilterClass {
 public:
+    // Types
+    /**
+     * The query processing context that `schema_init` initializes for a schema. It can be saved and
+     * restored later so that the schema doesn't need to be initialized again before it's searched.
+     */
+    class SchemaContext {
+    private:
+        friend class QueryRunner;
+
+        int32_t m_schema{-1};
+        std::shared_ptr<ast::Expression> m_expr;
+        EvaluatedValue m_expression_value{EvaluatedValue::Unknown};
+        std::unordered_map<ast::Expression*, clp::Query*> m_expr_clp_query;
+        std::unordered_map<ast::Expression*, std::unordered_set<int64_t>*> m_expr_var_match_map;
+        std::vector<ast::ColumnDescriptor*> m_wildcard_columns;
+        std::map<ast::ColumnDescriptor*, std::set<int32_t>> m_wildcard_to_searched_basic_columns;
+        ast::literal_type_bitmask_t m_wildcard_type_mask{0};
+    };
+
+    // Constructors
     QueryRunner(
             std::shared_ptr<SchemaMatch> const& match,
             std::shared_ptr<ast::Expression> const& expr,
@@ -88,6 +108,19 @@ public:
      */
     auto schema_init(int32_t schema_id) -> EvaluatedValue;
 
+    /**
+     * Moves the context initialized by the last call to `schema_init` out of the runner.
+     * @return The context
+     */
+    [[nodiscard]] auto save_schema_context() -> SchemaContext;
+
+    /**
+     * Restores a context returned by `save_schema_context`, as if `schema_init` was called again
+     * for its schema.
+     * @param context
+     */
+    void restore_schema_context(SchemaContext context);
+
     /**
      * Selects a filtering implementation, and prepares a filter on a given ERT.
      *
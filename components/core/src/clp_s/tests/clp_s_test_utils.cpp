@@ -3,10 +3,12 @@
 #include <filesystem>
 #include <optional>
 #include <string>
+#include <utility>
 #include <vector>
 
 #include <catch2/catch_test_macros.hpp>
 
+#include "../src/clp_s/ArchiveReader.hpp"
 #include "../src/clp_s/ArchiveWriter.hpp"
 #include "../src/clp_s/InputConfig.hpp"
 #include "../src/clp_s/JsonParser.hpp"
@@ -55,3 +57,37 @@ auto compress_archive(
     REQUIRE((false == std::filesystem::is_empty(archive_directory)));
     return archive_stats;
 }
+
+auto compress_single_archive(
+        std::string const& file_path,
+        std::string const& archive_directory,
+        std::optional<std::string> timestamp_key,
+        bool retain_float_format,
+        bool single_file_archive,
+        bool structurize_arrays
+) -> clp_s::Path {
+    REQUIRE_NOTHROW(compress_archive(
+            file_path,
+            archive_directory,
+            std::move(timestamp_key),
+            retain_float_format,
+            single_file_archive,
+            structurize_arrays
+    ));
+
+    std::vector<clp_s::Path> archive_paths;
+    REQUIRE(clp_s::get_input_archives_for_raw_path(archive_directory, archive_paths));
+    REQUIRE((1 == archive_paths.size()));
+    return archive_paths.back();
+}
+
+auto open_archive_for_reading(clp_s::Path const& archive_path, clp_s::ArchiveReader& archive_reader)
+        -> void {
+    REQUIRE_NOTHROW(archive_reader.open(archive_path, clp_s::NetworkAuthOption{}));
+    prepare_archive_for_reading(archive_reader);
+}
+
+auto prepare_archive_for_reading(clp_s::ArchiveReader& archive_reader) -> void {
+    REQUIRE_NOTHROW(archive_reader.read_dictionaries_and_metadata());
+    REQUIRE_NOTHROW(archive_reader.open_packed_streams());
+}
@@ -5,6 +5,7 @@
 #include <string>
 #include <vector>
 
+#include "../src/clp_s/ArchiveReader.hpp"
 #include "../src/clp_s/ArchiveWriter.hpp"
 #include "../src/clp_s/InputConfig.hpp"
 
@@ -29,4 +30,49 @@
         bool single_file_archive,
         bool structurize_arrays
 ) -> std::vector<clp_s::ArchiveStats>;
+
+/**
+ * Compresses a file into an archive directory that must not already contain any archives, according
+ * to a given set of configuration options.
+ *
+ * This helper uses `REQUIRE...` statements to assert that compression was successful and produced
+ * exactly one archive.
+ *
+ * @param file_path
+ * @param archive_directory
+ * @param timestamp_key
+ * @param retain_float_format
+ * @param single_file_archive
+ * @param structurize_arrays
+ * @return The path of the archive.
+ */
+[[nodiscard]] auto compress_single_archive(
+        std::string const& file_path,
+        std::string const& archive_directory,
+        std::optional<std::string> timestamp_key,
+        bool retain_float_format,
+        bool single_file_archive,
+        bool structurize_arrays
+) -> clp_s::Path;
+
+/**
+ * Opens an archive and prepares it for reading its tables.
+ *
+ * This helper uses `REQUIRE...` statements to assert that the archive was opened successfully.
+ *
+ * @param archive_path
+ * @param archive_reader
+ */
+auto open_archive_for_reading(clp_s::Path const& archive_path, clp_s::ArchiveReader& archive_reader)
+        -> void;
+
+/**
+ * Reads the dictionaries and metadata of an open archive and opens its packed streams, so that its
+ * tables can be read.
+ *
+ * This helper uses `REQUIRE...` statements to assert that the archive was read successfully.
+ *
+ * @param archive_reader
+ */
+auto prepare_archive_for_reading(clp_s::ArchiveReader& archive_reader) -> void;
 #endif  // CLP_S_TEST_UTILS_HPP
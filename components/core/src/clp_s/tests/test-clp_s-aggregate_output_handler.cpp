@@ -0,0 +1,192 @@
+#include <sys/socket.h>
+#include <unistd.h>
+
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <map>
+#include <memory>
+#include <optional>
+#include <string>
+#include <string_view>
+#include <vector>
+
+#include <catch2/catch_message.hpp>
+#include <catch2/catch_test_macros.hpp>
+
+#include "../src/clp/FileWriter.hpp"
+#include "../src/clp_s/ArchiveReader.hpp"
+#include "../src/clp_s/Defs.hpp"
+#include "../src/clp_s/ErrorCode.hpp"
+#include "../src/clp_s/OutputHandlerImpl.hpp"
+#include "../src/clp_s/SchemaReader.hpp"
+#include "../src/clp_s/search/OutputHandler.hpp"
+#include "../src/reducer/AggregateOperator.hpp"
+#include "../src/reducer/BinaryRecordGroup.hpp"
+#include "../src/reducer/GroupTags.hpp"
+#include "clp_s_test_utils.hpp"
+#include "TestOutputCleaner.hpp"
+
+constexpr std::string_view cTestAggregateArchiveDirectory{"test-aggregate-archive"};
+constexpr std::string_view cTestAggregateInputFile{"test-aggregate-input.jsonl"};
+
+namespace {
+struct Aggregate {
+    int64_t count;
+    double sum;
+    double min;
+    double max;
+    double avg;
+};
+
+/**
+ * Receives every record group sent to the reducer over the given socket until it's closed.
+ * @param socket_fd
+ * @return A map from each group's tags to the group's only record
+ */
+auto receive_partial_aggregates(int socket_fd) -> std::map<reducer::GroupTags, Aggregate>;
+
+auto receive_partial_aggregates(int socket_fd) -> std::map<reducer::GroupTags, Aggregate> {
+    std::string received;
+    std::array<char, 4096> buf{};
+    for (auto num_bytes{read(socket_fd, buf.data(), buf.size())}; num_bytes > 0;
+         num_bytes = read(socket_fd, buf.data(), buf.size()))
+    {
+        received.append(buf.data(), static_cast<size_t>(num_bytes));
+    }
+
+    std::map<reducer::GroupTags, Aggregate> aggregates;
+    reducer::BinaryRecordGroupView group;
+    size_t pos{0};
+    while (pos < received.size()) {
+        size_t group_size{0};
+        REQUIRE((pos + sizeof(group_size) <= received.size()));
+        std::memcpy(&group_size, received.data() + pos, sizeof(group_size));
+        pos += sizeof(group_size);
+        REQUIRE((pos + group_size <= received.size()));
+        REQUIRE(group.parse(received.data() + pos, group_size));
+        pos += group_size;
+
+        auto& record_it{group.record_iter()};
+        REQUIRE_FALSE(record_it.done());
+        auto const& record{record_it.get()};
+        using reducer::PartialAggregateRecordAdapter;
+        aggregates.emplace(
+                group.get_tags(),
+                Aggregate{
+                        record.get_int64_value(PartialAggregateRecordAdapter::cCountKey),
+                        record.get_double_value(PartialAggregateRecordAdapter::cSumKey),
+                        record.get_double_value(PartialAggregateRecordAdapter::cMinKey),
+                        record.get_double_value(PartialAggregateRecordAdapter::cMaxKey),
+                        record.get_double_value(PartialAggregateRecordAdapter::cAvgKey)
+                }
+        );
+        record_it.next();
+        REQUIRE(record_it.done());
+    }
+    return aggregates;
+}
+}  // namespace
+
+TEST_CASE("clp-s-aggregate-reducer-output-handler", "[clp-s][output-handler]") {
+    // Besides the records whose aggregated field is missing or isn't numeric, the records' schemas
+    // differ in whether the group-by field is missing or null, and in the types of each field
+    constexpr size_t cNumSchemas{8};
+    std::vector<std::string_view> const records{
+            R"({"service":"a","latency":1})",
+            R"({"service":"a","latency":2.5})",
+            R"({"service":"a","latency":-2,"extra":true})",
+            R"({"service":"b","latency":10})",
+            R"({"latency":4})",
+            R"({"service":null,"latency":6})",
+            R"({"service":"undefined","latency":3})",
+            R"({"service":7,"latency":5})",
+            R"({"service":"b"})",
+            R"({"service":"a","latency":"slow"})"
+    };
+    std::map<reducer::GroupTags, Aggregate> const expected_aggregates{
+            {{R"("a")"}, {3, 1.5, -2.0, 2.5, 0.5}},
+            {{R"("b")"}, {1, 10.0, 10.0, 10.0, 10.0}},
+            {{std::string{clp_s::AggregateReducerOutputHandler::cMissingGroupByFieldTag}},
+             {1, 4.0, 4.0, 4.0, 4.0}},
+            {{"null"}, {1, 6.0, 6.0, 6.0, 6.0}},
+            {{R"("undefined")"}, {1, 3.0, 3.0, 3.0, 3.0}},
+            {{"7"}, {1, 5.0, 5.0, 5.0, 5.0}}
+    };
+
+    TestOutputCleaner const test_cleanup{
+            {std::string{cTestAggregateArchiveDirectory}, std::string{cTestAggregateInputFile}}
+    };
+    clp::FileWriter writer;
+    writer.open(
+            std::string{cTestAggregateInputFile},
+            clp::FileWriter::OpenMode::CREATE_FOR_WRITING
+    );
+    for (auto const record : records) {
+        writer.write_string(std::string{record});
+        writer.write_char('\n');
+    }
+    writer.close();
+
+    clp_s::ArchiveReader archive_reader;
+    open_archive_for_reading(
+            compress_single_archive(
+                    std::string{cTestAggregateInputFile},
+                    std::string{cTestAggregateArchiveDirectory},
+                    std::nullopt,
+                    false,
+                    false,
+                    false
+            ),
+            archive_reader
+    );
+    std::vector<std::shared_ptr<clp_s::SchemaReader>> schema_readers;
+    REQUIRE_NOTHROW(schema_readers = archive_reader.read_all_tables());
+    REQUIRE((cNumSchemas == schema_readers.size()));
+    auto const schema_tree{archive_reader.get_schema_tree()};
+    auto const schema_map{archive_reader.get_schema_map()};
+
+    std::array<int, 2> socket_fds{};
+    REQUIRE((0 == socketpair(AF_UNIX, SOCK_STREAM, 0, socket_fds.data())));
+    {
+        clp_s::AggregateReducerOutputHandler handler{socket_fds[0], "latency", {"service"}};
+        // Every record matches, as if the query were `*`
+        for (auto const& schema_reader : schema_readers) {
+            std::vector<uint64_t> message_idxs;
+            std::vector<clp_s::epochtime_t> timestamps;
+            std::vector<int64_t> log_event_idxs;
+            for (uint64_t i{0}; i < schema_reader->get_num_messages(); ++i) {
+                message_idxs.push_back(i);
+                timestamps.push_back(0);
+                log_event_idxs.push_back(0);
+            }
+            handler.write_columnar_batch(
+                    {archive_reader.get_archive_id(),
+                     *schema_tree,
+                     *schema_map,
+                     *schema_reader,
+                     message_idxs,
+                     timestamps,
+                     log_event_idxs}
+            );
+        }
+        REQUIRE((clp_s::ErrorCodeSuccess == handler.finish()));
+    }
+    close(socket_fds[0]);
+    auto const aggregates{receive_partial_aggregates(socket_fds[1])};
+    close(socket_fds[1]);
+    REQUIRE_NOTHROW(archive_reader.close());
+
+    REQUIRE((expected_aggregates.size() == aggregates.size()));
+    for (auto const& [tags, expected] : expected_aggregates) {
+        CAPTURE(tags);
+        REQUIRE(aggregates.contains(tags));
+        auto const& actual{aggregates.at(tags)};
+        REQUIRE((expected.count == actual.count));
+        REQUIRE((expected.sum == actual.sum));
+        REQUIRE((expected.min == actual.min));
+        REQUIRE((expected.max == actual.max));
+        REQUIRE((expected.avg == actual.avg));
+    }
+}
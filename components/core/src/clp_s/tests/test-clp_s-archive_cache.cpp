@@ -0,0 +1,174 @@
+#include <chrono>
+#include <cstddef>
+#include <memory>
+#include <string>
+#include <string_view>
+#include <thread>
+#include <utility>
+#include <vector>
+
+#include <catch2/catch_test_macros.hpp>
+
+#include "../src/clp/BufferReader.hpp"
+#include "../src/clp/ErrorCode.hpp"
+#include "../src/clp/ReaderInterface.hpp"
+#include "../src/clp_s/ArchiveCache.hpp"
+#include "../src/clp_s/CachedArchiveReader.hpp"
+#include "TestOutputCleaner.hpp"
+
+namespace {
+constexpr std::string_view cTestArchiveCacheDirectory{"test-archive-cache"};
+constexpr std::string_view cTestArchiveId{"test-archive"};
+
+/**
+ * A reader over an in-memory buffer that counts the bytes read from it.
+ */
+class CountingReader : public clp::ReaderInterface {
+public:
+    explicit CountingReader(std::string data)
+            : m_data{std::move(data)},
+              m_reader{m_data.data(), m_data.size()} {}
+
+    [[nodiscard]] auto try_read(char* buf, size_t num_bytes_to_read, size_t& num_bytes_read)
+            -> clp::ErrorCode override {
+        auto const rc{m_reader.try_read(buf, num_bytes_to_read, num_bytes_read)};
+        m_num_bytes_read += num_bytes_read;
+        return rc;
+    }
+
+    [[nodiscard]] auto try_seek_from_begin(size_t pos) -> clp::ErrorCode override {
+        return m_reader.try_seek_from_begin(pos);
+    }
+
+    [[nodiscard]] auto try_get_pos(size_t& pos) -> clp::ErrorCode override {
+        return m_reader.try_get_pos(pos);
+    }
+
+    [[nodiscard]] auto get_num_bytes_read() const -> size_t { return m_num_bytes_read; }
+
+private:
+    std::string m_data;
+    clp::BufferReader m_reader;
+    size_t m_num_bytes_read{0};
+};
+
+/**
+ * @param reader
+ * @param pos
+ * @param num_bytes
+ * @return The given number of bytes read from the given position, or an empty string on error.
+ */
+auto read_at(clp::ReaderInterface& reader, size_t pos, size_t num_bytes) -> std::string;
+
+auto read_at(clp::ReaderInterface& reader, size_t pos, size_t num_bytes) -> std::string {
+    std::string buf(num_bytes, '\0');
+    if (clp::ErrorCode_Success != reader.try_seek_from_begin(pos)
+        || clp::ErrorCode_Success != reader.try_read_exact_length(buf.data(), buf.size()))
+    {
+        return {};
+    }
+    return buf;
+}
+}  // namespace
+
+TEST_CASE("clp-s-archive-cache-lru-eviction", "[clp-s][ArchiveCache]") {
+    // Entries' last-used times are file modification times, so we wait between operations to
+    // ensure they're distinguishable on file systems with coarse timestamps.
+    constexpr auto cTimestampGranularity{std::chrono::milliseconds{20}};
+    constexpr size_t cEntrySize{100};
+    TestOutputCleaner const test_cleanup{{std::string{cTestArchiveCacheDirectory}}};
+
+    clp_s::ArchiveCache cache{std::string{cTestArchiveCacheDirectory}, 2 * cEntrySize + 50};
+    std::string const entry_a(cEntrySize, 'a');
+    std::string const entry_b(cEntrySize, 'b');
+    std::string const entry_c(cEntrySize, 'c');
+
+    cache.write(cTestArchiveId, 0, cEntrySize, entry_a.data());
+    std::this_thread::sleep_for(cTimestampGranularity);
+    cache.write(cTestArchiveId, cEntrySize, 2 * cEntrySize, entry_b.data());
+    std::this_thread::sleep_for(cTimestampGranularity);
+
+    // Reading an entry makes it the most recently used one
+    std::vector<char> buf;
+    REQUIRE(cache.try_read(cTestArchiveId, 0, cEntrySize, buf));
+    REQUIRE((std::string{buf.begin(), buf.end()} == entry_a));
+    std::this_thread::sleep_for(cTimestampGranularity);
+
+    // Exceeding the capacity evicts the least recently used entry
+    cache.write(cTestArchiveId, 2 * cEntrySize, 3 * cEntrySize, entry_c.data());
+    REQUIRE(cache.contains(cTestArchiveId, 0, cEntrySize));
+    REQUIRE_FALSE(cache.contains(cTestArchiveId, cEntrySize, 2 * cEntrySize));
+    REQUIRE(cache.contains(cTestArchiveId, 2 * cEntrySize, 3 * cEntrySize));
+
+    // Entries are specific to an archive and range
+    REQUIRE_FALSE(cache.contains("another-archive", 0, cEntrySize));
+    REQUIRE_FALSE(cache.try_read(cTestArchiveId, 0, cEntrySize - 1, buf));
+
+    // A new instance (e.g., in another process) counts the existing entries on its first write,
+    // even though its own writes alone are within the capacity
+    std::this_thread::sleep_for(cTimestampGranularity);
+    clp_s::ArchiveCache other_cache{std::string{cTestArchiveCacheDirectory}, 2 * cEntrySize + 50};
+    std::string const entry_d(cEntrySize, 'd');
+    other_cache.write(cTestArchiveId, 3 * cEntrySize, 4 * cEntrySize, entry_d.data());
+    REQUIRE_FALSE(cache.contains(cTestArchiveId, 0, cEntrySize));
+    REQUIRE(cache.contains(cTestArchiveId, 2 * cEntrySize, 3 * cEntrySize));
+    REQUIRE(cache.contains(cTestArchiveId, 3 * cEntrySize, 4 * cEntrySize));
+}
+
+TEST_CASE("clp-s-cached-archive-reader", "[clp-s][ArchiveCache]") {
+    constexpr size_t cArchiveSize{1000};
+    TestOutputCleaner const test_cleanup{{std::string{cTestArchiveCacheDirectory}}};
+
+    std::string archive(cArchiveSize, '\0');
+    for (size_t i{0}; i < archive.size(); ++i) {
+        archive[i] = static_cast<char>('a' + i % 26);
+    }
+    std::vector<std::pair<size_t, size_t>> const ranges{{100, 400}, {400, 450}, {700, 1000}};
+    auto cache{std::make_shared<clp_s::ArchiveCache>(
+            std::string{cTestArchiveCacheDirectory},
+            clp_s::ArchiveCache::cDefaultCapacity
+    )};
+
+    // Reading the ranges for the first time reads them from the underlying reader
+    auto first_reader{std::make_shared<CountingReader>(archive)};
+    clp_s::CachedArchiveReader first_cached_reader{
+            cache,
+            std::string{cTestArchiveId},
+            first_reader
+    };
+    REQUIRE((ranges == first_cached_reader.add_ranges(ranges)));
+
+    // Ranges that overlap a different registered range are ignored, unlike identical ones
+    std::vector<std::pair<size_t, size_t>> const overlapping_ranges{
+            {50, 150},
+            {100, 400},
+            {420, 430},
+            {800, 1200}
+    };
+    REQUIRE((std::vector<std::pair<size_t, size_t>>{{100, 400}}
+             == first_cached_reader.add_ranges(overlapping_ranges)));
+    REQUIRE((archive == read_at(first_cached_reader, 0, cArchiveSize)));
+    REQUIRE(cArchiveSize == first_reader->get_num_bytes_read());
+    for (auto const& [begin, end] : ranges) {
+        REQUIRE(cache->contains(cTestArchiveId, begin, end));
+    }
+
+    // Later readers read the ranges from the cache, and only read the rest of the archive from the
+    // underlying reader
+    auto second_reader{std::make_shared<CountingReader>(archive)};
+    clp_s::CachedArchiveReader second_cached_reader{
+            cache,
+            std::string{cTestArchiveId},
+            second_reader
+    };
+    REQUIRE(second_cached_reader.add_ranges(ranges).empty());
+    REQUIRE((archive.substr(120, 600) == read_at(second_cached_reader, 120, 600)));
+    REQUIRE((archive.substr(750) == read_at(second_cached_reader, 750, cArchiveSize - 750)));
+    REQUIRE((archive.substr(0, 50) == read_at(second_cached_reader, 0, 50)));
+    REQUIRE(300 == second_reader->get_num_bytes_read());
+
+    char c{};
+    size_t num_bytes_read{0};
+    REQUIRE(clp::ErrorCode_Success == second_cached_reader.try_seek_from_begin(cArchiveSize));
+    REQUIRE(clp::ErrorCode_EndOfFile == second_cached_reader.try_read(&c, 1, num_bytes_read));
+}
@@ -0,0 +1,676 @@
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <map>
+#include <memory>
+#include <optional>
+#include <span>
+#include <string>
+#include <string_view>
+#include <vector>
+
+#include <catch2/catch_test_macros.hpp>
+#include <msgpack.hpp>
+#include <nlohmann/json.hpp>
+
+#include "../src/clp/FileWriter.hpp"
+#include "../src/clp_s/ArchiveReader.hpp"
+#include "../src/clp_s/ColumnarBatchSerializer.hpp"
+#include "../src/clp_s/Schema.hpp"
+#include "../src/clp_s/SchemaReader.hpp"
+#include "../src/clp_s/SchemaTree.hpp"
+#include "../src/clp_s/search/OutputHandler.hpp"
+#include "clp_s_test_utils.hpp"
+#include "TestOutputCleaner.hpp"
+
+constexpr std::string_view cTestColumnarBatchArchiveDirectory{"test-columnar-batch-archive"};
+constexpr std::string_view cTestColumnarBatchInputFile{"test-columnar-batch-input.jsonl"};
+constexpr size_t cNumRecords{10};
+
+namespace {
+/**
+ * Rebuilds records from serialized columnar batches, using only the contents of the serialized
+ * archive and batch maps, as a consumer of the batches would.
+ */
+class RecordBuilder {
+public:
+    // Constructors
+    explicit RecordBuilder(nlohmann::json const& archive_map);
+
+    // Methods
+    /**
+     * @param batch A deserialized batch map
+     * @return The batch's records, in order
+     */
+    auto build_records(nlohmann::json const& batch) -> std::vector<nlohmann::json>;
+
+private:
+    // Types
+    struct Node {
+        int32_t parent_id{};
+        clp_s::NodeType type{};
+        std::string key_name;
+    };
+
+    // Methods
+    /**
+     * Decodes every value in a column, resolving variable IDs using the variables sent so far.
+     * @param column
+     * @return The column's values
+     */
+    auto decode_column(nlohmann::json const& column) const -> std::vector<nlohmann::json>;
+
+    /**
+     * Builds the value of the given node in the current record, consuming the next column if the
+     * node has values.
+     * @param node_id
+     * @return The value
+     */
+    auto build_value(int32_t node_id) -> nlohmann::json;
+
+    /**
+     * Builds a structured array from its entries in the schema.
+     * @param array_root
+     * @param entries
+     * @return The array
+     */
+    auto build_array(int32_t array_root, std::span<int32_t const> entries) -> nlohmann::json;
+
+    /**
+     * Builds an object within a structured array from its entries in the schema.
+     * @param object_root
+     * @param entries
+     * @return The object
+     */
+    auto build_object(int32_t object_root, std::span<int32_t const> entries) -> nlohmann::json;
+
+    /**
+     * @param ancestor_id
+     * @param node_id
+     * @return The keys of the nodes on the path from the given ancestor (exclusive) to the given
+     * node (inclusive), or std::nullopt if the node isn't a descendant of the ancestor.
+     */
+    auto get_path(int32_t ancestor_id, int32_t node_id) const
+            -> std::optional<std::vector<std::string>>;
+
+    /**
+     * @param subtree_root
+     * @param node_id
+     * @param type
+     * @return The ID of the node of the given type closest to `subtree_root` on the path from
+     * `subtree_root` (exclusive) to the given node (inclusive), or -1 if there's no such node.
+     */
+    auto find_subtree_root(int32_t subtree_root, int32_t node_id, clp_s::NodeType type) const
+            -> int32_t;
+
+    /**
+     * @param entries
+     * @return The first entry that is a node ID rather than a delimiter.
+     */
+    static auto get_first_node_id(std::span<int32_t const> entries) -> int32_t;
+
+    /**
+     * Sets the value at the given path in an object, creating any intermediate objects.
+     * @param object
+     * @param path
+     * @param value
+     */
+    static auto
+    set_value(nlohmann::json& object, std::vector<std::string> const& path, nlohmann::json value)
+            -> void;
+
+    // Variables
+    std::vector<Node> m_nodes;
+    int32_t m_default_namespace_root{-1};
+    std::map<int32_t, std::pair<size_t, std::vector<int32_t>>> m_schemas;
+    std::map<uint64_t, std::string> m_variables;
+    std::vector<std::vector<nlohmann::json>> m_column_values;
+    size_t m_next_column_idx{0};
+    size_t m_record_idx{0};
+};
+
+/**
+ * @param record_idx
+ * @return The test record with the given index
+ */
+auto create_record(size_t record_idx) -> nlohmann::json;
+
+/**
+ * @param record_idx
+ * @return A test record with the given index that contains null values, empty objects, and
+ * structured arrays. Records with odd indices have a different schema from those with even ones.
+ */
+auto create_structured_record(size_t record_idx) -> nlohmann::json;
+
+/**
+ * Decodes a bin of fixed-width values.
+ * @tparam T
+ * @param bin
+ * @return The values
+ */
+template <typename T>
+auto decode_fixed_width_values(nlohmann::json const& bin) -> std::vector<T>;
+
+/**
+ * @param batch A deserialized batch map
+ * @param node_type
+ * @return The column of the given type in the batch
+ */
+auto get_column(nlohmann::json const& batch, clp_s::NodeType node_type) -> nlohmann::json const&;
+
+RecordBuilder::RecordBuilder(nlohmann::json const& archive_map) {
+    for (auto const& node : archive_map.at("schema_tree")) {
+        auto const node_id{node.at(0).get<size_t>()};
+        if (m_nodes.size() <= node_id) {
+            m_nodes.resize(node_id + 1);
+        }
+        m_nodes[node_id] = {
+                node.at(1).get<int32_t>(),
+                static_cast<clp_s::NodeType>(node.at(2).get<uint8_t>()),
+                node.at(3).get<std::string>()
+        };
+        if (-1 == m_nodes[node_id].parent_id && clp_s::NodeType::Object == m_nodes[node_id].type
+            && m_nodes[node_id].key_name.empty())
+        {
+            m_default_namespace_root = static_cast<int32_t>(node_id);
+        }
+    }
+    for (auto const& schema : archive_map.at("schemas")) {
+        m_schemas.emplace(
+                schema.at(0).get<int32_t>(),
+                std::make_pair(schema.at(1).get<size_t>(), schema.at(2).get<std::vector<int32_t>>())
+        );
+    }
+}
+
+auto RecordBuilder::build_records(nlohmann::json const& batch) -> std::vector<nlohmann::json> {
+    for (auto const& entry : batch.at("variable_dictionary")) {
+        m_variables.emplace(entry.at(0).get<uint64_t>(), entry.at(1).get<std::string>());
+    }
+    m_column_values.clear();
+    for (auto const& column : batch.at("columns")) {
+        m_column_values.emplace_back(decode_column(column));
+    }
+
+    REQUIRE(m_schemas.contains(batch.at("schema_id").get<int32_t>()));
+    auto const& [num_ordered, entries]{m_schemas.at(batch.at("schema_id").get<int32_t>())};
+    std::span<int32_t const> const schema{entries};
+    std::vector<nlohmann::json> records;
+    for (m_record_idx = 0; m_record_idx < batch.at("num_records").get<size_t>(); ++m_record_idx) {
+        m_next_column_idx = 0;
+        auto record{nlohmann::json::object()};
+        for (size_t i{0}; i < schema.size(); ++i) {
+            auto const entry{schema[i]};
+            if (clp_s::Schema::schema_entry_is_unordered_object(entry)) {
+                size_t const length{static_cast<size_t>(
+                        clp_s::Schema::get_unordered_object_length(entry)
+                )};
+                auto const array_entries{schema.subspan(i + 1, length)};
+                auto const array_root{find_subtree_root(
+                        -1,
+                        get_first_node_id(array_entries),
+                        clp_s::Schema::get_unordered_object_type(entry)
+                )};
+                auto const path{get_path(m_default_namespace_root, array_root)};
+                REQUIRE(path.has_value());
+                set_value(record, path.value(), build_array(array_root, array_entries));
+                i += length;
+                continue;
+            }
+
+            // Nodes outside the default namespace (e.g., the log event index) aren't part of the
+            // record
+            auto value{build_value(entry)};
+            if (auto const path{get_path(m_default_namespace_root, entry)}; path.has_value()) {
+                set_value(record, path.value(), std::move(value));
+            }
+        }
+        REQUIRE((m_column_values.size() == m_next_column_idx));
+        records.emplace_back(std::move(record));
+    }
+    return records;
+}
+
+auto RecordBuilder::decode_column(nlohmann::json const& column) const
+        -> std::vector<nlohmann::json> {
+    auto const& values{column.at("values")};
+    std::vector<nlohmann::json> decoded_values;
+    switch (static_cast<clp_s::NodeType>(column.at("node_type").get<uint8_t>())) {
+        case clp_s::NodeType::Integer:
+        case clp_s::NodeType::DeltaInteger:
+            for (auto const value : decode_fixed_width_values<int64_t>(values)) {
+                decoded_values.emplace_back(value);
+            }
+            break;
+        case clp_s::NodeType::Float:
+        case clp_s::NodeType::FormattedFloat:
+        case clp_s::NodeType::DictionaryFloat:
+            for (auto const value : decode_fixed_width_values<double>(values)) {
+                decoded_values.emplace_back(value);
+            }
+            break;
+        case clp_s::NodeType::Boolean:
+            for (auto const value : decode_fixed_width_values<uint8_t>(values)) {
+                decoded_values.emplace_back(0 != value);
+            }
+            break;
+        case clp_s::NodeType::VarString:
+            for (auto const id : decode_fixed_width_values<uint64_t>(values)) {
+                REQUIRE(m_variables.contains(id));
+                decoded_values.emplace_back(m_variables.at(id));
+            }
+            break;
+        case clp_s::NodeType::UnstructuredArray:
+            for (auto const& value : values) {
+                decoded_values.emplace_back(nlohmann::json::parse(value.get<std::string>()));
+            }
+            break;
+        default:
+            for (auto const& value : values) {
+                decoded_values.emplace_back(value);
+            }
+            break;
+    }
+    return decoded_values;
+}
+
+auto RecordBuilder::build_value(int32_t node_id) -> nlohmann::json {
+    switch (m_nodes.at(node_id).type) {
+        case clp_s::NodeType::Object:
+            return nlohmann::json::object();
+        case clp_s::NodeType::StructuredArray:
+            return nlohmann::json::array();
+        case clp_s::NodeType::NullValue:
+            return nullptr;
+        default:
+            REQUIRE((m_next_column_idx < m_column_values.size()));
+            return m_column_values[m_next_column_idx++].at(m_record_idx);
+    }
+}
+
+auto RecordBuilder::build_array(int32_t array_root, std::span<int32_t const> entries)
+        -> nlohmann::json {
+    auto array{nlohmann::json::array()};
+    for (size_t i{0}; i < entries.size(); ++i) {
+        auto const entry{entries[i]};
+        if (false == clp_s::Schema::schema_entry_is_unordered_object(entry)) {
+            array.emplace_back(build_value(entry));
+            continue;
+        }
+
+        size_t const length{
+                static_cast<size_t>(clp_s::Schema::get_unordered_object_length(entry))
+        };
+        auto const element_entries{entries.subspan(i + 1, length)};
+        auto const type{clp_s::Schema::get_unordered_object_type(entry)};
+        auto const element_root{
+                find_subtree_root(array_root, get_first_node_id(element_entries), type)
+        };
+        if (clp_s::NodeType::StructuredArray == type) {
+            array.emplace_back(build_array(element_root, element_entries));
+        } else {
+            REQUIRE((clp_s::NodeType::Object == type));
+            array.emplace_back(build_object(element_root, element_entries));
+        }
+        i += length;
+    }
+    return array;
+}
+
+auto RecordBuilder::build_object(int32_t object_root, std::span<int32_t const> entries)
+        -> nlohmann::json {
+    auto object{nlohmann::json::object()};
+    for (size_t i{0}; i < entries.size(); ++i) {
+        auto const entry{entries[i]};
+        if (false == clp_s::Schema::schema_entry_is_unordered_object(entry)) {
+            auto const path{get_path(object_root, entry)};
+            REQUIRE(path.has_value());
+            set_value(object, path.value(), build_value(entry));
+            continue;
+        }
+
+        // Only arrays can be nested in objects within arrays
+        size_t const length{
+                static_cast<size_t>(clp_s::Schema::get_unordered_object_length(entry))
+        };
+        auto const array_entries{entries.subspan(i + 1, length)};
+        auto const array_root{find_subtree_root(
+                object_root,
+                get_first_node_id(array_entries),
+                clp_s::NodeType::StructuredArray
+        )};
+        auto const path{get_path(object_root, array_root)};
+        REQUIRE(path.has_value());
+        set_value(object, path.value(), build_array(array_root, array_entries));
+        i += length;
+    }
+    return object;
+}
+
+auto RecordBuilder::get_path(int32_t ancestor_id, int32_t node_id) const
+        -> std::optional<std::vector<std::string>> {
+    std::vector<std::string> path;
+    for (auto id{node_id}; ancestor_id != id; id = m_nodes.at(id).parent_id) {
+        if (-1 == id) {
+            return std::nullopt;
+        }
+        path.insert(path.begin(), m_nodes.at(id).key_name);
+    }
+    return path;
+}
+
+auto RecordBuilder::find_subtree_root(int32_t subtree_root, int32_t node_id, clp_s::NodeType type)
+        const -> int32_t {
+    int32_t subtree_root_of_type{-1};
+    for (auto id{node_id}; subtree_root != id; id = m_nodes.at(id).parent_id) {
+        if (type == m_nodes.at(id).type) {
+            subtree_root_of_type = id;
+        }
+    }
+    return subtree_root_of_type;
+}
+
+auto RecordBuilder::get_first_node_id(std::span<int32_t const> entries) -> int32_t {
+    for (auto const entry : entries) {
+        if (false == clp_s::Schema::schema_entry_is_unordered_object(entry)) {
+            return entry;
+        }
+    }
+    FAIL("No node ID in the entries");
+    return -1;
+}
+
+auto RecordBuilder::set_value(
+        nlohmann::json& object,
+        std::vector<std::string> const& path,
+        nlohmann::json value
+) -> void {
+    REQUIRE_FALSE(path.empty());
+    auto* parent{&object};
+    for (size_t i{0}; i + 1 < path.size(); ++i) {
+        parent = &(*parent)[path[i]];
+    }
+    (*parent)[path.back()] = std::move(value);
+}
+
+auto create_record(size_t record_idx) -> nlohmann::json {
+    auto const idx{static_cast<int64_t>(record_idx)};
+    return {{"int", idx * 1000 - 1},
+            {"float", static_cast<double>(idx) + 0.25},
+            {"bool", 0 == record_idx % 2},
+            {"var", "variable_" + std::to_string(record_idx % 3)},
+            {"clp", "a log message with " + std::to_string(record_idx) + " in it"}};
+}
+
+auto create_structured_record(size_t record_idx) -> nlohmann::json {
+    auto const idx{static_cast<int64_t>(record_idx)};
+    nlohmann::json record;
+    record["id"] = idx;
+    record["null"] = nullptr;
+    record["empty_object"] = nlohmann::json::object();
+    record["empty_array"] = nlohmann::json::array();
+    record["nested"]["int"] = idx * 3;
+    record["nested"]["null"] = nullptr;
+    record["nested"]["empty_object"] = nlohmann::json::object();
+    record["message"] = "a log message with " + std::to_string(record_idx) + " in it";
+    if (0 == record_idx % 2) {
+        nlohmann::json object_in_array;
+        object_in_array["int"] = idx;
+        object_in_array["null"] = nullptr;
+        object_in_array["empty_object"] = nlohmann::json::object();
+        object_in_array["array"] = nlohmann::json::array({false, {{"nested", "value"}}});
+        record["array"] = nlohmann::json::array(
+                {idx,
+                 "token_" + std::to_string(record_idx % 3),
+                 "a string with spaces",
+                 static_cast<double>(idx) + 0.5,
+                 true,
+                 nullptr,
+                 nlohmann::json::object(),
+                 nlohmann::json::array(),
+                 object_in_array,
+                 nlohmann::json::array({idx, nlohmann::json::array({idx})})}
+        );
+    } else {
+        record["flag"] = 0 == record_idx % 3;
+        record["array"] = nlohmann::json::array({idx, "token"});
+    }
+    return record;
+}
+
+template <typename T>
+auto decode_fixed_width_values(nlohmann::json const& bin) -> std::vector<T> {
+    auto const& bytes{bin.get_binary()};
+    REQUIRE(0 == bytes.size() % sizeof(T));
+    std::vector<T> values(bytes.size() / sizeof(T));
+    std::memcpy(values.data(), bytes.data(), bytes.size());
+    return values;
+}
+
+auto get_column(nlohmann::json const& batch, clp_s::NodeType node_type) -> nlohmann::json const& {
+    for (auto const& column : batch.at("columns")) {
+        if (static_cast<uint8_t>(node_type) == column.at("node_type").get<uint8_t>()) {
+            return column;
+        }
+    }
+    FAIL("No column of the given type");
+    return batch;
+}
+}  // namespace
+
+TEST_CASE("clp-s-columnar-batch-serializer", "[clp-s][columnar-batch]") {
+    TestOutputCleaner const test_cleanup{
+            {std::string{cTestColumnarBatchArchiveDirectory},
+             std::string{cTestColumnarBatchInputFile}}
+    };
+    std::vector<nlohmann::json> records;
+    clp::FileWriter writer;
+    writer.open(
+            std::string{cTestColumnarBatchInputFile},
+            clp::FileWriter::OpenMode::CREATE_FOR_WRITING
+    );
+    for (size_t i{0}; i < cNumRecords; ++i) {
+        records.emplace_back(create_record(i));
+        writer.write_string(records.back().dump());
+        writer.write_char('\n');
+    }
+    writer.close();
+
+    clp_s::ArchiveReader archive_reader;
+    open_archive_for_reading(
+            compress_single_archive(
+                    std::string{cTestColumnarBatchInputFile},
+                    std::string{cTestColumnarBatchArchiveDirectory},
+                    std::nullopt,
+                    false,
+                    false,
+                    false
+            ),
+            archive_reader
+    );
+    std::vector<std::shared_ptr<clp_s::SchemaReader>> schema_readers;
+    REQUIRE_NOTHROW(schema_readers = archive_reader.read_all_tables());
+    REQUIRE(1 == schema_readers.size());
+    auto& schema_reader{*schema_readers.back()};
+    auto const schema_tree{archive_reader.get_schema_tree()};
+    auto const schema_map{archive_reader.get_schema_map()};
+    auto const archive_id{archive_reader.get_archive_id()};
+
+    // The first batch contains only the first record, so it's preceded by the archive map
+    clp_s::ColumnarBatchSerializer serializer;
+    std::vector<uint64_t> const first_message_idxs{0};
+    std::vector<clp_s::epochtime_t> const first_timestamps{0};
+    std::vector<int64_t> const first_log_event_idxs{0};
+    msgpack::sbuffer first_buffer;
+    serializer.serialize(
+            {archive_id,
+             *schema_tree,
+             *schema_map,
+             schema_reader,
+             first_message_idxs,
+             first_timestamps,
+             first_log_event_idxs},
+            first_buffer
+    );
+    auto const archive_map{nlohmann::json::from_msgpack(
+            first_buffer.data(),
+            first_buffer.data() + first_buffer.size(),
+            false
+    )};
+    REQUIRE("archive" == archive_map.at("type"));
+    REQUIRE(archive_id == archive_map.at("archive_id").get<std::string>());
+    REQUIRE(schema_tree->get_nodes().size() == archive_map.at("schema_tree").size());
+    REQUIRE(schema_map->size() == archive_map.at("schemas").size());
+
+    // The second batch contains every record, and isn't preceded by another archive map
+    std::vector<uint64_t> message_idxs;
+    std::vector<clp_s::epochtime_t> timestamps;
+    std::vector<int64_t> log_event_idxs;
+    for (size_t i{0}; i < cNumRecords; ++i) {
+        message_idxs.push_back(i);
+        timestamps.push_back(static_cast<clp_s::epochtime_t>(i) * 10);
+        log_event_idxs.push_back(static_cast<int64_t>(i));
+    }
+    msgpack::sbuffer buffer;
+    serializer.serialize(
+            {archive_id,
+             *schema_tree,
+             *schema_map,
+             schema_reader,
+             message_idxs,
+             timestamps,
+             log_event_idxs},
+            buffer
+    );
+    auto const batch{nlohmann::json::from_msgpack(buffer.data(), buffer.data() + buffer.size())};
+    REQUIRE("batch" == batch.at("type"));
+    REQUIRE(cNumRecords == batch.at("num_records").get<size_t>());
+    REQUIRE(timestamps == decode_fixed_width_values<clp_s::epochtime_t>(batch.at("timestamps")));
+    REQUIRE(log_event_idxs == decode_fixed_width_values<int64_t>(batch.at("log_event_idxs")));
+
+    auto const ints{decode_fixed_width_values<int64_t>(
+            get_column(batch, clp_s::NodeType::Integer).at("values")
+    )};
+    auto const floats{
+            decode_fixed_width_values<double>(get_column(batch, clp_s::NodeType::Float).at("values"))
+    };
+    auto const bools{decode_fixed_width_values<uint8_t>(
+            get_column(batch, clp_s::NodeType::Boolean).at("values")
+    )};
+    auto const var_ids{decode_fixed_width_values<uint64_t>(
+            get_column(batch, clp_s::NodeType::VarString).at("values")
+    )};
+    auto const& clp_strings{get_column(batch, clp_s::NodeType::ClpString).at("values")};
+
+    // Every variable except the first record's was first referenced by this batch
+    nlohmann::json::object_t variables;
+    for (auto const& entry : batch.at("variable_dictionary")) {
+        variables[std::to_string(entry.at(0).get<uint64_t>())] = entry.at(1);
+    }
+    REQUIRE(2 == variables.size());
+    REQUIRE(0 == variables.count(std::to_string(var_ids[0])));
+
+    for (size_t i{0}; i < cNumRecords; ++i) {
+        auto const& record{records[i]};
+        REQUIRE(record.at("int").get<int64_t>() == ints[i]);
+        REQUIRE(record.at("float").get<double>() == floats[i]);
+        REQUIRE(record.at("bool").get<bool>() == (0 != bools[i]));
+        REQUIRE(record.at("clp") == clp_strings.at(i));
+        if (var_ids[i] != var_ids[0]) {
+            REQUIRE(record.at("var") == variables.at(std::to_string(var_ids[i])));
+        }
+    }
+    REQUIRE_NOTHROW(archive_reader.close());
+}
+
+TEST_CASE("clp-s-columnar-batch-record-reconstruction", "[clp-s][columnar-batch]") {
+    TestOutputCleaner const test_cleanup{
+            {std::string{cTestColumnarBatchArchiveDirectory},
+             std::string{cTestColumnarBatchInputFile}}
+    };
+    std::vector<nlohmann::json> records;
+    clp::FileWriter writer;
+    writer.open(
+            std::string{cTestColumnarBatchInputFile},
+            clp::FileWriter::OpenMode::CREATE_FOR_WRITING
+    );
+    for (size_t i{0}; i < cNumRecords; ++i) {
+        records.emplace_back(create_structured_record(i));
+        writer.write_string(records.back().dump());
+        writer.write_char('\n');
+    }
+    writer.close();
+
+    clp_s::ArchiveReader archive_reader;
+    open_archive_for_reading(
+            compress_single_archive(
+                    std::string{cTestColumnarBatchInputFile},
+                    std::string{cTestColumnarBatchArchiveDirectory},
+                    std::nullopt,
+                    false,
+                    false,
+                    true
+            ),
+            archive_reader
+    );
+    std::vector<std::shared_ptr<clp_s::SchemaReader>> schema_readers;
+    REQUIRE_NOTHROW(schema_readers = archive_reader.read_all_tables());
+    REQUIRE(2 == schema_readers.size());
+    auto const schema_tree{archive_reader.get_schema_tree()};
+    auto const schema_map{archive_reader.get_schema_map()};
+    auto const archive_id{archive_reader.get_archive_id()};
+
+    // An empty batch is enough to get the archive map, so every later buffer holds exactly one
+    // batch
+    clp_s::ColumnarBatchSerializer serializer;
+    msgpack::sbuffer archive_buffer;
+    serializer.serialize(
+            {archive_id, *schema_tree, *schema_map, *schema_readers.front(), {}, {}, {}},
+            archive_buffer
+    );
+    RecordBuilder record_builder{nlohmann::json::from_msgpack(
+            archive_buffer.data(),
+            archive_buffer.data() + archive_buffer.size(),
+            false
+    )};
+
+    size_t num_records{0};
+    for (auto const& schema_reader : schema_readers) {
+        std::vector<uint64_t> message_idxs;
+        std::vector<clp_s::epochtime_t> timestamps;
+        std::vector<int64_t> log_event_idxs;
+        for (uint64_t i{0}; i < schema_reader->get_num_messages(); ++i) {
+            message_idxs.push_back(i);
+            timestamps.push_back(0);
+            log_event_idxs.push_back(0);
+        }
+        msgpack::sbuffer buffer;
+        serializer.serialize(
+                {archive_id,
+                 *schema_tree,
+                 *schema_map,
+                 *schema_reader,
+                 message_idxs,
+                 timestamps,
+                 log_event_idxs},
+                buffer
+        );
+        auto const rebuilt_records{record_builder.build_records(
+                nlohmann::json::from_msgpack(buffer.data(), buffer.data() + buffer.size())
+        )};
+        REQUIRE(message_idxs.size() == rebuilt_records.size());
+
+        // Each rebuilt record matches the record as it's output with `--json`
+        schema_reader->initialize_serializer();
+        for (uint64_t i{0}; i < schema_reader->get_num_messages(); ++i) {
+            std::string json_record;
+            schema_reader->append_json_string(i, json_record);
+            auto const record{nlohmann::json::parse(json_record)};
+            REQUIRE(record == rebuilt_records[i]);
+            REQUIRE(records.at(record.at("id").get<size_t>()) == record);
+            ++num_records;
+        }
+    }
+    REQUIRE(cNumRecords == num_records);
+    REQUIRE_NOTHROW(archive_reader.close());
+}
@@ -119,3 +119,53 @@ TEST_CASE("clp-s-delta-encode-log-order", "[clp-s][delta-encode-log-order]") {
     }
     REQUIRE_NOTHROW(archive_reader.close());
 }
+
+TEST_CASE("clp-s-read-tables-in-log-event-idx-range", "[clp-s][delta-encode-log-order]") {
+    int64_t const begin_log_event_idx = GENERATE(0LL, 1LL, 2LL);
+    TestOutputCleaner const test_cleanup{{std::string{cTestDeltaEncodeOrderArchiveDirectory}}};
+
+    REQUIRE_NOTHROW(compress_archive(
+            get_test_input_local_path(),
+            std::string{cTestDeltaEncodeOrderArchiveDirectory},
+            std::nullopt,
+            false,
+            true,
+            false
+    ));
+
+    std::vector<clp_s::Path> archive_paths;
+    REQUIRE(clp_s::get_input_archives_for_raw_path(
+            std::string{cTestDeltaEncodeOrderArchiveDirectory},
+            archive_paths
+    ));
+    REQUIRE(1 == archive_paths.size());
+
+    clp_s::ArchiveReader archive_reader;
+    REQUIRE_NOTHROW(archive_reader.open(archive_paths.back(), clp_s::NetworkAuthOption{}));
+    REQUIRE_NOTHROW(archive_reader.read_dictionaries_and_metadata());
+    REQUIRE_NOTHROW(archive_reader.open_packed_streams());
+    REQUIRE(archive_reader.get_header().has_schema_log_event_idx_ranges());
+
+    // No table overlaps a range past the end of the archive
+    std::vector<std::shared_ptr<clp_s::SchemaReader>> schema_readers;
+    REQUIRE_NOTHROW(
+            schema_readers = archive_reader.read_tables_in_log_event_idx_range(
+                    static_cast<int64_t>(cNumEntries),
+                    static_cast<int64_t>(cNumEntries) + 1
+            )
+    );
+    REQUIRE(schema_readers.empty());
+
+    REQUIRE_NOTHROW(
+            schema_readers = archive_reader.read_tables_in_log_event_idx_range(
+                    begin_log_event_idx,
+                    begin_log_event_idx + 1
+            )
+    );
+    REQUIRE(1 == schema_readers.size());
+    auto schema_reader = schema_readers.back();
+    schema_reader->skip_to_log_event_idx(begin_log_event_idx);
+    REQUIRE_FALSE(schema_reader->done());
+    REQUIRE(begin_log_event_idx == schema_reader->get_next_log_event_idx());
+    REQUIRE_NOTHROW(archive_reader.close());
+}
@@ -1,17 +1,26 @@
 #include <sys/wait.h>
 
+#include <algorithm>
+#include <cstddef>
+#include <cstdint>
 #include <cstdlib>
 #include <filesystem>
+#include <fstream>
+#include <iterator>
+#include <map>
 #include <optional>
 #include <set>
+#include <sstream>
 #include <string>
 #include <string_view>
 #include <utility>
 #include <vector>
 
+#include <catch2/catch_message.hpp>
 #include <catch2/catch_test_macros.hpp>
 #include <catch2/generators/catch_generators.hpp>
 #include <fmt/format.h>
+#include <nlohmann/json.hpp>
 
 #include "../src/clp_s/archive_constants.hpp"
 #include "../src/clp_s/ArchiveReader.hpp"
@@ -38,6 +47,7 @@ constexpr std::string_view cTestEndToEndInvalidFormattedFloatInputFile{
         "test_invalid_formatted_float.jsonl"
 };
 constexpr std::string_view cTestEndToEndTimestampInputFile{"test_timestamp.jsonl"};
+constexpr std::string_view cTestEndToEndGeneratedInputFile{"test-end-to-end-generated.jsonl"};
 
 namespace {
 auto get_test_input_path_relative_to_tests_dir(std::string_view const test_input_path)
@@ -52,6 +62,21 @@ void literallyCompare(
 void check_all_leaf_nodes_match_types(std::set<clp_s::NodeType> const& types);
 void validate_archive_header();
 
+/**
+ * Writes records with several interleaved schemas to the generated input file.
+ * @param num_records
+ */
+void write_generated_input_file(size_t num_records);
+
+/**
+ * Decompresses every archive in log order into a separate subdirectory of the output directory.
+ * @param num_threads
+ * @param target_ordered_chunk_size
+ * @return A map from the name of each decompressed chunk to its contents.
+ */
+auto extract_in_order(size_t num_threads, size_t target_ordered_chunk_size)
+        -> std::map<std::string, std::string>;
+
 auto get_test_input_path_relative_to_tests_dir(std::string_view const test_input_path)
         -> std::filesystem::path {
     return std::filesystem::path{cTestEndToEndInputFileDirectory} / test_input_path;
@@ -129,6 +154,64 @@ void validate_archive_header() {
     }
 }
 
+void write_generated_input_file(size_t num_records) {
+    std::ofstream input_file{std::string{cTestEndToEndGeneratedInputFile}};
+    for (size_t i{0}; i < num_records; ++i) {
+        switch (i % 3) {
+            case 0:
+                input_file << fmt::format(R"({{"idx":{},"msg":"started task {}"}})", i, i * 7);
+                break;
+            case 1:
+                input_file << fmt::format(R"({{"idx":{},"latency":{},"ok":true}})", i, i % 97);
+                break;
+            default:
+                input_file << fmt::format(
+                        R"({{"idx":{},"nested":{{"host":"node-{}","tags":["a","b"]}}}})",
+                        i,
+                        i % 5
+                );
+                break;
+        }
+        input_file << '\n';
+    }
+}
+
+auto extract_in_order(size_t num_threads, size_t target_ordered_chunk_size)
+        -> std::map<std::string, std::string> {
+    auto const output_dir{
+            std::filesystem::path{cTestEndToEndOutputDirectory}
+            / fmt::format("{}-threads", num_threads)
+    };
+    std::filesystem::create_directories(output_dir);
+
+    clp_s::JsonConstructorOption constructor_option{};
+    constructor_option.output_dir = output_dir.string();
+    constructor_option.ordered = true;
+    constructor_option.target_ordered_chunk_size = target_ordered_chunk_size;
+    constructor_option.num_threads = num_threads;
+    for (auto const& entry : std::filesystem::directory_iterator(cTestEndToEndArchiveDirectory)) {
+        constructor_option.archive_path = clp_s::Path{
+                .source{clp_s::InputSource::Filesystem},
+                .path{entry.path().string()}
+        };
+        clp_s::JsonConstructor constructor{constructor_option};
+        constructor.store();
+    }
+
+    std::map<std::string, std::string> chunk_name_to_contents;
+    for (auto const& entry : std::filesystem::directory_iterator(output_dir)) {
+        std::ifstream chunk_file{entry.path(), std::ios::binary};
+        chunk_name_to_contents.emplace(
+                entry.path().filename().string(),
+                std::string{
+                        std::istreambuf_iterator<char>{chunk_file},
+                        std::istreambuf_iterator<char>{}
+                }
+        );
+    }
+    return chunk_name_to_contents;
+}
+
 auto extract() -> std::filesystem::path {
     constexpr auto cDefaultOrdered = false;
     constexpr auto cDefaultTargetOrderedChunkSize = 0;
@@ -363,3 +446,60 @@ TEST_CASE("clp-s-compress-extract-timestamps", "[clp-s][end-to-end]") {
             extracted_json_path
     );
 }
+
+/**
+ * Tests that decompressing in log order on multiple threads produces exactly the same chunks as
+ * decompressing on one thread.
+ */
+TEST_CASE("clp-s-compress-extract-ordered-in-parallel", "[clp-s][end-to-end]") {
+    constexpr size_t cNumRecords{3000};
+    constexpr size_t cTargetOrderedChunkSize{16UL * 1024};
+    auto single_file_archive = GENERATE(true, false);
+
+    TestOutputCleaner const test_cleanup{
+            {std::string{cTestEndToEndArchiveDirectory},
+             std::string{cTestEndToEndOutputDirectory},
+             std::string{cTestEndToEndGeneratedInputFile}}
+    };
+
+    write_generated_input_file(cNumRecords);
+    REQUIRE_NOTHROW(
+            std::ignore = compress_archive(
+                    std::string{cTestEndToEndGeneratedInputFile},
+                    std::string{cTestEndToEndArchiveDirectory},
+                    std::nullopt,
+                    false,
+                    single_file_archive,
+                    false
+            )
+    );
+
+    auto const serial_chunks{extract_in_order(1, cTargetOrderedChunkSize)};
+    REQUIRE((serial_chunks.size() > 1));
+
+    // Every chunk holds consecutive records in log order, and every record is decompressed once
+    std::vector<int64_t> record_idxs;
+    for (auto const& [chunk_name, contents] : serial_chunks) {
+        CAPTURE(chunk_name);
+        std::istringstream chunk_stream{contents};
+        std::optional<int64_t> prev_record_idx;
+        for (std::string line; std::getline(chunk_stream, line);) {
+            auto const record_idx{nlohmann::json::parse(line).at("idx").get<int64_t>()};
+            if (prev_record_idx.has_value()) {
+                REQUIRE((prev_record_idx.value() + 1 == record_idx));
+            }
+            prev_record_idx = record_idx;
+            record_idxs.push_back(record_idx);
+        }
+    }
+    std::sort(record_idxs.begin(), record_idxs.end());
+    REQUIRE((cNumRecords == record_idxs.size()));
+    for (size_t i{0}; i < record_idxs.size(); ++i) {
+        REQUIRE((static_cast<int64_t>(i) == record_idxs[i]));
+    }
+
+    for (size_t const num_threads : {2, 4, 7}) {
+        CAPTURE(num_threads);
+        REQUIRE((serial_chunks == extract_in_order(num_threads, cTargetOrderedChunkSize)));
+    }
+}
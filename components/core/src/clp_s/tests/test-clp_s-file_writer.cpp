@@ -0,0 +1,171 @@
+#include <sys/syscall.h>
+#include <sys/types.h>
+#include <unistd.h>
+
+#include <algorithm>
+#include <cerrno>
+#include <cstddef>
+#include <fstream>
+#include <iterator>
+#include <optional>
+#include <string>
+#include <string_view>
+
+#include <catch2/catch_message.hpp>
+#include <catch2/catch_test_macros.hpp>
+#include <catch2/generators/catch_generators.hpp>
+
+#include "../src/clp_s/FileWriter.hpp"
+#include "TestOutputCleaner.hpp"
+
+namespace {
+constexpr std::string_view cTestArchiveFile{"test-file-writer-archive"};
+constexpr std::string_view cTestSectionFile{"test-file-writer-section"};
+constexpr std::string_view cTestEmptySectionFile{"test-file-writer-empty-section"};
+
+// Larger than the buffer used when the kernel can't copy the data itself
+constexpr size_t cSectionSize{200'003};
+
+/**
+ * Makes `copy_file_range` fail with the given error once it has copied the given number of bytes.
+ */
+struct CopyFileRangeFailure {
+    size_t num_bytes_before_failure;
+    int error;
+};
+
+// If set, calls to `copy_file_range` (within this process) fail as described
+std::optional<CopyFileRangeFailure> copy_file_range_failure;
+size_t num_bytes_copied_by_copy_file_range{0};
+
+/**
+ * @param path
+ * @return The contents of the file at the given path.
+ */
+auto read_file(std::string_view path) -> std::string;
+
+/**
+ * Writes the test sections to the test archive file, between a header and suffix, using the given
+ * copy method.
+ * @param copy_method
+ * @return The expected contents of the archive file.
+ */
+auto write_test_archive(clp_s::FileWriter::CopyMethod copy_method) -> std::string;
+
+auto read_file(std::string_view path) -> std::string {
+    std::ifstream file{std::string{path}, std::ios::binary};
+    return {std::istreambuf_iterator<char>{file}, std::istreambuf_iterator<char>{}};
+}
+
+auto write_test_archive(clp_s::FileWriter::CopyMethod copy_method) -> std::string {
+    std::string section;
+    for (size_t i{0}; i < cSectionSize; ++i) {
+        section.push_back(static_cast<char>(i * 31 % 251));
+    }
+    std::ofstream{std::string{cTestSectionFile}, std::ios::binary} << section;
+    std::ofstream{std::string{cTestEmptySectionFile}, std::ios::binary};
+
+    std::string const header{"header"};
+    std::string const prefix{"prefix"};
+    std::string const suffix{"suffix"};
+    clp_s::FileWriter writer;
+    writer.open(std::string{cTestArchiveFile}, clp_s::FileWriter::OpenMode::CreateForWriting);
+    writer.seek_from_begin(header.size());
+    writer.write(prefix.data(), prefix.size());
+    writer.write_file_contents(std::string{cTestSectionFile}, copy_method);
+    writer.write_file_contents(std::string{cTestEmptySectionFile}, copy_method);
+    REQUIRE((header.size() + prefix.size() + section.size() == writer.get_pos()));
+    writer.write(suffix.data(), suffix.size());
+    writer.seek_from_begin(0);
+    writer.write(header.data(), header.size());
+    writer.close();
+    return header + prefix + section + suffix;
+}
+}  // namespace
+
+#if defined(__linux__)
+/**
+ * Replaces libc's `copy_file_range` for this process, so that tests can simulate the kernel failing
+ * part way through a copy. Unless a failure is requested, calls are forwarded to the system call.
+ */
+extern "C" auto copy_file_range(
+        int in_fd,
+        off64_t* in_offset,
+        int out_fd,
+        off64_t* out_offset,
+        size_t length,
+        unsigned int flags
+) -> ssize_t {
+    if (copy_file_range_failure.has_value()) {
+        auto const& failure{copy_file_range_failure.value()};
+        if (num_bytes_copied_by_copy_file_range >= failure.num_bytes_before_failure) {
+            errno = failure.error;
+            return -1;
+        }
+        length = std::min(
+                length,
+                failure.num_bytes_before_failure - num_bytes_copied_by_copy_file_range
+        );
+    }
+    auto const rc{
+            syscall(SYS_copy_file_range, in_fd, in_offset, out_fd, out_offset, length, flags)
+    };
+    if (rc > 0) {
+        num_bytes_copied_by_copy_file_range += static_cast<size_t>(rc);
+    }
+    return rc;
+}
+#endif
+
+TEST_CASE("clp-s-file-writer-write-file-contents", "[clp-s][FileWriter]") {
+    TestOutputCleaner const test_cleanup{
+            {std::string{cTestArchiveFile},
+             std::string{cTestSectionFile},
+             std::string{cTestEmptySectionFile}}
+    };
+
+    auto const copy_method{GENERATE(
+            clp_s::FileWriter::CopyMethod::KernelIfAvailable,
+            clp_s::FileWriter::CopyMethod::Buffered
+    )};
+    CAPTURE(static_cast<int>(copy_method));
+
+    num_bytes_copied_by_copy_file_range = 0;
+    auto const expected{write_test_archive(copy_method)};
+    REQUIRE((expected == read_file(cTestArchiveFile)));
+#if defined(__linux__)
+    if (clp_s::FileWriter::CopyMethod::Buffered == copy_method) {
+        REQUIRE((0 == num_bytes_copied_by_copy_file_range));
+    }
+#endif
+}
+
+#if defined(__linux__)
+TEST_CASE("clp-s-file-writer-write-file-contents-fallback", "[clp-s][FileWriter]") {
+    TestOutputCleaner const test_cleanup{
+            {std::string{cTestArchiveFile},
+             std::string{cTestSectionFile},
+             std::string{cTestEmptySectionFile}}
+    };
+
+    // The kernel copies part of the section (or none of it) before it can't copy any more, so the
+    // rest is copied through a buffer
+    auto const error{GENERATE(EXDEV, EINVAL)};
+    auto const num_bytes_before_failure{GENERATE(size_t{0}, size_t{4096}, cSectionSize / 3 + 1)};
+    CAPTURE(error, num_bytes_before_failure);
+
+    num_bytes_copied_by_copy_file_range = 0;
+    copy_file_range_failure = CopyFileRangeFailure{num_bytes_before_failure, error};
+    std::string expected;
+    try {
+        expected = write_test_archive(clp_s::FileWriter::CopyMethod::KernelIfAvailable);
+    } catch (...) {
+        copy_file_range_failure.reset();
+        throw;
+    }
+    copy_file_range_failure.reset();
+
+    REQUIRE((expected == read_file(cTestArchiveFile)));
+    REQUIRE((num_bytes_before_failure == num_bytes_copied_by_copy_file_range));
+}
+#endif
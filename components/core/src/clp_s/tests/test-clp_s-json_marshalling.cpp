@@ -0,0 +1,163 @@
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <optional>
+#include <string>
+#include <string_view>
+#include <tuple>
+#include <vector>
+
+#include <catch2/benchmark/catch_benchmark.hpp>
+#include <catch2/catch_test_macros.hpp>
+#include <nlohmann/json.hpp>
+
+#include "../src/clp/FileWriter.hpp"
+#include "../src/clp_s/ArchiveReader.hpp"
+#include "../src/clp_s/SchemaReader.hpp"
+#include "clp_s_test_utils.hpp"
+#include "TestOutputCleaner.hpp"
+
+constexpr std::string_view cTestJsonMarshallingArchiveDirectory{"test-json-marshalling-archive"};
+constexpr std::string_view cTestJsonMarshallingInputFile{"test-json-marshalling-input.jsonl"};
+constexpr size_t cNumFieldsPerType{8};
+
+namespace {
+/**
+ * Creates a record with a wide schema (many fields of every type), so that marshalling dominates
+ * the cost of decompressing it.
+ * @param record_idx
+ * @return The record
+ */
+auto create_wide_record(size_t record_idx) -> nlohmann::json;
+
+/**
+ * Writes `num_records` wide records to the test input file, one record per line.
+ * @param num_records
+ * @return The records written
+ */
+auto write_test_input(size_t num_records) -> std::vector<nlohmann::json>;
+
+/**
+ * Compresses the test input file and opens the resulting archive, ready to read tables.
+ * @param archive_reader
+ */
+auto compress_and_open_test_archive(clp_s::ArchiveReader& archive_reader) -> void;
+
+auto create_wide_record(size_t record_idx) -> nlohmann::json {
+    auto const idx{static_cast<int64_t>(record_idx)};
+    nlohmann::json record;
+    record["id"] = idx;
+    for (size_t i{0}; i < cNumFieldsPerType; ++i) {
+        auto const suffix{std::to_string(i)};
+        auto const offset{static_cast<int64_t>(i)};
+        record["int_" + suffix] = (idx * 1'000'003 + offset) * (0 == i % 2 ? 1 : -1);
+        record["float_" + suffix] = static_cast<double>(idx + offset) + 0.5;
+        record["string_" + suffix] = "value " + std::to_string(record_idx) + " \"quoted\"\t\\";
+        record["bool_" + suffix] = 0 == (record_idx + i) % 2;
+        record["null_" + suffix] = nullptr;
+        record["nested_" + suffix]["int"] = idx + offset;
+        record["nested_" + suffix]["key with \"escapes\""] = "nested " + suffix;
+    }
+    return record;
+}
+
+auto write_test_input(size_t num_records) -> std::vector<nlohmann::json> {
+    std::vector<nlohmann::json> records;
+    clp::FileWriter writer;
+    writer.open(
+            std::string{cTestJsonMarshallingInputFile},
+            clp::FileWriter::OpenMode::CREATE_FOR_WRITING
+    );
+    for (size_t i{0}; i < num_records; ++i) {
+        auto const& record{records.emplace_back(create_wide_record(i))};
+        writer.write_string(record.dump());
+        writer.write_char('\n');
+    }
+    writer.close();
+    return records;
+}
+
+auto compress_and_open_test_archive(clp_s::ArchiveReader& archive_reader) -> void {
+    auto const archive_path{compress_single_archive(
+            std::string{cTestJsonMarshallingInputFile},
+            std::string{cTestJsonMarshallingArchiveDirectory},
+            std::nullopt,
+            false,
+            false,
+            false
+    )};
+    open_archive_for_reading(archive_path, archive_reader);
+}
+}  // namespace
+
+TEST_CASE("clp-s-json-marshalling", "[clp-s][json-marshalling]") {
+    constexpr size_t cNumRecords{100};
+    TestOutputCleaner const test_cleanup{
+            {std::string{cTestJsonMarshallingArchiveDirectory},
+             std::string{cTestJsonMarshallingInputFile}}
+    };
+    auto const records{write_test_input(cNumRecords)};
+
+    clp_s::ArchiveReader archive_reader;
+    compress_and_open_test_archive(archive_reader);
+    std::vector<std::shared_ptr<clp_s::SchemaReader>> schema_readers;
+    REQUIRE_NOTHROW(schema_readers = archive_reader.read_all_tables());
+    REQUIRE(1 == schema_readers.size());
+
+    // Append every record to the same buffer, then check that each line round-trips
+    std::string buffer;
+    auto& schema_reader{*schema_readers.back()};
+    while (schema_reader.append_next_message(buffer)) {}
+
+    size_t num_records{0};
+    size_t line_begin{0};
+    for (auto line_end{buffer.find('\n')}; std::string::npos != line_end;
+         line_end = buffer.find('\n', line_begin))
+    {
+        auto const record{nlohmann::json::parse(buffer.substr(line_begin, line_end - line_begin))};
+        auto const record_idx{record.at("id").get<size_t>()};
+        REQUIRE(record_idx < records.size());
+        REQUIRE(records[record_idx] == record);
+        ++num_records;
+        line_begin = line_end + 1;
+    }
+    REQUIRE(buffer.size() == line_begin);
+    REQUIRE(cNumRecords == num_records);
+
+    // Replaying a record into a non-empty buffer appends to it
+    std::string appended{"prefix"};
+    schema_reader.append_json_string(0, appended);
+    REQUIRE(appended.starts_with("prefix{"));
+    auto const appended_record{nlohmann::json::parse(appended.substr(std::string{"prefix"}.size()))};
+    REQUIRE(records[0] == appended_record);
+    REQUIRE_NOTHROW(archive_reader.close());
+}
+
+TEST_CASE("clp-s-json-marshalling-throughput", "[clp-s][json-marshalling][!benchmark]") {
+    // Each benchmark iteration marshals `cNumRecords` records, so the throughput in records/s is
+    // `cNumRecords` divided by the reported mean iteration time.
+    constexpr size_t cNumRecords{10'000};
+    TestOutputCleaner const test_cleanup{
+            {std::string{cTestJsonMarshallingArchiveDirectory},
+             std::string{cTestJsonMarshallingInputFile}}
+    };
+    std::ignore = write_test_input(cNumRecords);
+
+    clp_s::ArchiveReader archive_reader;
+    compress_and_open_test_archive(archive_reader);
+    std::vector<std::shared_ptr<clp_s::SchemaReader>> schema_readers;
+    REQUIRE_NOTHROW(schema_readers = archive_reader.read_all_tables());
+    REQUIRE(1 == schema_readers.size());
+    auto& schema_reader{*schema_readers.back()};
+    schema_reader.initialize_serializer();
+
+    BENCHMARK("append_json_string") {
+        std::string buffer;
+        for (uint64_t i{0}; i < schema_reader.get_num_messages(); ++i) {
+            schema_reader.append_json_string(i, buffer);
+            buffer.push_back('\n');
+        }
+        return buffer.size();
+    };
+    REQUIRE_NOTHROW(archive_reader.close());
+}
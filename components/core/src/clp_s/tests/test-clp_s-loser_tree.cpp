@@ -0,0 +1,65 @@
+#include <algorithm>
+#include <cstddef>
+#include <cstdint>
+#include <random>
+#include <vector>
+
+#include <catch2/catch_test_macros.hpp>
+#include <catch2/generators/catch_generators.hpp>
+
+#include "../src/clp_s/LoserTree.hpp"
+
+using clp_s::LoserTree;
+
+TEST_CASE("clp-s-loser-tree-merge", "[clp-s][loser-tree]") {
+    auto const num_sources = GENERATE(as<size_t>{}, 1, 2, 3, 7, 16, 33);
+    constexpr size_t cNumValues{1000};
+
+    // Distribute the values among the sources, leaving some sources empty and giving some
+    // sources equal values to test tie-breaking
+    std::mt19937 generator{static_cast<std::mt19937::result_type>(num_sources)};
+    std::uniform_int_distribution<size_t> source_distribution{0, num_sources - 1};
+    std::vector<std::vector<int64_t>> sources(num_sources);
+    std::vector<int64_t> expected_values;
+    for (size_t i = 0; i < cNumValues; ++i) {
+        auto const value{static_cast<int64_t>(i / 2)};
+        sources[source_distribution(generator) / 2].push_back(value);
+        expected_values.push_back(value);
+    }
+
+    std::vector<size_t> next_value_ixs(num_sources, 0);
+    auto get_next_key = [&](size_t source) -> int64_t {
+        return next_value_ixs[source] < sources[source].size()
+                       ? sources[source][next_value_ixs[source]]
+                       : LoserTree::cExhaustedKey;
+    };
+    std::vector<int64_t> keys;
+    for (size_t source = 0; source < num_sources; ++source) {
+        keys.push_back(get_next_key(source));
+    }
+
+    LoserTree loser_tree{keys};
+    std::vector<int64_t> merged_values;
+    size_t prev_winner{0};
+    while (LoserTree::cExhaustedKey != loser_tree.get_winning_key()) {
+        auto const winner{loser_tree.get_winner()};
+        auto const key{loser_tree.get_winning_key()};
+        // Equal keys are taken from sources in ascending order
+        if (false == merged_values.empty() && merged_values.back() == key) {
+            REQUIRE((prev_winner <= winner));
+        }
+        merged_values.push_back(key);
+        prev_winner = winner;
+        ++next_value_ixs[winner];
+        loser_tree.update_winning_key(get_next_key(winner));
+    }
+    REQUIRE((merged_values == expected_values));
+}
+
+TEST_CASE("clp-s-loser-tree-empty", "[clp-s][loser-tree]") {
+    LoserTree const no_sources{{}};
+    REQUIRE((LoserTree::cExhaustedKey == no_sources.get_winning_key()));
+
+    LoserTree const exhausted_sources{{LoserTree::cExhaustedKey, LoserTree::cExhaustedKey}};
+    REQUIRE((LoserTree::cExhaustedKey == exhausted_sources.get_winning_key()));
+}
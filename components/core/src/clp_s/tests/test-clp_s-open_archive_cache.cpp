@@ -0,0 +1,113 @@
+#include <cstddef>
+#include <cstdint>
+#include <filesystem>
+#include <memory>
+#include <optional>
+#include <string>
+#include <string_view>
+
+#include <catch2/catch_test_macros.hpp>
+
+#include "../src/clp_s/ArchiveReader.hpp"
+#include "../src/clp_s/InputConfig.hpp"
+#include "../src/clp_s/OpenArchiveCache.hpp"
+#include "../src/clp_s/SchemaReader.hpp"
+#include "clp_s_test_utils.hpp"
+#include "TestOutputCleaner.hpp"
+
+namespace {
+constexpr std::string_view cTestOpenArchiveCacheArchiveDirectory{
+        "test-open-archive-cache-archive"
+};
+constexpr std::string_view cTestOpenArchiveCacheOtherArchiveDirectory{
+        "test-open-archive-cache-other-archive"
+};
+constexpr std::string_view cTestInputFileDirectory{"test_log_files"};
+constexpr std::string_view cTestInputFile{"test_simple_order.jsonl"};
+constexpr size_t cNumEntries{3};
+
+auto get_test_input_local_path() -> std::string;
+
+/**
+ * Compresses the test input into a single-file archive in the given directory.
+ * @param archive_directory
+ * @return The path of the archive.
+ */
+auto create_test_archive(std::string_view archive_directory) -> clp_s::Path;
+
+/**
+ * Reads every table in the given archive as a search would.
+ * @param archive_reader
+ * @return The number of messages in the archive.
+ */
+auto count_messages(clp_s::ArchiveReader& archive_reader) -> uint64_t;
+
+auto get_test_input_local_path() -> std::string {
+    std::filesystem::path const current_file_path{__FILE__};
+    auto const tests_dir{current_file_path.parent_path()};
+    return (tests_dir / cTestInputFileDirectory / cTestInputFile).string();
+}
+
+auto create_test_archive(std::string_view archive_directory) -> clp_s::Path {
+    return compress_single_archive(
+            get_test_input_local_path(),
+            std::string{archive_directory},
+            std::nullopt,
+            false,
+            true,
+            false
+    );
+}
+
+auto count_messages(clp_s::ArchiveReader& archive_reader) -> uint64_t {
+    prepare_archive_for_reading(archive_reader);
+    uint64_t num_messages{0};
+    for (auto const& schema_reader : archive_reader.read_all_tables()) {
+        num_messages += schema_reader->get_num_messages();
+    }
+    return num_messages;
+}
+}  // namespace
+
+TEST_CASE("clp-s-open-archive-cache", "[clp-s][OpenArchiveCache]") {
+    TestOutputCleaner const test_cleanup{
+            {std::string{cTestOpenArchiveCacheArchiveDirectory},
+             std::string{cTestOpenArchiveCacheOtherArchiveDirectory}}
+    };
+    auto const archive_path{create_test_archive(cTestOpenArchiveCacheArchiveDirectory)};
+    auto const other_archive_path{create_test_archive(cTestOpenArchiveCacheOtherArchiveDirectory)};
+
+    REQUIRE_THROWS_AS(clp_s::OpenArchiveCache(0), clp_s::OpenArchiveCache::OperationFailed);
+    clp_s::OpenArchiveCache cache{1};
+
+    // Repeated searches reuse the open archive, even if the previous search left its packed
+    // streams open
+    auto const archive_reader{cache.get(archive_path, clp_s::NetworkAuthOption{})};
+    REQUIRE(cNumEntries == count_messages(*archive_reader));
+    REQUIRE((archive_reader == cache.get(archive_path, clp_s::NetworkAuthOption{})));
+    REQUIRE(cNumEntries == count_messages(*archive_reader));
+    REQUIRE(1 == cache.size());
+
+    // Opening another archive evicts the least recently used one, which remains usable by its
+    // holders
+    auto const other_archive_reader{cache.get(other_archive_path, clp_s::NetworkAuthOption{})};
+    REQUIRE(1 == cache.size());
+    archive_reader->close_packed_streams();
+    REQUIRE(cNumEntries == count_messages(*archive_reader));
+    REQUIRE(cNumEntries == count_messages(*other_archive_reader));
+    auto const reopened_archive_reader{cache.get(archive_path, clp_s::NetworkAuthOption{})};
+    REQUIRE((archive_reader != reopened_archive_reader));
+    REQUIRE(cNumEntries == count_messages(*reopened_archive_reader));
+
+    // The same archive opened with different authentication is a different entry
+    clp_s::NetworkAuthOption const s3_auth{.method = clp_s::AuthMethod::S3PresignedUrlV4};
+    auto const s3_archive_reader{cache.get(archive_path, s3_auth)};
+    REQUIRE((reopened_archive_reader != s3_archive_reader));
+    REQUIRE(cNumEntries == count_messages(*s3_archive_reader));
+    REQUIRE(1 == cache.size());
+
+    cache.erase(archive_path, clp_s::NetworkAuthOption{});
+    REQUIRE(1 == cache.size());
+    cache.erase(archive_path, s3_auth);
+    REQUIRE(0 == cache.size());
+}
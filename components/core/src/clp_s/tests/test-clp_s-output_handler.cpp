@@ -0,0 +1,149 @@
+#include <cstddef>
+#include <cstdint>
+#include <filesystem>
+#include <fstream>
+#include <iterator>
+#include <string>
+#include <string_view>
+#include <vector>
+
+#include <catch2/catch_test_macros.hpp>
+
+#include "../src/clp_s/Defs.hpp"
+#include "../src/clp_s/ErrorCode.hpp"
+#include "../src/clp_s/OutputHandlerImpl.hpp"
+#include "../src/clp_s/ReaderUtils.hpp"
+#include "../src/clp_s/SchemaReader.hpp"
+#include "../src/clp_s/SchemaTree.hpp"
+#include "../src/clp_s/search/OutputHandler.hpp"
+#include "TestOutputCleaner.hpp"
+
+constexpr std::string_view cTestOutputHandlerPerEventFile{"test-output-handler-per-event.bin"};
+constexpr std::string_view cTestOutputHandlerBatchFile{"test-output-handler-batch.bin"};
+constexpr std::string_view cTestOutputHandlerArchiveId{"test-archive"};
+
+namespace {
+struct TestLogEvent {
+    std::string message;
+    clp_s::epochtime_t timestamp;
+    int64_t log_event_idx;
+};
+
+/**
+ * An output handler that requests columnar batches without overriding `write_columnar_batch`.
+ */
+class RecordOnlyOutputHandler : public clp_s::search::OutputHandler {
+public:
+    RecordOnlyOutputHandler() : clp_s::search::OutputHandler{false, false, true} {}
+
+    void write(
+            std::string_view message,
+            clp_s::epochtime_t timestamp,
+            std::string_view archive_id,
+            int64_t log_event_idx
+    ) override {}
+
+    void write(std::string_view message) override {}
+};
+
+/**
+ * @param path
+ * @return The contents of the file at `path`
+ */
+auto read_file(std::string_view path) -> std::string;
+
+auto read_file(std::string_view path) -> std::string {
+    std::ifstream file{std::string{path}, std::ios::binary};
+    return {std::istreambuf_iterator<char>{file}, std::istreambuf_iterator<char>{}};
+}
+}  // namespace
+
+TEST_CASE("clp-s-log-event-batch", "[clp-s][output-handler]") {
+    clp_s::search::LogEventBatch batch{cTestOutputHandlerArchiveId};
+    REQUIRE(batch.empty());
+
+    std::vector<std::string_view> const messages{"{\"a\":1}\n", "", "{\"b\":\"c\"}\n"};
+    for (size_t i{0}; i < messages.size(); ++i) {
+        auto& buffer{batch.get_message_buffer()};
+        auto const message_begin{buffer.size()};
+        buffer.append(messages[i]);
+        batch.add_log_event(message_begin, static_cast<clp_s::epochtime_t>(i), 10 + i);
+    }
+
+    REQUIRE(messages.size() == batch.size());
+    REQUIRE(cTestOutputHandlerArchiveId == batch.get_archive_id());
+    REQUIRE("{\"a\":1}\n{\"b\":\"c\"}\n" == batch.get_messages());
+    for (size_t i{0}; i < messages.size(); ++i) {
+        auto const log_event{batch.get_log_event(i)};
+        REQUIRE(messages[i] == log_event.message);
+        REQUIRE(static_cast<clp_s::epochtime_t>(i) == log_event.timestamp);
+        REQUIRE(static_cast<int64_t>(10 + i) == log_event.log_event_idx);
+    }
+
+    batch.clear();
+    REQUIRE(batch.empty());
+    REQUIRE(batch.get_messages().empty());
+}
+
+TEST_CASE("clp-s-file-output-handler-write-batch", "[clp-s][output-handler]") {
+    TestOutputCleaner const test_cleanup{
+            {std::string{cTestOutputHandlerPerEventFile}, std::string{cTestOutputHandlerBatchFile}}
+    };
+    std::vector<TestLogEvent> const log_events{
+            {"{\"key\":\"value\"}\n", 0, 0},
+            {"", -1, 1},
+            {std::string(70'000, 'x') + "\n", 1'700'000'000'000, 1'000'000},
+    };
+
+    {
+        clp_s::FileOutputHandler handler{std::string{cTestOutputHandlerPerEventFile}, true};
+        for (auto const& log_event : log_events) {
+            handler.write(
+                    log_event.message,
+                    log_event.timestamp,
+                    cTestOutputHandlerArchiveId,
+                    log_event.log_event_idx
+            );
+        }
+    }
+
+    {
+        clp_s::search::LogEventBatch batch{cTestOutputHandlerArchiveId};
+        for (auto const& log_event : log_events) {
+            auto& buffer{batch.get_message_buffer()};
+            auto const message_begin{buffer.size()};
+            buffer.append(log_event.message);
+            batch.add_log_event(message_begin, log_event.timestamp, log_event.log_event_idx);
+        }
+        clp_s::FileOutputHandler handler{std::string{cTestOutputHandlerBatchFile}, true};
+        handler.write_batch(batch);
+    }
+
+    auto const per_event_output{read_file(cTestOutputHandlerPerEventFile)};
+    REQUIRE_FALSE(per_event_output.empty());
+    REQUIRE(per_event_output == read_file(cTestOutputHandlerBatchFile));
+}
+
+TEST_CASE("clp-s-output-handler-unsupported-columnar-batch", "[clp-s][output-handler]") {
+    clp_s::SchemaTree const schema_tree;
+    clp_s::ReaderUtils::SchemaMap const schemas;
+    clp_s::SchemaReader reader;
+    clp_s::search::ColumnarBatch const batch{
+            .archive_id = cTestOutputHandlerArchiveId,
+            .schema_tree = schema_tree,
+            .schemas = schemas,
+            .reader = reader,
+            .message_idxs = {},
+            .timestamps = {},
+            .log_event_idxs = {}
+    };
+
+    RecordOnlyOutputHandler handler;
+    REQUIRE(handler.should_output_columnar_batches());
+    try {
+        handler.write_columnar_batch(batch);
+        FAIL("Writing a columnar batch to a handler that doesn't support them didn't throw");
+    } catch (clp_s::search::OutputHandler::OperationFailed const& e) {
+        REQUIRE((clp_s::ErrorCodeUnsupported == e.get_error_code()));
+    }
+}
@@ -0,0 +1,245 @@
+#include <cstddef>
+#include <filesystem>
+#include <fstream>
+#include <memory>
+#include <set>
+#include <string>
+#include <string_view>
+#include <tuple>
+#include <utility>
+#include <vector>
+
+#include <catch2/catch_message.hpp>
+#include <catch2/catch_test_macros.hpp>
+#include <catch2/generators/catch_generators.hpp>
+#include <fmt/format.h>
+
+#include "../src/clp_s/archive_constants.hpp"
+#include "../src/clp_s/ArchiveReaderAdaptor.hpp"
+#include "../src/clp_s/ErrorCode.hpp"
+#include "../src/clp_s/InputConfig.hpp"
+#include "../src/clp_s/JsonParser.hpp"
+#include "../src/clp_s/PackedStreamReader.hpp"
+#include "../src/clp_s/ZstdDecompressor.hpp"
+#include "TestOutputCleaner.hpp"
+
+namespace {
+constexpr std::string_view cTestPackedStreamReaderInputFile{"test-packed-stream-reader.jsonl"};
+constexpr std::string_view cTestPackedStreamReaderArchiveDirectory{
+        "test-packed-stream-reader-archives"
+};
+constexpr size_t cNumSchemas{8};
+constexpr size_t cNumRecordsPerSchema{100};
+
+/**
+ * Compresses records with `cNumSchemas` different schemas into an archive where each schema's table
+ * is packed into its own stream.
+ * @return The path of the archive.
+ */
+auto compress_archive_with_one_stream_per_table() -> std::string;
+
+/**
+ * Opens a reader for the packed streams of the given archive.
+ * @param archive_path
+ * @param reader Returns the opened reader
+ * @return The adaptor the reader reads from.
+ */
+auto open_packed_stream_reader(std::string const& archive_path, clp_s::PackedStreamReader& reader)
+        -> std::shared_ptr<clp_s::ArchiveReaderAdaptor>;
+
+/**
+ * Reads every stream of the given archive without prefetching.
+ * @param archive_path
+ * @return The contents of each stream, indexed by stream ID.
+ */
+auto read_all_streams(std::string const& archive_path) -> std::vector<std::string>;
+
+auto compress_archive_with_one_stream_per_table() -> std::string {
+    constexpr auto cTargetEncodedSize{8ULL * 1024 * 1024 * 1024};  // 8 GiB
+    constexpr auto cMaxDocumentSize{512ULL * 1024 * 1024};  // 512 MiB
+    constexpr auto cCompressionLevel{3};
+
+    {
+        std::ofstream input_file{std::string{cTestPackedStreamReaderInputFile}};
+        for (size_t i{0}; i < cNumRecordsPerSchema; ++i) {
+            for (size_t schema_idx{0}; schema_idx < cNumSchemas; ++schema_idx) {
+                input_file << fmt::format("{{\"field{}\":{}}}\n", schema_idx, i);
+            }
+        }
+    }
+
+    std::string const archive_directory{cTestPackedStreamReaderArchiveDirectory};
+    std::filesystem::create_directory(archive_directory);
+    clp_s::JsonParserOption parser_option{};
+    parser_option.input_paths_and_canonical_filenames.emplace_back(
+            clp_s::Path{
+                    .source = clp_s::InputSource::Filesystem,
+                    .path = std::string{cTestPackedStreamReaderInputFile}
+            },
+            std::string{cTestPackedStreamReaderInputFile}
+    );
+    parser_option.archives_dir = archive_directory;
+    parser_option.target_encoded_size = cTargetEncodedSize;
+    parser_option.max_document_size = cMaxDocumentSize;
+    // Every table is larger than the minimum, so each one is packed into its own stream
+    parser_option.min_table_size = 1;
+    parser_option.compression_level = cCompressionLevel;
+
+    clp_s::JsonParser parser{parser_option};
+    REQUIRE(parser.ingest());
+    REQUIRE_NOTHROW(std::ignore = parser.store());
+
+    std::vector<std::string> archive_paths;
+    for (auto const& entry : std::filesystem::directory_iterator{archive_directory}) {
+        archive_paths.emplace_back(entry.path().string());
+    }
+    REQUIRE((1 == archive_paths.size()));
+    return archive_paths.front();
+}
+
+auto open_packed_stream_reader(std::string const& archive_path, clp_s::PackedStreamReader& reader)
+        -> std::shared_ptr<clp_s::ArchiveReaderAdaptor> {
+    constexpr size_t cDecompressorFileReadBufferCapacity{64 * 1024};  // 64 KiB
+
+    auto adaptor{std::make_shared<clp_s::ArchiveReaderAdaptor>(
+            clp_s::Path{.source = clp_s::InputSource::Filesystem, .path = archive_path},
+            clp_s::NetworkAuthOption{}
+    )};
+    REQUIRE((clp_s::ErrorCodeSuccess == adaptor->load_archive_metadata()));
+
+    auto table_metadata_reader{
+            adaptor->checkout_reader_for_section(clp_s::constants::cArchiveTableMetadataFile)
+    };
+    clp_s::ZstdDecompressor decompressor;
+    decompressor.open(*table_metadata_reader, cDecompressorFileReadBufferCapacity);
+    REQUIRE_FALSE(reader.read_metadata(decompressor).has_error());
+    decompressor.close();
+    table_metadata_reader.reset();
+    adaptor->checkin_reader_for_section(clp_s::constants::cArchiveTableMetadataFile);
+
+    reader.open_packed_streams(adaptor);
+    return adaptor;
+}
+
+auto read_all_streams(std::string const& archive_path) -> std::vector<std::string> {
+    clp_s::PackedStreamReader reader;
+    auto const adaptor{open_packed_stream_reader(archive_path, reader)};
+
+    std::vector<std::string> stream_contents;
+    std::shared_ptr<char[]> buf;
+    size_t buf_size{0};
+    for (size_t stream_id{0}; stream_id < cNumSchemas; ++stream_id) {
+        reader.read_stream(stream_id, buf, buf_size);
+        stream_contents.emplace_back(buf.get(), reader.get_uncompressed_stream_size(stream_id));
+    }
+    reader.close();
+    return stream_contents;
+}
+}  // namespace
+
+TEST_CASE("clp-s-packed-stream-reader-prefetch", "[clp-s][PackedStreamReader]") {
+    TestOutputCleaner const test_cleanup{
+            {std::string{cTestPackedStreamReaderInputFile},
+             std::string{cTestPackedStreamReaderArchiveDirectory}}
+    };
+    auto const archive_path{compress_archive_with_one_stream_per_table()};
+    auto const stream_contents{read_all_streams(archive_path)};
+    REQUIRE((cNumSchemas == stream_contents.size()));
+
+    std::vector<size_t> all_stream_ids;
+    for (size_t stream_id{0}; stream_id < cNumSchemas; ++stream_id) {
+        all_stream_ids.push_back(stream_id);
+    }
+
+    SECTION("Prefetched streams are returned in order, including when some are skipped") {
+        auto const max_num_prefetched_streams = GENERATE(1UL, 2UL, 16UL);
+        CAPTURE(max_num_prefetched_streams);
+
+        clp_s::PackedStreamReader reader;
+        auto const adaptor{open_packed_stream_reader(archive_path, reader)};
+        reader.prefetch_streams({0, 2, 3, 5, 7}, max_num_prefetched_streams);
+
+        // Stream 1 wasn't prefetched, so it can't be read
+        std::shared_ptr<char[]> buf;
+        size_t buf_size{0};
+        REQUIRE_THROWS_AS(
+                reader.read_stream(1, buf, buf_size),
+                clp_s::PackedStreamReader::OperationFailed
+        );
+
+        for (size_t const stream_id : {2, 5, 7}) {
+            CAPTURE(stream_id);
+            reader.read_stream(stream_id, buf, buf_size);
+            REQUIRE((buf_size >= stream_contents[stream_id].size()));
+            REQUIRE((std::string{buf.get(), stream_contents[stream_id].size()}
+                     == stream_contents[stream_id]));
+        }
+        reader.close();
+    }
+
+    SECTION("Buffers are reused only once the caller releases them") {
+        clp_s::PackedStreamReader reader;
+        auto const adaptor{open_packed_stream_reader(archive_path, reader)};
+        reader.prefetch_streams(all_stream_ids, 1);
+
+        // Buffers still held by the caller must never be decompressed into again
+        std::vector<std::shared_ptr<char[]>> held_bufs;
+        std::shared_ptr<char[]> buf;
+        size_t buf_size{0};
+        for (size_t stream_id{0}; stream_id < cNumSchemas / 2; ++stream_id) {
+            reader.read_stream(stream_id, buf, buf_size);
+            held_bufs.emplace_back(buf);
+        }
+        for (size_t stream_id{0}; stream_id < held_bufs.size(); ++stream_id) {
+            CAPTURE(stream_id);
+            REQUIRE((std::string{held_bufs[stream_id].get(), stream_contents[stream_id].size()}
+                     == stream_contents[stream_id]));
+        }
+        std::set<char const*> known_bufs;
+        for (auto const& held_buf : held_bufs) {
+            known_bufs.emplace(held_buf.get());
+        }
+        held_bufs.clear();
+
+        // Every table has the same size, so once the caller releases each buffer before reading the
+        // next stream, the streams after the next one are decompressed into released buffers
+        for (size_t stream_id{cNumSchemas / 2}; stream_id < cNumSchemas; ++stream_id) {
+            CAPTURE(stream_id);
+            REQUIRE((stream_contents[stream_id].size() == stream_contents.front().size()));
+            buf.reset();
+            reader.read_stream(stream_id, buf, buf_size);
+            REQUIRE((std::string{buf.get(), stream_contents[stream_id].size()}
+                     == stream_contents[stream_id]));
+            if (stream_id > cNumSchemas / 2) {
+                REQUIRE(known_bufs.contains(buf.get()));
+            }
+            known_bufs.emplace(buf.get());
+        }
+        reader.close();
+    }
+
+    SECTION("Closing the reader before every prefetched stream is read stops prefetching") {
+        std::shared_ptr<char[]> buf;
+        size_t buf_size{0};
+        {
+            clp_s::PackedStreamReader reader;
+            auto const adaptor{open_packed_stream_reader(archive_path, reader)};
+            reader.prefetch_streams(all_stream_ids, 2);
+            reader.read_stream(0, buf, buf_size);
+            reader.close();
+
+            // The reader can be reopened and read without prefetching
+            REQUIRE_FALSE(nullptr == open_packed_stream_reader(archive_path, reader));
+            std::shared_ptr<char[]> other_buf;
+            size_t other_buf_size{0};
+            reader.read_stream(cNumSchemas - 1, other_buf, other_buf_size);
+            REQUIRE((std::string{other_buf.get(), stream_contents.back().size()}
+                     == stream_contents.back()));
+        }
+
+        // A buffer the caller still holds outlives the reader and its pool
+        auto const& first_stream_contents{stream_contents.front()};
+        REQUIRE((std::string{buf.get(), first_stream_contents.size()} == first_stream_contents));
+        buf.reset();
+    }
+}
@@ -0,0 +1,208 @@
+#include <sys/socket.h>
+#include <sys/un.h>
+#include <unistd.h>
+
+#include <algorithm>
+#include <array>
+#include <chrono>
+#include <cstddef>
+#include <cstring>
+#include <iostream>
+#include <optional>
+#include <string>
+#include <string_view>
+#include <thread>
+#include <tuple>
+#include <vector>
+
+#include <catch2/catch_test_macros.hpp>
+#include <fmt/format.h>
+
+#include "../src/clp_s/SearchServer.hpp"
+#include "TestOutputCleaner.hpp"
+
+namespace {
+constexpr std::string_view cTestSearchServerSocketPath{"test-search-server.sock"};
+constexpr std::chrono::milliseconds cTestRequestTimeout{200};
+
+/**
+ * Runs a search server on a background thread, stopping it when destroyed so that the server is
+ * stopped even if an assertion fails.
+ */
+class ServerThread {
+public:
+    // Constructors
+    explicit ServerThread(clp_s::SearchServer& server)
+            : m_server{server},
+              m_thread{[this]() { m_served_without_error = m_server.serve(); }} {}
+
+    // Delete copy & move constructors and assignment operators
+    ServerThread(ServerThread const&) = delete;
+    ServerThread(ServerThread&&) = delete;
+    auto operator=(ServerThread const&) -> ServerThread& = delete;
+    auto operator=(ServerThread&&) -> ServerThread& = delete;
+
+    // Destructor
+    ~ServerThread() { std::ignore = stop(); }
+
+    // Methods
+    /**
+     * Stops the server and waits for it to finish serving.
+     * @return Whether the server stopped without encountering an error.
+     */
+    [[nodiscard]] auto stop() -> bool {
+        if (m_thread.joinable()) {
+            m_server.stop();
+            m_thread.join();
+        }
+        return m_served_without_error;
+    }
+
+private:
+    clp_s::SearchServer& m_server;
+    bool m_served_without_error{false};
+    std::thread m_thread;
+};
+
+/**
+ * Sends a request to the server listening on the test socket and reads the response until the
+ * server closes the connection.
+ * @param request The data to send, or std::nullopt to only connect.
+ * @param close_for_writing Whether to tell the server that the request is complete.
+ * @return The response, or std::nullopt if the server couldn't be reached.
+ */
+auto send_request(std::optional<std::string_view> request, bool close_for_writing)
+        -> std::optional<std::string>;
+
+/**
+ * @param response
+ * @return The last line of the response, without its newline.
+ */
+auto get_status_line(std::string_view response) -> std::string;
+
+auto send_request(std::optional<std::string_view> request, bool close_for_writing)
+        -> std::optional<std::string> {
+    int const fd{::socket(AF_UNIX, SOCK_STREAM, 0)};
+    if (-1 == fd) {
+        return std::nullopt;
+    }
+    sockaddr_un address{};
+    address.sun_family = AF_UNIX;
+    std::memcpy(
+            address.sun_path,
+            cTestSearchServerSocketPath.data(),
+            cTestSearchServerSocketPath.size()
+    );
+    // NOLINTNEXTLINE(cppcoreguidelines-pro-type-reinterpret-cast)
+    if (0 != ::connect(fd, reinterpret_cast<sockaddr*>(&address), sizeof(address))) {
+        ::close(fd);
+        return std::nullopt;
+    }
+
+    if (request.has_value()
+        && static_cast<ssize_t>(request->size())
+                   != ::send(fd, request->data(), request->size(), MSG_NOSIGNAL))
+    {
+        ::close(fd);
+        return std::nullopt;
+    }
+    if (close_for_writing) {
+        ::shutdown(fd, SHUT_WR);
+    }
+
+    std::string response;
+    std::array<char, 4096> buf{};
+    while (true) {
+        auto const num_bytes_read{::recv(fd, buf.data(), buf.size(), 0)};
+        if (num_bytes_read <= 0) {
+            break;
+        }
+        response.append(buf.data(), static_cast<size_t>(num_bytes_read));
+    }
+    ::close(fd);
+    return response;
+}
+
+auto get_status_line(std::string_view response) -> std::string {
+    if (response.ends_with('\n')) {
+        response.remove_suffix(1);
+    }
+    auto const last_line_pos{response.rfind('\n')};
+    return std::string{
+            std::string_view::npos == last_line_pos ? response : response.substr(last_line_pos + 1)
+    };
+}
+}  // namespace
+
+TEST_CASE("clp-s-search-server", "[clp-s][SearchServer]") {
+    TestOutputCleaner const test_cleanup{{std::string{cTestSearchServerSocketPath}}};
+
+    // The search echoes its arguments as results, and fails if the first one is "fail"
+    std::vector<std::vector<std::string>> served_search_args;
+    clp_s::SearchServer server{
+            std::string{cTestSearchServerSocketPath},
+            [&](std::vector<std::string> const& search_args) -> bool {
+                served_search_args.push_back(search_args);
+                for (auto const& arg : search_args) {
+                    std::cout << arg << '\n';
+                }
+                return search_args.empty() || "fail" != search_args.front();
+            },
+            cTestRequestTimeout
+    };
+    REQUIRE(server.listen());
+    ServerThread server_thread{server};
+
+    auto const success_status_line{std::string{clp_s::SearchServer::cSuccessStatusLine}};
+    auto const error_status_prefix{std::string{clp_s::SearchServer::cErrorStatusPrefix}};
+
+    // A successful search's results are followed by the success status line
+    auto const response{send_request("[\"archive-dir\", \"a: 1\"]\n", false)};
+    REQUIRE(response.has_value());
+    REQUIRE((fmt::format("archive-dir\na: 1\n{}\n", success_status_line) == response.value()));
+
+    // A request without a trailing newline is complete once the client stops sending
+    auto const unterminated_response{send_request(R"(["b: 2"])", true)};
+    REQUIRE(unterminated_response.has_value());
+    REQUIRE((fmt::format("b: 2\n{}\n", success_status_line) == unterminated_response.value()));
+
+    // A failed search's results are followed by an error status line
+    auto const failed_search_response{send_request("[\"fail\"]\n", false)};
+    REQUIRE(failed_search_response.has_value());
+    REQUIRE(failed_search_response->starts_with("fail\n"));
+    REQUIRE(get_status_line(failed_search_response.value()).starts_with(error_status_prefix));
+
+    // Invalid requests aren't searched
+    for (std::string_view const invalid_request : {"not json\n", "{\"a\": 1}\n", "[1]\n"}) {
+        auto const invalid_request_response{send_request(invalid_request, false)};
+        REQUIRE(invalid_request_response.has_value());
+        REQUIRE(invalid_request_response->starts_with(error_status_prefix));
+        REQUIRE(invalid_request_response->ends_with('\n'));
+        REQUIRE((1 == std::count(
+                          invalid_request_response->begin(),
+                          invalid_request_response->end(),
+                          '\n'
+                  )));
+    }
+
+    // A client that never finishes its request times out instead of holding up the server
+    auto const incomplete_request_response{send_request(R"(["c: 3")", false)};
+    REQUIRE(incomplete_request_response.has_value());
+    REQUIRE(incomplete_request_response->starts_with(error_status_prefix));
+    REQUIRE((std::string::npos != incomplete_request_response->find("Timed out")));
+
+    // The server keeps serving after a timeout
+    auto const last_response{send_request("[]\n", false)};
+    REQUIRE(last_response.has_value());
+    REQUIRE((fmt::format("{}\n", success_status_line) == last_response.value()));
+
+    REQUIRE(server_thread.stop());
+
+    std::vector<std::vector<std::string>> const expected_search_args{
+            {"archive-dir", "a: 1"},
+            {"b: 2"},
+            {"fail"},
+            {}
+    };
+    REQUIRE((expected_search_args == served_search_args));
+}
@@ -0,0 +1,89 @@
+#include <cstdint>
+#include <string_view>
+#include <utility>
+
+#include <catch2/catch_test_macros.hpp>
+
+#include "../src/clp_s/Defs.hpp"
+#include "../src/clp_s/TimestampDictionaryWriter.hpp"
+
+namespace {
+constexpr std::string_view cTimestampKey{"timestamp"};
+constexpr int32_t cTimestampNodeId{1};
+
+constexpr std::string_view cDashedTimestamp{"2024-01-02 03:04:05"};
+constexpr std::string_view cNextDashedTimestamp{"2024-01-02 03:04:06"};
+constexpr std::string_view cBracketedTimestamp{"[2024-01-02 03:04:05]"};
+constexpr std::string_view cQuotedTimestamp{R"("2024-01-02 03:04:05")"};
+constexpr clp_s::epochtime_t cEpochTimestamp{1'704'164'645'000'000'000};
+constexpr clp_s::epochtime_t cNextEpochTimestamp{1'704'164'646'000'000'000};
+constexpr clp_s::epochtime_t cNanosecondsInMillisecond{1'000'000};
+}  // namespace
+
+TEST_CASE("clp-s-timestamp-dictionary-writer", "[clp-s][TimestampDictionaryWriter]") {
+    clp_s::TimestampDictionaryWriter writer;
+    auto const ingest = [&](std::string_view timestamp, bool is_json_literal) {
+        return writer.ingest_string_timestamp(
+                cTimestampKey,
+                cTimestampNodeId,
+                timestamp,
+                is_json_literal
+        );
+    };
+
+    SECTION("A column alternating between two formats parses each value with its own pattern") {
+        auto const dashed_result{ingest(cDashedTimestamp, false)};
+        auto const bracketed_result{ingest(cBracketedTimestamp, false)};
+        REQUIRE((cEpochTimestamp == dashed_result.first));
+        REQUIRE((cEpochTimestamp == bracketed_result.first));
+        REQUIRE((dashed_result.second != bracketed_result.second));
+
+        for (int i{0}; i < 3; ++i) {
+            REQUIRE((dashed_result == ingest(cDashedTimestamp, false)));
+            REQUIRE((bracketed_result == ingest(cBracketedTimestamp, false)));
+        }
+
+        // A new value in the first format reuses its pattern instead of adding one
+        auto const next_dashed_result{ingest(cNextDashedTimestamp, false)};
+        REQUIRE((std::make_pair(cNextEpochTimestamp, dashed_result.second) == next_dashed_result));
+
+        // Every value, including the repeated ones, is added to the column's time range
+        REQUIRE((cEpochTimestamp / cNanosecondsInMillisecond == writer.get_begin_timestamp()));
+        REQUIRE((cNextEpochTimestamp / cNanosecondsInMillisecond == writer.get_end_timestamp()));
+    }
+
+    SECTION("An exact repeat that isn't a JSON literal isn't served from the last value") {
+        // Quoted patterns only match the quotes of JSON literals, so the same text can't be parsed
+        // once it isn't a JSON literal
+        REQUIRE((cEpochTimestamp == ingest(cQuotedTimestamp, true).first));
+        REQUIRE_THROWS_AS(
+                ingest(cQuotedTimestamp, false),
+                clp_s::TimestampDictionaryWriter::OperationFailed
+        );
+        REQUIRE((cEpochTimestamp == ingest(cQuotedTimestamp, true).first));
+    }
+
+    SECTION("An exact repeat that is a JSON literal isn't served from the last value") {
+        REQUIRE((cEpochTimestamp == ingest(cDashedTimestamp, false).first));
+        REQUIRE_THROWS_AS(
+                ingest(cDashedTimestamp, true),
+                clp_s::TimestampDictionaryWriter::OperationFailed
+        );
+    }
+
+    SECTION("Clearing the writer resets each column's state") {
+        auto const dashed_result{ingest(cDashedTimestamp, false)};
+        auto const bracketed_result{ingest(cBracketedTimestamp, false)};
+        REQUIRE((0 == dashed_result.second));
+        REQUIRE((1 == bracketed_result.second));
+
+        writer.clear();
+
+        // The repeated value must be parsed again so that its pattern is added to the new
+        // dictionary, with a new ID
+        auto const new_bracketed_result{ingest(cBracketedTimestamp, false)};
+        REQUIRE((std::make_pair(cEpochTimestamp, uint64_t{0}) == new_bracketed_result));
+        auto const new_dashed_result{ingest(cDashedTimestamp, false)};
+        REQUIRE((std::make_pair(cEpochTimestamp, uint64_t{1}) == new_dashed_result));
+    }
+}
@@ -18,6 +18,7 @@ using glt::ir::is_delim;
 using glt::streaming_archive::reader::Archive;
 using glt::streaming_archive::reader::File;
 using glt::streaming_archive::reader::Message;
+using glt::streaming_archive::reader::SingleLogtypeTableManager;
 using std::string;
 using std::vector;
 
@@ -1056,6 +1057,7 @@ size_t Grep::search_segment_and_output(
         Query const& query,
         size_t limit,
         Archive& archive,
+        SingleLogtypeTableManager& logtype_table_manager,
         OutputFunc output_func,
         void* output_func_arg
 ) {
@@ -1066,29 +1068,58 @@ size_t Grep::search_segment_and_output(
 
     // Go through each logtype
     for (auto const& query_for_logtype : queries) {
-        size_t logtype_matches = 0;
-        // preload the data
+        if (num_matches >= limit) {
+            break;
+        }
+
+        // preload the timestamps and variable columns
         auto logtype_id = query_for_logtype.get_logtype_id();
         auto const& sub_queries = query_for_logtype.get_queries();
-        auto& logtype_table_manager = archive.get_logtype_table_manager();
         logtype_table_manager.open_logtype_table(logtype_id);
-        logtype_table_manager.load_all();
         auto num_vars = archive.get_logtype_dictionary().get_entry(logtype_id).get_num_variables();
+        logtype_table_manager.load_ts();
+        logtype_table_manager.load_partial_columns(0, num_vars);
+
+        // Find matching messages a column at a time
+        std::vector<size_t> matched_row_ix;
+        std::vector<bool> wildcard_required;
+        archive.find_messages_matching_with_logtype_query_by_column(
+                logtype_table_manager,
+                sub_queries,
+                matched_row_ix,
+                wildcard_required,
+                query
+        );
+
+        size_t const num_potential_matches = matched_row_ix.size();
+        if (0 == num_potential_matches) {
+            logtype_table_manager.close_logtype_table();
+            continue;
+        }
+
+        // Only load the remaining data of the matching rows
+        std::vector<epochtime_t> loaded_ts(num_potential_matches);
+        std::vector<file_id_t> loaded_file_id(num_potential_matches);
+        std::vector<encoded_variable_t> loaded_vars(num_potential_matches * num_vars);
+        logtype_table_manager.logtype_table().load_remaining_data_into_vec(
+                loaded_ts,
+                loaded_file_id,
+                loaded_vars,
+                matched_row_ix
+        );
+
         compressed_msg.resize_var(num_vars);
         compressed_msg.set_logtype_id(logtype_id);
-
-        while (num_matches < limit) {
-            // Find matching message
-            bool required_wild_card = false;
-            bool found_matched = archive.find_message_matching_with_logtype_query(
-                    sub_queries,
-                    compressed_msg,
-                    required_wild_card,
-                    query
+        auto& compressed_msg_vars = compressed_msg.get_writable_vars();
+        for (size_t ix = 0; ix < num_potential_matches && num_matches < limit; ++ix) {
+            compressed_msg.set_timestamp(loaded_ts[ix]);
+            compressed_msg.set_file_id(loaded_file_id[ix]);
+            std::copy_n(
+                    loaded_vars.cbegin() + ix * num_vars,
+                    num_vars,
+                    compressed_msg_vars.begin()
             );
-            if (found_matched == false) {
-                break;
-            }
+
             // Decompress match
             bool decompress_successful = archive.decompress_message_with_fixed_timestamp_pattern(
                     compressed_msg,
@@ -1102,7 +1133,7 @@ size_t Grep::search_segment_and_output(
             // Check if:
             // - Sub-query requires wildcard match, or
             // - no subqueries exist and the search string is not a match-all
-            if ((query.contains_sub_queries() && required_wild_card)
+            if ((query.contains_sub_queries() && wildcard_required[ix])
                 || (query.contains_sub_queries() == false
                     && query.search_string_matches_all() == false))
             {
@@ -1118,10 +1149,9 @@ size_t Grep::search_segment_and_output(
             std::string orig_file_path = archive.get_file_name(compressed_msg.get_file_id());
             // Print match
             output_func(orig_file_path, compressed_msg, decompressed_msg, output_func_arg);
-            ++logtype_matches;
+            ++num_matches;
         }
         logtype_table_manager.close_logtype_table();
-        num_matches += logtype_matches;
     }
 
     return num_matches;
@@ -1133,6 +1163,7 @@ size_t Grep::search_combined_table_and_output(
         Query const& query,
         size_t limit,
         Archive& archive,
+        SingleLogtypeTableManager& logtype_table_manager,
         OutputFunc output_func,
         void* output_func_arg
 ) {
@@ -1140,7 +1171,6 @@ size_t Grep::search_combined_table_and_output(
 
     Message compressed_msg;
     string decompressed_msg;
-    auto& logtype_table_manager = archive.get_logtype_table_manager();
     logtype_table_manager.open_combined_table(table_id);
     for (auto const& iter : queries) {
         logtype_dictionary_id_t logtype_id = iter.get_logtype_id();
@@ -1160,6 +1190,7 @@ size_t Grep::search_combined_table_and_output(
         while (num_matches < limit) {
             // Find matching message
             bool found_matched = archive.find_message_matching_with_logtype_query_from_combined(
+                    logtype_table_manager,
                     queries_by_logtype,
                     compressed_msg,
                     required_wild_card,
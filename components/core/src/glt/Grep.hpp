@@ -119,11 +119,13 @@ public:
 
     /**
      * Searches the segment with the given queries and outputs any results using the given method
-     * This method doesn't do any column based optimizations
+     * Each logtype table's variables are matched a column at a time, and only the matching rows
+     * are decompressed
      * @param queries
      * @param limit
      * @param query
      * @param archive
+     * @param logtype_table_manager The manager (or view) of the segment to open the tables with
      * @param output_func
      * @param output_func_arg
      * @return Number of matches found
@@ -136,16 +138,34 @@ public:
             Query const& query,
             size_t limit,
             streaming_archive::reader::Archive& archive,
+            streaming_archive::reader::SingleLogtypeTableManager& logtype_table_manager,
             OutputFunc output_func,
             void* output_func_arg
     );
 
+    /**
+     * Searches a combined table of the segment with the given queries and outputs any results
+     * using the given method
+     * @param table_id
+     * @param queries
+     * @param query
+     * @param limit
+     * @param archive
+     * @param logtype_table_manager The manager (or view) of the segment to open the table with
+     * @param output_func
+     * @param output_func_arg
+     * @return Number of matches found
+     * @throw streaming_archive::reader::Archive::OperationFailed if decompression unexpectedly
+     * fails
+     * @throw TimestampPattern::OperationFailed if failed to insert timestamp into message
+     */
     static size_t search_combined_table_and_output(
             combined_table_id_t table_id,
             std::vector<LogtypeQueries> const& queries,
             Query const& query,
             size_t limit,
             streaming_archive::reader::Archive& archive,
+            streaming_archive::reader::SingleLogtypeTableManager& logtype_table_manager,
             OutputFunc output_func,
             void* output_func_arg
     );
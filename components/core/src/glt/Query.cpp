@@ -1,5 +1,7 @@
 #include "Query.hpp"
 
+#include <algorithm>
+
 using std::set;
 using std::string;
 using std::unordered_set;
@@ -27,6 +29,10 @@ static void inplace_set_intersection(SetType const& a, SetType& b) {
 
 namespace glt {
 namespace {
+// Imprecise variables with at most this many possible values are matched by comparing against each
+// value, which the compiler can vectorize, rather than by a hash set lookup per variable
+constexpr size_t cMaxPossibleDictVarsToCompare = 16;
+
 bool matches_var(
         std::vector<encoded_variable_t> const& logtype_vars,
         std::vector<QueryVar> const& query_vars,
@@ -100,6 +106,25 @@ bool QueryVar::matches(encoded_variable_t var) const {
            || (!m_is_precise_var && m_possible_dict_vars.count(var) > 0);
 }
 
+void QueryVar::matches(encoded_variable_t const* vars, size_t num_vars, uint8_t* matches) const {
+    if (m_is_precise_var) {
+        for (size_t ix = 0; ix < num_vars; ++ix) {
+            matches[ix] = (m_precise_var == vars[ix]);
+        }
+    } else if (m_possible_dict_vars.size() <= cMaxPossibleDictVarsToCompare) {
+        std::fill_n(matches, num_vars, 0);
+        for (auto const possible_dict_var : m_possible_dict_vars) {
+            for (size_t ix = 0; ix < num_vars; ++ix) {
+                matches[ix] |= (possible_dict_var == vars[ix]);
+            }
+        }
+    } else {
+        for (size_t ix = 0; ix < num_vars; ++ix) {
+            matches[ix] = (m_possible_dict_vars.count(vars[ix]) > 0);
+        }
+    }
+}
+
 void QueryVar::remove_segments_that_dont_contain_dict_var(set<segment_id_t>& segment_ids) const {
     if (false == m_is_dict_var) {
         // Not a dictionary variable, so do nothing
@@ -220,4 +245,52 @@ void Query::make_sub_queries_relevant_to_segment(segment_id_t segment_id) {
 bool LogtypeQuery::matches_vars(std::vector<encoded_variable_t> const& vars) const {
     return matches_var(vars, m_vars, 0, 0);
 }
+
+void LogtypeQuery::matches_vars(
+        std::vector<encoded_variable_t const*> const& columns,
+        size_t num_rows,
+        std::vector<uint8_t>& row_matches
+) const {
+    size_t const num_query_vars = m_vars.size();
+    size_t const num_columns = columns.size();
+    if (num_columns < num_query_vars) {
+        // Not enough variables to satisfy query
+        row_matches.assign(num_rows, 0);
+        return;
+    }
+
+    // Like matches_var, greedily match the query's variables to each row's variables in order, but
+    // advance every row through one column at a time. num_matched_vars[row] is the index of the
+    // next query variable the row has to match.
+    std::vector<uint32_t> num_matched_vars(num_rows, 0);
+    std::vector<uint8_t> var_matches(num_rows);
+    for (size_t column_ix = 0; column_ix < num_columns; ++column_ix) {
+        // At this column, a row can only be matching a query variable that has enough preceding
+        // columns for the query variables before it, and enough remaining columns for the query
+        // variables after it
+        size_t const remaining_num_columns = num_columns - column_ix;
+        size_t const min_query_var_ix = num_query_vars > remaining_num_columns
+                                                ? num_query_vars - remaining_num_columns
+                                                : 0;
+        size_t const max_query_var_ix = std::min(column_ix + 1, num_query_vars);
+
+        // Visit the query variables in descending order so that a row which matches one doesn't
+        // also get matched against the next one in the same column
+        auto const* column = columns[column_ix];
+        for (size_t query_var_ix = max_query_var_ix; query_var_ix > min_query_var_ix;) {
+            --query_var_ix;
+            m_vars[query_var_ix].matches(column, num_rows, var_matches.data());
+            for (size_t row_ix = 0; row_ix < num_rows; ++row_ix) {
+                num_matched_vars[row_ix] += static_cast<uint32_t>(
+                        (num_matched_vars[row_ix] == query_var_ix) & var_matches[row_ix]
+                );
+            }
+        }
+    }
+
+    row_matches.resize(num_rows);
+    for (size_t row_ix = 0; row_ix < num_rows; ++row_ix) {
+        row_matches[row_ix] = (num_matched_vars[row_ix] == num_query_vars);
+    }
+}
 }  // namespace glt
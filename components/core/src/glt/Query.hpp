@@ -1,6 +1,7 @@
 #ifndef GLT_QUERY_HPP
 #define GLT_QUERY_HPP
 
+#include <cstdint>
 #include <set>
 #include <string>
 #include <unordered_set>
@@ -32,6 +33,13 @@ public:
      * @return true if matched, false otherwise
      */
     bool matches(encoded_variable_t var) const;
+    /**
+     * Checks which of the given encoded variables match this QueryVar
+     * @param vars
+     * @param num_vars
+     * @param matches Returns 1 for each variable that matches and 0 otherwise
+     */
+    void matches(encoded_variable_t const* vars, size_t num_vars, uint8_t* matches) const;
 
     /**
      * Removes segments from the given set that don't contain the given variable
@@ -242,6 +250,17 @@ public:
      * @return true if matched, false otherwise
      */
     bool matches_vars(std::vector<encoded_variable_t> const& vars) const;
+    /**
+     * Column-at-a-time version of matches_vars which checks every row of a logtype table at once
+     * @param columns The table's variable columns, each containing num_rows variables
+     * @param num_rows
+     * @param row_matches Returns 1 for each row whose variables match and 0 otherwise
+     */
+    void matches_vars(
+            std::vector<encoded_variable_t const*> const& columns,
+            size_t num_rows,
+            std::vector<uint8_t>& row_matches
+    ) const;
 
     bool get_wildcard_flag() const { return m_wildcard_match_required; }
 
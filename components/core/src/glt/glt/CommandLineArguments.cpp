@@ -409,11 +409,22 @@ CommandLineArguments::parse_arguments(int argc, char const* argv[]) {
                     "Ignore case distinctions in both WILDCARD STRING and the input files"
             );
 
+            // Define performance options
+            po::options_description options_performance("Performance Options");
+            options_performance.add_options()(
+                    "num-threads",
+                    po::value<size_t>(&m_num_threads)
+                            ->value_name("NUM")
+                            ->default_value(m_num_threads),
+                    "Number of threads to search each segment's tables with"
+            );
+
             // Define visible options
             po::options_description visible_options;
             visible_options.add(options_general);
             visible_options.add(options_search_input);
             visible_options.add(options_match_control);
+            visible_options.add(options_performance);
 
             // Define hidden positional options (not shown in Boost's program options help message)
             po::options_description hidden_positional_options;
@@ -439,6 +450,7 @@ CommandLineArguments::parse_arguments(int argc, char const* argv[]) {
             all_search_options.add(options_general);
             all_search_options.add(options_search_input);
             all_search_options.add(options_match_control);
+            all_search_options.add(options_performance);
             all_search_options.add(hidden_positional_options);
 
             vector<string> unrecognized_options
@@ -483,6 +495,10 @@ CommandLineArguments::parse_arguments(int argc, char const* argv[]) {
                 throw invalid_argument("Wildcard string not specified or empty.");
             }
 
+            if (0 == m_num_threads) {
+                throw invalid_argument("num-threads must be non-zero.");
+            }
+
             // Validate timestamp range and compute m_search_begin_ts and m_search_end_ts
             if (parsed_command_line_options.count("teq")) {
                 if (parsed_command_line_options.count("tgt")
@@ -39,7 +39,8 @@ public:
               m_ignore_case(false),
               m_output_method(OutputMethod::StdoutText),
               m_search_begin_ts(cEpochTimeMin),
-              m_search_end_ts(cEpochTimeMax) {}
+              m_search_end_ts(cEpochTimeMax),
+              m_num_threads(1) {}
 
     // Methods
     ParsingResult parse_arguments(int argc, char const* argv[]) override;
@@ -91,6 +92,8 @@ public:
 
     epochtime_t get_search_end_ts() const { return m_search_end_ts; }
 
+    size_t get_num_threads() const { return m_num_threads; }
+
 private:
     // Methods
     void print_basic_usage() const override;
@@ -121,6 +124,7 @@ private:
     std::string m_file_path;
     OutputMethod m_output_method;
     epochtime_t m_search_begin_ts, m_search_end_ts;
+    size_t m_num_threads;
 };
 }  // namespace glt::glt
 
@@ -2,9 +2,15 @@
 
 #include <sys/stat.h>
 
+#include <algorithm>
+#include <atomic>
 #include <cstring>
+#include <exception>
 #include <filesystem>
+#include <functional>
 #include <iostream>
+#include <mutex>
+#include <thread>
 
 #include <spdlog/sinks/stdout_sinks.h>
 
@@ -30,6 +36,7 @@ using glt::streaming_archive::MetadataDB;
 using glt::streaming_archive::reader::Archive;
 using glt::streaming_archive::reader::File;
 using glt::streaming_archive::reader::Message;
+using glt::streaming_archive::reader::SingleLogtypeTableManager;
 using glt::TraceableException;
 using std::cerr;
 using std::cout;
@@ -38,6 +45,59 @@ using std::string;
 using std::vector;
 
 namespace glt::glt {
+namespace {
+/**
+ * Serializes the calls to an output function, so that it can be shared by threads searching a
+ * segment concurrently
+ */
+class SynchronizedOutput {
+public:
+    // Constructors
+    SynchronizedOutput(Grep::OutputFunc output_func, void* output_func_arg)
+            : m_output_func(output_func),
+              m_output_func_arg(output_func_arg) {}
+
+    // Methods
+    /**
+     * Grep::OutputFunc that forwards the search result to the wrapped output function
+     * @param orig_file_path
+     * @param compressed_msg
+     * @param decompressed_msg
+     * @param custom_arg The SynchronizedOutput
+     */
+    static void output(
+            string const& orig_file_path,
+            Message const& compressed_msg,
+            string const& decompressed_msg,
+            void* custom_arg
+    ) {
+        auto& synchronized_output = *static_cast<SynchronizedOutput*>(custom_arg);
+        std::lock_guard<std::mutex> lock(synchronized_output.m_mutex);
+        synchronized_output.m_output_func(
+                orig_file_path,
+                compressed_msg,
+                decompressed_msg,
+                synchronized_output.m_output_func_arg
+        );
+    }
+
+private:
+    // Variables
+    Grep::OutputFunc m_output_func;
+    void* m_output_func_arg;
+    std::mutex m_mutex;
+};
+
+/**
+ * Searches one or more tables of a segment using the given logtype table manager and output method
+ * @return The number of matches found
+ */
+using TableSearchTask = std::function<
+        size_t(SingleLogtypeTableManager& logtype_table_manager,
+               Grep::OutputFunc output_func,
+               void* output_func_arg)>;
+}  // namespace
+
 /**
  * Opens the archive and reads the dictionaries
  * @param archive_path
@@ -46,18 +106,40 @@ namespace glt::glt {
  */
 static bool open_archive(string const& archive_path, Archive& archive_reader);
 /**
- * To update
+ * Searches the segment opened by the archive's logtype table manager. Each single logtype table
+ * and each combined table is searched as a separate task, and the tasks are run by the given number
+ * of threads, each with its own view of the segment.
  * @param queries
  * @param output_method
  * @param archive
  * @param segment_id
+ * @param num_threads
  * @return The total number of matches found across all files
  */
 static size_t search_segments(
         vector<Query>& queries,
         CommandLineArguments::OutputMethod output_method,
         Archive& archive,
-        size_t segment_id
+        size_t segment_id,
+        size_t num_threads
+);
+/**
+ * Runs the given table search tasks with up to the given number of threads. If only one thread is
+ * used, the tasks run in order using the archive's logtype table manager.
+ * @param tasks
+ * @param archive
+ * @param num_threads
+ * @param output_func
+ * @param output_func_arg
+ * @return The total number of matches found by the tasks
+ * @throw Any exception thrown by a task
+ */
+static size_t run_table_search_tasks(
+        vector<TableSearchTask> const& tasks,
+        Archive& archive,
+        size_t num_threads,
+        Grep::OutputFunc output_func,
+        void* output_func_arg
 );
 /**
  * get all messages in the segment within query's time range
@@ -258,7 +340,8 @@ static bool search(
                             queries,
                             command_line_args.get_output_method(),
                             archive,
-                            segment_id
+                            segment_id,
+                            command_line_args.get_num_threads()
                     );
                     archive.close_logtype_table_manager();
                 }
@@ -335,7 +418,8 @@ static size_t search_segments(
         vector<Query>& queries,
         CommandLineArguments::OutputMethod const output_method,
         Archive& archive,
-        size_t segment_id
+        size_t segment_id,
+        size_t num_threads
 ) {
     size_t num_matches = 0;
 
@@ -373,28 +457,110 @@ static size_t search_segments(
                 combined_table_queires
         );
 
-        // first search through the single variable table
-        num_matches += Grep::search_segment_and_output(
-                single_table_queries,
-                query,
-                SIZE_MAX,
+        // Each single logtype table and each combined table can be searched independently
+        vector<TableSearchTask> tasks;
+        for (auto const& logtype_queries : single_table_queries) {
+            tasks.emplace_back([&, single_table_query = vector<LogtypeQueries>{logtype_queries}](
+                                       SingleLogtypeTableManager& logtype_table_manager,
+                                       Grep::OutputFunc task_output_func,
+                                       void* task_output_func_arg
+                               ) {
+                return Grep::search_segment_and_output(
+                        single_table_query,
+                        query,
+                        SIZE_MAX,
+                        archive,
+                        logtype_table_manager,
+                        task_output_func,
+                        task_output_func_arg
+                );
+            });
+        }
+        for (auto const& [table_id, combined_logtype_queries] : combined_table_queires) {
+            tasks.emplace_back([&, table_id](
+                                       SingleLogtypeTableManager& logtype_table_manager,
+                                       Grep::OutputFunc task_output_func,
+                                       void* task_output_func_arg
+                               ) {
+                return Grep::search_combined_table_and_output(
+                        table_id,
+                        combined_logtype_queries,
+                        query,
+                        SIZE_MAX,
+                        archive,
+                        logtype_table_manager,
+                        task_output_func,
+                        task_output_func_arg
+                );
+            });
+        }
+        num_matches += run_table_search_tasks(
+                tasks,
                 archive,
+                num_threads,
                 output_func,
                 output_func_arg
         );
-        for (auto const& iter : combined_table_queires) {
-            combined_table_id_t table_id = iter.first;
-            auto const& combined_logtype_queries = iter.second;
-            num_matches += Grep::search_combined_table_and_output(
-                    table_id,
-                    combined_logtype_queries,
-                    query,
-                    SIZE_MAX,
-                    archive,
-                    output_func,
-                    output_func_arg
-            );
+    }
+    return num_matches;
+}
+
+static size_t run_table_search_tasks(
+        vector<TableSearchTask> const& tasks,
+        Archive& archive,
+        size_t num_threads,
+        Grep::OutputFunc output_func,
+        void* output_func_arg
+) {
+    size_t const num_threads_to_use = std::min(num_threads, tasks.size());
+    if (num_threads_to_use <= 1) {
+        size_t num_matches = 0;
+        for (auto const& task : tasks) {
+            num_matches += task(archive.get_logtype_table_manager(), output_func, output_func_arg);
         }
+        return num_matches;
+    }
+
+    SynchronizedOutput synchronized_output(output_func, output_func_arg);
+    std::atomic_size_t next_task_ix{0};
+    std::atomic_size_t num_matches{0};
+    std::mutex first_exception_mutex;
+    std::exception_ptr first_exception;
+    auto run_tasks = [&]() {
+        SingleLogtypeTableManager logtype_table_manager;
+        try {
+            logtype_table_manager.open_view(archive.get_logtype_table_manager());
+            for (auto task_ix = next_task_ix++; task_ix < tasks.size(); task_ix = next_task_ix++) {
+                num_matches += tasks[task_ix](
+                        logtype_table_manager,
+                        SynchronizedOutput::output,
+                        &synchronized_output
+                );
+            }
+        } catch (...) {
+            std::lock_guard<std::mutex> lock(first_exception_mutex);
+            if (nullptr == first_exception) {
+                first_exception = std::current_exception();
+            }
+            // Stop the other threads from claiming more tasks
+            next_task_ix = tasks.size();
+        }
+        logtype_table_manager.close();
+    };
+
+    // The current thread also runs tasks
+    vector<std::thread> threads;
+    threads.reserve(num_threads_to_use - 1);
+    for (size_t i = 1; i < num_threads_to_use; ++i) {
+        threads.emplace_back(run_tasks);
+    }
+    run_tasks();
+    for (auto& thread : threads) {
+        thread.join();
+    }
+
+    if (nullptr != first_exception) {
+        std::rethrow_exception(first_exception);
     }
     return num_matches;
 }
@@ -21,6 +21,7 @@ constexpr char cSchemaFileName[] = "schema.txt";
 
 namespace cMetadataDB {
 constexpr char ArchivesTableName[] = "archives";
+constexpr char ArchivesTimeIndexTableName[] = "archives_time_index";
 constexpr char FilesTableName[] = "files";
 constexpr char EmptyDirectoriesTableName[] = "empty_directories";
 
@@ -34,6 +35,13 @@ constexpr char CreatorId[] = "creator_id";
 constexpr char CreationIx[] = "creation_ix";
 }  // namespace Archive
 
+namespace ArchiveTimeIndex {
+constexpr char Id[] = "id";
+constexpr char BeginTimestamp[] = "begin_timestamp";
+constexpr char EndTimestamp[] = "end_timestamp";
+constexpr char ArchiveId[] = "archive_id";
+}  // namespace ArchiveTimeIndex
+
 namespace File {
 constexpr char Id[] = "id";
 constexpr char OrigFileId[] = "orig_file_id";
@@ -2,6 +2,7 @@
 
 #include <sys/stat.h>
 
+#include <cstdint>
 #include <cstring>
 #include <fstream>
 #include <vector>
@@ -333,6 +334,7 @@ void Archive::update_valid_segment_ids() {
 }
 
 bool Archive::find_message_matching_with_logtype_query_from_combined(
+        SingleLogtypeTableManager& logtype_table_manager,
         std::vector<LogtypeQuery> const& logtype_query,
         Message& msg,
         bool& wildcard,
@@ -340,7 +342,7 @@ bool Archive::find_message_matching_with_logtype_query_from_combined(
         size_t left_boundary,
         size_t right_boundary
 ) {
-    auto& combined_tables = m_logtype_table_manager.combined_tables();
+    auto& combined_tables = logtype_table_manager.combined_tables();
     while (true) {
         // break if there's no next message
         if (!combined_tables.get_next_message_partial(msg, left_boundary, right_boundary)) {
@@ -418,6 +420,55 @@ void Archive::find_message_matching_with_logtype_query_optimized(
     }
 }
 
+void Archive::find_messages_matching_with_logtype_query_by_column(
+        SingleLogtypeTableManager& logtype_table_manager,
+        std::vector<LogtypeQuery> const& logtype_query,
+        std::vector<size_t>& matched_rows,
+        std::vector<bool>& wildcard,
+        Query const& query
+) {
+    auto const& logtype_table = logtype_table_manager.logtype_table();
+    size_t const num_rows = logtype_table.get_num_row();
+    size_t const num_columns = logtype_table.get_num_column();
+    std::vector<encoded_variable_t const*> columns(num_columns);
+    for (size_t column_ix = 0; column_ix < num_columns; ++column_ix) {
+        columns[column_ix] = logtype_table.get_column(column_ix);
+    }
+
+    // Only rows in the search time range need to be matched
+    std::vector<uint8_t> unmatched_rows(num_rows);
+    auto const* timestamps = logtype_table.get_timestamps();
+    size_t num_unmatched_rows = 0;
+    for (size_t row_ix = 0; row_ix < num_rows; ++row_ix) {
+        unmatched_rows[row_ix] = query.timestamp_is_in_search_time_range(timestamps[row_ix]);
+        num_unmatched_rows += unmatched_rows[row_ix];
+    }
+
+    // Each row takes its wildcard flag from the first sub-query that it matches
+    std::vector<LogtypeQuery const*> matching_sub_queries(num_rows, nullptr);
+    std::vector<uint8_t> row_matches;
+    for (auto const& possible_sub_query : logtype_query) {
+        if (0 == num_unmatched_rows) {
+            break;
+        }
+        possible_sub_query.matches_vars(columns, num_rows, row_matches);
+        for (size_t row_ix = 0; row_ix < num_rows; ++row_ix) {
+            if (unmatched_rows[row_ix] && row_matches[row_ix]) {
+                matching_sub_queries[row_ix] = &possible_sub_query;
+                unmatched_rows[row_ix] = 0;
+                --num_unmatched_rows;
+            }
+        }
+    }
+
+    for (size_t row_ix = 0; row_ix < num_rows; ++row_ix) {
+        if (nullptr != matching_sub_queries[row_ix]) {
+            matched_rows.push_back(row_ix);
+            wildcard.push_back(matching_sub_queries[row_ix]->get_wildcard_flag());
+        }
+    }
+}
+
 size_t Archive::decompress_messages_and_output(
         logtype_dictionary_id_t logtype_id,
         std::vector<epochtime_t>& ts,
@@ -172,7 +172,42 @@ public:
             std::vector<bool>& wildcard,
             Query const& query
     );
+    /**
+     * This functions assumes a specific logtype table is loaded with all its timestamps and
+     * variable columns. The function takes in all logtype_query associated with the logtype, and
+     * matches each query variable against a whole column at a time, rather than matching a row at
+     * a time.
+     *
+     * @param logtype_table_manager The manager with the loaded logtype table
+     * @param logtype_query
+     * @param matched_rows Returns the indices of the matching rows, in ascending order
+     * @param wildcard Returns, for each matching row, whether it still requires wildcard match
+     * @param query (to provide time range info)
+     */
+    void find_messages_matching_with_logtype_query_by_column(
+            SingleLogtypeTableManager& logtype_table_manager,
+            std::vector<LogtypeQuery> const& logtype_query,
+            std::vector<size_t>& matched_rows,
+            std::vector<bool>& wildcard,
+            Query const& query
+    );
+    /**
+     * This functions assumes a specific logtype table is loaded from a combined table with the
+     * given manager. The function takes in all logtype_query associated with the logtype, and finds
+     * the next matching message in the table
+     *
+     * @param logtype_table_manager The manager with the loaded combined table
+     * @param logtype_query
+     * @param msg
+     * @param wildcard (by reference)
+     * @param query (to provide time range info)
+     * @param left
+     * @param right
+     * @return Return true if a matching message is found. wildcard gets set to true if the matching
+     * message still requires wildcard match
+     */
     bool find_message_matching_with_logtype_query_from_combined(
+            SingleLogtypeTableManager& logtype_table_manager,
             std::vector<LogtypeQuery> const& logtype_query,
             Message& msg,
             bool& wildcard,
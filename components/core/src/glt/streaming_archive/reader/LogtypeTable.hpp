@@ -45,6 +45,19 @@ public:
 
     size_t get_num_column() const { return m_num_columns; }
 
+    /**
+     * @return The loaded timestamps, one per row
+     */
+    epochtime_t const* get_timestamps() const { return m_timestamps.data(); }
+
+    /**
+     * @param column_ix
+     * @return The loaded variables of the given column, one per row
+     */
+    encoded_variable_t const* get_column(size_t column_ix) const {
+        return m_column_based_variables.data() + column_ix * m_num_row;
+    }
+
     /**
      * Get next row in the loaded 2D variable columns and load timestamp, file_id and variables into
      * the msg
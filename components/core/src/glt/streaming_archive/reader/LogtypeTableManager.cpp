@@ -14,13 +14,40 @@ void LogtypeTableManager::open(std::string const& segment_path) {
     m_is_open = true;
 }
 
+void LogtypeTableManager::open_view(LogtypeTableManager const& manager) {
+    if (m_is_open) {
+        throw OperationFailed(ErrorCode_Failure, __FILENAME__, __LINE__);
+    }
+    if (!manager.m_is_open) {
+        throw OperationFailed(ErrorCode_NotInit, __FILENAME__, __LINE__);
+    }
+    m_var_column_directory_path = manager.m_var_column_directory_path;
+    m_logtype_table_metadata = manager.m_logtype_table_metadata;
+    m_combined_tables_metadata = manager.m_combined_tables_metadata;
+    m_combined_table_info = manager.m_combined_table_info;
+    m_logtype_table_order = manager.m_logtype_table_order;
+    m_combined_table_order = manager.m_combined_table_order;
+    m_combined_table_count = manager.m_combined_table_count;
+    // Copies of a mapped file share the same mapping
+    m_memory_mapped_segment_file = manager.m_memory_mapped_segment_file;
+    m_is_view = true;
+    m_is_open = true;
+}
+
 void LogtypeTableManager::close() {
     // GLT TODO
     // if(!m_is_open) {
     //     throw OperationFailed(ErrorCode_NotInit, __FILENAME__, __LINE__);
     // }
     m_is_open = false;
-    m_memory_mapped_segment_file.close();
+    if (m_is_view) {
+        // Closing the shared mapping would unmap it for the manager this view was opened from, so
+        // only release this view's reference to it
+        m_memory_mapped_segment_file = boost::iostreams::mapped_file_source();
+        m_is_view = false;
+    } else {
+        m_memory_mapped_segment_file.close();
+    }
     m_logtype_table_metadata.clear();
     m_var_column_directory_path.clear();
     m_logtype_table_order.clear();
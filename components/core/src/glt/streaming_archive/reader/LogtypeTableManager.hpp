@@ -24,7 +24,7 @@ public:
         }
     };
 
-    LogtypeTableManager() : m_is_open(false) {}
+    LogtypeTableManager() : m_is_open(false), m_is_view(false) {}
 
     /**
      * Open the concated variable segment file and metadata associated with the segment
@@ -32,6 +32,15 @@ public:
      */
     virtual void open(std::string const& segment_path);
 
+    /**
+     * Opens a view of the segment opened by the given manager. The view shares the manager's memory
+     * mapped variable segment and copies its metadata, so that the two can open and read tables
+     * independently (e.g., from different threads). The view must be closed before the manager.
+     * @param manager
+     * @throw OperationFailed if this manager is already open or the given manager isn't open
+     */
+    void open_view(LogtypeTableManager const& manager);
+
     virtual void close();
 
     std::unordered_map<logtype_dictionary_id_t, LogtypeMetadata> const& get_metadata_map() {
@@ -63,6 +72,8 @@ protected:
     void load_variables_segment();
 
     bool m_is_open;
+    // Whether the memory mapped segment is shared with the manager this view was opened from
+    bool m_is_view;
     std::string m_var_column_directory_path;
     std::unordered_map<logtype_dictionary_id_t, LogtypeMetadata> m_logtype_table_metadata;
     std::unordered_map<logtype_dictionary_id_t, CombinedMetadata> m_combined_tables_metadata;
@@ -0,0 +1,52 @@
+#include "AggregateOperator.hpp"
+
+namespace reducer {
+void AggregateOperator::push_intra_stage_record_group(
+        GroupTags const& tags,
+        ConstRecordIterator& record_it
+) {
+    auto& group = m_groups[tags];
+
+    for (; false == record_it.done(); record_it.next()) {
+        auto const& record = record_it.get();
+        PartialAggregate partial;
+        partial.count = record.get_int64_value(
+                static_cast<char const*>(PartialAggregateRecordAdapter::cCountKey)
+        );
+        partial.sum = record.get_double_value(
+                static_cast<char const*>(PartialAggregateRecordAdapter::cSumKey)
+        );
+        partial.min = record.get_double_value(
+                static_cast<char const*>(PartialAggregateRecordAdapter::cMinKey)
+        );
+        partial.max = record.get_double_value(
+                static_cast<char const*>(PartialAggregateRecordAdapter::cMaxKey)
+        );
+        group.merge(partial);
+    }
+}
+
+void AggregateOperator::push_inter_stage_record_group(
+        GroupTags const& tags,
+        ConstRecordIterator& record_it
+) {
+    auto& group = m_groups[tags];
+
+    for (; false == record_it.done(); record_it.next()) {
+        group.add(record_it.get().get_double_value(m_value_key));
+    }
+}
+
+std::unique_ptr<RecordGroupIterator> AggregateOperator::get_stored_result_iterator() {
+    return std::make_unique<PartialAggregateMapRecordGroupIterator>(m_groups);
+}
+
+std::unique_ptr<RecordGroupIterator> AggregateOperator::get_stored_result_iterator(
+        std::set<GroupTags> const& filtered_tags
+) {
+    return std::make_unique<FilteredPartialAggregateMapRecordGroupIterator>(
+            m_groups,
+            filtered_tags
+    );
+}
+}  // namespace reducer
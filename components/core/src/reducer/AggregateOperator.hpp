@@ -0,0 +1,253 @@
+#ifndef REDUCER_AGGREGATEOPERATOR_HPP
+#define REDUCER_AGGREGATEOPERATOR_HPP
+
+#include <algorithm>
+#include <cstddef>
+#include <cstdint>
+#include <limits>
+#include <memory>
+#include <set>
+#include <string>
+#include <string_view>
+#include <utility>
+
+#include <absl/container/flat_hash_map.h>
+
+#include "ConstRecordIterator.hpp"
+#include "GroupTags.hpp"
+#include "Operator.hpp"
+#include "Record.hpp"
+#include "RecordGroup.hpp"
+#include "RecordGroupIterator.hpp"
+#include "RecordTypedKeyIterator.hpp"
+
+namespace reducer {
+/**
+ * The partial aggregate of the values in a record group. Partial aggregates of the same group can
+ * be merged, so each stage can reduce its input to one small record per group.
+ */
+struct PartialAggregate {
+    void add(double value) {
+        ++count;
+        sum += value;
+        min = std::min(min, value);
+        max = std::max(max, value);
+    }
+
+    void merge(PartialAggregate const& other) {
+        count += other.count;
+        sum += other.sum;
+        min = std::min(min, other.min);
+        max = std::max(max, other.max);
+    }
+
+    [[nodiscard]] double avg() const {
+        return 0 == count ? 0.0 : sum / static_cast<double>(count);
+    }
+
+    int64_t count{0};
+    double sum{0.0};
+    double min{std::numeric_limits<double>::infinity()};
+    double max{-std::numeric_limits<double>::infinity()};
+};
+
+/**
+ * Record implementation which exposes a PartialAggregate as five elements: "count" (Int64), and
+ * "sum", "min", "max", and "avg" (Double).
+ *
+ * The PartialAggregate can be updated allowing this class to act as an adapter for a larger set of
+ * data.
+ */
+class PartialAggregateRecordAdapter : public Record {
+public:
+    static constexpr char cCountKey[] = "count";
+    static constexpr char cSumKey[] = "sum";
+    static constexpr char cMinKey[] = "min";
+    static constexpr char cMaxKey[] = "max";
+    static constexpr char cAvgKey[] = "avg";
+
+    void set_record_value(PartialAggregate const* value) { m_value = value; }
+
+    [[nodiscard]] int64_t get_int64_value(std::string_view key) const override {
+        if (key == cCountKey) {
+            return m_value->count;
+        }
+        return 0;
+    }
+
+    [[nodiscard]] double get_double_value(std::string_view key) const override {
+        if (key == cSumKey) {
+            return m_value->sum;
+        }
+        if (key == cMinKey) {
+            return m_value->min;
+        }
+        if (key == cMaxKey) {
+            return m_value->max;
+        }
+        if (key == cAvgKey) {
+            return m_value->avg();
+        }
+        return 0.0;
+    }
+
+    [[nodiscard]] std::unique_ptr<RecordTypedKeyIterator> typed_key_iter() const override {
+        return std::make_unique<TypedKeyIterator>();
+    }
+
+private:
+    /**
+     * A RecordTypedKeyIterator over the elements of a PartialAggregateRecordAdapter.
+     */
+    class TypedKeyIterator : public RecordTypedKeyIterator {
+    public:
+        TypedRecordKey get() override {
+            if (0 == m_key_idx) {
+                return {cCountKey, ValueType::Int64};
+            }
+            return {cDoubleKeys[m_key_idx - 1], ValueType::Double};
+        }
+
+        void next() override { ++m_key_idx; }
+
+        bool done() override { return m_key_idx > std::size(cDoubleKeys); }
+
+    private:
+        static constexpr char const* cDoubleKeys[] = {cSumKey, cMinKey, cMaxKey, cAvgKey};
+
+        size_t m_key_idx{0};
+    };
+
+    PartialAggregate const* m_value{nullptr};
+};
+
+/**
+ * Operator that accumulates the count, sum, min, max, and average of a numeric element per record
+ * group. Groups are stored in a flat hash table since the operator only needs to look them up by
+ * their tags, not iterate them in order.
+ *
+ * Inter-stage records each contribute the value of their `value_key` element, read as a double.
+ * Intra-stage records must be partial aggregates as exposed by PartialAggregateRecordAdapter.
+ */
+class AggregateOperator : public Operator {
+public:
+    using GroupMap = absl::flat_hash_map<GroupTags, PartialAggregate>;
+
+    AggregateOperator() = default;
+
+    explicit AggregateOperator(std::string value_key) : m_value_key{std::move(value_key)} {}
+
+    /**
+     * Adds a single value to the given group. This lets callers that read values directly from
+     * their own storage aggregate them without wrapping each one in a Record.
+     * @param tags
+     * @param value
+     */
+    void add_value(GroupTags const& tags, double value) { m_groups[tags].add(value); }
+
+    [[nodiscard]] GroupMap const& get_groups() const { return m_groups; }
+
+    void
+    push_intra_stage_record_group(GroupTags const& tags, ConstRecordIterator& record_it) override;
+
+    void
+    push_inter_stage_record_group(GroupTags const& tags, ConstRecordIterator& record_it) override;
+
+    std::unique_ptr<RecordGroupIterator> get_stored_result_iterator() override;
+    std::unique_ptr<RecordGroupIterator> get_stored_result_iterator(
+            std::set<GroupTags> const& filtered_tags
+    ) override;
+
+private:
+    std::string m_value_key;
+    GroupMap m_groups;
+};
+
+/**
+ * A RecordGroupIterator that exposes a map which maps GroupTags to PartialAggregates.
+ */
+class PartialAggregateMapRecordGroupIterator : public RecordGroupIterator {
+public:
+    explicit PartialAggregateMapRecordGroupIterator(AggregateOperator::GroupMap const& map)
+            : m_group{nullptr, m_record},
+              m_map_it{map.cbegin()},
+              m_map_end_it{map.cend()} {}
+
+    RecordGroup& get() override {
+        m_record.set_record_value(&m_map_it->second);
+        m_group.set_tags(&m_map_it->first);
+        m_group.reset_record_iterator();
+        return m_group;
+    }
+
+    void next() override { ++m_map_it; }
+
+    bool done() override { return m_map_it == m_map_end_it; }
+
+private:
+    PartialAggregateRecordAdapter m_record;
+    SingleRecordGroup m_group;
+    AggregateOperator::GroupMap::const_iterator m_map_it;
+    AggregateOperator::GroupMap::const_iterator m_map_end_it;
+};
+
+/**
+ * A RecordGroupIterator that exposes a map which maps GroupTags to PartialAggregates, filtered by
+ * another set of GroupTags.
+ */
+class FilteredPartialAggregateMapRecordGroupIterator : public RecordGroupIterator {
+public:
+    FilteredPartialAggregateMapRecordGroupIterator(
+            AggregateOperator::GroupMap const& map,
+            std::set<GroupTags> const& filter
+    )
+            : m_group{nullptr, m_record},
+              m_map{map},
+              m_filter_it{filter.cbegin()},
+              m_filter_end_it{filter.cend()} {
+        advance_to_next_filter();
+    }
+
+    // Disable copy and move construction/assignment since m_map is a reference
+    FilteredPartialAggregateMapRecordGroupIterator(
+            FilteredPartialAggregateMapRecordGroupIterator const&
+    ) = delete;
+    FilteredPartialAggregateMapRecordGroupIterator(FilteredPartialAggregateMapRecordGroupIterator&&)
+            = delete;
+    FilteredPartialAggregateMapRecordGroupIterator& operator=(
+            FilteredPartialAggregateMapRecordGroupIterator const&
+    ) = delete;
+    FilteredPartialAggregateMapRecordGroupIterator& operator=(
+            FilteredPartialAggregateMapRecordGroupIterator&&
+    ) = delete;
+
+    RecordGroup& get() override {
+        m_record.set_record_value(&m_map_it->second);
+        m_group.set_tags(&m_map_it->first);
+        m_group.reset_record_iterator();
+        return m_group;
+    }
+
+    void next() override { advance_to_next_filter(); }
+
+    bool done() override { return m_map_it == m_map.cend(); }
+
+private:
+    void advance_to_next_filter() {
+        m_map_it = m_map.cend();
+        while (m_map_it == m_map.cend() && m_filter_it != m_filter_end_it) {
+            m_map_it = m_map.find(*m_filter_it);
+            ++m_filter_it;
+        }
+    }
+
+    PartialAggregateRecordAdapter m_record;
+    SingleRecordGroup m_group;
+    AggregateOperator::GroupMap const& m_map;
+    AggregateOperator::GroupMap::const_iterator m_map_it;
+    std::set<GroupTags>::const_iterator m_filter_it;
+    std::set<GroupTags>::const_iterator m_filter_end_it;
+};
+}  // namespace reducer
+
+#endif  // REDUCER_AGGREGATEOPERATOR_HPP
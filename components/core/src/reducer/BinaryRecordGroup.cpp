@@ -0,0 +1,362 @@
+#include "BinaryRecordGroup.hpp"
+
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <memory>
+#include <string_view>
+#include <vector>
+
+namespace reducer {
+namespace {
+/**
+ * A view of an element of a binary-encoded record.
+ */
+struct ElementView {
+    ValueType type;
+    std::string_view key;
+    // The element's encoded value
+    char const* value;
+    // The position just past the element
+    char const* end;
+};
+
+/**
+ * A RecordTypedKeyIterator over the elements of a binary-encoded record.
+ */
+class BinaryRecordTypedKeyIterator : public RecordTypedKeyIterator {
+public:
+    BinaryRecordTypedKeyIterator(char const* elements_begin, uint32_t num_elements);
+
+    TypedRecordKey get() override { return {m_element.key, m_element.type}; }
+
+    void next() override;
+
+    bool done() override { return 0 == m_num_elements_remaining; }
+
+private:
+    ElementView m_element{};
+    uint32_t m_num_elements_remaining;
+};
+
+/**
+ * Appends a fixed-width value to the buffer.
+ * @tparam T
+ * @param value
+ * @param buffer
+ */
+template <typename T>
+void append_value(T value, std::vector<char>& buffer);
+
+/**
+ * Appends a string to the buffer, preceded by its size.
+ * @param str
+ * @param buffer
+ */
+void append_string(std::string_view str, std::vector<char>& buffer);
+
+/**
+ * Reads a fixed-width value without checking the bounds of the buffer.
+ * @tparam T
+ * @param pos
+ * @return The value
+ */
+template <typename T>
+T read_value(char const* pos);
+
+/**
+ * Reads a fixed-width value and advances past it, checking that it lies within the buffer.
+ * @tparam T
+ * @param pos
+ * @param end
+ * @param value Returns the value
+ * @return Whether the value lies within the buffer
+ */
+template <typename T>
+bool read_value_checked(char const*& pos, char const* end, T& value);
+
+/**
+ * Skips a size-prefixed string, checking that it lies within the buffer.
+ * @param pos
+ * @param end
+ * @param str Returns the string
+ * @return Whether the string lies within the buffer
+ */
+bool read_string_checked(char const*& pos, char const* end, std::string_view& str);
+
+/**
+ * Reads an element without checking the bounds of the buffer.
+ * @param pos The position of the element
+ * @return A view of the element
+ */
+ElementView read_element(char const* pos);
+
+/**
+ * Skips an element, checking that it's well-formed and lies within the buffer.
+ * @param pos
+ * @param end
+ * @return Whether the element is valid
+ */
+bool skip_element_checked(char const*& pos, char const* end);
+
+BinaryRecordTypedKeyIterator::BinaryRecordTypedKeyIterator(
+        char const* elements_begin,
+        uint32_t num_elements
+)
+        : m_num_elements_remaining{num_elements} {
+    if (m_num_elements_remaining > 0) {
+        m_element = read_element(elements_begin);
+    }
+}
+
+void BinaryRecordTypedKeyIterator::next() {
+    --m_num_elements_remaining;
+    if (m_num_elements_remaining > 0) {
+        m_element = read_element(m_element.end);
+    }
+}
+
+template <typename T>
+void append_value(T value, std::vector<char>& buffer) {
+    auto const offset = buffer.size();
+    buffer.resize(offset + sizeof(value));
+    std::memcpy(buffer.data() + offset, &value, sizeof(value));
+}
+
+void append_string(std::string_view str, std::vector<char>& buffer) {
+    append_value(static_cast<uint32_t>(str.size()), buffer);
+    buffer.insert(buffer.end(), str.begin(), str.end());
+}
+
+template <typename T>
+T read_value(char const* pos) {
+    T value;
+    std::memcpy(&value, pos, sizeof(value));
+    return value;
+}
+
+template <typename T>
+bool read_value_checked(char const*& pos, char const* end, T& value) {
+    if (static_cast<size_t>(end - pos) < sizeof(value)) {
+        return false;
+    }
+    value = read_value<T>(pos);
+    pos += sizeof(value);
+    return true;
+}
+
+bool read_string_checked(char const*& pos, char const* end, std::string_view& str) {
+    uint32_t size{0};
+    if (false == read_value_checked(pos, end, size) || static_cast<size_t>(end - pos) < size) {
+        return false;
+    }
+    str = {pos, size};
+    pos += size;
+    return true;
+}
+
+ElementView read_element(char const* pos) {
+    ElementView element{};
+    element.type = static_cast<ValueType>(read_value<uint8_t>(pos));
+    pos += sizeof(uint8_t);
+    auto const key_size = read_value<uint32_t>(pos);
+    pos += sizeof(key_size);
+    element.key = {pos, key_size};
+    pos += key_size;
+    element.value = pos;
+    if (ValueType::String == element.type) {
+        pos += sizeof(uint32_t) + read_value<uint32_t>(pos);
+    } else {
+        pos += sizeof(int64_t);
+    }
+    element.end = pos;
+    return element;
+}
+
+bool skip_element_checked(char const*& pos, char const* end) {
+    uint8_t type{0};
+    std::string_view key;
+    if (false == read_value_checked(pos, end, type) || false == read_string_checked(pos, end, key))
+    {
+        return false;
+    }
+
+    switch (static_cast<ValueType>(type)) {
+        case ValueType::Int64: {
+            int64_t value{0};
+            return read_value_checked(pos, end, value);
+        }
+        case ValueType::Double: {
+            double value{0.0};
+            return read_value_checked(pos, end, value);
+        }
+        case ValueType::String: {
+            std::string_view value;
+            return read_string_checked(pos, end, value);
+        }
+        default:
+            return false;
+    }
+}
+}  // namespace
+
+void serialize_binary(
+        GroupTags const& tags,
+        ConstRecordIterator& record_it,
+        std::vector<char>& buffer
+) {
+    buffer.push_back(static_cast<char>(cBinaryRecordGroupMagic));
+    append_value(static_cast<uint32_t>(tags.size()), buffer);
+    for (auto const& tag : tags) {
+        append_string(tag, buffer);
+    }
+
+    // The number of records isn't known until they've all been serialized
+    auto const num_records_offset = buffer.size();
+    uint32_t num_records{0};
+    append_value(num_records, buffer);
+    for (; false == record_it.done(); record_it.next()) {
+        auto const& record = record_it.get();
+        auto const num_elements_offset = buffer.size();
+        uint32_t num_elements{0};
+        append_value(num_elements, buffer);
+        for (auto typed_key_it = record.typed_key_iter(); false == typed_key_it->done();
+             typed_key_it->next())
+        {
+            auto const typed_key = typed_key_it->get();
+            auto const key = typed_key.get_key();
+            buffer.push_back(static_cast<char>(typed_key.get_type()));
+            append_string(key, buffer);
+            switch (typed_key.get_type()) {
+                case ValueType::Int64:
+                    append_value(record.get_int64_value(key), buffer);
+                    break;
+                case ValueType::Double:
+                    append_value(record.get_double_value(key), buffer);
+                    break;
+                case ValueType::String:
+                    append_string(record.get_string_view(key), buffer);
+                    break;
+            }
+            ++num_elements;
+        }
+        std::memcpy(buffer.data() + num_elements_offset, &num_elements, sizeof(num_elements));
+        ++num_records;
+    }
+    std::memcpy(buffer.data() + num_records_offset, &num_records, sizeof(num_records));
+}
+
+std::string_view BinaryRecordView::get_string_view(std::string_view key) const {
+    auto const* value = find_value(key, ValueType::String);
+    if (nullptr == value) {
+        return {};
+    }
+    return {value + sizeof(uint32_t), read_value<uint32_t>(value)};
+}
+
+int64_t BinaryRecordView::get_int64_value(std::string_view key) const {
+    auto const* value = find_value(key, ValueType::Int64);
+    if (nullptr == value) {
+        return 0;
+    }
+    return read_value<int64_t>(value);
+}
+
+double BinaryRecordView::get_double_value(std::string_view key) const {
+    auto const* value = find_value(key, ValueType::Double);
+    if (nullptr == value) {
+        return 0.0;
+    }
+    return read_value<double>(value);
+}
+
+std::unique_ptr<RecordTypedKeyIterator> BinaryRecordView::typed_key_iter() const {
+    return std::make_unique<BinaryRecordTypedKeyIterator>(m_elements_begin, m_num_elements);
+}
+
+char const* BinaryRecordView::find_value(std::string_view key, ValueType type) const {
+    auto const* pos = m_elements_begin;
+    for (uint32_t i = 0; i < m_num_elements; ++i) {
+        auto const element = read_element(pos);
+        if (element.key == key) {
+            return element.type == type ? element.value : nullptr;
+        }
+        pos = element.end;
+    }
+    return nullptr;
+}
+
+void BinaryRecordIterator::reset(char const* records_begin, uint32_t num_records) {
+    m_next_record = records_begin;
+    m_num_records_remaining = num_records;
+    if (m_num_records_remaining > 0) {
+        load_record();
+    }
+}
+
+void BinaryRecordIterator::next() {
+    --m_num_records_remaining;
+    if (m_num_records_remaining > 0) {
+        load_record();
+    }
+}
+
+void BinaryRecordIterator::load_record() {
+    auto const num_elements = read_value<uint32_t>(m_next_record);
+    auto const* elements_begin = m_next_record + sizeof(num_elements);
+    m_record.set_record(elements_begin, num_elements);
+
+    // Find the beginning of the following record
+    auto const* pos = elements_begin;
+    for (uint32_t i = 0; i < num_elements; ++i) {
+        pos = read_element(pos).end;
+    }
+    m_next_record = pos;
+}
+
+bool BinaryRecordGroupView::parse(char const* buf, size_t size) {
+    auto const* pos = buf;
+    auto const* const end = buf + size;
+
+    uint8_t magic{0};
+    if (false == read_value_checked(pos, end, magic) || cBinaryRecordGroupMagic != magic) {
+        return false;
+    }
+
+    uint32_t num_tags{0};
+    if (false == read_value_checked(pos, end, num_tags)) {
+        return false;
+    }
+    m_tags.resize(num_tags);
+    for (auto& tag : m_tags) {
+        std::string_view tag_view;
+        if (false == read_string_checked(pos, end, tag_view)) {
+            return false;
+        }
+        tag.assign(tag_view);
+    }
+
+    uint32_t num_records{0};
+    if (false == read_value_checked(pos, end, num_records)) {
+        return false;
+    }
+    auto const* records_begin = pos;
+    for (uint32_t i = 0; i < num_records; ++i) {
+        uint32_t num_elements{0};
+        if (false == read_value_checked(pos, end, num_elements)) {
+            return false;
+        }
+        for (uint32_t j = 0; j < num_elements; ++j) {
+            if (false == skip_element_checked(pos, end)) {
+                return false;
+            }
+        }
+    }
+    if (pos != end) {
+        return false;
+    }
+
+    m_record_it.reset(records_begin, num_records);
+    return true;
+}
+}  // namespace reducer
@@ -0,0 +1,142 @@
+#ifndef REDUCER_BINARYRECORDGROUP_HPP
+#define REDUCER_BINARYRECORDGROUP_HPP
+
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <string_view>
+#include <vector>
+
+#include "ConstRecordIterator.hpp"
+#include "GroupTags.hpp"
+#include "Record.hpp"
+#include "RecordGroup.hpp"
+#include "RecordTypedKeyIterator.hpp"
+
+namespace reducer {
+/**
+ * Marks a record group encoded in the compact binary format below. The byte is never used by
+ * msgpack, so receivers can tell binary record groups apart from msgpack-encoded ones.
+ *
+ * The binary format is laid out as follows, where every integer is unaligned and in the host's
+ * byte order (like the size prefix that frames each record group on the wire):
+ * - uint8_t cBinaryRecordGroupMagic
+ * - uint32_t num_tags, followed by each tag as a uint32_t size and its bytes
+ * - uint32_t num_records, followed by each record as:
+ *   - uint32_t num_elements, followed by each element as:
+ *     - uint8_t value type (ValueType)
+ *     - uint32_t key size and the key's bytes
+ *     - the value: 8 bytes for Int64 and Double values; a uint32_t size and the bytes for String
+ *       values
+ */
+constexpr uint8_t cBinaryRecordGroupMagic{0xC1};
+
+/**
+ * Serializes a record group into the binary format and appends it to the given buffer.
+ * @param tags
+ * @param record_it
+ * @param buffer
+ */
+void serialize_binary(
+        GroupTags const& tags,
+        ConstRecordIterator& record_it,
+        std::vector<char>& buffer
+);
+
+/**
+ * Record implementation that reads the elements of a binary-encoded record in place.
+ *
+ * Elements are found by scanning the record, which is cheap for the handful of elements that
+ * records in aggregation results contain.
+ */
+class BinaryRecordView : public Record {
+public:
+    /**
+     * Points the view at a record's elements.
+     * NOTE: The elements must have been validated by BinaryRecordGroupView::parse.
+     * @param elements_begin
+     * @param num_elements
+     */
+    void set_record(char const* elements_begin, uint32_t num_elements) {
+        m_elements_begin = elements_begin;
+        m_num_elements = num_elements;
+    }
+
+    [[nodiscard]] std::string_view get_string_view(std::string_view key) const override;
+
+    [[nodiscard]] int64_t get_int64_value(std::string_view key) const override;
+
+    [[nodiscard]] double get_double_value(std::string_view key) const override;
+
+    [[nodiscard]] std::unique_ptr<RecordTypedKeyIterator> typed_key_iter() const override;
+
+private:
+    /**
+     * @param key
+     * @param type
+     * @return A pointer to the encoded value of the element with the given key and type, or
+     * nullptr if there's no such element.
+     */
+    [[nodiscard]] char const* find_value(std::string_view key, ValueType type) const;
+
+    char const* m_elements_begin{nullptr};
+    uint32_t m_num_elements{0};
+};
+
+/**
+ * ConstRecordIterator over the binary-encoded records of a record group.
+ */
+class BinaryRecordIterator : public ConstRecordIterator {
+public:
+    /**
+     * Points the iterator at the first of a record group's records.
+     * NOTE: The records must have been validated by BinaryRecordGroupView::parse.
+     * @param records_begin
+     * @param num_records
+     */
+    void reset(char const* records_begin, uint32_t num_records);
+
+    [[nodiscard]] Record const& get() const override { return m_record; }
+
+    void next() override;
+
+    bool done() override { return 0 == m_num_records_remaining; }
+
+private:
+    /**
+     * Points the record view at the record beginning at `m_next_record`.
+     */
+    void load_record();
+
+    BinaryRecordView m_record;
+    char const* m_next_record{nullptr};
+    uint32_t m_num_records_remaining{0};
+};
+
+/**
+ * RecordGroup implementation that reads a binary-encoded record group in place from the buffer it
+ * was received into. The buffer must outlive any use of the group's records.
+ *
+ * The view can be reused for many record groups to avoid reallocating the storage for their tags.
+ */
+class BinaryRecordGroupView : public RecordGroup {
+public:
+    /**
+     * Validates the binary-encoded record group in the given buffer and points the view at it.
+     * @param buf
+     * @param size
+     * @return Whether the buffer contains exactly one valid binary-encoded record group.
+     */
+    [[nodiscard]] bool parse(char const* buf, size_t size);
+
+    [[nodiscard]] GroupTags const& get_tags() const override { return m_tags; }
+
+    [[nodiscard]] ConstRecordIterator& record_iter() override { return m_record_it; }
+
+private:
+    GroupTags m_tags;
+    BinaryRecordIterator m_record_it;
+};
+}  // namespace reducer
+
+#endif  // REDUCER_BINARYRECORDGROUP_HPP
@@ -30,6 +30,8 @@ public:
 
     [[nodiscard]] int get_upsert_interval() const { return m_upsert_interval; }
 
+    [[nodiscard]] int get_num_threads() const { return m_num_threads; }
+
 private:
     // Methods
     void print_basic_usage() const override;
@@ -41,6 +43,7 @@ private:
     int m_scheduler_port{7000};
     std::string m_mongodb_uri{"mongodb://localhost:27017/clp-search"};
     int m_upsert_interval{100};  // Milliseconds
+    int m_num_threads{1};
 };
 }  // namespace reducer
 
@@ -3,6 +3,7 @@
 #include <cstring>
 
 #include "../clp/spdlog_with_specializations.hpp"
+#include "BinaryRecordGroup.hpp"
 #include "DeserializedRecordGroup.hpp"
 #include "types.hpp"
 
@@ -63,8 +64,21 @@ bool RecordReceiverContext::read_record_groups_packet() {
         }
         read_head += sizeof(record_size);
 
-        auto record_group = DeserializedRecordGroup{read_head, record_size};
-        m_server_ctx->push_record_group(record_group.get_tags(), record_group.record_iter());
+        // Binary record groups are read in place; anything else is from a worker that still sends
+        // msgpack-encoded record groups.
+        if (record_size > 0 && static_cast<char>(cBinaryRecordGroupMagic) == *read_head) {
+            if (false == m_binary_record_group.parse(read_head, record_size)) {
+                SPDLOG_ERROR("Received malformed record group");
+                return false;
+            }
+            m_server_ctx->push_record_group(
+                    m_binary_record_group.get_tags(),
+                    m_binary_record_group.record_iter()
+            );
+        } else {
+            auto record_group = DeserializedRecordGroup{read_head, record_size};
+            m_server_ctx->push_record_group(record_group.get_tags(), record_group.record_iter());
+        }
         m_buf_num_bytes_occupied -= (record_size + sizeof(record_size));
         read_head += record_size;
     }
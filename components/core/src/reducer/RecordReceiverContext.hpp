@@ -6,6 +6,7 @@
 
 #include <boost/asio/ip/tcp.hpp>
 
+#include "BinaryRecordGroup.hpp"
 #include "ServerContext.hpp"
 
 namespace reducer {
@@ -86,6 +87,7 @@ private:
     boost::asio::ip::tcp::socket m_socket;
     std::vector<char> m_buf;
     size_t m_buf_num_bytes_occupied{0};
+    BinaryRecordGroupView m_binary_record_group;
 };
 }  // namespace reducer
 #endif  // REDUCER_RECORDRECEIVERCONTEXT_HPP
@@ -1,5 +1,10 @@
 #include "ServerContext.hpp"
 
+#include <exception>
+#include <memory>
+#include <mutex>
+#include <thread>
+
 #include <bsoncxx/builder/stream/document.hpp>
 #include <mongocxx/bulk_write.hpp>
 #include <mongocxx/client.hpp>
@@ -12,9 +17,12 @@
 #include <nlohmann/json.hpp>
 
 #include "../clp/spdlog_with_specializations.hpp"
+#include "AggregateOperator.hpp"
 #include "CommandLineArguments.hpp"
 #include "CountOperator.hpp"
 #include "DeserializedRecordGroup.hpp"
+#include "Pipeline.hpp"
+#include "ShardedPipeline.hpp"
 
 using boost::asio::ip::tcp;
 using std::vector;
@@ -52,11 +60,13 @@ vector<uint8_t> serialize_timeline_result(GroupTags const& tags, ConstRecordIter
 // TODO: We should use tcp::v6 and set ip::v6_only to false, but this isn't guaranteed to work; so
 // for now, we use v4 to be safe.
 ServerContext::ServerContext(CommandLineArguments& args)
-        : m_tcp_acceptor{m_ioctx, tcp::endpoint(tcp::v4(), args.get_reducer_port())},
+        : m_control_strand{boost::asio::make_strand(m_ioctx)},
+          m_tcp_acceptor{m_ioctx, tcp::endpoint(tcp::v4(), args.get_reducer_port())},
           m_scheduler_socket{m_ioctx},
           m_upsert_timer{m_ioctx},
           m_reducer_host{args.get_reducer_host()},
           m_reducer_port{args.get_reducer_port()},
+          m_num_threads{args.get_num_threads()},
           m_upsert_interval{args.get_upsert_interval()} {
     mongocxx::uri mongodb_uri = mongocxx::uri(args.get_mongodb_uri());
     try {
@@ -70,14 +80,46 @@ ServerContext::ServerContext(CommandLineArguments& args)
 
 void ServerContext::reset() {
     m_ioctx.restart();
-    m_pipeline.reset(nullptr);
+    m_pipeline.reset();
     m_status = ServerStatus::Idle;
     m_job_id = -1;
+    m_finalized_results = false;
     m_is_timeline_aggregation = false;
-    m_updated_tags.clear();
     m_num_active_receiver_tasks = 0;
 }
 
+void ServerContext::run() {
+    // Run the event loop on this thread and `m_num_threads - 1` others, rethrowing the first
+    // failure once every thread has exited
+    std::mutex exception_mutex;
+    std::exception_ptr exception;
+    auto run_event_loop = [&]() {
+        try {
+            m_ioctx.run();
+        } catch (...) {
+            std::lock_guard const lock{exception_mutex};
+            if (nullptr == exception) {
+                exception = std::current_exception();
+            }
+            m_ioctx.stop();
+        }
+    };
+
+    std::vector<std::thread> threads;
+    threads.reserve(m_num_threads - 1);
+    for (int i = 1; i < m_num_threads; ++i) {
+        threads.emplace_back(run_event_loop);
+    }
+    run_event_loop();
+    for (auto& thread : threads) {
+        thread.join();
+    }
+
+    if (nullptr != exception) {
+        std::rethrow_exception(exception);
+    }
+}
+
 void ServerContext::stop_event_loop() {
     m_tcp_acceptor.cancel();
     m_scheduler_socket.close();
@@ -132,11 +174,12 @@ bool ServerContext::ack_query_scheduler() {
 }
 
 void ServerContext::decrement_num_active_receiver_tasks() {
-    --m_num_active_receiver_tasks;
-    if (0 == m_num_active_receiver_tasks && ServerStatus::ReceivedAllResults == m_status) {
-        if (false == try_finalize_results()) {
-            m_status = ServerStatus::UnrecoverableFailure;
-        }
+    if (0 == --m_num_active_receiver_tasks && ServerStatus::ReceivedAllResults == m_status) {
+        boost::asio::post(m_control_strand, [this]() {
+            if (false == try_finalize_results()) {
+                m_status = ServerStatus::UnrecoverableFailure;
+            }
+        });
     }
 }
 
@@ -145,44 +188,47 @@ void ServerContext::set_up_pipeline(nlohmann::json const& query_config) {
 
     SPDLOG_INFO("Setting up pipeline for job {}", m_job_id);
 
-    // For now, all pipelines only perform count and optionally, group-by time and count for the
-    // timeline aggregation.
+    // For now, pipelines either merge the partial aggregates of a numeric field (grouped by the
+    // tags the search workers assign to each record group), or perform count and optionally,
+    // group-by time and count for the timeline aggregation.
     // TODO: We'll need to implement more general pipeline initialization once more operators are
     // needed.
-    m_pipeline = std::make_unique<Pipeline>(PipelineInputMode::IntraStage);
-    m_pipeline->add_pipeline_stage(std::make_shared<CountOperator>());
-
+    bool const is_field_aggregation{
+            query_config.count(cJobAttributes::AggregationField) > 0
+            && false == query_config[cJobAttributes::AggregationField].is_null()
+    };
     if (query_config.count(cJobAttributes::TimeBucketSize) > 0
         && false == query_config[cJobAttributes::TimeBucketSize].is_null())
     {
         m_is_timeline_aggregation = true;
     }
+    m_pipeline = std::make_unique<ShardedPipeline>(
+            m_num_threads,
+            [&]() {
+                auto pipeline = std::make_unique<Pipeline>(PipelineInputMode::IntraStage);
+                if (is_field_aggregation) {
+                    pipeline->add_pipeline_stage(std::make_shared<AggregateOperator>());
+                } else {
+                    pipeline->add_pipeline_stage(std::make_shared<CountOperator>());
+                }
+                return pipeline;
+            },
+            m_is_timeline_aggregation
+    );
 
     auto collection_name = std::to_string(m_job_id);
     m_mongodb_results_collection = m_mongodb_results_database[collection_name];
 }
 
 void ServerContext::push_record_group(GroupTags const& tags, ConstRecordIterator& record_it) {
-    if (m_is_timeline_aggregation) {
-        m_updated_tags.insert(tags);
-    }
     m_pipeline->push_record_group(tags, record_it);
 }
 
 bool ServerContext::upsert_timeline_results() {
-    if (m_updated_tags.empty()) {
-        return true;
-    }
-
-    bool any_updates = false;
-    auto bulk_write = m_mongodb_results_collection.create_bulk_write();
     vector<vector<uint8_t>> results;
-    for (auto group_it = m_pipeline->finish(m_updated_tags); false == group_it->done();
-         group_it->next())
-    {
-        int64_t timestamp{std::stoll(group_it->get().get_tags().front())};
-
-        auto& group = group_it->get();
+    auto bulk_write = m_mongodb_results_collection.create_bulk_write();
+    auto append_upsert = [&](RecordGroup& group) {
+        int64_t timestamp{std::stoll(group.get_tags().front())};
         results.emplace_back(serialize_timeline_result(group.get_tags(), group.record_iter()));
 
         auto& result = results.back();
@@ -194,34 +240,32 @@ bool ServerContext::upsert_timeline_results() {
         };
         replace_op.upsert(true);
         bulk_write.append(replace_op);
-
-        any_updates = true;
-    }
-    try {
-        if (any_updates) {
+    };
+    auto execute_bulk_write = [&]() {
+        try {
             bulk_write.execute();
-            m_updated_tags.clear();
+        } catch (mongocxx::bulk_write_exception const& e) {
+            SPDLOG_ERROR("Failed to upsert timeline results - {}", e.what());
+            return false;
         }
-    } catch (mongocxx::bulk_write_exception const& e) {
-        SPDLOG_ERROR("Failed to upsert timeline results - {}", e.what());
-        return false;
-    }
-
-    return true;
+        return true;
+    };
+    // The updated groups are only marked as published if the bulk write succeeds, so that they're
+    // upserted again in the next period otherwise
+    return m_pipeline->publish_updated_groups(append_upsert, execute_bulk_write);
 }
 
 bool ServerContext::publish_pipeline_results() {
     vector<vector<uint8_t>> results;
     vector<bsoncxx::document::view> result_documents;
-    for (auto group_it = m_pipeline->finish(); false == group_it->done(); group_it->next()) {
-        auto& group = group_it->get();
+    m_pipeline->finish([&](RecordGroup& group) {
         results.push_back(
                 serialize(group.get_tags(), group.record_iter(), nlohmann::json::to_bson)
         );
 
         vector<uint8_t>& encoded_result = results.back();
         result_documents.emplace_back(encoded_result.data(), encoded_result.size());
-    }
+    });
     try {
         if (result_documents.empty() == false) {
             m_mongodb_results_collection.insert_many(result_documents);
@@ -235,6 +279,10 @@ bool ServerContext::publish_pipeline_results() {
 }
 
 bool ServerContext::try_finalize_results() {
+    if (m_finalized_results) {
+        // Both the scheduler's final message and the last receiver task can trigger finalization
+        return true;
+    }
     if (ServerStatus::Running == m_status) {
         // The pipeline's still running
         return true;
@@ -253,6 +301,7 @@ bool ServerContext::try_finalize_results() {
         SPDLOG_ERROR("Failed to publish results to results cache.");
         return false;
     }
+    m_finalized_results = true;
 
     // Notify the query scheduler that the results have been pushed
     return ack_query_scheduler();
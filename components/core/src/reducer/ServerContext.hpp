@@ -1,8 +1,11 @@
 #ifndef REDUCER_SERVERCONTEXT_HPP
 #define REDUCER_SERVERCONTEXT_HPP
 
+#include <atomic>
+#include <cstddef>
+#include <memory>
 #include <optional>
-#include <set>
+#include <vector>
 
 #include <boost/asio.hpp>
 #include <mongocxx/client.hpp>
@@ -11,7 +14,7 @@
 
 #include "../clp/TraceableException.hpp"
 #include "CommandLineArguments.hpp"
-#include "Pipeline.hpp"
+#include "ShardedPipeline.hpp"
 #include "types.hpp"
 
 namespace reducer {
@@ -26,11 +29,18 @@ enum class ServerStatus : uint8_t {
 namespace cJobAttributes {
 constexpr char JobId[] = "job_id";
 constexpr char TimeBucketSize[] = "count_by_time_bucket_size";
+constexpr char AggregationField[] = "aggregation_field";
 }  // namespace cJobAttributes
 
 /**
  * Class which manages interactions with the jobs database and result cache database. Also holds
  * state for the reducer job this server is handling.
+ *
+ * The event loop runs on several threads. Record groups are received concurrently and hashed by
+ * their tags to one of several pipeline shards, so each group's state lives in exactly one shard
+ * and the shards' results can be published one after another. Everything else (the scheduler
+ * connection, the acceptor, the upsert timer, and publishing results) is serialized on the control
+ * strand.
  */
 class ServerContext {
 public:
@@ -58,9 +68,10 @@ public:
     void reset();
 
     /**
-     * Executes the server event loop until no tasks remain.
+     * Executes the server event loop on all of the server's threads until no tasks remain.
+     * @throw boost::system::system_error if the event loop fails on any thread
      */
-    void run() { m_ioctx.run(); }
+    void run();
 
     /**
      * Stops the event loop by closing the connection to the scheduler, and cancelling any ongoing
@@ -90,8 +101,9 @@ public:
     void increment_num_active_receiver_tasks() { ++m_num_active_receiver_tasks; }
 
     /**
-     * Decrements the number of active receiver tasks, and calls try_finalize_results if the server
-     * is in the state ReceivedAllResults and there are no remaining active receiver tasks.
+     * Decrements the number of active receiver tasks, and queues a call to try_finalize_results on
+     * the control strand if the server is in the state ReceivedAllResults and there are no
+     * remaining active receiver tasks.
      */
     void decrement_num_active_receiver_tasks();
 
@@ -102,7 +114,8 @@ public:
     void set_up_pipeline(nlohmann::json const& query_config);
 
     /**
-     * Pushes a record group into the reducer pipeline.
+     * Pushes a record group into the pipeline shard its tags hash to. This method can be called
+     * concurrently from any thread.
      * @param group_tags The tags in the record group.
      * @param record_it An iterator for the records in the record group.
      */
@@ -133,6 +146,14 @@ public:
 
     boost::asio::io_context& get_io_context() { return m_ioctx; }
 
+    /**
+     * @return The strand which all tasks that use the scheduler connection, the acceptor, the
+     * upsert timer, or the results cache must run on.
+     */
+    boost::asio::strand<boost::asio::io_context::executor_type>& get_control_strand() {
+        return m_control_strand;
+    }
+
     boost::asio::ip::tcp::acceptor& get_tcp_acceptor() { return m_tcp_acceptor; }
 
     boost::asio::ip::tcp::socket& get_scheduler_update_socket() { return m_scheduler_socket; }
@@ -157,20 +178,22 @@ public:
 
 private:
     boost::asio::io_context m_ioctx;
+    boost::asio::strand<boost::asio::io_context::executor_type> m_control_strand;
     boost::asio::ip::tcp::acceptor m_tcp_acceptor;
     boost::asio::ip::tcp::socket m_scheduler_socket;
     std::vector<char> m_scheduler_update_buffer;
 
     std::string m_reducer_host;
     int m_reducer_port;
-    int m_num_active_receiver_tasks{0};
+    int m_num_threads;
+    std::atomic_int m_num_active_receiver_tasks{0};
 
-    ServerStatus m_status{ServerStatus::Idle};
+    std::atomic<ServerStatus> m_status{ServerStatus::Idle};
     job_id_t m_job_id{-1};
+    bool m_finalized_results{false};
 
-    std::unique_ptr<Pipeline> m_pipeline;
+    std::unique_ptr<ShardedPipeline> m_pipeline;
     bool m_is_timeline_aggregation{false};
-    std::set<GroupTags> m_updated_tags;
 
     boost::asio::steady_timer m_upsert_timer;
     int m_upsert_interval;
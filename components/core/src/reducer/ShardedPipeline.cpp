@@ -0,0 +1,98 @@
+#include "ShardedPipeline.hpp"
+
+#include <cstddef>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <set>
+#include <utility>
+#include <vector>
+
+#include <absl/hash/hash.h>
+
+#include "ConstRecordIterator.hpp"
+#include "GroupTags.hpp"
+#include "Pipeline.hpp"
+
+namespace reducer {
+ShardedPipeline::ShardedPipeline(
+        size_t num_shards,
+        std::function<std::unique_ptr<Pipeline>()> const& make_pipeline,
+        bool track_updated_tags
+)
+        : m_track_updated_tags{track_updated_tags} {
+    m_shards.reserve(num_shards);
+    for (size_t i = 0; i < num_shards; ++i) {
+        auto shard = std::make_unique<Shard>();
+        shard->pipeline = make_pipeline();
+        m_shards.emplace_back(std::move(shard));
+    }
+}
+
+void ShardedPipeline::push_record_group(GroupTags const& tags, ConstRecordIterator& record_it) {
+    auto& shard = get_shard(tags);
+    std::lock_guard const lock{shard.mutex};
+    if (m_track_updated_tags) {
+        shard.updated_tags.insert(tags);
+    }
+    shard.pipeline->push_record_group(tags, record_it);
+}
+
+void ShardedPipeline::finish(GroupHandler const& handle_group) {
+    for (auto& shard : m_shards) {
+        std::lock_guard const lock{shard->mutex};
+        for (auto group_it = shard->pipeline->finish(); false == group_it->done(); group_it->next())
+        {
+            handle_group(group_it->get());
+        }
+    }
+}
+
+bool ShardedPipeline::publish_updated_groups(
+        GroupHandler const& handle_group,
+        std::function<bool()> const& commit
+) {
+    // Take each shard's updated tags so that groups updated while publishing are published again
+    // next time
+    std::vector<std::set<GroupTags>> published_tags_per_shard(m_shards.size());
+    auto restore_published_tags = [&]() {
+        for (size_t i = 0; i < m_shards.size(); ++i) {
+            auto& shard = *m_shards[i];
+            std::lock_guard const lock{shard.mutex};
+            shard.updated_tags.merge(published_tags_per_shard[i]);
+        }
+    };
+
+    bool any_updates{false};
+    bool committed{false};
+    try {
+        for (size_t i = 0; i < m_shards.size(); ++i) {
+            auto& shard = *m_shards[i];
+            std::lock_guard const lock{shard.mutex};
+            if (shard.updated_tags.empty()) {
+                continue;
+            }
+            auto& published_tags = published_tags_per_shard[i];
+            published_tags = std::exchange(shard.updated_tags, {});
+            for (auto group_it = shard.pipeline->finish(published_tags); false == group_it->done();
+                 group_it->next())
+            {
+                handle_group(group_it->get());
+                any_updates = true;
+            }
+        }
+        committed = false == any_updates || commit();
+    } catch (...) {
+        restore_published_tags();
+        throw;
+    }
+    if (false == committed) {
+        restore_published_tags();
+    }
+    return committed;
+}
+
+ShardedPipeline::Shard& ShardedPipeline::get_shard(GroupTags const& tags) {
+    return *m_shards[absl::Hash<GroupTags>{}(tags) % m_shards.size()];
+}
+}  // namespace reducer
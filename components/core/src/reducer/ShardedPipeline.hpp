@@ -0,0 +1,94 @@
+#ifndef REDUCER_SHARDEDPIPELINE_HPP
+#define REDUCER_SHARDEDPIPELINE_HPP
+
+#include <cstddef>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <set>
+#include <vector>
+
+#include "ConstRecordIterator.hpp"
+#include "GroupTags.hpp"
+#include "Pipeline.hpp"
+#include "RecordGroup.hpp"
+
+namespace reducer {
+/**
+ * A set of pipelines ("shards") that record groups are hashed into by their tags, so that record
+ * groups can be pushed concurrently from several threads. Each group's state lives in exactly one
+ * shard, so merging the shards' results only requires concatenating them.
+ */
+class ShardedPipeline {
+public:
+    // Types
+    using GroupHandler = std::function<void(RecordGroup& group)>;
+
+    // Constructors
+    /**
+     * @param num_shards
+     * @param make_pipeline Creates the pipeline for each shard
+     * @param track_updated_tags Whether to track which groups were updated since they were last
+     * published by `publish_updated_groups`
+     */
+    ShardedPipeline(
+            size_t num_shards,
+            std::function<std::unique_ptr<Pipeline>()> const& make_pipeline,
+            bool track_updated_tags
+    );
+
+    // Methods
+    [[nodiscard]] size_t get_num_shards() const { return m_shards.size(); }
+
+    /**
+     * Pushes a record group into the shard its tags hash to. This method can be called
+     * concurrently from any thread.
+     * @param tags
+     * @param record_it
+     */
+    void push_record_group(GroupTags const& tags, ConstRecordIterator& record_it);
+
+    /**
+     * Passes every group in every shard to `handle_group`.
+     * @param handle_group
+     */
+    void finish(GroupHandler const& handle_group);
+
+    /**
+     * Passes every group updated since the groups were last published to `handle_group`, and then
+     * publishes them by calling `commit`. If `commit` fails, the groups are passed again by the
+     * next call, along with any groups updated in the meantime.
+     * @param handle_group
+     * @param commit
+     * @return Whether `commit` succeeded, or true if no groups were updated.
+     */
+    bool publish_updated_groups(
+            GroupHandler const& handle_group,
+            std::function<bool()> const& commit
+    );
+
+private:
+    // Types
+    /**
+     * A pipeline and the state that's updated alongside it, guarded by a mutex.
+     */
+    struct Shard {
+        std::mutex mutex;
+        std::unique_ptr<Pipeline> pipeline;
+        std::set<GroupTags> updated_tags;
+    };
+
+    // Methods
+    /**
+     * @param tags
+     * @return The shard that record groups with the given tags are pushed into.
+     */
+    Shard& get_shard(GroupTags const& tags);
+
+    // Variables
+    std::vector<std::unique_ptr<Shard>> m_shards;
+    bool m_track_updated_tags;
+};
+}  // namespace reducer
+
+#endif  // REDUCER_SHARDEDPIPELINE_HPP
@@ -5,11 +5,12 @@
 #include <cstddef>
 #include <memory>
 #include <string>
+#include <vector>
 
 #include "../clp/ErrorCode.hpp"
 #include "../clp/networking/socket_utils.hpp"
+#include "BinaryRecordGroup.hpp"
 #include "BufferedSocketWriter.hpp"
-#include "DeserializedRecordGroup.hpp"
 #include "RecordGroupIterator.hpp"
 #include "types.hpp"
 
@@ -48,10 +49,12 @@ bool send_pipeline_results(int reducer_socket_fd, std::unique_ptr<RecordGroupIte
     constexpr int cBufSize = 1024;
     BufferedSocketWriter buffered_writer{reducer_socket_fd, cBufSize};
 
+    std::vector<char> serialized_result;
     for (; false == results->done(); results->next()) {
         auto& group = results->get();
-        auto serialized_result = serialize(group.get_tags(), group.record_iter());
-        auto serialized_result_size = serialized_result.size();
+        serialized_result.clear();
+        serialize_binary(group.get_tags(), group.record_iter(), serialized_result);
+        size_t serialized_result_size = serialized_result.size();
 
         // Send size
         if (false
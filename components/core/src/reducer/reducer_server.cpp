@@ -78,6 +78,10 @@ private:
     std::shared_ptr<RecordReceiverContext> m_record_recv_ctx;
 };
 
+// NOTE: The event loop runs on several threads. Accept, scheduler update, and periodic upsert tasks
+// run on the server's control strand since they share the acceptor, the scheduler connection, and
+// the results cache. Receive and validate tasks only touch their own connection (which has at most
+// one outstanding read), so they run concurrently on any thread.
 void queue_accept_task(std::shared_ptr<ServerContext> const& ctx);
 void queue_receive_task(std::shared_ptr<RecordReceiverContext> const& ctx);
 void queue_scheduler_update_listener_task(
@@ -123,7 +127,10 @@ void PeriodicUpsertTask::operator()([[maybe_unused]] boost::system::error_code c
 
     auto& upsert_timer = m_server_ctx->get_upsert_timer();
     upsert_timer.expires_after(std::chrono::milliseconds(m_server_ctx->get_upsert_interval()));
-    upsert_timer.async_wait(PeriodicUpsertTask(m_server_ctx));
+    upsert_timer.async_wait(boost::asio::bind_executor(
+            m_server_ctx->get_control_strand(),
+            PeriodicUpsertTask(m_server_ctx)
+    ));
 }
 
 void ReceiveTask::operator()(boost::system::error_code const& error, size_t num_bytes_read) {
@@ -209,7 +216,10 @@ void SchedulerUpdateListenerTask::operator()(
             upsert_timer.expires_after(
                     std::chrono::milliseconds(m_server_ctx->get_upsert_interval())
             );
-            upsert_timer.async_wait(PeriodicUpsertTask(m_server_ctx));
+            upsert_timer.async_wait(boost::asio::bind_executor(
+                    m_server_ctx->get_control_strand(),
+                    PeriodicUpsertTask(m_server_ctx)
+            ));
         }
 
         // Synchronously notify the scheduler that the reducer is ready
@@ -264,7 +274,10 @@ void ValidateSenderTask::operator()(boost::system::error_code const& error, size
 
 void queue_accept_task(std::shared_ptr<ServerContext> const& ctx) {
     auto rctx = RecordReceiverContext::new_receiver(ctx);
-    ctx->get_tcp_acceptor().async_accept(rctx->get_socket(), AcceptTask(rctx));
+    ctx->get_tcp_acceptor().async_accept(
+            rctx->get_socket(),
+            boost::asio::bind_executor(ctx->get_control_strand(), AcceptTask(rctx))
+    );
 }
 
 void queue_receive_task(std::shared_ptr<RecordReceiverContext> const& ctx) {
@@ -283,7 +296,10 @@ void queue_scheduler_update_listener_task(
             ctx->get_scheduler_update_socket(),
             boost::asio::dynamic_buffer(ctx->get_scheduler_update_buffer()),
             boost::asio::transfer_at_least(1),  // Makes boost::asio forward results right away
-            SchedulerUpdateListenerTask(ctx, current_buffer_occupancy)
+            boost::asio::bind_executor(
+                    ctx->get_control_strand(),
+                    SchedulerUpdateListenerTask(ctx, current_buffer_occupancy)
+            )
     );
 }
 
@@ -322,7 +338,7 @@ std::string server_status_to_string(ServerStatus status) {
 int main(int argc, char const* argv[]) {
     // Program-wide initialization
     try {
-        auto stderr_logger = spdlog::stderr_logger_st("stderr");
+        auto stderr_logger = spdlog::stderr_logger_mt("stderr");
         spdlog::set_default_logger(stderr_logger);
         spdlog::set_pattern("%Y-%m-%dT%H:%M:%S.%e%z [%l] %v");
     } catch (std::exception& e) {
@@ -0,0 +1,134 @@
+#include <unistd.h>
+
+#include <array>
+#include <string>
+#include <string_view>
+#include <unordered_set>
+
+#include <catch2/catch_test_macros.hpp>
+
+#include "../src/clp/Defs.h"
+#include "../src/clp/VariableDictionaryEntry.hpp"
+#include "../src/clp/VariableDictionaryReader.hpp"
+#include "../src/clp/VariableDictionaryWriter.hpp"
+
+using clp::cVariableDictionaryIdMax;
+using clp::variable_dictionary_id_t;
+using clp::VariableDictionaryEntry;
+using clp::VariableDictionaryReader;
+using clp::VariableDictionaryWriter;
+
+namespace {
+constexpr std::string_view cVarDictPath{"var.dict"};
+constexpr std::string_view cVarSegmentIndexPath{"var.segindex"};
+constexpr std::string_view cVarSubstringIndexPath{"var.substrindex"};
+
+/**
+ * Searches the given dictionary for entries matching the given wildcard string
+ * @param var_dict_reader
+ * @param wildcard_string
+ * @param ignore_case
+ * @return The matching entries
+ */
+auto get_entries_matching_wildcard_string(
+        VariableDictionaryReader const& var_dict_reader,
+        std::string_view wildcard_string,
+        bool ignore_case
+) -> std::unordered_set<VariableDictionaryEntry const*>;
+
+auto get_entries_matching_wildcard_string(
+        VariableDictionaryReader const& var_dict_reader,
+        std::string_view wildcard_string,
+        bool ignore_case
+) -> std::unordered_set<VariableDictionaryEntry const*> {
+    std::unordered_set<VariableDictionaryEntry const*> entries;
+    var_dict_reader.get_entries_matching_wildcard_string(wildcard_string, ignore_case, entries);
+    return entries;
+}
+}  // namespace
+
+TEST_CASE("DictionarySubstringIndex", "[DictionarySubstringIndex]") {
+    // Values indexed by the substring index
+    constexpr std::array<std::string_view, 8> cIndexedValues{
+            "connection reset by peer",
+            "Connection RESET",
+            "conn-reset",
+            "task_12*34",
+            "task_12?34",
+            "path\\to\\file",
+            "",
+            "reset"
+    };
+    // Values added after the substring index was built
+    constexpr std::array<std::string_view, 2> cUnindexedValues{"late connection reset", "late"};
+
+    VariableDictionaryWriter var_dict_writer;
+    var_dict_writer.open(
+            std::string{cVarDictPath},
+            std::string{cVarSegmentIndexPath},
+            cVariableDictionaryIdMax
+    );
+    variable_dictionary_id_t id{};
+    for (auto const value : cIndexedValues) {
+        var_dict_writer.add_entry(value, id);
+    }
+    REQUIRE((var_dict_writer.write_substring_index(std::string{cVarSubstringIndexPath}) > 0));
+    for (auto const value : cUnindexedValues) {
+        var_dict_writer.add_entry(value, id);
+    }
+    var_dict_writer.close();
+
+    VariableDictionaryReader var_dict_reader;
+    var_dict_reader.open(std::string{cVarDictPath}, std::string{cVarSegmentIndexPath});
+    var_dict_reader.read_new_entries();
+    REQUIRE((false == var_dict_reader.has_substring_index()));
+
+    // Results must be the same with and without the index
+    constexpr std::array<std::string_view, 12> cWildcardStrings{
+            "*",
+            "*connection reset*",
+            "*reset*",
+            "reset",
+            "*RESET",
+            "conn*reset*",
+            "*12\\*34*",
+            "*12\\?34*",
+            "*12?34*",
+            "*\\\\to\\\\*",
+            "*late*",
+            "*no such value*"
+    };
+    std::array<std::unordered_set<VariableDictionaryEntry const*>, cWildcardStrings.size()>
+            expected_case_sensitive_results;
+    std::array<std::unordered_set<VariableDictionaryEntry const*>, cWildcardStrings.size()>
+            expected_case_insensitive_results;
+    for (size_t i = 0; i < cWildcardStrings.size(); ++i) {
+        auto const wildcard_string{cWildcardStrings.at(i)};
+        expected_case_sensitive_results.at(i)
+                = get_entries_matching_wildcard_string(var_dict_reader, wildcard_string, false);
+        expected_case_insensitive_results.at(i)
+                = get_entries_matching_wildcard_string(var_dict_reader, wildcard_string, true);
+    }
+
+    var_dict_reader.read_substring_index(std::string{cVarSubstringIndexPath});
+    REQUIRE(var_dict_reader.has_substring_index());
+    for (size_t i = 0; i < cWildcardStrings.size(); ++i) {
+        auto const wildcard_string{cWildcardStrings.at(i)};
+        REQUIRE((get_entries_matching_wildcard_string(var_dict_reader, wildcard_string, false)
+                 == expected_case_sensitive_results.at(i)));
+        REQUIRE((get_entries_matching_wildcard_string(var_dict_reader, wildcard_string, true)
+                 == expected_case_insensitive_results.at(i)));
+    }
+
+    // Sanity check some of the expected results
+    REQUIRE((2 == expected_case_sensitive_results.at(1).size()));
+    REQUIRE((3 == expected_case_insensitive_results.at(1).size()));
+    REQUIRE((1 == expected_case_sensitive_results.at(6).size()));
+
+    var_dict_reader.close();
+
+    // Clean-up
+    REQUIRE((0 == unlink(cVarDictPath.data())));
+    REQUIRE((0 == unlink(cVarSegmentIndexPath.data())));
+    REQUIRE((0 == unlink(cVarSubstringIndexPath.data())));
+}
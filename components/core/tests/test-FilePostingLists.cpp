@@ -0,0 +1,83 @@
+#include <unistd.h>
+
+#include <string>
+#include <string_view>
+#include <unordered_set>
+#include <vector>
+
+#include <catch2/catch_test_macros.hpp>
+
+#include "../src/clp/Defs.h"
+#include "../src/clp/Query.hpp"
+#include "../src/clp/streaming_archive/reader/FilePostingLists.hpp"
+#include "../src/clp/streaming_archive/writer/FilePostingLists.hpp"
+
+using clp::logtype_dictionary_id_t;
+using clp::SubQuery;
+using clp::variable_dictionary_id_t;
+
+namespace {
+constexpr std::string_view cPostingListsPath{"file.postings"};
+constexpr int cCompressionLevel{3};
+}  // namespace
+
+TEST_CASE("FilePostingLists", "[FilePostingLists]") {
+    std::string const file_with_vars_id{"file-with-vars"};
+    std::string const file_without_vars_id{"file-without-vars"};
+
+    clp::streaming_archive::writer::FilePostingLists writer;
+    writer.open(std::string{cPostingListsPath}, cCompressionLevel);
+    writer.add_file(file_with_vars_id, {5, 1, 3}, {20, 10});
+    writer.write_header_and_flush_to_disk();
+    writer.add_file(file_without_vars_id, {2}, {});
+    writer.close();
+
+    clp::streaming_archive::reader::FilePostingLists reader;
+    reader.read_from_file(std::string{cPostingListsPath});
+    REQUIRE((nullptr == reader.get_posting_list("nonexistent-file")));
+
+    auto const* posting_list = reader.get_posting_list(file_with_vars_id);
+    REQUIRE((nullptr != posting_list));
+    REQUIRE((std::vector<logtype_dictionary_id_t>{1, 3, 5} == posting_list->logtype_ids));
+    REQUIRE((std::vector<variable_dictionary_id_t>{10, 20} == posting_list->var_ids));
+    auto const& logtype_ids = posting_list->logtype_ids;
+    auto const& var_ids = posting_list->var_ids;
+
+    SECTION("Precise dictionary variable") {
+        SubQuery sub_query;
+        sub_query.set_possible_logtypes({3, 4});
+        sub_query.add_dict_var(0, 10);
+        REQUIRE(sub_query.may_match_file(logtype_ids, var_ids));
+
+        sub_query.add_dict_var(0, 15);
+        REQUIRE((false == sub_query.may_match_file(logtype_ids, var_ids)));
+    }
+
+    SECTION("Imprecise dictionary variable") {
+        SubQuery sub_query;
+        sub_query.set_possible_logtypes({1});
+        sub_query.add_non_dict_var(0);
+        sub_query.add_imprecise_dict_var({0, 1}, {15, 20});
+        REQUIRE(sub_query.may_match_file(logtype_ids, var_ids));
+
+        sub_query.add_imprecise_dict_var({0, 1}, {11, 12});
+        REQUIRE((false == sub_query.may_match_file(logtype_ids, var_ids)));
+    }
+
+    SECTION("Missing logtype") {
+        SubQuery sub_query;
+        sub_query.set_possible_logtypes({2, 4});
+        REQUIRE((false == sub_query.may_match_file(logtype_ids, var_ids)));
+
+        auto const* other_posting_list = reader.get_posting_list(file_without_vars_id);
+        REQUIRE((nullptr != other_posting_list));
+        REQUIRE(other_posting_list->var_ids.empty());
+        REQUIRE(sub_query.may_match_file(
+                other_posting_list->logtype_ids,
+                other_posting_list->var_ids
+        ));
+    }
+
+    // Clean-up
+    REQUIRE((0 == unlink(cPostingListsPath.data())));
+}
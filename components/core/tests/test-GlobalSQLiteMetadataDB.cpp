@@ -0,0 +1,196 @@
+#include <cstddef>
+#include <cstdint>
+#include <filesystem>
+#include <memory>
+#include <string>
+#include <string_view>
+#include <utility>
+#include <vector>
+
+#include <catch2/catch_test_macros.hpp>
+
+#include "../src/clp/Defs.h"
+#include "../src/clp/GlobalMetadataDB.hpp"
+#include "../src/clp/GlobalSQLiteMetadataDB.hpp"
+#include "../src/clp/streaming_archive/ArchiveMetadata.hpp"
+#include "../src/clp/streaming_archive/Constants.hpp"
+
+using clp::epochtime_t;
+using clp::GlobalMetadataDB;
+using clp::GlobalSQLiteMetadataDB;
+using clp::streaming_archive::ArchiveMetadata;
+using std::string;
+using std::vector;
+
+namespace {
+constexpr std::string_view cTestDbPath{"test-global-sqlite-metadata-db.db"};
+constexpr std::string_view cCreatorId{"test-creator"};
+
+struct TestArchive {
+    string id;
+    epochtime_t begin_ts;
+    epochtime_t end_ts;
+};
+
+/**
+ * @param creation_idx
+ * @param begin_ts
+ * @param end_ts
+ * @return Metadata for an archive with the given time range, or without any timestamps if
+ * `begin_ts` > `end_ts`.
+ */
+auto create_archive_metadata(uint64_t creation_idx, epochtime_t begin_ts, epochtime_t end_ts)
+        -> ArchiveMetadata;
+
+/**
+ * @param db
+ * @param begin_ts
+ * @param end_ts
+ * @return The IDs of the archives returned by the database for the given time window, in order.
+ */
+auto get_archive_ids_for_time_window(
+        GlobalSQLiteMetadataDB& db,
+        epochtime_t begin_ts,
+        epochtime_t end_ts
+) -> vector<string>;
+
+/**
+ * @param archives
+ * @param begin_ts
+ * @param end_ts
+ * @return The IDs of the given archives which overlap the given time window, in order.
+ */
+auto get_expected_archive_ids_for_time_window(
+        vector<TestArchive> const& archives,
+        epochtime_t begin_ts,
+        epochtime_t end_ts
+) -> vector<string>;
+
+auto create_archive_metadata(uint64_t creation_idx, epochtime_t begin_ts, epochtime_t end_ts)
+        -> ArchiveMetadata {
+    ArchiveMetadata metadata{
+            clp::streaming_archive::cArchiveFormatVersion::Version,
+            string{cCreatorId},
+            creation_idx
+    };
+    if (begin_ts <= end_ts) {
+        metadata.expand_time_range(begin_ts, end_ts);
+    }
+    return metadata;
+}
+
+auto get_archive_ids_for_time_window(
+        GlobalSQLiteMetadataDB& db,
+        epochtime_t begin_ts,
+        epochtime_t end_ts
+) -> vector<string> {
+    std::unique_ptr<GlobalMetadataDB::ArchiveIterator> const archive_it{
+            db.get_archive_iterator_for_time_window(begin_ts, end_ts)
+    };
+    vector<string> archive_ids;
+    for (; archive_it->contains_element(); archive_it->get_next()) {
+        archive_it->get_id(archive_ids.emplace_back());
+    }
+    return archive_ids;
+}
+
+auto get_expected_archive_ids_for_time_window(
+        vector<TestArchive> const& archives,
+        epochtime_t begin_ts,
+        epochtime_t end_ts
+) -> vector<string> {
+    vector<string> archive_ids;
+    for (auto const& archive : archives) {
+        if (archive.begin_ts <= end_ts && archive.end_ts >= begin_ts) {
+            archive_ids.emplace_back(archive.id);
+        }
+    }
+    return archive_ids;
+}
+}  // namespace
+
+TEST_CASE("global_sqlite_metadata_db_time_window", "[GlobalSQLiteMetadataDB]") {
+    std::filesystem::remove(cTestDbPath);
+
+    // NOLINTBEGIN(cppcoreguidelines-avoid-magic-numbers,readability-magic-numbers)
+    // Timestamps are large enough that the index's 32-bit float coordinates can't represent them
+    // exactly.
+    constexpr epochtime_t cBaseTs{1'700'000'000'000};
+    vector<TestArchive> archives{
+            {"archive-0", cBaseTs, cBaseTs + 5},
+            {"archive-1", cBaseTs + 6, cBaseTs + 10},
+            {"archive-2", cBaseTs + 3, cBaseTs + 100'000},
+            {"archive-3", clp::cEpochTimeMax, clp::cEpochTimeMin},
+            {"archive-4", cBaseTs + 11, cBaseTs + 11}
+    };
+    vector<std::pair<epochtime_t, epochtime_t>> const time_windows{
+            {cBaseTs, cBaseTs},
+            {cBaseTs + 6, cBaseTs + 6},
+            {cBaseTs + 5, cBaseTs + 6},
+            {cBaseTs + 11, cBaseTs + 20},
+            {cBaseTs + 12, cBaseTs + 20},
+            {cBaseTs + 100'001, cBaseTs + 200'000},
+            {clp::cEpochTimeMin, cBaseTs - 1},
+            {clp::cEpochTimeMin, cBaseTs + 5}
+    };
+    // NOLINTEND(cppcoreguidelines-avoid-magic-numbers,readability-magic-numbers)
+
+    GlobalSQLiteMetadataDB db{string{cTestDbPath}};
+    db.open();
+    for (size_t i = 0; i < archives.size(); ++i) {
+        db.add_archive(
+                archives[i].id,
+                create_archive_metadata(i, archives[i].begin_ts, archives[i].end_ts)
+        );
+    }
+    for (auto const& [begin_ts, end_ts] : time_windows) {
+        REQUIRE((get_expected_archive_ids_for_time_window(archives, begin_ts, end_ts)
+                 == get_archive_ids_for_time_window(db, begin_ts, end_ts)));
+    }
+
+    // Updating an archive's time range updates the index
+    archives[1].end_ts = cBaseTs + 30;
+    db.update_archive_metadata(
+            archives[1].id,
+            create_archive_metadata(1, archives[1].begin_ts, archives[1].end_ts)
+    );
+    for (auto const& [begin_ts, end_ts] : time_windows) {
+        REQUIRE((get_expected_archive_ids_for_time_window(archives, begin_ts, end_ts)
+                 == get_archive_ids_for_time_window(db, begin_ts, end_ts)));
+    }
+
+    // Updating an archive without timestamps adds it to the index
+    archives[3].begin_ts = cBaseTs + 20;
+    archives[3].end_ts = cBaseTs + 25;
+    db.update_archive_metadata(
+            archives[3].id,
+            create_archive_metadata(3, archives[3].begin_ts, archives[3].end_ts)
+    );
+    for (auto const& [begin_ts, end_ts] : time_windows) {
+        REQUIRE((get_expected_archive_ids_for_time_window(archives, begin_ts, end_ts)
+                 == get_archive_ids_for_time_window(db, begin_ts, end_ts)));
+    }
+
+    // A failed addition is rolled back and doesn't prevent later additions
+    TestArchive const new_archive{"archive-5", cBaseTs + 12, cBaseTs + 13};
+    auto const new_archive_metadata
+            = create_archive_metadata(archives.size(), new_archive.begin_ts, new_archive.end_ts);
+    REQUIRE_THROWS(db.add_archive(archives[0].id, new_archive_metadata));
+    db.add_archive(new_archive.id, new_archive_metadata);
+    archives.push_back(new_archive);
+    for (auto const& [begin_ts, end_ts] : time_windows) {
+        REQUIRE((get_expected_archive_ids_for_time_window(archives, begin_ts, end_ts)
+                 == get_archive_ids_for_time_window(db, begin_ts, end_ts)));
+    }
+    db.close();
+
+    // Reopening the database doesn't re-index its archives
+    db.open();
+    for (auto const& [begin_ts, end_ts] : time_windows) {
+        REQUIRE((get_expected_archive_ids_for_time_window(archives, begin_ts, end_ts)
+                 == get_archive_ids_for_time_window(db, begin_ts, end_ts)));
+    }
+    db.close();
+
+    REQUIRE(std::filesystem::remove(cTestDbPath));
+}
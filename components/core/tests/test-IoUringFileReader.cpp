@@ -0,0 +1,247 @@
+#include <sys/stat.h>
+
+#include <algorithm>
+#include <cerrno>
+#include <cstddef>
+#include <filesystem>
+#include <fstream>
+#include <ios>
+#include <string>
+#include <string_view>
+#include <thread>
+#include <utility>
+#include <vector>
+
+#include <catch2/catch_message.hpp>
+#include <catch2/catch_test_macros.hpp>
+#include <catch2/generators/catch_generators.hpp>
+#include <ystdlib/containers/Array.hpp>
+
+#include "../src/clp/FileReader.hpp"
+#include "../src/clp/IoUringFileReader.hpp"
+#include "../src/clp/ReaderInterface.hpp"
+
+namespace {
+constexpr size_t cDefaultReaderBufferSize{1024};
+// Small enough that the test input spans many blocks
+constexpr size_t cBlockSize{16};
+constexpr size_t cQueueDepth{3};
+
+[[nodiscard]] auto get_test_input_local_path() -> std::string;
+
+/**
+ * Skips the current test if the given reader is expected to use io_uring but can't, since io_uring
+ * may be unavailable or disabled where the test runs. Otherwise, requires that the reader uses
+ * io_uring exactly when it's expected to.
+ * @param reader
+ * @param read_method The read method the reader was created with.
+ */
+void require_read_method(
+        clp::IoUringFileReader const& reader,
+        clp::IoUringFileReader::ReadMethod read_method
+);
+
+/**
+ * @param reader
+ * @param read_buf_size The size of the buffer to use for individual reads from the reader.
+ * @return All data read from the given reader.
+ */
+auto get_content(clp::ReaderInterface& reader, size_t read_buf_size = cDefaultReaderBufferSize)
+        -> std::vector<char>;
+
+auto get_test_input_local_path() -> std::string {
+    std::filesystem::path const current_file_path{__FILE__};
+    auto const tests_dir{current_file_path.parent_path()};
+    return (tests_dir / "test_log_files" / "log.txt").string();
+}
+
+void require_read_method(
+        clp::IoUringFileReader const& reader,
+        clp::IoUringFileReader::ReadMethod read_method
+) {
+    if (clp::IoUringFileReader::ReadMethod::Direct == read_method) {
+        REQUIRE_FALSE(reader.is_using_io_uring());
+        return;
+    }
+    if (false == reader.is_using_io_uring()) {
+        SKIP("io_uring is unavailable");
+    }
+}
+
+auto get_content(clp::ReaderInterface& reader, size_t read_buf_size) -> std::vector<char> {
+    std::vector<char> buf;
+    ystdlib::containers::Array<char> read_buf(read_buf_size);
+    for (bool has_more_content{true}; has_more_content;) {
+        size_t num_bytes_read{};
+        has_more_content = reader.read(read_buf.data(), read_buf_size, num_bytes_read);
+        std::string_view const view{read_buf.data(), num_bytes_read};
+        buf.insert(buf.cend(), view.cbegin(), view.cend());
+    }
+    return buf;
+}
+}  // namespace
+
+TEST_CASE("io_uring_file_reader_basic", "[IoUringFileReader]") {
+    auto const read_method{GENERATE(
+            clp::IoUringFileReader::ReadMethod::IoUringIfAvailable,
+            clp::IoUringFileReader::ReadMethod::Direct
+    )};
+
+    clp::FileReader ref_reader{get_test_input_local_path()};
+    auto const expected{get_content(ref_reader)};
+
+    clp::IoUringFileReader reader{
+            get_test_input_local_path(),
+            clp::IoUringFileReader::cDefaultBlockSize,
+            clp::IoUringFileReader::cDefaultQueueDepth,
+            read_method
+    };
+    require_read_method(reader, read_method);
+    REQUIRE((get_content(reader) == expected));
+
+    // Reads that span several blocks, end mid-block, or are smaller than a block
+    for (size_t const read_buf_size : {cBlockSize * 5, cBlockSize + 1, size_t{7}, size_t{1}}) {
+        clp::IoUringFileReader small_block_reader{
+                get_test_input_local_path(),
+                cBlockSize,
+                cQueueDepth,
+                read_method
+        };
+        require_read_method(small_block_reader, read_method);
+        REQUIRE((get_content(small_block_reader, read_buf_size) == expected));
+    }
+}
+
+TEST_CASE("io_uring_file_reader_with_offset_and_seek", "[IoUringFileReader]") {
+    constexpr size_t cOffset{119};
+    auto const read_method{GENERATE(
+            clp::IoUringFileReader::ReadMethod::IoUringIfAvailable,
+            clp::IoUringFileReader::ReadMethod::Direct
+    )};
+
+    clp::FileReader ref_reader{get_test_input_local_path()};
+    ref_reader.seek_from_begin(cOffset);
+    auto const expected{get_content(ref_reader)};
+    auto const ref_end_pos{ref_reader.get_pos()};
+
+    clp::IoUringFileReader reader{
+            get_test_input_local_path(),
+            cBlockSize,
+            cQueueDepth,
+            read_method
+    };
+    require_read_method(reader, read_method);
+    // Read ahead before seeking backwards, so that the seek discards in-flight reads
+    char c{};
+    REQUIRE((clp::ErrorCode_Success == reader.try_read_exact_length(&c, 1)));
+    reader.seek_from_begin(cOffset);
+    auto const actual{get_content(reader)};
+    REQUIRE((reader.get_pos() == ref_end_pos));
+    REQUIRE((actual == expected));
+
+    // Reading at EOF
+    size_t num_bytes_read{0};
+    REQUIRE((clp::ErrorCode_EndOfFile == reader.try_read(&c, 1, num_bytes_read)));
+    REQUIRE((0 == num_bytes_read));
+}
+
+TEST_CASE("io_uring_file_reader_seek_within_read_ahead", "[IoUringFileReader]") {
+    auto const read_method{GENERATE(
+            clp::IoUringFileReader::ReadMethod::IoUringIfAvailable,
+            clp::IoUringFileReader::ReadMethod::Direct
+    )};
+
+    clp::FileReader ref_reader{get_test_input_local_path()};
+    auto const expected{get_content(ref_reader)};
+
+    clp::IoUringFileReader reader{
+            get_test_input_local_path(),
+            cBlockSize,
+            cQueueDepth,
+            read_method
+    };
+    require_read_method(reader, read_method);
+    // Each position and length is read in turn: seeking forwards within the read-ahead data, back
+    // within the head block, across blocks, behind the read-ahead data, and beyond it
+    std::vector<std::pair<size_t, size_t>> const reads{
+            {0, 1},
+            {cBlockSize + 3, 5},
+            {cBlockSize + 1, 10},
+            {2 * cBlockSize + 5, 2 * cBlockSize},
+            {3, 4},
+            {10 * cBlockSize, cBlockSize + 1},
+            {10 * cBlockSize + 2, 1}
+    };
+    for (auto const& [pos, num_bytes] : reads) {
+        CAPTURE(pos, num_bytes);
+        REQUIRE((pos + num_bytes <= expected.size()));
+        std::vector<char> buf(num_bytes);
+        REQUIRE((clp::ErrorCode_Success == reader.try_seek_from_begin(pos)));
+        REQUIRE((clp::ErrorCode_Success == reader.try_read_exact_length(buf.data(), buf.size())));
+        REQUIRE((reader.get_pos() == pos + num_bytes));
+        REQUIRE(std::equal(buf.cbegin(), buf.cend(), expected.cbegin() + pos));
+    }
+}
+
+TEST_CASE("io_uring_file_reader_fifo", "[IoUringFileReader]") {
+    constexpr std::string_view cFifoPath{"test-io-uring-file-reader-fifo"};
+
+    clp::FileReader ref_reader{get_test_input_local_path()};
+    auto const expected{get_content(ref_reader)};
+
+    REQUIRE((0 == mkfifo(std::string{cFifoPath}.c_str(), 0600)));
+    // Opening a FIFO blocks until both of its ends are open, so it's written to concurrently
+    std::thread writer{[&]() {
+        std::ofstream fifo{std::string{cFifoPath}, std::ios::binary};
+        fifo.write(expected.data(), static_cast<std::streamsize>(expected.size()));
+    }};
+    bool is_using_io_uring{false};
+    std::vector<char> content;
+    clp::ErrorCode seek_to_pos_error_code{};
+    clp::ErrorCode seek_elsewhere_error_code{};
+    int seek_elsewhere_errno{0};
+    {
+        clp::IoUringFileReader reader{std::string{cFifoPath}, cBlockSize, cQueueDepth};
+        is_using_io_uring = reader.is_using_io_uring();
+        content = get_content(reader, cBlockSize + 1);
+        seek_to_pos_error_code = reader.try_seek_from_begin(expected.size());
+        seek_elsewhere_error_code = reader.try_seek_from_begin(0);
+        seek_elsewhere_errno = errno;
+    }
+    writer.join();
+    REQUIRE(std::filesystem::remove(cFifoPath));
+
+    // FIFOs can't be read at an offset, so they're read sequentially and can't be seeked
+    REQUIRE_FALSE(is_using_io_uring);
+    REQUIRE((content == expected));
+    REQUIRE((clp::ErrorCode_Success == seek_to_pos_error_code));
+    REQUIRE((clp::ErrorCode_errno == seek_elsewhere_error_code));
+    REQUIRE((ESPIPE == seek_elsewhere_errno));
+}
+
+TEST_CASE("io_uring_file_reader_small_files", "[IoUringFileReader]") {
+    constexpr std::string_view cTestFilePath{"test-io-uring-file-reader-small-file.txt"};
+    constexpr std::string_view cContent{"small file content"};
+
+    SECTION("Read-ahead is capped at the file's size") {
+        {
+            std::ofstream file{std::string{cTestFilePath}};
+            file << cContent;
+        }
+        // The default block size and queue depth are far larger than the file
+        clp::IoUringFileReader reader{std::string{cTestFilePath}};
+        auto const content{get_content(reader)};
+        REQUIRE((std::string_view{content.data(), content.size()} == cContent));
+    }
+
+    SECTION("Empty files are read directly") {
+        {
+            std::ofstream const file{std::string{cTestFilePath}};
+        }
+        clp::IoUringFileReader reader{std::string{cTestFilePath}};
+        REQUIRE_FALSE(reader.is_using_io_uring());
+        REQUIRE(get_content(reader).empty());
+    }
+
+    REQUIRE(std::filesystem::remove(cTestFilePath));
+}
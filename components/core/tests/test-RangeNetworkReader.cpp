@@ -0,0 +1,383 @@
+#include <arpa/inet.h>
+#include <netinet/in.h>
+#include <sys/socket.h>
+#include <unistd.h>
+
+#include <algorithm>
+#include <atomic>
+#include <cctype>
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <mutex>
+#include <optional>
+#include <string>
+#include <string_view>
+#include <thread>
+#include <utility>
+#include <vector>
+
+#include <catch2/catch_test_macros.hpp>
+#include <fmt/format.h>
+
+#include "../src/clp/CurlGlobalInstance.hpp"
+#include "../src/clp/ErrorCode.hpp"
+#include "../src/clp/RangeNetworkReader.hpp"
+
+namespace {
+/**
+ * A minimal HTTP server, listening on a loopback port, that serves a fixed body and honours
+ * single-range `Range` headers. Each connection is served on its own thread and kept alive until
+ * the client closes it.
+ *
+ * Since Catch2 assertions may only be used on the test's thread, the server records any invalid
+ * request it receives, for the test to check with `received_invalid_request`.
+ */
+class RangeHttpServer {
+public:
+    explicit RangeHttpServer(std::string body);
+
+    // Delete copy & move constructors and assignment operators
+    RangeHttpServer(RangeHttpServer const&) = delete;
+    RangeHttpServer(RangeHttpServer&&) = delete;
+    auto operator=(RangeHttpServer const&) -> RangeHttpServer& = delete;
+    auto operator=(RangeHttpServer&&) -> RangeHttpServer& = delete;
+
+    ~RangeHttpServer();
+
+    [[nodiscard]] auto get_url() const -> std::string {
+        return fmt::format("http://127.0.0.1:{}/archive", m_port);
+    }
+
+    [[nodiscard]] auto get_num_requests() const -> size_t { return m_num_requests; }
+
+    [[nodiscard]] auto get_num_connections() const -> size_t { return m_num_connections; }
+
+    [[nodiscard]] auto get_num_body_bytes_sent() const -> size_t { return m_num_body_bytes_sent; }
+
+    [[nodiscard]] auto received_invalid_request() const -> bool {
+        return m_received_invalid_request;
+    }
+
+private:
+    /**
+     * Accepts connections until the listening socket is shut down, serving each on a new thread.
+     */
+    void accept_connections();
+
+    /**
+     * Serves requests from the given connection until it's closed.
+     * @param fd
+     */
+    void serve(int fd);
+
+    /**
+     * @param request
+     * @return The response to the given request, or std::nullopt if the request is invalid.
+     */
+    [[nodiscard]] auto get_response(std::string request) -> std::optional<std::string>;
+
+    std::string m_body;
+    int m_listen_fd{-1};
+    uint16_t m_port{0};
+    std::atomic_size_t m_num_requests{0};
+    std::atomic_size_t m_num_connections{0};
+    std::atomic_size_t m_num_body_bytes_sent{0};
+    std::atomic_bool m_received_invalid_request{false};
+    std::thread m_accept_thread;
+
+    std::mutex m_connections_mutex;
+    std::vector<int> m_connection_fds;
+    std::vector<std::thread> m_connection_threads;
+};
+
+/**
+ * @param size
+ * @return A deterministic pseudo-random body of the given size.
+ */
+auto generate_body(size_t size) -> std::string;
+
+/**
+ * Reads the given number of bytes at the given position.
+ * @param reader
+ * @param pos
+ * @param num_bytes
+ * @return The bytes read, or std::nullopt on error.
+ */
+auto read_at(clp::RangeNetworkReader& reader, size_t pos, size_t num_bytes)
+        -> std::optional<std::string>;
+
+RangeHttpServer::RangeHttpServer(std::string body) : m_body{std::move(body)} {
+    m_listen_fd = socket(AF_INET, SOCK_STREAM, 0);
+    REQUIRE(m_listen_fd >= 0);
+    sockaddr_in addr{};
+    addr.sin_family = AF_INET;
+    addr.sin_addr.s_addr = htonl(INADDR_LOOPBACK);
+    addr.sin_port = 0;
+    // NOLINTNEXTLINE(cppcoreguidelines-pro-type-reinterpret-cast)
+    REQUIRE(0 == bind(m_listen_fd, reinterpret_cast<sockaddr*>(&addr), sizeof(addr)));
+    socklen_t addr_len{sizeof(addr)};
+    // NOLINTNEXTLINE(cppcoreguidelines-pro-type-reinterpret-cast)
+    REQUIRE(0 == getsockname(m_listen_fd, reinterpret_cast<sockaddr*>(&addr), &addr_len));
+    m_port = ntohs(addr.sin_port);
+    constexpr int cBacklog{64};
+    REQUIRE(0 == listen(m_listen_fd, cBacklog));
+    m_accept_thread = std::thread{[this]() { accept_connections(); }};
+}
+
+RangeHttpServer::~RangeHttpServer() {
+    shutdown(m_listen_fd, SHUT_RDWR);
+    m_accept_thread.join();
+    close(m_listen_fd);
+
+    // Clients may keep their connections open, so we shut them down to stop their threads
+    for (auto const fd : m_connection_fds) {
+        shutdown(fd, SHUT_RDWR);
+    }
+    for (auto& thread : m_connection_threads) {
+        thread.join();
+    }
+    for (auto const fd : m_connection_fds) {
+        close(fd);
+    }
+}
+
+void RangeHttpServer::accept_connections() {
+    while (true) {
+        auto const fd{accept(m_listen_fd, nullptr, nullptr)};
+        if (fd < 0) {
+            return;
+        }
+        ++m_num_connections;
+        std::lock_guard const lock{m_connections_mutex};
+        m_connection_fds.push_back(fd);
+        m_connection_threads.emplace_back([this, fd]() { serve(fd); });
+    }
+}
+
+void RangeHttpServer::serve(int fd) {
+    constexpr std::string_view cHeaderEnd{"\r\n\r\n"};
+    std::string received;
+    std::vector<char> buf(4096);
+    while (true) {
+        auto header_end_pos{received.find(cHeaderEnd)};
+        while (std::string::npos == header_end_pos) {
+            auto const num_bytes_read{recv(fd, buf.data(), buf.size(), 0)};
+            if (num_bytes_read <= 0) {
+                return;
+            }
+            received.append(buf.data(), static_cast<size_t>(num_bytes_read));
+            header_end_pos = received.find(cHeaderEnd);
+        }
+        // Requests are GETs without bodies, so each one ends with its headers
+        auto request{received.substr(0, header_end_pos + cHeaderEnd.size())};
+        received.erase(0, request.size());
+        ++m_num_requests;
+
+        auto const response{get_response(std::move(request))};
+        if (false == response.has_value()) {
+            m_received_invalid_request = true;
+            return;
+        }
+        for (size_t num_bytes_sent{0}; num_bytes_sent < response->size();) {
+            auto const rc{send(
+                    fd,
+                    response->data() + num_bytes_sent,
+                    response->size() - num_bytes_sent,
+                    MSG_NOSIGNAL
+            )};
+            if (rc <= 0) {
+                return;
+            }
+            num_bytes_sent += static_cast<size_t>(rc);
+        }
+    }
+}
+
+auto RangeHttpServer::get_response(std::string request) -> std::optional<std::string> {
+    std::transform(request.begin(), request.end(), request.begin(), [](unsigned char c) -> char {
+        return static_cast<char>(std::tolower(c));
+    });
+    constexpr std::string_view cRangeHeader{"\r\nrange: bytes="};
+    auto const range_pos{request.find(cRangeHeader)};
+    if (std::string::npos == range_pos) {
+        m_num_body_bytes_sent += m_body.size();
+        return fmt::format("HTTP/1.1 200 OK\r\nContent-Length: {}\r\n\r\n", m_body.size())
+               + m_body;
+    }
+
+    size_t begin{0};
+    size_t last{0};
+    if (2
+        != std::sscanf(
+                request.c_str() + range_pos + cRangeHeader.size(),
+                "%zu-%zu",
+                &begin,
+                &last
+        ))
+    {
+        return std::nullopt;
+    }
+    if (begin >= m_body.size()) {
+        return "HTTP/1.1 416 Range Not Satisfiable\r\nContent-Length: 0\r\n\r\n";
+    }
+    last = std::min(last, m_body.size() - 1);
+    auto const num_body_bytes{last + 1 - begin};
+    m_num_body_bytes_sent += num_body_bytes;
+    return fmt::format(
+                   "HTTP/1.1 206 Partial Content\r\nContent-Range: bytes {}-{}/{}\r\n"
+                   "Content-Length: {}\r\n\r\n",
+                   begin,
+                   last,
+                   m_body.size(),
+                   num_body_bytes
+           )
+           + m_body.substr(begin, num_body_bytes);
+}
+
+auto generate_body(size_t size) -> std::string {
+    std::string body(size, '\0');
+    uint32_t state{1};
+    for (auto& c : body) {
+        state = state * 1'103'515'245U + 12'345U;
+        c = static_cast<char>(state >> 24U);
+    }
+    return body;
+}
+
+auto read_at(clp::RangeNetworkReader& reader, size_t pos, size_t num_bytes)
+        -> std::optional<std::string> {
+    if (clp::ErrorCode_Success != reader.try_seek_from_begin(pos)) {
+        return std::nullopt;
+    }
+    std::string buf(num_bytes, '\0');
+    size_t num_bytes_read{0};
+    if (clp::ErrorCode_Success != reader.try_read(buf.data(), num_bytes, num_bytes_read)) {
+        return std::nullopt;
+    }
+    buf.resize(num_bytes_read);
+    return buf;
+}
+}  // namespace
+
+TEST_CASE("range_network_reader_random_access", "[RangeNetworkReader]") {
+    constexpr size_t cBodySize{10'000};
+    constexpr size_t cBlockSize{1024};
+    constexpr size_t cMaxNumCachedBlocks{4};
+    auto const body{generate_body(cBodySize)};
+    RangeHttpServer const server{body};
+
+    clp::CurlGlobalInstance const curl_global_instance;
+    clp::RangeNetworkReader reader{server.get_url(), cBlockSize, cMaxNumCachedBlocks};
+
+    // Reads can go backwards and span blocks
+    for (auto const [pos, num_bytes] : std::vector<std::pair<size_t, size_t>>{
+                 {5000, 3000},
+                 {100, 50},
+                 {9990, 10},
+                 {0, cBodySize}
+         })
+    {
+        REQUIRE((body.substr(pos, num_bytes) == read_at(reader, pos, num_bytes)));
+    }
+
+    // Re-reading a recently read block doesn't issue a request
+    auto const num_requests{reader.get_num_requests()};
+    REQUIRE((body.substr(cBodySize - 100, 50) == read_at(reader, cBodySize - 100, 50)));
+    REQUIRE(num_requests == reader.get_num_requests());
+    REQUIRE(server.get_num_requests() == reader.get_num_requests());
+
+    // Every request reuses the first request's connection
+    REQUIRE(1 == server.get_num_connections());
+
+    // Reads are truncated at, and fail past, the end of the data
+    REQUIRE((body.substr(9990) == read_at(reader, 9990, 100)));
+    REQUIRE(cBodySize == reader.get_size());
+    REQUIRE(clp::ErrorCode_Success == reader.try_seek_from_begin(cBodySize + cBlockSize * 4));
+    char c{};
+    size_t num_bytes_read{0};
+    REQUIRE(clp::ErrorCode_EndOfFile == reader.try_read(&c, 1, num_bytes_read));
+    REQUIRE(0 == num_bytes_read);
+    REQUIRE_FALSE(server.received_invalid_request());
+}
+
+TEST_CASE("range_network_reader_prefetch", "[RangeNetworkReader]") {
+    constexpr size_t cBodySize{64 * 1024};
+    constexpr size_t cBlockSize{1024};
+    constexpr size_t cMaxNumCachedBlocks{32};
+    constexpr size_t cMaxNumParallelRequests{4};
+    constexpr size_t cMaxCoalescingGap{2 * cBlockSize};
+    auto const body{generate_body(cBodySize)};
+    RangeHttpServer const server{body};
+
+    clp::CurlGlobalInstance const curl_global_instance;
+    clp::RangeNetworkReader reader{
+            server.get_url(),
+            cBlockSize,
+            cMaxNumCachedBlocks,
+            cMaxNumParallelRequests,
+            cMaxCoalescingGap
+    };
+
+    // The first two ranges (blocks 0 and 3) are close enough to be coalesced, unlike the others
+    std::vector<clp::RangeNetworkReader::ByteRange> const ranges{
+            {10, 100},
+            {3 * cBlockSize + 10, 3 * cBlockSize + 20},
+            {20 * cBlockSize, 22 * cBlockSize + 1},
+            {40 * cBlockSize, 41 * cBlockSize}
+    };
+    REQUIRE(clp::ErrorCode_Success == reader.prefetch(ranges));
+    REQUIRE(3 == reader.get_num_requests());
+    REQUIRE(3 == server.get_num_requests());
+
+    // The prefetched ranges are read without issuing any requests
+    for (auto const& [begin, end] : ranges) {
+        REQUIRE((body.substr(begin, end - begin) == read_at(reader, begin, end - begin)));
+    }
+    REQUIRE(3 == reader.get_num_requests());
+
+    // Prefetching cached ranges is a no-op
+    REQUIRE(clp::ErrorCode_Success == reader.prefetch(ranges));
+    REQUIRE(3 == reader.get_num_requests());
+    REQUIRE(3 == server.get_num_requests());
+    REQUIRE(server.get_num_connections() <= cMaxNumParallelRequests);
+    REQUIRE_FALSE(server.received_invalid_request());
+}
+
+TEST_CASE("range_network_reader_prefetch_limit", "[RangeNetworkReader]") {
+    constexpr size_t cBodySize{64 * 1024};
+    constexpr size_t cBlockSize{1024};
+    constexpr size_t cMaxNumCachedBlocks{8};
+    constexpr size_t cMaxNumPrefetchedBlocks{cMaxNumCachedBlocks / 2};
+    constexpr size_t cMaxNumParallelRequests{4};
+    constexpr size_t cMaxCoalescingGap{4 * cBlockSize};
+    auto const body{generate_body(cBodySize)};
+    RangeHttpServer const server{body};
+
+    clp::CurlGlobalInstance const curl_global_instance;
+    clp::RangeNetworkReader reader{
+            server.get_url(),
+            cBlockSize,
+            cMaxNumCachedBlocks,
+            cMaxNumParallelRequests,
+            cMaxCoalescingGap
+    };
+
+    // Coalescing blocks 0 and 4 would download 5 blocks, exceeding the limit, so they're requested
+    // separately. Blocks 5 and 6 are coalesced with block 4, after which the limit is reached.
+    std::vector<clp::RangeNetworkReader::ByteRange> const ranges{
+            {0, 1},
+            {4 * cBlockSize, 7 * cBlockSize},
+            {8 * cBlockSize, 9 * cBlockSize}
+    };
+    REQUIRE(clp::ErrorCode_Success == reader.prefetch(ranges));
+    REQUIRE(2 == server.get_num_requests());
+    REQUIRE(cMaxNumPrefetchedBlocks * cBlockSize == server.get_num_body_bytes_sent());
+
+    // Blocks that weren't prefetched are downloaded on demand
+    constexpr size_t cUnprefetchedPos{8 * cBlockSize};
+    REQUIRE((body.substr(cUnprefetchedPos, cBlockSize)
+             == read_at(reader, cUnprefetchedPos, cBlockSize)));
+    REQUIRE(3 == server.get_num_requests());
+    REQUIRE_FALSE(server.received_invalid_request());
+}
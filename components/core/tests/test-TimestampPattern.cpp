@@ -1,3 +1,11 @@
+#include <cstddef>
+#include <filesystem>
+#include <fstream>
+#include <string>
+#include <vector>
+
+#include <catch2/benchmark/catch_benchmark.hpp>
+#include <catch2/catch_message.hpp>
 #include <catch2/catch_test_macros.hpp>
 
 #include "../src/clp/TimestampPattern.hpp"
@@ -5,6 +13,78 @@
 using clp::epochtime_t;
 using clp::TimestampPattern;
 using std::string;
+using std::vector;
+
+namespace {
+/**
+ * @return The lines of the test log files, followed by a sample line for each kind of known
+ * timestamp pattern and a few lines without timestamps.
+ */
+auto get_benchmark_lines() -> vector<string>;
+
+/**
+ * Searches for a known timestamp pattern by parsing the line with every known pattern in order, as
+ * a reference for `TimestampPattern::search_known_ts_patterns`.
+ * @param line
+ * @param timestamp Parsed timestamp
+ * @param timestamp_begin_pos
+ * @param timestamp_end_pos
+ * @return pointer to the timestamp pattern if found, nullptr otherwise
+ */
+auto search_known_ts_patterns_linearly(
+        string const& line,
+        epochtime_t& timestamp,
+        size_t& timestamp_begin_pos,
+        size_t& timestamp_end_pos
+) -> TimestampPattern const*;
+
+auto get_benchmark_lines() -> vector<string> {
+    std::filesystem::path const current_file_path{__FILE__};
+    auto const test_log_files_dir{current_file_path.parent_path() / "test_log_files"};
+
+    vector<string> lines;
+    for (auto const* file_name : {"log.txt", "log_with_capture.txt"}) {
+        std::ifstream file{test_log_files_dir / file_name};
+        REQUIRE(file.is_open());
+        for (string line; std::getline(file, line);) {
+            lines.emplace_back(line);
+        }
+    }
+    lines.insert(
+            lines.end(),
+            {"2015-01-31T15:50:45.392 content after",
+             "[2015-01-31 15:50:45,085] content after",
+             "INFO [main] 2015-01-31 15:50:45,085 content after",
+             "01 Jan 2016 15:50:17,085 content after",
+             "[20170106-16:56:41] content after",
+             "Jan 01, 2016 3:50:17 PM content after",
+             "localhost - - [01/Jan/2016:15:50:17 content after",
+             "ERROR: apport (pid 4557) Sun Jan  1 15:50:45 2015 content after",
+             "Jan 21 11:56:42 content after",
+             "916321 content after",
+             "content without a timestamp",
+             "    at org.apache.hadoop.ipc.Client.call(Client.java:1476)",
+             ""}
+    );
+    return lines;
+}
+
+auto search_known_ts_patterns_linearly(
+        string const& line,
+        epochtime_t& timestamp,
+        size_t& timestamp_begin_pos,
+        size_t& timestamp_end_pos
+) -> TimestampPattern const* {
+    for (auto const& pattern : TimestampPattern::get_known_ts_patterns()) {
+        if (pattern.parse_timestamp(line, timestamp, timestamp_begin_pos, timestamp_end_pos)) {
+            return &pattern;
+        }
+    }
+    timestamp_begin_pos = string::npos;
+    timestamp_end_pos = string::npos;
+    return nullptr;
+}
+}  // namespace
 
 TEST_CASE("Test known timestamp patterns", "[KnownTimestampPatterns]") {
     TimestampPattern::init();
@@ -549,3 +629,107 @@ TEST_CASE("Test known timestamp patterns", "[KnownTimestampPatterns]") {
     specific_pattern.insert_formatted_timestamp(timestamp, content);
     REQUIRE(line == content);
 }
+
+TEST_CASE("Test known timestamp pattern dispatch", "[KnownTimestampPatterns]") {
+    TimestampPattern::init();
+
+    epochtime_t timestamp{0};
+    size_t timestamp_begin_pos{0};
+    size_t timestamp_end_pos{0};
+
+    // Lines without timestamps, including ones with too few spaces for most patterns
+    for (string const line : {"", " ", "content", "0 content", "   ", "INFO [main] content"}) {
+        REQUIRE(nullptr
+                == TimestampPattern::search_known_ts_patterns(
+                        line,
+                        timestamp,
+                        timestamp_begin_pos,
+                        timestamp_end_pos
+                ));
+        REQUIRE(string::npos == timestamp_begin_pos);
+        REQUIRE(string::npos == timestamp_end_pos);
+    }
+
+    // Relative timestamps can't begin with a zero
+    string line = "0916321 content after";
+    REQUIRE(nullptr
+            == TimestampPattern::search_known_ts_patterns(
+                    line,
+                    timestamp,
+                    timestamp_begin_pos,
+                    timestamp_end_pos
+            ));
+
+    // A line whose first character rules out most patterns still matches later patterns in order
+    line = "Jan 21 11:56:42 content after";
+    auto const* pattern = TimestampPattern::search_known_ts_patterns(
+            line,
+            timestamp,
+            timestamp_begin_pos,
+            timestamp_end_pos
+    );
+    REQUIRE(nullptr != pattern);
+    REQUIRE(pattern->get_num_spaces_before_ts() == 0);
+    REQUIRE(pattern->get_format() == "%b %d %H:%M:%S");
+    REQUIRE(0 == timestamp_begin_pos);
+    REQUIRE(15 == timestamp_end_pos);
+
+    // Every line gets the same result as parsing it with each known pattern in turn, including when
+    // the line is shifted so that the timestamp begins at a different position
+    for (auto const& benchmark_line : get_benchmark_lines()) {
+        for (auto const& line_variant :
+             {benchmark_line, " " + benchmark_line, "[" + benchmark_line, "0" + benchmark_line})
+        {
+            CAPTURE(line_variant);
+            pattern = TimestampPattern::search_known_ts_patterns(
+                    line_variant,
+                    timestamp,
+                    timestamp_begin_pos,
+                    timestamp_end_pos
+            );
+
+            epochtime_t expected_timestamp{0};
+            size_t expected_begin_pos{0};
+            size_t expected_end_pos{0};
+            auto const* expected_pattern = search_known_ts_patterns_linearly(
+                    line_variant,
+                    expected_timestamp,
+                    expected_begin_pos,
+                    expected_end_pos
+            );
+            REQUIRE(expected_pattern == pattern);
+            REQUIRE(expected_begin_pos == timestamp_begin_pos);
+            REQUIRE(expected_end_pos == timestamp_end_pos);
+            if (nullptr != pattern) {
+                REQUIRE(expected_timestamp == timestamp);
+            }
+        }
+    }
+}
+
+TEST_CASE("Known timestamp pattern search throughput", "[KnownTimestampPatterns][!benchmark]") {
+    TimestampPattern::init();
+    auto const lines = get_benchmark_lines();
+
+    // Each benchmark iteration searches every line once, so the throughput in lines/s is the
+    // number of lines divided by the reported mean iteration time.
+    BENCHMARK("search_known_ts_patterns") {
+        size_t num_timestamps_found{0};
+        epochtime_t timestamp{0};
+        size_t timestamp_begin_pos{0};
+        size_t timestamp_end_pos{0};
+        for (auto const& line : lines) {
+            if (nullptr
+                != TimestampPattern::search_known_ts_patterns(
+                        line,
+                        timestamp,
+                        timestamp_begin_pos,
+                        timestamp_end_pos
+                ))
+            {
+                ++num_timestamps_found;
+            }
+        }
+        return num_timestamps_found;
+    };
+}
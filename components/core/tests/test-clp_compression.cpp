@@ -0,0 +1,164 @@
+#include <cstddef>
+#include <filesystem>
+#include <fstream>
+#include <iterator>
+#include <map>
+#include <memory>
+#include <string>
+#include <string_view>
+#include <utility>
+#include <vector>
+
+#include <catch2/catch_message.hpp>
+#include <catch2/catch_test_macros.hpp>
+#include <fmt/format.h>
+#include <spdlog/spdlog.h>
+
+#include "../src/clp/clp/run.hpp"
+#include "../src/clp/GlobalMetadataDB.hpp"
+#include "../src/clp/GlobalSQLiteMetadataDB.hpp"
+#include "../src/clp/streaming_archive/Constants.hpp"
+#include "../src/clp/streaming_archive/reader/Archive.hpp"
+#include "TestOutputCleaner.hpp"
+
+namespace {
+constexpr std::string_view cTestInputDirectory{"test-clp-compression-input"};
+constexpr std::string_view cTestArchiveDirectory{"test-clp-compression-archives"};
+constexpr std::string_view cTestOutputDirectory{"test-clp-compression-output"};
+constexpr size_t cNumInputFiles{12};
+constexpr size_t cNumLinesPerInputFile{500};
+constexpr size_t cNumThreads{4};
+
+/**
+ * Runs `clp` with the given arguments.
+ * @param args
+ * @return The exit code of `clp`.
+ */
+auto run_clp(std::vector<std::string> const& args) -> int;
+
+/**
+ * Writes input files with distinct contents to the test input directory.
+ * @return A map from each input file's name to its contents.
+ */
+auto write_input_files() -> std::map<std::string, std::string>;
+
+/**
+ * @param path
+ * @return The contents of the file at the given path.
+ */
+auto read_file(std::filesystem::path const& path) -> std::string;
+
+auto run_clp(std::vector<std::string> const& args) -> int {
+    std::vector<char const*> argv{"clp"};
+    for (auto const& arg : args) {
+        argv.push_back(arg.c_str());
+    }
+    argv.push_back(nullptr);
+    // `clp::clp::run` registers a logger for `spdlog` that persists across runs, so we drop it to
+    // allow each run to create a fresh one.
+    spdlog::drop_all();
+    return clp::clp::run(static_cast<int>(argv.size() - 1), argv.data());
+}
+
+auto write_input_files() -> std::map<std::string, std::string> {
+    std::filesystem::create_directory(cTestInputDirectory);
+    std::map<std::string, std::string> file_name_to_contents;
+    for (size_t file_idx{0}; file_idx < cNumInputFiles; ++file_idx) {
+        std::string contents;
+        for (size_t line_idx{0}; line_idx < cNumLinesPerInputFile; ++line_idx) {
+            contents += fmt::format(
+                    "2024-01-01 00:00:{:02}.{:03} INFO Worker {} processed task {} in {} ms\n",
+                    line_idx % 60,
+                    line_idx % 1000,
+                    file_idx,
+                    line_idx,
+                    file_idx * line_idx
+            );
+        }
+        auto file_name{fmt::format("file-{}.log", file_idx)};
+        std::ofstream{std::filesystem::path{cTestInputDirectory} / file_name} << contents;
+        file_name_to_contents.emplace(std::move(file_name), std::move(contents));
+    }
+    return file_name_to_contents;
+}
+
+auto read_file(std::filesystem::path const& path) -> std::string {
+    std::ifstream file{path, std::ios::binary};
+    return {std::istreambuf_iterator<char>{file}, std::istreambuf_iterator<char>{}};
+}
+}  // namespace
+
+TEST_CASE("clp_compression_with_multiple_threads", "[clp][compression]") {
+    TestOutputCleaner const test_cleanup{
+            {std::string{cTestInputDirectory},
+             std::string{cTestArchiveDirectory},
+             std::string{cTestOutputDirectory}}
+    };
+    auto const file_name_to_contents{write_input_files()};
+    auto const input_dir{std::filesystem::absolute(cTestInputDirectory)};
+
+    REQUIRE((0
+             == run_clp(
+                     {"c",
+                      "--num-threads",
+                      std::to_string(cNumThreads),
+                      "--remove-path-prefix",
+                      input_dir.string(),
+                      std::string{cTestArchiveDirectory},
+                      input_dir.string()}
+             )));
+
+    // Each thread compresses into its own archives, and every file is in exactly one archive
+    std::filesystem::path const archives_dir{cTestArchiveDirectory};
+    clp::GlobalSQLiteMetadataDB global_metadata_db{
+            (archives_dir / clp::streaming_archive::cMetadataDBFileName).string()
+    };
+    global_metadata_db.open();
+    std::map<std::string, size_t> file_name_to_num_archives;
+    size_t num_archives{0};
+    std::unique_ptr<clp::GlobalMetadataDB::ArchiveIterator> const archive_it{
+            global_metadata_db.get_archive_iterator()
+    };
+    for (std::string archive_id; archive_it->contains_element(); archive_it->get_next()) {
+        archive_it->get_id(archive_id);
+        ++num_archives;
+        clp::streaming_archive::reader::Archive archive_reader;
+        archive_reader.open((archives_dir / archive_id).string());
+        auto file_it{archive_reader.get_file_iterator()};
+        for (std::string path; file_it->has_next(); file_it->next()) {
+            file_it->get_path(path);
+            ++file_name_to_num_archives[std::filesystem::path{path}.filename().string()];
+        }
+        file_it.reset();
+        archive_reader.close();
+    }
+    global_metadata_db.close();
+
+    REQUIRE((num_archives > 0));
+    REQUIRE((file_name_to_num_archives.size() == file_name_to_contents.size()));
+    for (auto const& [file_name, num_archives_containing_file] : file_name_to_num_archives) {
+        CAPTURE(file_name);
+        REQUIRE(file_name_to_contents.contains(file_name));
+        REQUIRE((1 == num_archives_containing_file));
+    }
+
+    // Every file decompresses identically
+    REQUIRE((0
+             == run_clp(
+                     {"x", std::string{cTestArchiveDirectory}, std::string{cTestOutputDirectory}}
+             )));
+    size_t num_decompressed_files{0};
+    for (auto const& entry :
+         std::filesystem::recursive_directory_iterator{std::string{cTestOutputDirectory}})
+    {
+        if (false == entry.is_regular_file()) {
+            continue;
+        }
+        auto const file_name{entry.path().filename().string()};
+        CAPTURE(file_name);
+        REQUIRE(file_name_to_contents.contains(file_name));
+        REQUIRE((read_file(entry.path()) == file_name_to_contents.at(file_name)));
+        ++num_decompressed_files;
+    }
+    REQUIRE((num_decompressed_files == file_name_to_contents.size()));
+}
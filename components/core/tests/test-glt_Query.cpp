@@ -0,0 +1,153 @@
+#include <cstddef>
+#include <cstdint>
+#include <random>
+#include <unordered_set>
+#include <vector>
+
+#include <catch2/catch_message.hpp>
+#include <catch2/catch_test_macros.hpp>
+#include <catch2/generators/catch_generators.hpp>
+
+#include "../src/glt/Defs.h"
+#include "../src/glt/Query.hpp"
+#include "../src/glt/VariableDictionaryEntry.hpp"
+
+using glt::encoded_variable_t;
+using glt::LogtypeQuery;
+using glt::QueryVar;
+using glt::VariableDictionaryEntry;
+
+namespace {
+// Variables are drawn from a small range so that query variables match often
+constexpr encoded_variable_t cMaxVarValue{31};
+constexpr size_t cMaxNumColumns{6};
+constexpr size_t cMaxNumQueryVars{4};
+constexpr size_t cNumRows{64};
+constexpr size_t cNumQueriesPerKind{200};
+
+enum class QueryVarKind : uint8_t {
+    Precise,
+    FewImprecise,
+    ManyImprecise,
+    Mixed
+};
+
+/**
+ * @param kind
+ * @param gen
+ * @return A random query variable of the given kind, or of a random kind if `kind` is `Mixed`.
+ */
+auto generate_query_var(QueryVarKind kind, std::mt19937& gen) -> QueryVar;
+
+/**
+ * @param num_possible_vars
+ * @param gen
+ * @return An imprecise dictionary query variable with the given number of distinct possible values.
+ */
+auto generate_imprecise_query_var(size_t num_possible_vars, std::mt19937& gen) -> QueryVar;
+
+auto generate_query_var(QueryVarKind kind, std::mt19937& gen) -> QueryVar {
+    if (QueryVarKind::Mixed == kind) {
+        std::uniform_int_distribution<int> kind_dist{0, 2};
+        kind = static_cast<QueryVarKind>(kind_dist(gen));
+    }
+
+    std::uniform_int_distribution<encoded_variable_t> var_dist{0, cMaxVarValue};
+    switch (kind) {
+        case QueryVarKind::Precise:
+            // Both precise non-dictionary and precise dictionary variables are compared directly
+            if (0 == var_dist(gen) % 2) {
+                return QueryVar{var_dist(gen)};
+            }
+            return QueryVar{var_dist(gen), nullptr};
+        case QueryVarKind::FewImprecise: {
+            // At most 16 possible values are compared one value at a time
+            std::uniform_int_distribution<size_t> num_possible_vars_dist{2, 16};
+            return generate_imprecise_query_var(num_possible_vars_dist(gen), gen);
+        }
+        case QueryVarKind::ManyImprecise:
+        default: {
+            // More than 16 possible values are looked up in a hash set
+            std::uniform_int_distribution<size_t> num_possible_vars_dist{17, 24};
+            return generate_imprecise_query_var(num_possible_vars_dist(gen), gen);
+        }
+    }
+}
+
+auto generate_imprecise_query_var(size_t num_possible_vars, std::mt19937& gen) -> QueryVar {
+    std::uniform_int_distribution<encoded_variable_t> var_dist{0, cMaxVarValue};
+    std::unordered_set<encoded_variable_t> possible_vars;
+    while (possible_vars.size() < num_possible_vars) {
+        possible_vars.insert(var_dist(gen));
+    }
+    return QueryVar{possible_vars, std::unordered_set<VariableDictionaryEntry const*>{}};
+}
+}  // namespace
+
+TEST_CASE("glt_logtype_query_matches_vars_by_column", "[glt][Query]") {
+    auto const kind = GENERATE(
+            QueryVarKind::Precise,
+            QueryVarKind::FewImprecise,
+            QueryVarKind::ManyImprecise,
+            QueryVarKind::Mixed
+    );
+    CAPTURE(static_cast<int>(kind));
+
+    std::mt19937 gen{static_cast<std::mt19937::result_type>(kind)};
+    std::uniform_int_distribution<size_t> num_columns_dist{0, cMaxNumColumns};
+    std::uniform_int_distribution<size_t> num_query_vars_dist{0, cMaxNumQueryVars};
+    std::uniform_int_distribution<encoded_variable_t> var_dist{0, cMaxVarValue};
+
+    size_t num_matching_rows{0};
+    size_t num_non_matching_rows{0};
+    for (size_t query_ix{0}; query_ix < cNumQueriesPerKind; ++query_ix) {
+        CAPTURE(query_ix);
+
+        std::vector<QueryVar> query_vars;
+        auto const num_query_vars{num_query_vars_dist(gen)};
+        for (size_t i{0}; i < num_query_vars; ++i) {
+            query_vars.push_back(generate_query_var(kind, gen));
+        }
+        LogtypeQuery const query{query_vars, false};
+
+        // Store the table both by column, as the logtype table does, and by row
+        auto const num_columns{num_columns_dist(gen)};
+        std::vector<std::vector<encoded_variable_t>> columns(
+                num_columns,
+                std::vector<encoded_variable_t>(cNumRows)
+        );
+        std::vector<std::vector<encoded_variable_t>> rows(
+                cNumRows,
+                std::vector<encoded_variable_t>(num_columns)
+        );
+        for (size_t row_ix{0}; row_ix < cNumRows; ++row_ix) {
+            for (size_t column_ix{0}; column_ix < num_columns; ++column_ix) {
+                auto const var{var_dist(gen)};
+                columns[column_ix][row_ix] = var;
+                rows[row_ix][column_ix] = var;
+            }
+        }
+        std::vector<encoded_variable_t const*> column_ptrs;
+        for (auto const& column : columns) {
+            column_ptrs.push_back(column.data());
+        }
+
+        std::vector<uint8_t> row_matches;
+        query.matches_vars(column_ptrs, cNumRows, row_matches);
+        REQUIRE((cNumRows == row_matches.size()));
+        for (size_t row_ix{0}; row_ix < cNumRows; ++row_ix) {
+            CAPTURE(row_ix);
+            auto const expected_match{query.matches_vars(rows[row_ix])};
+            REQUIRE((expected_match == (0 != row_matches[row_ix])));
+            if (expected_match) {
+                ++num_matching_rows;
+            } else {
+                ++num_non_matching_rows;
+            }
+        }
+    }
+
+    // Both outcomes must have been exercised for the comparison to be meaningful
+    REQUIRE((num_matching_rows > 0));
+    REQUIRE((num_non_matching_rows > 0));
+}
@@ -1,8 +1,10 @@
+#include <algorithm>
 #include <cstddef>
 #include <cstdint>
 #include <map>
 #include <memory>
 #include <optional>
+#include <span>
 #include <sstream>
 #include <string>
 #include <string_view>
@@ -12,6 +14,7 @@
 #include <utility>
 #include <vector>
 
+#include <catch2/benchmark/catch_benchmark.hpp>
 #include <catch2/catch_template_test_macros.hpp>
 #include <catch2/catch_test_macros.hpp>
 #include <catch2/generators/catch_generators.hpp>
@@ -250,6 +253,28 @@ template <typename encoded_variable_t>
         Serializer<encoded_variable_t>& serializer
 ) -> bool;
 
+/**
+ * Unpacks the given pairs of auto-generated and user-generated JSON objects into msgpack maps.
+ * @tparam encoded_variable_t
+ * @param json_object_pairs
+ * @param msgpack_obj_handles Returns the handles that own the unpacked msgpack objects. The handles
+ * must outlive the returned maps.
+ * @return The unpacked pairs of msgpack maps.
+ */
+template <typename encoded_variable_t>
+[[nodiscard]] auto unpack_json_object_pairs(
+        vector<std::pair<nlohmann::json, nlohmann::json>> const& json_object_pairs,
+        vector<msgpack::object_handle>& msgpack_obj_handles
+) -> vector<typename Serializer<encoded_variable_t>::MsgpackMapPair>;
+
+/**
+ * @param num_log_events
+ * @return Pairs of auto-generated and user-generated JSON objects representative of structured logs
+ * produced by log shippers, where most consecutive log events share the same schema shape.
+ */
+[[nodiscard]] auto create_structured_log_event_json_object_pairs(size_t num_log_events)
+        -> vector<std::pair<nlohmann::json, nlohmann::json>>;
+
 template <typename encoded_variable_t>
 [[nodiscard]] auto serialize_log_events(
         vector<UnstructuredLogEvent> const& log_events,
@@ -428,6 +453,62 @@ auto unpack_and_assert_serialization_failure(
     }
     return true;
 }
+
+template <typename encoded_variable_t>
+auto unpack_json_object_pairs(
+        vector<std::pair<nlohmann::json, nlohmann::json>> const& json_object_pairs,
+        vector<msgpack::object_handle>& msgpack_obj_handles
+) -> vector<typename Serializer<encoded_variable_t>::MsgpackMapPair> {
+    auto const unpack = [&](nlohmann::json const& json_obj) -> msgpack::object_map {
+        auto const msgpack_bytes{nlohmann::json::to_msgpack(json_obj)};
+        auto& handle{msgpack_obj_handles.emplace_back(msgpack::unpack(
+                size_checked_pointer_cast<char const>(msgpack_bytes.data()),
+                msgpack_bytes.size()
+        ))};
+        auto const& msgpack_obj{handle.get()};
+        REQUIRE((msgpack::type::MAP == msgpack_obj.type));
+        return msgpack_obj.via.map;
+    };
+
+    vector<typename Serializer<encoded_variable_t>::MsgpackMapPair> msgpack_map_pairs;
+    msgpack_map_pairs.reserve(json_object_pairs.size());
+    for (auto const& [auto_gen_json_obj, user_gen_json_obj] : json_object_pairs) {
+        auto const auto_gen_map{unpack(auto_gen_json_obj)};
+        auto const user_gen_map{unpack(user_gen_json_obj)};
+        msgpack_map_pairs.emplace_back(auto_gen_map, user_gen_map);
+    }
+    return msgpack_map_pairs;
+}
+
+auto create_structured_log_event_json_object_pairs(size_t num_log_events)
+        -> vector<std::pair<nlohmann::json, nlohmann::json>> {
+    constexpr size_t cNumInstances{8};
+    constexpr size_t cShapeChangePeriod{64};
+    constexpr int64_t cBaseTimestamp{1'700'000'000'000};
+
+    vector<std::pair<nlohmann::json, nlohmann::json>> json_object_pairs;
+    json_object_pairs.reserve(num_log_events);
+    for (size_t i{0}; i < num_log_events; ++i) {
+        auto const idx{static_cast<int64_t>(i)};
+        nlohmann::json const auto_gen_obj
+                = {{"timestamp", cBaseTimestamp + idx}, {"utc_offset", 0}, {"source", "stdout"}};
+        nlohmann::json user_gen_obj
+                = {{"level", 0 == i % cShapeChangePeriod ? "WARN" : "INFO"},
+                   {"service", {{"name", "api-gateway"}, {"instance", i % cNumInstances}}},
+                   {"message",
+                    "GET /api/v1/users/" + std::to_string(i) + " completed in "
+                            + std::to_string(i % 1000) + " ms"},
+                   {"latency_ms", static_cast<double>(i % 1000) / 3.0},
+                   {"success", 0 != i % cShapeChangePeriod},
+                   {"tags", {"prod", "us-east-1"}}};
+        if (0 == i % cShapeChangePeriod) {
+            // Periodically change the schema shape
+            user_gen_obj["error"] = {{"code", idx}, {"reason", "upstream timeout"}};
+        }
+        json_object_pairs.emplace_back(auto_gen_obj, std::move(user_gen_obj));
+    }
+    return json_object_pairs;
+}
 }  // namespace
 
 /**
@@ -1602,3 +1683,135 @@ TEMPLATE_TEST_CASE(
     REQUIRE(IrSerializationError{IrSerializationErrorEnum::UnsupportedUserDefinedMetadata}
             == serializer_result.error());
 }
+
+// NOLINTNEXTLINE(readability-function-cognitive-complexity)
+TEMPLATE_TEST_CASE(
+        "ffi_ir_stream_Serializer_serialize_msgpack_map_batch",
+        "[clp][ffi][ir_stream][Serializer]",
+        four_byte_encoded_variable_t,
+        eight_byte_encoded_variable_t
+) {
+    constexpr size_t cNumLogEvents{256};
+    auto json_object_pairs{create_structured_log_event_json_object_pairs(cNumLogEvents)};
+
+    // Add log events whose shapes only differ from their predecessors' in key order, nesting, or
+    // value types, to exercise the node ID cache's fallback.
+    auto const empty_obj = nlohmann::json::parse("{}");
+    json_object_pairs.emplace_back(empty_obj, nlohmann::json{{"a", {{"b", 1}}}, {"c", 2}});
+    json_object_pairs.emplace_back(empty_obj, nlohmann::json{{"a", {{"b", 1}, {"c", 2}}}});
+    json_object_pairs.emplace_back(empty_obj, nlohmann::json{{"a", {{"b", "str"}, {"c", 2}}}});
+    json_object_pairs.emplace_back(empty_obj, nlohmann::json{{"a", empty_obj}, {"c", 2.0}});
+    json_object_pairs.emplace_back(empty_obj, empty_obj);
+
+    vector<msgpack::object_handle> msgpack_obj_handles;
+    auto const msgpack_map_pairs{
+            unpack_json_object_pairs<TestType>(json_object_pairs, msgpack_obj_handles)
+    };
+
+    // Serialize the log events one by one
+    auto per_event_serializer_result{Serializer<TestType>::create()};
+    REQUIRE_FALSE(per_event_serializer_result.has_error());
+    auto& per_event_serializer{per_event_serializer_result.value()};
+    for (auto const& [auto_gen_map, user_gen_map] : msgpack_map_pairs) {
+        REQUIRE_FALSE(per_event_serializer.serialize_msgpack_map(auto_gen_map, user_gen_map)
+                              .has_error());
+    }
+
+    // Serialize the log events as batches
+    auto batch_serializer_result{Serializer<TestType>::create()};
+    REQUIRE_FALSE(batch_serializer_result.has_error());
+    auto& batch_serializer{batch_serializer_result.value()};
+    constexpr size_t cBatchSize{100};
+    std::span<typename Serializer<TestType>::MsgpackMapPair const> remaining{msgpack_map_pairs};
+    while (false == remaining.empty()) {
+        auto const batch_size{std::min(cBatchSize, remaining.size())};
+        REQUIRE_FALSE(batch_serializer.serialize_msgpack_map_batch(remaining.first(batch_size))
+                              .has_error());
+        remaining = remaining.subspan(batch_size);
+    }
+
+    auto const per_event_ir_buf_view{per_event_serializer.get_ir_buf_view()};
+    auto const batch_ir_buf_view{batch_serializer.get_ir_buf_view()};
+    REQUIRE(std::ranges::equal(per_event_ir_buf_view, batch_ir_buf_view));
+
+    // A batch containing an invalid log event should leave the serializer unchanged
+    auto const num_ir_bytes_before_invalid_batch{batch_ir_buf_view.size()};
+    std::map<string, std::map<int, int>> const invalid_map{{"new_key", {{0, 0}}}};
+    std::stringstream msgpack_serialization_buffer;
+    msgpack::pack(msgpack_serialization_buffer, invalid_map);
+    auto const invalid_msgpack_bytes{msgpack_serialization_buffer.str()};
+    auto const invalid_msgpack_obj_handle{
+            msgpack::unpack(invalid_msgpack_bytes.data(), invalid_msgpack_bytes.size())
+    };
+    vector<typename Serializer<TestType>::MsgpackMapPair> invalid_batch{
+            msgpack_map_pairs.begin(),
+            msgpack_map_pairs.begin() + cBatchSize
+    };
+    invalid_batch.emplace_back(
+            msgpack_map_pairs.front().first,
+            invalid_msgpack_obj_handle.get().via.map
+    );
+    REQUIRE(batch_serializer.serialize_msgpack_map_batch(invalid_batch).has_error());
+    REQUIRE((num_ir_bytes_before_invalid_batch == batch_serializer.get_ir_buf_view().size()));
+
+    // Serializing the same log events after the failed batch should produce identical results
+    std::span<typename Serializer<TestType>::MsgpackMapPair const> const valid_batch{
+            invalid_batch.data(),
+            cBatchSize
+    };
+    REQUIRE_FALSE(batch_serializer.serialize_msgpack_map_batch(valid_batch).has_error());
+    for (auto const& [auto_gen_map, user_gen_map] : valid_batch) {
+        REQUIRE_FALSE(per_event_serializer.serialize_msgpack_map(auto_gen_map, user_gen_map)
+                              .has_error());
+    }
+    REQUIRE(std::ranges::equal(
+            per_event_serializer.get_ir_buf_view(),
+            batch_serializer.get_ir_buf_view()
+    ));
+}
+
+TEMPLATE_TEST_CASE(
+        "ffi_ir_stream_Serializer_throughput",
+        "[clp][ffi][ir_stream][Serializer][!benchmark]",
+        four_byte_encoded_variable_t,
+        eight_byte_encoded_variable_t
+) {
+    // Each benchmark iteration serializes `cNumLogEvents` log events, so the throughput in events/s
+    // is `cNumLogEvents` divided by the reported mean iteration time.
+    constexpr size_t cNumLogEvents{10'000};
+    constexpr size_t cBatchSize{1000};
+    auto const json_object_pairs{create_structured_log_event_json_object_pairs(cNumLogEvents)};
+    vector<msgpack::object_handle> msgpack_obj_handles;
+    auto const msgpack_map_pairs{
+            unpack_json_object_pairs<TestType>(json_object_pairs, msgpack_obj_handles)
+    };
+
+    auto serializer_result{Serializer<TestType>::create()};
+    REQUIRE_FALSE(serializer_result.has_error());
+    auto& serializer{serializer_result.value()};
+
+    BENCHMARK("serialize_msgpack_map") {
+        serializer.clear_ir_buf();
+        for (auto const& [auto_gen_map, user_gen_map] : msgpack_map_pairs) {
+            if (serializer.serialize_msgpack_map(auto_gen_map, user_gen_map).has_error()) {
+                return size_t{0};
+            }
+        }
+        return serializer.get_ir_buf_view().size();
+    };
+
+    BENCHMARK("serialize_msgpack_map_batch") {
+        serializer.clear_ir_buf();
+        std::span<typename Serializer<TestType>::MsgpackMapPair const> remaining{
+                msgpack_map_pairs
+        };
+        while (false == remaining.empty()) {
+            auto const batch_size{std::min(cBatchSize, remaining.size())};
+            if (serializer.serialize_msgpack_map_batch(remaining.first(batch_size)).has_error()) {
+                return size_t{0};
+            }
+            remaining = remaining.subspan(batch_size);
+        }
+        return serializer.get_ir_buf_view().size();
+    };
+}
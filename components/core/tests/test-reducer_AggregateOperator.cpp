@@ -0,0 +1,96 @@
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <set>
+#include <vector>
+
+#include <catch2/catch_test_macros.hpp>
+#include <nlohmann/json.hpp>
+
+#include "../src/reducer/AggregateOperator.hpp"
+#include "../src/reducer/DeserializedRecordGroup.hpp"
+#include "../src/reducer/GroupTags.hpp"
+#include "../src/reducer/JsonArrayRecordIterator.hpp"
+#include "../src/reducer/Pipeline.hpp"
+
+using reducer::AggregateOperator;
+using reducer::DeserializedRecordGroup;
+using reducer::GroupTags;
+using reducer::PartialAggregateRecordAdapter;
+using reducer::Pipeline;
+using reducer::PipelineInputMode;
+
+TEST_CASE("reducer-aggregate-operator-inter-stage", "[reducer][AggregateOperator]") {
+    AggregateOperator aggregate_operator{"latency"};
+    GroupTags const tags{"service-a"};
+    reducer::JsonArrayRecordIterator record_it{nlohmann::json::array_t{
+            {{"latency", 3}},
+            {{"latency", -1.5}},
+            {{"latency", 10}},
+    }};
+    aggregate_operator.push_inter_stage_record_group(tags, record_it);
+
+    auto const& groups{aggregate_operator.get_groups()};
+    REQUIRE(1 == groups.size());
+    auto const& partial{groups.at(tags)};
+    REQUIRE(3 == partial.count);
+    REQUIRE(11.5 == partial.sum);
+    REQUIRE(-1.5 == partial.min);
+    REQUIRE(10.0 == partial.max);
+}
+
+TEST_CASE("reducer-aggregate-operator-merge-partials", "[reducer][AggregateOperator]") {
+    // Each "archive" computes its own partial aggregates, which are serialized, deserialized, and
+    // merged by the reducer's pipeline
+    GroupTags const tags_a{"a", "1"};
+    GroupTags const tags_b{"b", "2"};
+    AggregateOperator first_archive;
+    first_archive.add_value(tags_a, 1.0);
+    first_archive.add_value(tags_a, 5.0);
+    first_archive.add_value(tags_b, 7.0);
+    AggregateOperator second_archive;
+    second_archive.add_value(tags_a, -2.0);
+
+    Pipeline pipeline{PipelineInputMode::IntraStage};
+    pipeline.add_pipeline_stage(std::make_shared<AggregateOperator>());
+    for (auto* archive : {&first_archive, &second_archive}) {
+        for (auto group_it = archive->get_stored_result_iterator(); false == group_it->done();
+             group_it->next())
+        {
+            auto& group = group_it->get();
+            auto serialized_group = reducer::serialize(group.get_tags(), group.record_iter());
+            DeserializedRecordGroup deserialized_group{serialized_group};
+            pipeline.push_record_group(
+                    deserialized_group.get_tags(),
+                    deserialized_group.record_iter()
+            );
+        }
+    }
+
+    size_t num_groups{0};
+    for (auto group_it = pipeline.finish(); false == group_it->done(); group_it->next()) {
+        auto& group = group_it->get();
+        auto& record_it = group.record_iter();
+        REQUIRE_FALSE(record_it.done());
+        auto const& record = record_it.get();
+        if (tags_a == group.get_tags()) {
+            REQUIRE(3 == record.get_int64_value(PartialAggregateRecordAdapter::cCountKey));
+            REQUIRE(4.0 == record.get_double_value(PartialAggregateRecordAdapter::cSumKey));
+            REQUIRE(-2.0 == record.get_double_value(PartialAggregateRecordAdapter::cMinKey));
+            REQUIRE(5.0 == record.get_double_value(PartialAggregateRecordAdapter::cMaxKey));
+        } else {
+            REQUIRE(tags_b == group.get_tags());
+            REQUIRE(1 == record.get_int64_value(PartialAggregateRecordAdapter::cCountKey));
+            REQUIRE(7.0 == record.get_double_value(PartialAggregateRecordAdapter::cAvgKey));
+        }
+        ++num_groups;
+    }
+    REQUIRE(2 == num_groups);
+
+    std::set<GroupTags> const filter{tags_b, GroupTags{"missing"}};
+    auto filtered_it = pipeline.finish(filter);
+    REQUIRE_FALSE(filtered_it->done());
+    REQUIRE(tags_b == filtered_it->get().get_tags());
+    filtered_it->next();
+    REQUIRE(filtered_it->done());
+}
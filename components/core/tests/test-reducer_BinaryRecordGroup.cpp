@@ -0,0 +1,163 @@
+#include <cstddef>
+#include <cstdint>
+#include <string>
+#include <utility>
+#include <vector>
+
+#include <catch2/benchmark/catch_benchmark.hpp>
+#include <catch2/catch_test_macros.hpp>
+
+#include "../src/reducer/AggregateOperator.hpp"
+#include "../src/reducer/BinaryRecordGroup.hpp"
+#include "../src/reducer/ConstRecordIterator.hpp"
+#include "../src/reducer/DeserializedRecordGroup.hpp"
+#include "../src/reducer/GroupTags.hpp"
+#include "../src/reducer/Record.hpp"
+#include "../src/reducer/RecordTypedKeyIterator.hpp"
+
+using reducer::BinaryRecordGroupView;
+using reducer::ConstRecordIterator;
+using reducer::GroupTags;
+using reducer::PartialAggregate;
+using reducer::PartialAggregateRecordAdapter;
+using reducer::Record;
+using reducer::ValueType;
+
+namespace {
+/**
+ * A ConstRecordIterator over records owned by the caller.
+ */
+class RecordPointerIterator : public ConstRecordIterator {
+public:
+    explicit RecordPointerIterator(std::vector<Record const*> records)
+            : m_records{std::move(records)} {}
+
+    [[nodiscard]] Record const& get() const override { return *m_records[m_idx]; }
+
+    void next() override { ++m_idx; }
+
+    bool done() override { return m_idx == m_records.size(); }
+
+private:
+    std::vector<Record const*> m_records;
+    size_t m_idx{0};
+};
+
+/**
+ * @param num_groups
+ * @return `num_groups` partial aggregates with distinct tags
+ */
+auto create_partial_aggregates(size_t num_groups)
+        -> std::vector<std::pair<GroupTags, PartialAggregate>>;
+
+auto create_partial_aggregates(size_t num_groups)
+        -> std::vector<std::pair<GroupTags, PartialAggregate>> {
+    std::vector<std::pair<GroupTags, PartialAggregate>> partial_aggregates;
+    for (size_t i = 0; i < num_groups; ++i) {
+        PartialAggregate partial;
+        partial.add(static_cast<double>(i));
+        partial.add(static_cast<double>(i) * 2.5);
+        partial_aggregates.emplace_back(
+                GroupTags{"service-" + std::to_string(i % 100), std::to_string(i)},
+                partial
+        );
+    }
+    return partial_aggregates;
+}
+}  // namespace
+
+TEST_CASE("reducer-binary-record-group-round-trip", "[reducer][BinaryRecordGroup]") {
+    PartialAggregate partial;
+    partial.add(-1.5);
+    partial.add(4.0);
+    PartialAggregateRecordAdapter aggregate_record;
+    aggregate_record.set_record_value(&partial);
+    reducer::SingleStringRecordAdapter string_record{"name"};
+    string_record.set_record_value("a string with \"quotes\"");
+    reducer::EmptyRecord const empty_record;
+
+    GroupTags const tags{"tag", "", "another tag"};
+    RecordPointerIterator record_it{{&aggregate_record, &string_record, &empty_record}};
+    std::vector<char> buffer;
+    reducer::serialize_binary(tags, record_it, buffer);
+
+    BinaryRecordGroupView group;
+    REQUIRE(group.parse(buffer.data(), buffer.size()));
+    REQUIRE(tags == group.get_tags());
+
+    auto& it = group.record_iter();
+    REQUIRE_FALSE(it.done());
+    REQUIRE(2 == it.get().get_int64_value(PartialAggregateRecordAdapter::cCountKey));
+    REQUIRE(2.5 == it.get().get_double_value(PartialAggregateRecordAdapter::cSumKey));
+    REQUIRE(-1.5 == it.get().get_double_value(PartialAggregateRecordAdapter::cMinKey));
+    REQUIRE(4.0 == it.get().get_double_value(PartialAggregateRecordAdapter::cMaxKey));
+    REQUIRE(1.25 == it.get().get_double_value(PartialAggregateRecordAdapter::cAvgKey));
+    // Looking up an element with the wrong type or a missing key returns the default value
+    REQUIRE(0 == it.get().get_int64_value(PartialAggregateRecordAdapter::cSumKey));
+    REQUIRE(it.get().get_string_view("missing").empty());
+    size_t num_elements{0};
+    for (auto key_it = it.get().typed_key_iter(); false == key_it->done(); key_it->next()) {
+        auto const expected_type = 0 == num_elements ? ValueType::Int64 : ValueType::Double;
+        REQUIRE(expected_type == key_it->get().get_type());
+        ++num_elements;
+    }
+    REQUIRE(5 == num_elements);
+
+    it.next();
+    REQUIRE_FALSE(it.done());
+    REQUIRE("a string with \"quotes\"" == it.get().get_string_view("name"));
+    auto key_it = it.get().typed_key_iter();
+    REQUIRE("name" == key_it->get().get_key());
+    REQUIRE(ValueType::String == key_it->get().get_type());
+
+    it.next();
+    REQUIRE_FALSE(it.done());
+    REQUIRE(it.get().typed_key_iter()->done());
+
+    it.next();
+    REQUIRE(it.done());
+
+    // Truncated and padded buffers are rejected
+    REQUIRE_FALSE(group.parse(buffer.data(), buffer.size() - 1));
+    buffer.push_back('\0');
+    REQUIRE_FALSE(group.parse(buffer.data(), buffer.size()));
+}
+
+TEST_CASE("reducer-record-group-throughput", "[reducer][BinaryRecordGroup][!benchmark]") {
+    // Each benchmark iteration serializes and then receives `cNumGroups` groups, so the throughput
+    // in groups/s is `cNumGroups` divided by the reported mean iteration time.
+    constexpr size_t cNumGroups{10'000};
+    auto const partial_aggregates = create_partial_aggregates(cNumGroups);
+    PartialAggregateRecordAdapter record;
+
+    BENCHMARK("msgpack") {
+        int64_t total_count{0};
+        for (auto const& [tags, partial] : partial_aggregates) {
+            record.set_record_value(&partial);
+            RecordPointerIterator record_it{{&record}};
+            auto serialized_group = reducer::serialize(tags, record_it);
+            reducer::DeserializedRecordGroup group{serialized_group};
+            for (auto& it = group.record_iter(); false == it.done(); it.next()) {
+                total_count += it.get().get_int64_value(PartialAggregateRecordAdapter::cCountKey);
+            }
+        }
+        return total_count;
+    };
+
+    BENCHMARK("binary") {
+        int64_t total_count{0};
+        std::vector<char> buffer;
+        BinaryRecordGroupView group;
+        for (auto const& [tags, partial] : partial_aggregates) {
+            record.set_record_value(&partial);
+            RecordPointerIterator record_it{{&record}};
+            buffer.clear();
+            reducer::serialize_binary(tags, record_it, buffer);
+            REQUIRE(group.parse(buffer.data(), buffer.size()));
+            for (auto& it = group.record_iter(); false == it.done(); it.next()) {
+                total_count += it.get().get_int64_value(PartialAggregateRecordAdapter::cCountKey);
+            }
+        }
+        return total_count;
+    };
+}
@@ -0,0 +1,159 @@
+#include <cstddef>
+#include <cstdint>
+#include <map>
+#include <memory>
+#include <string>
+#include <thread>
+#include <vector>
+
+#include <catch2/catch_test_macros.hpp>
+#include <nlohmann/json.hpp>
+
+#include "../src/reducer/CountOperator.hpp"
+#include "../src/reducer/GroupTags.hpp"
+#include "../src/reducer/JsonArrayRecordIterator.hpp"
+#include "../src/reducer/Pipeline.hpp"
+#include "../src/reducer/RecordGroup.hpp"
+#include "../src/reducer/ShardedPipeline.hpp"
+
+using reducer::CountOperator;
+using reducer::GroupTags;
+using reducer::Pipeline;
+using reducer::PipelineInputMode;
+using reducer::RecordGroup;
+using reducer::ShardedPipeline;
+
+namespace {
+constexpr size_t cNumShards{4};
+constexpr size_t cNumGroups{20};
+
+/**
+ * @param track_updated_tags
+ * @return A sharded pipeline whose shards each count the records in every group.
+ */
+auto make_count_pipeline(bool track_updated_tags) -> ShardedPipeline;
+
+/**
+ * Pushes a record group containing the given count.
+ * @param pipeline
+ * @param tags
+ * @param count
+ */
+auto push_count(ShardedPipeline& pipeline, GroupTags const& tags, int64_t count) -> void;
+
+/**
+ * @param group_idx
+ * @return The tags of the group with the given index.
+ */
+auto get_group_tags(size_t group_idx) -> GroupTags;
+
+/**
+ * @param group
+ * @return The count in the given group.
+ */
+auto get_count(RecordGroup& group) -> int64_t;
+
+auto make_count_pipeline(bool track_updated_tags) -> ShardedPipeline {
+    return ShardedPipeline{
+            cNumShards,
+            []() {
+                auto pipeline = std::make_unique<Pipeline>(PipelineInputMode::IntraStage);
+                pipeline->add_pipeline_stage(std::make_shared<CountOperator>());
+                return pipeline;
+            },
+            track_updated_tags
+    };
+}
+
+auto push_count(ShardedPipeline& pipeline, GroupTags const& tags, int64_t count) -> void {
+    reducer::JsonArrayRecordIterator record_it{
+            nlohmann::json::array_t{{{CountOperator::cRecordElementKey, count}}}
+    };
+    pipeline.push_record_group(tags, record_it);
+}
+
+auto get_group_tags(size_t group_idx) -> GroupTags {
+    return GroupTags{std::to_string(group_idx)};
+}
+
+auto get_count(RecordGroup& group) -> int64_t {
+    auto& record_it = group.record_iter();
+    REQUIRE_FALSE(record_it.done());
+    return record_it.get().get_int64_value(CountOperator::cRecordElementKey);
+}
+}  // namespace
+
+TEST_CASE("reducer-sharded-pipeline-finish", "[reducer][ShardedPipeline]") {
+    constexpr size_t cNumThreads{4};
+    auto pipeline{make_count_pipeline(false)};
+    REQUIRE(cNumShards == pipeline.get_num_shards());
+
+    // Every thread pushes every group, so each group's state must be merged within its shard
+    std::vector<std::thread> threads;
+    for (size_t i = 0; i < cNumThreads; ++i) {
+        threads.emplace_back([&]() {
+            for (size_t group_idx = 0; group_idx < cNumGroups; ++group_idx) {
+                push_count(pipeline, get_group_tags(group_idx), static_cast<int64_t>(group_idx));
+            }
+        });
+    }
+    for (auto& thread : threads) {
+        thread.join();
+    }
+
+    std::map<GroupTags, int64_t> tags_to_count;
+    pipeline.finish([&](RecordGroup& group) {
+        REQUIRE(tags_to_count.emplace(group.get_tags(), get_count(group)).second);
+    });
+    REQUIRE(cNumGroups == tags_to_count.size());
+    for (size_t group_idx = 0; group_idx < cNumGroups; ++group_idx) {
+        REQUIRE(static_cast<int64_t>(cNumThreads * group_idx)
+                == tags_to_count.at(get_group_tags(group_idx)));
+    }
+}
+
+TEST_CASE("reducer-sharded-pipeline-publish-updated-groups", "[reducer][ShardedPipeline]") {
+    auto pipeline{make_count_pipeline(true)};
+    for (size_t group_idx = 0; group_idx < cNumGroups; ++group_idx) {
+        push_count(pipeline, get_group_tags(group_idx), 1);
+    }
+
+    std::map<GroupTags, int64_t> published_tags_to_count;
+    auto collect_group = [&](RecordGroup& group) {
+        published_tags_to_count[group.get_tags()] = get_count(group);
+    };
+    size_t num_commits{0};
+    auto fail_commit = [&]() {
+        ++num_commits;
+        return false;
+    };
+    auto succeed_commit = [&]() {
+        ++num_commits;
+        return true;
+    };
+
+    // A failed commit leaves the groups to be published again, along with any new updates
+    REQUIRE_FALSE(pipeline.publish_updated_groups(collect_group, fail_commit));
+    REQUIRE(1 == num_commits);
+    REQUIRE(cNumGroups == published_tags_to_count.size());
+    push_count(pipeline, get_group_tags(0), 1);
+
+    published_tags_to_count.clear();
+    REQUIRE(pipeline.publish_updated_groups(collect_group, succeed_commit));
+    REQUIRE(2 == num_commits);
+    REQUIRE(cNumGroups == published_tags_to_count.size());
+    REQUIRE(2 == published_tags_to_count.at(get_group_tags(0)));
+    REQUIRE(1 == published_tags_to_count.at(get_group_tags(1)));
+
+    // Nothing is published until a group is updated again
+    published_tags_to_count.clear();
+    REQUIRE(pipeline.publish_updated_groups(collect_group, succeed_commit));
+    REQUIRE(2 == num_commits);
+    REQUIRE(published_tags_to_count.empty());
+
+    push_count(pipeline, get_group_tags(cNumGroups - 1), 5);
+    REQUIRE(pipeline.publish_updated_groups(collect_group, succeed_commit));
+    REQUIRE(3 == num_commits);
+    REQUIRE(1 == published_tags_to_count.size());
+    REQUIRE(6 == published_tags_to_count.at(get_group_tags(cNumGroups - 1)));
+}
@@ -1,12 +1,15 @@
 #include <algorithm>
 #include <cstddef>
 #include <cstdint>
+#include <iterator>
 #include <optional>
 #include <random>
 #include <string>
 #include <string_view>
+#include <utility>
 #include <vector>
 
+#include <catch2/catch_message.hpp>
 #include <catch2/catch_test_macros.hpp>
 #include <catch2/generators/catch_generators.hpp>
 #include <nlohmann/json.hpp>
@@ -24,6 +27,29 @@ namespace {
  */
 [[nodiscard]] auto get_expected_escaped_string(std::string_view raw) -> std::string;
 
+/**
+ * Generates a random string from a mix of ASCII characters (including those that need escaping),
+ * valid multi-byte UTF-8 characters, and bytes that are invalid or out of place in UTF-8.
+ * @param generator
+ * @param length The number of pieces to combine into the string.
+ * @return The generated string.
+ */
+[[nodiscard]] auto generate_random_string(std::mt19937& generator, size_t length) -> std::string;
+
+/**
+ * Validates the given string with the given validation method, recording the positions of the
+ * characters passed to the escape handler.
+ * @tparam Validator
+ * @param str
+ * @param validate
+ * @return A pair containing:
+ * - Whether the string is valid UTF-8.
+ * - The positions passed to the escape handler.
+ */
+template <typename Validator>
+[[nodiscard]] auto get_escape_handler_positions(std::string_view str, Validator validate)
+        -> std::pair<bool, std::vector<size_t>>;
+
 /**
  * Generates a UTF-8 encoded byte sequence with the given code point and number of continuation
  * bytes. The range of the code point is not validated, which means the generated byte sequence can
@@ -42,6 +68,56 @@ auto get_expected_escaped_string(std::string_view raw) -> std::string {
     return {dumped_str.begin() + 1, dumped_str.end() - 1};
 }
 
+auto generate_random_string(std::mt19937& generator, size_t length) -> std::string {
+    std::vector<std::string> const pieces{
+            "a",
+            "Z",
+            " ",
+            "0123456789abcdef",
+            "\"",
+            "\\",
+            "\n",
+            std::string{'\0'},
+            "\x1F",
+            "\x7F",
+            "\xC2\xA2",
+            "\xE4\xB8\xAD",
+            "\xF0\xA0\x80\x8F",
+            "\xED\xA0\x80",  // Surrogate code point
+            "\xC0\x80",  // Overlong encoding
+            "\xF4\x90\x80\x80",  // Beyond the largest code point
+            "\x80",
+            "\xE4",
+            "\xFF"
+    };
+    // Weight valid ASCII characters heavily so that strings tend to contain long runs of them
+    constexpr size_t cNumAsciiPieces{4};
+    std::uniform_int_distribution<size_t> ascii_distribution{0, cNumAsciiPieces - 1};
+    std::uniform_int_distribution<size_t> piece_distribution{0, pieces.size() - 1};
+    std::bernoulli_distribution is_ascii_distribution{0.9};
+
+    std::string str;
+    for (size_t i{0}; i < length; ++i) {
+        auto const piece_idx{
+                is_ascii_distribution(generator) ? ascii_distribution(generator)
+                                                 : piece_distribution(generator)
+        };
+        str += pieces[piece_idx];
+    }
+    return str;
+}
+
+template <typename Validator>
+auto get_escape_handler_positions(std::string_view str, Validator validate)
+        -> std::pair<bool, std::vector<size_t>> {
+    std::vector<size_t> positions;
+    auto escape_handler = [&](std::string_view::const_iterator it) -> void {
+        positions.push_back(static_cast<size_t>(it - str.cbegin()));
+    };
+    auto const is_valid{validate(str, escape_handler)};
+    return {is_valid, positions};
+}
+
 auto generate_utf8_byte_sequence(uint32_t code_point, size_t num_continuation_bytes)
         -> std::string {
     REQUIRE((1 <= num_continuation_bytes && num_continuation_bytes <= 3));
@@ -213,3 +289,53 @@ TEST_CASE("validate_utf8_code_point_ranges", "[utf8_utils]") {
         REQUIRE((false == is_utf8_encoded(generate_utf8_byte_sequence(code_point, 3))));
     }
 }
+
+TEST_CASE("validate_utf8_string_matches_bytewise_validation", "[utf8_utils]") {
+    constexpr size_t cNumStrings{20'000};
+    constexpr size_t cMaxNumPieces{64};
+    std::mt19937 generator{std::random_device{}()};
+    std::uniform_int_distribution<size_t> num_pieces_distribution{0, cMaxNumPieces};
+
+    auto const validate_bytewise = [](std::string_view str, auto escape_handler) -> bool {
+        return clp::utf8_utils_internal::validate_utf8_string_bytewise(str, escape_handler);
+    };
+    auto const validate = [](std::string_view str, auto escape_handler) -> bool {
+        return clp::validate_utf8_string(str, escape_handler);
+    };
+    auto const validate_for_json = [](std::string_view str, auto escape_handler) -> bool {
+        return clp::validate_utf8_string_for_json(str, escape_handler);
+    };
+
+    for (size_t i{0}; i < cNumStrings; ++i) {
+        auto const str{generate_random_string(generator, num_pieces_distribution(generator))};
+        CAPTURE(str);
+
+        auto const [expected_is_valid, expected_positions]{
+                get_escape_handler_positions(str, validate_bytewise)
+        };
+        REQUIRE((is_utf8_encoded(str) == expected_is_valid));
+        REQUIRE((get_escape_handler_positions(str, validate)
+                 == std::make_pair(expected_is_valid, expected_positions)));
+
+        auto const [is_valid_for_json, json_positions]{
+                get_escape_handler_positions(str, validate_for_json)
+        };
+        REQUIRE((is_valid_for_json == expected_is_valid));
+        if (false == expected_is_valid) {
+            continue;
+        }
+        std::vector<size_t> expected_json_positions;
+        std::copy_if(
+                expected_positions.cbegin(),
+                expected_positions.cend(),
+                std::back_inserter(expected_json_positions),
+                [&](size_t pos) {
+                    constexpr uint8_t cLargestControlCharacter{0x1F};
+                    auto const c{str[pos]};
+                    return '"' == c || '\\' == c
+                           || cLargestControlCharacter >= static_cast<uint8_t>(c);
+                }
+        );
+        REQUIRE((json_positions == expected_json_positions));
+    }
+}
@@ -157,6 +157,14 @@ def _make_command_and_env_vars(
         if aggregation_config.count_by_time_bucket_size is not None:
             command.append("--count-by-time")
             command.append(str(aggregation_config.count_by_time_bucket_size))
+        if (
+            aggregation_config.aggregation_type is not None
+            and aggregation_config.aggregation_field is not None
+        ):
+            command.append(f"--{aggregation_config.aggregation_type}")
+            command.append(aggregation_config.aggregation_field)
+            for field in aggregation_config.group_by_fields or []:
+                command.extend(("--group-by", field))
     elif search_config.network_address is not None:
         # fmt: off
         command.extend((
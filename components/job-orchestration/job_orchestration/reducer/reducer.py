@@ -55,6 +55,7 @@ def main(argv: list[str]) -> int:
         "--scheduler-port", str(clp_config.query_scheduler.port),
         "--mongodb-uri", clp_config.results_cache.get_uri(),
         "--upsert-interval", str(parsed_args.upsert_interval),
+        "--num-threads", str(clp_config.reducer.num_threads),
         "--reducer-host", clp_config.reducer.host,
         "--reducer-port",
     ]
@@ -93,6 +94,7 @@ def main(argv: list[str]) -> int:
         f" Base port={clp_config.reducer.base_port}"
         f" Concurrency={concurrency}"
         f" Upsert Interval={parsed_args.upsert_interval}"
+        f" Threads={clp_config.reducer.num_threads}"
     )
     with ThreadPoolExecutor(max_workers=concurrency) as executor:
         futures = {executor.submit(reducers[i].communicate): i for i in range(concurrency)}
@@ -4,7 +4,7 @@ from enum import auto
 from typing import Literal
 
 from clp_py_utils.clp_config import S3Config
-from pydantic import BaseModel, field_validator
+from pydantic import BaseModel, field_validator, model_validator
 from strenum import LowercaseStrEnum
 
 
@@ -82,6 +82,19 @@ class AggregationConfig(BaseModel):
     reducer_port: int | None = None
     do_count_aggregation: bool | None = None
     count_by_time_bucket_size: int | None = None  # Milliseconds
+    aggregation_type: Literal["sum", "min", "max", "avg"] | None = None
+    aggregation_field: str | None = None
+    group_by_fields: list[str] | None = None
+
+    @model_validator(mode="after")
+    def validate_field_aggregation(self):
+        if (self.aggregation_type is None) != (self.aggregation_field is None):
+            raise ValueError("`aggregation_type` and `aggregation_field` must be set together")
+        if self.group_by_fields is not None and self.aggregation_field is None:
+            raise ValueError(
+                "`group_by_fields` requires `aggregation_type` and `aggregation_field` to be set"
+            )
+        return self
 
 
 class QueryJobConfig(BaseModel):